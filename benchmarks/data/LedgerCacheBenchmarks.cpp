@@ -0,0 +1,347 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCache.hpp"
+#include "data/Types.hpp"
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/newconfig/ConfigValue.hpp"
+#include "util/newconfig/Types.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <benchmark/benchmark.h>
+#include <xrpl/basics/base_uint.h>
+
+#ifdef __linux__
+#include <malloc.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kBATCH_SIZE = 512;
+constexpr std::size_t kOBJECTS_PER_LEDGER = 200;
+constexpr std::size_t kBLOB_SIZE = 100;
+
+/**
+ * @brief The original single std::map layout of LedgerCache, kept as the baseline for comparison.
+ */
+class MapLedgerCache {
+    struct CacheEntry {
+        uint32_t seq = 0;
+        data::Blob blob;
+    };
+
+    std::map<ripple::uint256, CacheEntry> map_;
+    mutable std::shared_mutex mtx_;
+    uint32_t latestSeq_ = 0;
+
+public:
+    void
+    update(std::vector<data::LedgerObject> const& objs, uint32_t seq, bool = false)
+    {
+        std::scoped_lock const lck{mtx_};
+        latestSeq_ = std::max(seq, latestSeq_);
+        for (auto const& obj : objs) {
+            if (not obj.blob.empty()) {
+                auto& e = map_[obj.key];
+                if (seq > e.seq)
+                    e = {.seq = seq, .blob = obj.blob};
+            } else {
+                map_.erase(obj.key);
+            }
+        }
+    }
+
+    std::optional<data::Blob>
+    get(ripple::uint256 const& key, uint32_t seq) const
+    {
+        std::shared_lock const lck{mtx_};
+        auto e = map_.find(key);
+        if (e == map_.end() or seq < e->second.seq)
+            return {};
+        return {e->second.blob};
+    }
+
+    std::optional<data::LedgerObject>
+    getSuccessor(ripple::uint256 const& key, uint32_t seq) const
+    {
+        std::shared_lock const lck{mtx_};
+        if (seq != latestSeq_)
+            return {};
+        auto e = map_.upper_bound(key);
+        if (e == map_.end())
+            return {};
+        return {{.key = e->first, .blob = e->second.blob}};
+    }
+
+    void
+    setFull()
+    {
+    }
+
+    uint32_t
+    latestLedgerSequence() const
+    {
+        std::shared_lock const lck{mtx_};
+        return latestSeq_;
+    }
+};
+
+void
+initPrometheus()
+{
+    static std::once_flag once;
+    std::call_once(once, [] {
+        util::config::ClioConfigDefinition const config{
+            {"prometheus.compress_reply",
+             util::config::ConfigValue{util::config::ConfigType::Boolean}.defaultValue(false)},
+            {"prometheus.enabled", util::config::ConfigValue{util::config::ConfigType::Boolean}.defaultValue(false)}
+        };
+        PrometheusService::init(config);
+    });
+}
+
+std::size_t
+allocatedBytes()
+{
+#ifdef __linux__
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+ripple::uint256
+randomKey(std::mt19937_64& gen)
+{
+    ripple::uint256 key;
+    for (auto it = key.begin(); it != key.end(); it += sizeof(uint64_t)) {
+        auto const value = gen();
+        std::copy_n(reinterpret_cast<unsigned char const*>(&value), sizeof(uint64_t), it);
+    }
+    return key;
+}
+
+std::vector<ripple::uint256>
+generateKeys(std::size_t count)
+{
+    std::mt19937_64 gen{count};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::vector<ripple::uint256> keys;
+    keys.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        keys.push_back(randomKey(gen));
+    return keys;
+}
+
+template <typename CacheType>
+void
+populate(CacheType& cache, std::vector<ripple::uint256> const& keys)
+{
+    std::vector<data::LedgerObject> batch;
+    batch.reserve(kBATCH_SIZE);
+    for (auto const& key : keys) {
+        batch.push_back({.key = key, .blob = data::Blob(kBLOB_SIZE, 0xAB)});
+        if (batch.size() == kBATCH_SIZE) {
+            cache.update(batch, 1, true);
+            batch.clear();
+        }
+    }
+    cache.update(batch, 1, true);
+    cache.setFull();
+}
+
+template <typename CacheType>
+struct PopulatedCache {
+    std::vector<ripple::uint256> keys;
+    CacheType cache;
+
+    static PopulatedCache&
+    instance(std::size_t size)
+    {
+        static std::map<std::size_t, std::unique_ptr<PopulatedCache>> instances;
+        static std::mutex mtx;
+
+        std::scoped_lock const lck{mtx};
+        auto& ptr = instances[size];
+        if (ptr == nullptr) {
+            ptr = std::make_unique<PopulatedCache>();
+            ptr->keys = generateKeys(size);
+            populate(ptr->cache, ptr->keys);
+        }
+        return *ptr;
+    }
+};
+
+}  // namespace
+
+template <typename CacheType>
+static void
+benchmarkCachePopulate(benchmark::State& state)
+{
+    initPrometheus();
+    auto const keys = generateKeys(state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto const before = allocatedBytes();
+        auto cache = std::make_unique<CacheType>();
+        state.ResumeTiming();
+
+        populate(*cache, keys);
+
+        state.PauseTiming();
+        state.counters["heap_bytes"] = static_cast<double>(allocatedBytes() - before);
+        cache.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename CacheType>
+static void
+benchmarkCacheGet(benchmark::State& state)
+{
+    initPrometheus();
+    auto& populated = PopulatedCache<CacheType>::instance(state.range(0));
+    std::mt19937_64 gen{static_cast<uint64_t>(state.thread_index())};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_int_distribution<std::size_t> dist{0, populated.keys.size() - 1};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(populated.cache.get(populated.keys[dist(gen)], 1));
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename CacheType>
+static void
+benchmarkCacheGetSuccessor(benchmark::State& state)
+{
+    initPrometheus();
+    auto& populated = PopulatedCache<CacheType>::instance(state.range(0));
+    std::mt19937_64 gen{static_cast<uint64_t>(state.thread_index())};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(populated.cache.getSuccessor(randomKey(gen), 1));
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Thread 0 keeps applying ledger diffs while the other threads read, which is the ETL vs RPC pattern.
+ */
+template <typename CacheType>
+static void
+benchmarkCacheGetWithWriter(benchmark::State& state)
+{
+    initPrometheus();
+    auto& populated = PopulatedCache<CacheType>::instance(state.range(0));
+    std::mt19937_64 gen{static_cast<uint64_t>(state.thread_index())};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_int_distribution<std::size_t> dist{0, populated.keys.size() - 1};
+
+    if (state.thread_index() == 0) {
+        std::vector<data::LedgerObject> diff(kOBJECTS_PER_LEDGER);
+        for (auto _ : state) {
+            for (auto& obj : diff)
+                obj = {.key = populated.keys[dist(gen)], .blob = data::Blob(kBLOB_SIZE, 0xCD)};
+            populated.cache.update(diff, populated.cache.latestLedgerSequence() + 1);
+        }
+    } else {
+        for (auto _ : state) {
+            auto const seq = populated.cache.latestLedgerSequence();
+            benchmark::DoNotOptimize(populated.cache.get(populated.keys[dist(gen)], seq));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Visit every object in key order by chaining successor lookups, as the initial ledger load used to.
+ */
+static void
+benchmarkCacheWalkSuccessors(benchmark::State& state)
+{
+    initPrometheus();
+    auto& populated = PopulatedCache<data::LedgerCache>::instance(state.range(0));
+
+    for (auto _ : state) {
+        ripple::uint256 key = data::kFIRST_KEY;
+        while (auto const next = populated.cache.getSuccessor(key, 1))
+            key = next->key;
+        benchmark::DoNotOptimize(key);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief Visit every object in key order with cursors over ranges walked by the given number of threads.
+ */
+static void
+benchmarkCacheWalkCursors(benchmark::State& state)
+{
+    initPrometheus();
+    auto& populated = PopulatedCache<data::LedgerCache>::instance(state.range(0));
+    auto const numThreads = static_cast<std::size_t>(state.range(1));
+
+    for (auto _ : state) {
+        auto cursors = populated.cache.getCursors(1, numThreads);
+        std::vector<std::thread> threads;
+        for (auto& cursor : cursors) {
+            threads.emplace_back([&cursor] {
+                while (auto const item = cursor.next())
+                    benchmark::DoNotOptimize(item->blob);
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(benchmarkCachePopulate<MapLedgerCache>)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(benchmarkCachePopulate<data::LedgerCache>)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(benchmarkCacheGet<MapLedgerCache>)->Arg(1 << 20)->ThreadRange(1, 8);
+BENCHMARK(benchmarkCacheGet<data::LedgerCache>)->Arg(1 << 20)->ThreadRange(1, 8);
+
+BENCHMARK(benchmarkCacheGetSuccessor<MapLedgerCache>)->Arg(1 << 20)->ThreadRange(1, 8);
+BENCHMARK(benchmarkCacheGetSuccessor<data::LedgerCache>)->Arg(1 << 20)->ThreadRange(1, 8);
+
+BENCHMARK(benchmarkCacheGetWithWriter<MapLedgerCache>)->Arg(1 << 20)->Threads(2)->Threads(4)->Threads(8);
+BENCHMARK(benchmarkCacheGetWithWriter<data::LedgerCache>)->Arg(1 << 20)->Threads(2)->Threads(4)->Threads(8);
+
+BENCHMARK(benchmarkCacheWalkSuccessors)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(benchmarkCacheWalkCursors)
+    ->Args({1 << 20, 1})
+    ->Args({1 << 20, 8})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "feed/impl/AccountSubscriptions.hpp"
+#include "feed/impl/SingleFeedBase.hpp"
+#include "util/Taggable.hpp"
+#include "util/async/AnyExecutionContext.hpp"
+#include "util/async/context/BasicExecutionContext.hpp"
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/newconfig/ConfigValue.hpp"
+#include "util/newconfig/Types.hpp"
+#include "util/prometheus/Prometheus.hpp"
+#include "web/SubscriptionContextInterface.hpp"
+
+#include <benchmark/benchmark.h>
+#include <xrpl/protocol/AccountID.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kMESSAGES_PER_LEDGER = 16;
+constexpr std::size_t kWORKERS = 8;
+
+void
+initPrometheus()
+{
+    static std::once_flag once;
+    std::call_once(once, [] {
+        util::config::ClioConfigDefinition const config{
+            {"prometheus.compress_reply",
+             util::config::ConfigValue{util::config::ConfigType::Boolean}.defaultValue(false)},
+            {"prometheus.enabled", util::config::ConfigValue{util::config::ConfigType::Boolean}.defaultValue(false)}
+        };
+        PrometheusService::init(config);
+    });
+}
+
+util::TagDecoratorFactory const&
+tagFactory()
+{
+    static util::TagDecoratorFactory const kFACTORY{util::config::ClioConfigDefinition{
+        {"log_tag_style", util::config::ConfigValue{util::config::ConfigType::String}.defaultValue("none")}
+    }};
+    return kFACTORY;
+}
+
+/**
+ * @brief A subscriber queueing the messages like a websocket session does, counting down once it got all of them.
+ */
+class QueueingSubscriber : public web::SubscriptionContextInterface {
+    std::mutex mtx_;
+    std::vector<std::shared_ptr<std::string>> queue_;
+    std::reference_wrapper<std::atomic_size_t> remaining_;
+
+public:
+    explicit QueueingSubscriber(std::atomic_size_t& remaining)
+        : web::SubscriptionContextInterface(tagFactory()), remaining_(remaining)
+    {
+    }
+
+    void
+    send(std::shared_ptr<std::string> message) override
+    {
+        std::scoped_lock const lck(mtx_);
+        queue_.push_back(std::move(message));
+        if (queue_.size() == kMESSAGES_PER_LEDGER) {
+            queue_.clear();
+            --remaining_.get();
+        }
+    }
+
+    void
+    onDisconnect(OnDisconnectSlot const&) override
+    {
+    }
+
+    void
+    setApiSubversion(uint32_t) override
+    {
+    }
+
+    uint32_t
+    apiSubversion() const override
+    {
+        return 1;
+    }
+};
+
+}  // namespace
+
+/**
+ * @brief Publishes the messages of a ledger to a number of subscribers and waits until all of them are delivered.
+ *
+ * The first argument is the number of subscribers, the second one the number of shards they are partitioned into.
+ */
+static void
+benchmarkFeedFanOut(benchmark::State& state)
+{
+    initPrometheus();
+
+    auto const numSubscribers = static_cast<std::size_t>(state.range(0));
+    util::async::AnyExecutionContext ctx{util::async::PoolExecutionContext{kWORKERS}};
+    feed::impl::SingleFeedBase feed{ctx, "benchmark", static_cast<std::size_t>(state.range(1))};
+
+    std::atomic_size_t remaining = 0;
+    std::vector<std::shared_ptr<QueueingSubscriber>> subscribers;
+    subscribers.reserve(numSubscribers);
+    for (std::size_t i = 0; i < numSubscribers; ++i)
+        feed.sub(subscribers.emplace_back(std::make_shared<QueueingSubscriber>(remaining)));
+
+    for (auto _ : state) {
+        remaining = numSubscribers;
+        for (std::size_t i = 0; i < kMESSAGES_PER_LEDGER; ++i)
+            feed.pub(R"({"type":"ledgerClosed"})");
+
+        while (remaining != 0)
+            std::this_thread::yield();
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kMESSAGES_PER_LEDGER * numSubscribers));
+    ctx.stop();
+    ctx.join();
+}
+
+BENCHMARK(benchmarkFeedFanOut)
+    ->ArgsProduct({{1'000, 10'000, 50'000}, {1, 2, 4, 8}})
+    ->ArgNames({"subscribers", "shards"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * @brief Matches the accounts affected by a transaction against subscribers watching a number of accounts each.
+ *
+ * The first argument is the number of subscribers, the second one the number of accounts each of them watches.
+ */
+static void
+benchmarkAccountMatch(benchmark::State& state)
+{
+    constexpr std::size_t kAFFECTED_ACCOUNTS = 4;
+
+    auto const numSubscribers = static_cast<std::size_t>(state.range(0));
+    auto const accountsPerSubscriber = static_cast<std::size_t>(state.range(1));
+
+    std::atomic_size_t remaining = 0;
+    std::vector<std::shared_ptr<QueueingSubscriber>> subscribers;
+    feed::impl::AccountSubscriptions subscriptions;
+    std::uint64_t nextAccount = 1;
+    for (std::size_t i = 0; i < numSubscribers; ++i) {
+        std::vector<ripple::AccountID> accounts;
+        accounts.reserve(accountsPerSubscriber);
+        for (std::size_t j = 0; j < accountsPerSubscriber; ++j)
+            accounts.emplace_back(nextAccount++);
+        subscriptions.sub(accounts, subscribers.emplace_back(std::make_shared<QueueingSubscriber>(remaining)));
+    }
+
+    // every affected account is watched by a different subscriber
+    std::unordered_set<ripple::AccountID> affected;
+    for (std::size_t i = 0; i < kAFFECTED_ACCOUNTS; ++i)
+        affected.emplace(std::uint64_t{1 + ((i * accountsPerSubscriber) % (nextAccount - 1))});
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(subscriptions.match(affected));
+}
+
+BENCHMARK(benchmarkAccountMatch)
+    ->ArgsProduct({{16, 256}, {1'000, 10'000}})
+    ->ArgNames({"subscribers", "accounts"})
+    ->Unit(benchmark::kMicrosecond);
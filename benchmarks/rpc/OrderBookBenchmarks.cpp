@@ -0,0 +1,169 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/BackendInterface.hpp"
+#include "data/Types.hpp"
+#include "rpc/RPCHelpers.hpp"
+#include "util/MockBackend.hpp"
+#include "util/TestObject.hpp"
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/newconfig/ConfigValue.hpp"
+#include "util/newconfig/Types.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/spawn.hpp>
+#include <gmock/gmock.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/AccountID.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/STAmount.h>
+#include <xrpl/protocol/UintTypes.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::uint32_t kSEQ = 30;
+constexpr auto kRTT = std::chrono::microseconds{200};
+constexpr auto kTXN_ID = "E3FE6EA3D48F0C2B639448020EA4F03D4F4F8FFDB243A852A0F59177921B4879";
+
+void
+initPrometheus()
+{
+    static std::once_flag once;
+    std::call_once(once, [] {
+        util::config::ClioConfigDefinition const config{
+            {"prometheus.compress_reply",
+             util::config::ConfigValue{util::config::ConfigType::Boolean}.defaultValue(false)},
+            {"prometheus.enabled", util::config::ConfigValue{util::config::ConfigType::Boolean}.defaultValue(false)}
+        };
+        PrometheusService::init(config);
+    });
+}
+
+/**
+ * @brief A backend holding the USD trust lines of a number of offer owners, where every read costs one round trip.
+ */
+struct OwnersBackend {
+    ripple::AccountID const issuer{std::uint64_t{1'000'000}};
+    ripple::Currency const currency = ripple::to_currency("USD");
+    std::vector<ripple::AccountID> owners;
+    std::map<ripple::uint256, data::Blob> objects;
+    std::atomic_size_t calls = 0;
+    std::unique_ptr<testing::NiceMock<MockBackend>> backend;
+
+    explicit OwnersBackend(std::size_t numOwners)
+    {
+        initPrometheus();
+
+        auto const issuerId = ripple::toBase58(issuer);
+        objects[ripple::keylet::account(issuer).key] =
+            createAccountRootObject(issuerId, 0, 2, 200, 2, kTXN_ID, 2).getSerializer().peekData();
+
+        // owners have smaller account ids than the issuer, so they are the low side of their lines
+        for (std::size_t idx = 1; idx <= numOwners; ++idx) {
+            auto const& owner = owners.emplace_back(std::uint64_t{idx});
+            auto const ownerId = ripple::toBase58(owner);
+            objects[ripple::keylet::line(owner, issuer, currency).key] =
+                createRippleStateLedgerObject("USD", issuerId, 100, ownerId, 1000, issuerId, 1000, kTXN_ID, 2)
+                    .getSerializer()
+                    .peekData();
+        }
+
+        backend = std::make_unique<testing::NiceMock<MockBackend>>(util::config::ClioConfigDefinition{});
+        ON_CALL(*backend, doFetchLedgerObject)
+            .WillByDefault([this](ripple::uint256 const& key, std::uint32_t, boost::asio::yield_context) {
+                roundTrip();
+                auto const it = objects.find(key);
+                return it == objects.end() ? std::optional<data::Blob>{} : it->second;
+            });
+        ON_CALL(*backend, doFetchLedgerObjects)
+            .WillByDefault([this](std::vector<ripple::uint256> const& keys, std::uint32_t, boost::asio::yield_context) {
+                roundTrip();
+                std::vector<data::Blob> blobs;
+                blobs.reserve(keys.size());
+                for (auto const& key : keys) {
+                    auto const it = objects.find(key);
+                    blobs.push_back(it == objects.end() ? data::Blob{} : it->second);
+                }
+                return blobs;
+            });
+    }
+
+    void
+    roundTrip()
+    {
+        ++calls;
+        std::this_thread::sleep_for(kRTT);
+    }
+};
+
+}  // namespace
+
+static void
+benchmarkOwnerFundsPerOwner(benchmark::State& state)
+{
+    OwnersBackend owners{static_cast<std::size_t>(state.range(0))};
+
+    for (auto _ : state) {
+        data::synchronous([&](boost::asio::yield_context yield) {
+            for (auto const& owner : owners.owners) {
+                benchmark::DoNotOptimize(
+                    rpc::accountHolds(*owners.backend, kSEQ, owner, owners.currency, owners.issuer, true, yield)
+                );
+            }
+        });
+    }
+
+    state.counters["backend_calls"] =
+        benchmark::Counter(static_cast<double>(owners.calls), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void
+benchmarkOwnerFundsBatched(benchmark::State& state)
+{
+    OwnersBackend owners{static_cast<std::size_t>(state.range(0))};
+
+    for (auto _ : state) {
+        data::synchronous([&](boost::asio::yield_context yield) {
+            benchmark::DoNotOptimize(rpc::accountHolds(
+                *owners.backend, kSEQ, owners.owners, owners.currency, owners.issuer, true, yield
+            ));
+        });
+    }
+
+    state.counters["backend_calls"] =
+        benchmark::Counter(static_cast<double>(owners.calls), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(benchmarkOwnerFundsPerOwner)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK(benchmarkOwnerFundsBatched)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMillisecond);
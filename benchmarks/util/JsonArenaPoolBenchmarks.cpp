@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/CountingMemoryResource.hpp"
+#include "util/JsonArenaPool.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/json/parse.hpp>
+#include <boost/json/storage_ptr.hpp>
+#include <fmt/core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+/**
+ * @brief A request with the given number of signers, to parse requests of different sizes.
+ */
+std::string
+makeRequest(std::size_t numSigners)
+{
+    std::string request = R"JSON({"method": "submit_multisigned", "params": [{"tx_json": {"Signers": [)JSON";
+    for (std::size_t idx = 0; idx < numSigners; ++idx) {
+        if (idx != 0)
+            request += ',';
+        request += fmt::format(
+            R"JSON({{"Signer": {{"Account": "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn", "TxnSignature": "{:064X}"}}}})JSON",
+            idx
+        );
+    }
+    return request + "]}}]}";
+}
+
+}  // namespace
+
+static void
+benchmarkParseRequestOnHeap(benchmark::State& state)
+{
+    auto const request = makeRequest(static_cast<std::size_t>(state.range(0)));
+    CountingMemoryResource heap;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(boost::json::parse(request, boost::json::storage_ptr{&heap}));
+
+    state.counters["heap_allocations"] =
+        benchmark::Counter(static_cast<double>(heap.allocations()), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(request.size()));
+}
+
+static void
+benchmarkParseRequestInArena(benchmark::State& state)
+{
+    auto const request = makeRequest(static_cast<std::size_t>(state.range(0)));
+    CountingMemoryResource heap;
+    util::JsonArenaPool pool{util::JsonArenaPool::kDEFAULT_BLOCK_SIZE, 1, boost::json::storage_ptr{&heap}};
+
+    for (auto _ : state) {
+        auto const arena = pool.acquire();
+        benchmark::DoNotOptimize(boost::json::parse(request, arena.storage()));
+    }
+
+    state.counters["heap_allocations"] =
+        benchmark::Counter(static_cast<double>(heap.allocations()), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(request.size()));
+}
+
+BENCHMARK(benchmarkParseRequestOnHeap)->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(benchmarkParseRequestInArena)->RangeMultiplier(8)->Range(1, 512);
@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/newconfig/ConfigValue.hpp"
+#include "util/newconfig/Types.hpp"
+#include "web/dosguard/DOSGuard.hpp"
+#include "web/dosguard/WhitelistHandlerInterface.hpp"
+
+#include <benchmark/benchmark.h>
+#include <fmt/core.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kCLIENTS_PER_THREAD = 1024;
+
+struct NoWhitelist : web::dosguard::WhitelistHandlerInterface {
+    [[nodiscard]] bool
+    isWhiteListed(std::string_view) const override
+    {
+        return false;
+    }
+};
+
+web::dosguard::DOSGuard&
+dosGuard()
+{
+    using util::config::ConfigType;
+    using util::config::ConfigValue;
+
+    // limits high enough for no client to ever hit them
+    static util::config::ClioConfigDefinition const kCONFIG{
+        {"dos_guard.max_fetches", ConfigValue{ConfigType::Integer}.defaultValue(1'000'000'000)},
+        {"dos_guard.max_connections", ConfigValue{ConfigType::Integer}.defaultValue(1'000'000)},
+        {"dos_guard.max_requests", ConfigValue{ConfigType::Integer}.defaultValue(1'000'000'000)},
+        {"dos_guard.sweep_interval", ConfigValue{ConfigType::Double}.defaultValue(1.0)}
+    };
+    static NoWhitelist const kWHITELIST;
+    static web::dosguard::DOSGuard guard{kCONFIG, kWHITELIST};
+    return guard;
+}
+
+}  // namespace
+
+/**
+ * @brief Every thread plays the connection threads of its own clients, checking each request the way the servers do.
+ */
+static void
+benchmarkDOSGuardRequests(benchmark::State& state)
+{
+    std::vector<std::string> ips;
+    ips.reserve(kCLIENTS_PER_THREAD);
+    for (std::size_t idx = 0; idx < kCLIENTS_PER_THREAD; ++idx)
+        ips.push_back(fmt::format("10.{}.{}.{}", state.thread_index(), idx / 256, idx % 256));
+
+    auto& guard = dosGuard();
+    std::size_t next = 0;
+    for (auto _ : state) {
+        auto const& ip = ips[next++ % ips.size()];
+        guard.increment(ip);
+        benchmark::DoNotOptimize(guard.request(ip));
+        benchmark::DoNotOptimize(guard.add(ip, 10));
+        benchmark::DoNotOptimize(guard.isOk(ip));
+        guard.decrement(ip);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief The same with the sweep running all the time on the first thread.
+ */
+static void
+benchmarkDOSGuardRequestsWhileSweeping(benchmark::State& state)
+{
+    if (state.thread_index() != 0) {
+        benchmarkDOSGuardRequests(state);
+        return;
+    }
+
+    auto& guard = dosGuard();
+    for (auto _ : state)
+        guard.clear();
+}
+
+BENCHMARK(benchmarkDOSGuardRequests)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(benchmarkDOSGuardRequestsWhileSweeping)->DenseThreadRange(2, 16, 7)->UseRealTime();
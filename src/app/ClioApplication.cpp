@@ -142,6 +142,12 @@ ClioApplication::run(bool const useNgWebServer)
     auto const rpcEngine =
         RPCEngineType::makeRPCEngine(config_, backend, balancer, dosGuard, workQueue, counters, handlerProvider);
 
+    // the engine holds the etl through its handlers, so the etl only keeps a weak reference back
+    etl->setOnLedgerPublished([weakEngine = std::weak_ptr(rpcEngine)](std::uint32_t ledgerSeq) {
+        if (auto const engine = weakEngine.lock(); engine != nullptr)
+            engine->notifyLedgerPublished(ledgerSeq);
+    });
+
     if (useNgWebServer or config_.get<bool>("server.__ng_web_server")) {
         web::ng::RPCServerHandler<RPCEngineType, etl::ETLService> handler{config_, backend, rpcEngine, etl};
 
@@ -184,8 +190,9 @@ ClioApplication::run(bool const useNgWebServer)
     }
 
     // Init the web server
-    auto handler =
-        std::make_shared<web::RPCServerHandler<RPCEngineType, etl::ETLService>>(config_, backend, rpcEngine, etl);
+    auto handler = std::make_shared<web::RPCServerHandler<RPCEngineType, etl::ETLService>>(
+        config_, backend, rpcEngine, etl, dosGuard
+    );
 
     auto const httpServer = web::makeHttpServer(config_, ioc, dosGuard, handler);
 
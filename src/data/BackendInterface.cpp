@@ -28,6 +28,7 @@
 #include <xrpl/basics/strHex.h>
 #include <xrpl/protocol/Fees.h>
 #include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/SField.h>
 #include <xrpl/protocol/STLedgerEntry.h>
 #include <xrpl/protocol/Serializer.h>
@@ -98,6 +99,7 @@ BackendInterface::fetchLedgerObject(
         LOG(gLog.trace()) << "Missed cache and missed in db";
     } else {
         LOG(gLog.trace()) << "Missed cache but found in db";
+        cache_.fill(key, sequence, *dbObj);
     }
     return dbObj;
 }
@@ -115,6 +117,47 @@ BackendInterface::fetchLedgerObjectSeq(
     return seq;
 }
 
+std::vector<std::optional<ripple::LedgerHeader>>
+BackendInterface::fetchLedgersBySequence(
+    std::vector<std::uint32_t> const& sequences,
+    boost::asio::yield_context yield
+) const
+{
+    std::vector<std::optional<ripple::LedgerHeader>> results(sequences.size());
+    std::vector<std::uint32_t> missing;
+    for (std::size_t i = 0; i < sequences.size(); ++i) {
+        results[i] = ledgerHeaderCache_.getBySequence(sequences[i]);
+        if (not results[i].has_value())
+            missing.push_back(sequences[i]);
+    }
+
+    if (missing.empty())
+        return results;
+
+    LOG(gLog.trace()) << "Fetching " << missing.size() << " ledger headers from db";
+    auto const fetched = doFetchLedgersBySequence(missing, yield);
+    ASSERT(fetched.size() == missing.size(), "Must fetch a header for each missing sequence");
+
+    for (std::size_t i = 0, j = 0; i < results.size(); ++i) {
+        if (not results[i].has_value())
+            results[i] = fetched[j++];
+    }
+    return results;
+}
+
+std::vector<std::optional<ripple::LedgerHeader>>
+BackendInterface::doFetchLedgersBySequence(
+    std::vector<std::uint32_t> const& sequences,
+    boost::asio::yield_context yield
+) const
+{
+    std::vector<std::optional<ripple::LedgerHeader>> results;
+    results.reserve(sequences.size());
+    for (auto const sequence : sequences)
+        results.push_back(fetchLedgerBySequence(sequence, yield));
+    return results;
+}
+
 std::vector<Blob>
 BackendInterface::fetchLedgerObjects(
     std::vector<ripple::uint256> const& keys,
@@ -140,6 +183,7 @@ BackendInterface::fetchLedgerObjects(
         for (size_t i = 0, j = 0; i < results.size(); ++i) {
             if (results[i].empty()) {
                 results[i] = objs[j];
+                cache_.fill(keys[i], sequence, results[i]);
                 ++j;
             }
         }
@@ -165,6 +209,46 @@ BackendInterface::fetchSuccessorKey(
     return succ ? succ->key : doFetchSuccessorKey(key, ledgerSequence, yield);
 }
 
+std::vector<ripple::uint256>
+BackendInterface::fetchSuccessorKeys(
+    ripple::uint256 const& key,
+    ripple::uint256 const& end,
+    std::uint32_t const ledgerSequence,
+    std::size_t const limit,
+    boost::asio::yield_context yield
+) const
+{
+    if (auto keys = cache_.getSuccessorKeys(key, end, ledgerSequence, limit); keys) {
+        LOG(gLog.trace()) << "Cache hit - " << ripple::strHex(key) << " - " << keys->size() << " successors";
+        return std::move(*keys);
+    }
+
+    LOG(gLog.trace()) << "Cache miss - " << ripple::strHex(key);
+    return doFetchSuccessorKeys(key, end, ledgerSequence, limit, yield);
+}
+
+std::vector<ripple::uint256>
+BackendInterface::doFetchSuccessorKeys(
+    ripple::uint256 const& key,
+    ripple::uint256 const& end,
+    std::uint32_t const ledgerSequence,
+    std::size_t const limit,
+    boost::asio::yield_context yield
+) const
+{
+    std::vector<ripple::uint256> keys;
+    auto cur = key;
+    while (keys.size() < limit) {
+        auto const succ = doFetchSuccessorKey(cur, ledgerSequence, yield);
+        if (not succ or *succ >= end)
+            break;
+
+        keys.push_back(*succ);
+        cur = *succ;
+    }
+    return keys;
+}
+
 std::optional<LedgerObject>
 BackendInterface::fetchSuccessorObject(
     ripple::uint256 key,
@@ -191,8 +275,11 @@ BackendInterface::fetchBookOffers(
     boost::asio::yield_context yield
 ) const
 {
-    // TODO try to speed this up. This can take a few seconds. The goal is
-    // to get it down to a few hundred milliseconds.
+    if (auto offers = cache_.getBookOffers(book, ledgerSequence, limit); offers) {
+        LOG(gLog.trace()) << "Book offers cache hit - " << ripple::strHex(book);
+        return {.offers = std::move(*offers), .cursor = std::nullopt};
+    }
+
     BookOffersPage page;
     ripple::uint256 const bookEnd = ripple::getQualityNext(book);
     ripple::uint256 uTipIndex = book;
@@ -204,20 +291,26 @@ BackendInterface::fetchBookOffers(
     long succMillis = 0;
     long pageMillis = 0;
     while (keys.size() < limit) {
+        // the cache could not answer, so every successor is a database read: look up one directory at a time rather
+        // than reading ahead directories that may not be needed
         auto mid1 = std::chrono::system_clock::now();
-        auto offerDir = fetchSuccessorObject(uTipIndex, ledgerSequence, yield);
+        auto const dirKeys = fetchSuccessorKeys(uTipIndex, bookEnd, ledgerSequence, 1, yield);
         auto mid2 = std::chrono::system_clock::now();
         numSucc++;
         succMillis += getMillis(mid2 - mid1);
-        if (!offerDir || offerDir->key >= bookEnd) {
-            LOG(gLog.trace()) << "offerDir.has_value() " << offerDir.has_value() << " breaking";
+        if (dirKeys.empty()) {
+            LOG(gLog.trace()) << "No more book dirs. breaking";
             break;
         }
-        uTipIndex = offerDir->key;
+
+        auto dir = fetchLedgerObject(dirKeys.front(), ledgerSequence, yield);
+        ASSERT(dir.has_value(), "Book dir must exist");
+        LedgerObject offerDir{.key = dirKeys.front(), .blob = std::move(*dir)};
+        uTipIndex = offerDir.key;
         while (keys.size() < limit) {
             ++numPages;
             ripple::STLedgerEntry const sle{
-                ripple::SerialIter{offerDir->blob.data(), offerDir->blob.size()}, offerDir->key
+                ripple::SerialIter{offerDir.blob.data(), offerDir.blob.size()}, offerDir.key
             };
             auto indexes = sle.getFieldV256(ripple::sfIndexes);
             keys.insert(keys.end(), indexes.begin(), indexes.end());
@@ -229,8 +322,8 @@ BackendInterface::fetchBookOffers(
             auto nextKey = ripple::keylet::page(uTipIndex, next);
             auto nextDir = fetchLedgerObject(nextKey.key, ledgerSequence, yield);
             ASSERT(nextDir.has_value(), "Next dir must exist");
-            offerDir->blob = *nextDir;
-            offerDir->key = nextKey.key;
+            offerDir.blob = *nextDir;
+            offerDir.key = nextKey.key;
         }
         auto mid3 = std::chrono::system_clock::now();
         pageMillis += getMillis(mid3 - mid2);
@@ -313,25 +406,9 @@ BackendInterface::fetchLedgerPage(
 {
     LedgerPage page;
 
-    std::vector<ripple::uint256> keys;
-    bool reachedEnd = false;
-
-    while (keys.size() < limit && !reachedEnd) {
-        ripple::uint256 const& curCursor = [&]() {
-            if (!keys.empty())
-                return keys.back();
-            return (cursor ? *cursor : kFIRST_KEY);
-        }();
-
-        std::uint32_t const seq = outOfOrder ? range_->maxSequence : ledgerSequence;
-        auto succ = fetchSuccessorKey(curCursor, seq, yield);
-
-        if (!succ) {
-            reachedEnd = true;
-        } else {
-            keys.push_back(*succ);
-        }
-    }
+    std::uint32_t const seq = outOfOrder ? range_->maxSequence : ledgerSequence;
+    auto const keys = fetchSuccessorKeys(cursor ? *cursor : kFIRST_KEY, kLAST_KEY, seq, limit, yield);
+    bool const reachedEnd = keys.size() < limit;
 
     auto objects = fetchLedgerObjects(keys, ledgerSequence, yield);
     for (size_t i = 0; i < objects.size(); ++i) {
@@ -21,6 +21,7 @@
 
 #include "data/DBHelpers.hpp"
 #include "data/LedgerCache.hpp"
+#include "data/LedgerHeaderCache.hpp"
 #include "data/Types.hpp"
 #include "etl/CorruptionDetector.hpp"
 #include "util/log/Logger.hpp"
@@ -140,6 +141,7 @@ protected:
     mutable std::shared_mutex rngMtx_;
     std::optional<LedgerRange> range_;
     LedgerCache cache_;
+    mutable LedgerHeaderCache ledgerHeaderCache_;  // the backend adds headers it commits or reads
     std::optional<etl::CorruptionDetector<LedgerCache>> corruptionDetector_;
 
 public:
@@ -196,6 +198,31 @@ public:
     virtual std::optional<ripple::LedgerHeader>
     fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::yield_context yield) const = 0;
 
+    /**
+     * @brief Fetches several ledgers by sequence number.
+     *
+     * Headers of recently written or read ledgers are served from memory. The rest are fetched with a single call to
+     * doFetchLedgersBySequence.
+     *
+     * @param sequences The sequence numbers to fetch for
+     * @param yield The coroutine context
+     * @return The ripple::LedgerHeader for each of the sequences, in the same order; nullopt for the ones not found
+     */
+    std::vector<std::optional<ripple::LedgerHeader>>
+    fetchLedgersBySequence(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield) const;
+
+    /**
+     * @brief The database-specific implementation for fetching several ledgers by sequence number.
+     *
+     * The default implementation calls fetchLedgerBySequence for each sequence.
+     *
+     * @param sequences The sequence numbers to fetch for
+     * @param yield The coroutine context
+     * @return The ripple::LedgerHeader for each of the sequences, in the same order; nullopt for the ones not found
+     */
+    virtual std::vector<std::optional<ripple::LedgerHeader>>
+    doFetchLedgersBySequence(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield) const;
+
     /**
      * @brief Fetches the latest ledger sequence.
      *
@@ -531,9 +558,54 @@ public:
     virtual std::optional<ripple::uint256>
     doFetchSuccessorKey(ripple::uint256 key, std::uint32_t ledgerSequence, boost::asio::yield_context yield) const = 0;
 
+    /**
+     * @brief Fetches several consecutive successor keys at once.
+     *
+     * The cache answers the whole range with a single lookup if it can. Otherwise the keys are fetched by
+     * doFetchSuccessorKeys.
+     *
+     * @param key The key to start after
+     * @param end No keys greater than or equal to this one are fetched
+     * @param ledgerSequence The ledger sequence to fetch for
+     * @param limit The maximum number of keys to fetch
+     * @param yield The coroutine context
+     * @return The keys following the given one in order; fewer than limit if the end was reached
+     */
+    std::vector<ripple::uint256>
+    fetchSuccessorKeys(
+        ripple::uint256 const& key,
+        ripple::uint256 const& end,
+        std::uint32_t ledgerSequence,
+        std::size_t limit,
+        boost::asio::yield_context yield
+    ) const;
+
+    /**
+     * @brief Database-specific implementation of fetching several consecutive successor keys.
+     *
+     * The default implementation follows the successor chain with doFetchSuccessorKey.
+     *
+     * @param key The key to start after
+     * @param end No keys greater than or equal to this one are fetched
+     * @param ledgerSequence The ledger sequence to fetch for
+     * @param limit The maximum number of keys to fetch
+     * @param yield The coroutine context
+     * @return The keys following the given one in order; fewer than limit if the end was reached
+     */
+    virtual std::vector<ripple::uint256>
+    doFetchSuccessorKeys(
+        ripple::uint256 const& key,
+        ripple::uint256 const& end,
+        std::uint32_t ledgerSequence,
+        std::size_t limit,
+        boost::asio::yield_context yield
+    ) const;
+
     /**
      * @brief Fetches book offers.
      *
+     * Served from the order book index of the cache when it is full; otherwise the book directories are walked.
+     *
      * @param book Unsigned 256-bit integer.
      * @param ledgerSequence The ledger sequence to fetch for
      * @param limit Pagaing limit as to how many transactions returned per page.
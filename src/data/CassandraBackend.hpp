@@ -44,6 +44,7 @@
 #include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/nft.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
@@ -75,6 +76,7 @@ class BasicCassandraBackend : public BackendInterface {
     Schema<SettingsProviderType> schema_;
 
     std::atomic_uint32_t ledgerSequence_ = 0u;
+    std::optional<ripple::LedgerHeader> writtenLedgerHeader_;  // cached once the ledger is committed
 
 protected:
     Handle handle_;
@@ -203,11 +205,15 @@ public:
             executor_.writeSync(schema_->updateLedgerRange, ledgerSequence_, false, ledgerSequence_);
         }
 
+        auto writtenLedgerHeader = std::exchange(writtenLedgerHeader_, std::nullopt);
         if (not executeSyncUpdate(schema_->updateLedgerRange.bind(ledgerSequence_, true, ledgerSequence_ - 1))) {
             LOG(log_.warn()) << "Update failed for ledger " << ledgerSequence_;
             return false;
         }
 
+        if (writtenLedgerHeader)
+            ledgerHeaderCache_.put(*writtenLedgerHeader);
+
         LOG(log_.info()) << "Committed ledger " << ledgerSequence_;
         return true;
     }
@@ -219,6 +225,7 @@ public:
 
         executor_.write(schema_->insertLedgerHash, ledgerHeader.hash, ledgerHeader.seq);
 
+        writtenLedgerHeader_ = ledgerHeader;
         ledgerSequence_ = ledgerHeader.seq;
     }
 
@@ -245,11 +252,16 @@ public:
     std::optional<ripple::LedgerHeader>
     fetchLedgerBySequence(std::uint32_t const sequence, boost::asio::yield_context yield) const override
     {
+        if (auto header = ledgerHeaderCache_.getBySequence(sequence); header)
+            return header;
+
         auto const res = executor_.read(yield, schema_->selectLedgerBySeq, sequence);
         if (res) {
             if (auto const& result = res.value(); result) {
                 if (auto const maybeValue = result.template get<std::vector<unsigned char>>(); maybeValue) {
-                    return util::deserializeHeader(ripple::makeSlice(*maybeValue));
+                    auto header = util::deserializeHeader(ripple::makeSlice(*maybeValue));
+                    ledgerHeaderCache_.put(header);
+                    return header;
                 }
 
                 LOG(log_.error()) << "Could not fetch ledger by sequence - no rows";
@@ -267,6 +279,9 @@ public:
     std::optional<ripple::LedgerHeader>
     fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::yield_context yield) const override
     {
+        if (auto header = ledgerHeaderCache_.getByHash(hash); header)
+            return header;
+
         if (auto const res = executor_.read(yield, schema_->selectLedgerByHash, hash); res) {
             if (auto const& result = res.value(); result) {
                 if (auto const maybeValue = result.template get<uint32_t>(); maybeValue)
@@ -284,6 +299,35 @@ public:
         return std::nullopt;
     }
 
+    std::vector<std::optional<ripple::LedgerHeader>>
+    doFetchLedgersBySequence(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield)
+        const override
+    {
+        if (sequences.empty())
+            return {};
+
+        std::vector<Statement> statements;
+        statements.reserve(sequences.size());
+        std::ranges::transform(sequences, std::back_inserter(statements), [this](auto const sequence) {
+            return schema_->selectLedgerBySeq.bind(sequence);
+        });
+
+        std::vector<std::optional<ripple::LedgerHeader>> results;
+        results.reserve(sequences.size());
+        for (auto const& entry : executor_.readEach(yield, statements)) {
+            if (auto const maybeValue = entry.template get<std::vector<unsigned char>>(); maybeValue) {
+                auto header = util::deserializeHeader(ripple::makeSlice(*maybeValue));
+                ledgerHeaderCache_.put(header);
+                results.emplace_back(std::move(header));
+            } else {
+                results.emplace_back(std::nullopt);
+            }
+        }
+
+        LOG(log_.trace()) << "Fetched " << sequences.size() << " ledger headers";
+        return results;
+    }
+
     std::optional<LedgerRange>
     hardFetchLedgerRange(boost::asio::yield_context yield) const override
     {
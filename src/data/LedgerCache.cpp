@@ -20,15 +20,27 @@
 #include "data/LedgerCache.hpp"
 
 #include "data/Types.hpp"
+#include "data/impl/BlobArena.hpp"
+#include "data/impl/BoundedObjectCache.hpp"
+#include "data/impl/LedgerCacheFile.hpp"
+#include "data/impl/LedgerCacheTree.hpp"
+#include "data/impl/OrderBookIndex.hpp"
 #include "util/Assert.hpp"
 
+#include <fmt/core.h>
 #include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/strHex.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <expected>
+#include <memory>
 #include <mutex>
 #include <optional>
-#include <shared_mutex>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace data {
@@ -36,7 +48,6 @@ namespace data {
 uint32_t
 LedgerCache::latestLedgerSequence() const
 {
-    std::shared_lock const lck{mtx_};
     return latestSeq_;
 }
 
@@ -59,32 +70,24 @@ LedgerCache::update(std::vector<LedgerObject> const& objs, uint32_t seq, bool is
 
     {
         std::scoped_lock const lck{mtx_};
-        if (seq > latestSeq_) {
+        auto const latestSeq = latestSeq_.load();
+        if (seq > latestSeq) {
             ASSERT(
-                seq == latestSeq_ + 1 || latestSeq_ == 0,
+                seq == latestSeq + 1 || latestSeq == 0,
                 "New sequense must be either next or first. seq = {}, latestSeq_ = {}",
                 seq,
-                latestSeq_
+                latestSeq
             );
             latestSeq_ = seq;
         }
-        for (auto const& obj : objs) {
-            if (!obj.blob.empty()) {
-                if (isBackground && deletes_.contains(obj.key))
-                    continue;
-
-                auto& e = map_[obj.key];
-                if (seq > e.seq) {
-                    e = {.seq = seq, .blob = obj.blob};
-                }
-            } else {
-                map_.erase(obj.key);
-                if (!full_ && !isBackground)
-                    deletes_.insert(obj.key);
-            }
+
+        if (partial_ != nullptr) {
+            updatePartial(objs, seq);
+        } else {
+            updateFull(objs, seq, isBackground);
         }
-        cv_.notify_all();
     }
+    cv_.notify_all();
 }
 
 std::optional<LedgerObject>
@@ -93,15 +96,91 @@ LedgerCache::getSuccessor(ripple::uint256 const& key, uint32_t seq) const
     if (disabled_ or not full_)
         return {};
 
-    std::shared_lock const lck{mtx_};
     ++successorReqCounter_.get();
-    if (seq != latestSeq_)
+    auto const snapshot = snapshotFor(seq);
+    if (seq != snapshot->seq)
+        return {};
+    auto const item = snapshot->tree.successor(key);
+    if (not item.has_value())
+        return {};
+    ++successorHitCounter_.get();
+    return {{.key = *item->key, .blob = item->blob->toBlob()}};
+}
+
+std::optional<std::vector<ripple::uint256>>
+LedgerCache::getSuccessorKeys(ripple::uint256 const& key, ripple::uint256 const& end, uint32_t seq, std::size_t limit)
+    const
+{
+    if (disabled_ or not full_)
         return {};
-    auto e = map_.upper_bound(key);
-    if (e == map_.end())
+
+    ++successorReqCounter_.get();
+    auto const snapshot = snapshotFor(seq);
+    if (seq != snapshot->seq)
         return {};
+
+    std::vector<ripple::uint256> keys;
+    auto const begin = snapshot->tree.rank(key);
+    auto cursor = snapshot->tree.cursor(begin, begin + std::min(limit, snapshot->tree.size()));
+    keys.reserve(cursor.remaining());
+    while (auto const item = cursor.next()) {
+        if (*item->key >= end)
+            break;
+        keys.push_back(*item->key);
+    }
+
     ++successorHitCounter_.get();
-    return {{.key = e->first, .blob = e->second.blob}};
+    return keys;
+}
+
+std::optional<std::vector<LedgerObject>>
+LedgerCache::getBookOffers(ripple::uint256 const& book, uint32_t seq, std::size_t limit) const
+{
+    if (disabled_ or not full_)
+        return {};
+
+    ++bookOffersReqCounter_.get();
+    auto const snapshot = snapshotFor(seq);
+    if (seq != snapshot->seq or not snapshot->books.has_value())
+        return {};
+
+    std::vector<LedgerObject> offers;
+    if (auto const* directories = snapshot->books->offers(book); directories != nullptr) {
+        for (auto dir = directories->begin(); dir != directories->end() and offers.size() < limit; ++dir) {
+            for (auto const& key : *dir->offers) {
+                if (offers.size() == limit)
+                    break;
+
+                auto const* blob = snapshot->tree.find(key);
+                ASSERT(blob != nullptr, "Offer {} of a book must be in cache", ripple::strHex(key));
+                offers.push_back({.key = key, .blob = blob->toBlob()});
+            }
+        }
+    }
+
+    ++bookOffersHitCounter_.get();
+    return offers;
+}
+
+std::vector<LedgerCache::Cursor>
+LedgerCache::getCursors(uint32_t seq, std::size_t count) const
+{
+    if (disabled_ or not full_ or count == 0)
+        return {};
+
+    auto const snapshot = snapshotFor(seq);
+    if (seq != snapshot->seq)
+        return {};
+
+    auto const size = snapshot->tree.size();
+    count = std::min(count, size);
+
+    std::vector<Cursor> cursors;
+    cursors.reserve(count);
+    for (std::size_t idx = 0; idx < count; ++idx)
+        cursors.emplace_back(snapshot, size * idx / count, size * (idx + 1) / count);
+
+    return cursors;
 }
 
 std::optional<LedgerObject>
@@ -110,33 +189,81 @@ LedgerCache::getPredecessor(ripple::uint256 const& key, uint32_t seq) const
     if (disabled_ or not full_)
         return {};
 
-    std::shared_lock const lck{mtx_};
-    if (seq != latestSeq_)
+    auto const snapshot = snapshotFor(seq);
+    if (seq != snapshot->seq)
         return {};
-    auto e = map_.lower_bound(key);
-    if (e == map_.begin())
+    auto const item = snapshot->tree.predecessor(key);
+    if (not item.has_value())
         return {};
-    --e;
-    return {{.key = e->first, .blob = e->second.blob}};
+    return {{.key = *item->key, .blob = item->blob->toBlob()}};
 }
 
 std::optional<Blob>
 LedgerCache::get(ripple::uint256 const& key, uint32_t seq) const
 {
-    if (disabled_)
+    if (isPartial_) {
+        if (disabled_ or seq > latestSeq_)
+            return {};
+
+        ++objectReqCounter_.get();
+        auto blob = partial_->get(key, seq);
+        if (blob.has_value())
+            ++objectHitCounter_.get();
+        return blob;
+    }
+
+    auto const view = getView(key, seq);
+    if (not view.has_value())
+        return {};
+    return view->toBlob();
+}
+
+std::optional<LedgerCache::BlobView>
+LedgerCache::getView(ripple::uint256 const& key, uint32_t seq) const
+{
+    if (disabled_ or isPartial_)
         return {};
 
-    std::shared_lock const lck{mtx_};
-    if (seq > latestSeq_)
+    auto const snapshot = snapshotFor(seq);
+    if (seq > snapshot->seq)
         return {};
     ++objectReqCounter_.get();
-    auto e = map_.find(key);
-    if (e == map_.end())
+    auto const* blob = snapshot->tree.find(key);
+    if (blob == nullptr)
         return {};
-    if (seq < e->second.seq)
+    if (seq < blob->seq())
         return {};
     ++objectHitCounter_.get();
-    return {e->second.blob};
+    return *blob;
+}
+
+void
+LedgerCache::fill(ripple::uint256 const& key, uint32_t seq, Blob const& blob) const
+{
+    if (disabled_ or not isPartial_ or blob.empty())
+        return;
+
+    // only objects read at the latest sequence are known to be current; later updates are applied to them
+    auto const result = partial_->put(key, seq, blob, [this, seq] { return latestSeq_ == seq; });
+    if (not result.admitted)
+        ++rejectionCounter_.get();
+    evictionCounter_.get() += result.evicted;
+}
+
+void
+LedgerCache::setPartial(std::size_t maxBytes)
+{
+    std::scoped_lock const lck{mtx_};
+    ASSERT(not full_ and latestSnapshot()->tree.size() == 0, "Partial cache must start empty");
+
+    partial_ = std::make_unique<impl::BoundedObjectCache>(maxBytes);
+    isPartial_ = true;
+}
+
+bool
+LedgerCache::isPartial() const
+{
+    return isPartial_;
 }
 
 void
@@ -154,12 +281,16 @@ LedgerCache::isDisabled() const
 void
 LedgerCache::setFull()
 {
-    if (disabled_)
+    if (disabled_ or isPartial_)
         return;
 
-    full_ = true;
     std::scoped_lock const lck{mtx_};
+    auto const current = latestSnapshot();
+    publish(current->tree, impl::OrderBookIndex::build(current->tree));
+
+    full_ = true;
     deletes_.clear();
+    updateArenaMetrics();
 }
 
 bool
@@ -171,8 +302,9 @@ LedgerCache::isFull() const
 size_t
 LedgerCache::size() const
 {
-    std::shared_lock const lck{mtx_};
-    return map_.size();
+    if (isPartial_)
+        return partial_->size();
+    return latestSnapshot()->tree.size();
 }
 
 float
@@ -191,4 +323,243 @@ LedgerCache::getSuccessorHitRate() const
     return static_cast<float>(successorHitCounter_.get().value()) / successorReqCounter_.get().value();
 }
 
+std::expected<uint32_t, std::string>
+LedgerCache::saveToFile(std::string const& path) const
+{
+    if (disabled_ or not full_)
+        return std::unexpected{"Only a full cache can be saved"};
+
+    auto const snapshot = latestSnapshot();
+    if (auto const result = impl::LedgerCacheFile::write(path, snapshot->seq, snapshot->tree); not result.has_value())
+        return std::unexpected{result.error()};
+
+    return snapshot->seq;
+}
+
+std::expected<uint32_t, std::string>
+LedgerCache::loadFromFile(
+    std::string const& path,
+    uint32_t minSequence,
+    uint32_t maxSequence,
+    DiffFetcher const& fetchDiff
+)
+{
+    if (disabled_ or isPartial_ or full_)
+        return std::unexpected{"Cache is disabled, partial or already full"};
+
+    auto data = impl::LedgerCacheFile::read(path);
+    if (not data.has_value())
+        return std::unexpected{std::move(data).error()};
+
+    if (data->seq < minSequence or data->seq > maxSequence) {
+        return std::unexpected{fmt::format(
+            "Cache file sequence is out of range. seq = {}, minSequence = {}, maxSequence = {}",
+            data->seq,
+            minSequence,
+            maxSequence
+        )};
+    }
+
+    auto const release = [this](impl::BlobRef const& blob) { arena_.release(blob); };
+
+    // the file is caught up in a private tree so that readers never see it behind the latest sequence
+    std::vector<impl::LedgerCacheTree::Write> writes;
+    writes.reserve(data->count);
+    for (auto const& segment : data->segments) {
+        impl::BlobArena::forEachRecord(segment, [&](impl::BlobRef const& record) {
+            writes.push_back({.key = record.key(), .blob = record});
+        });
+    }
+
+    auto tree = impl::LedgerCacheTree{}.apply(writes);
+    {
+        std::scoped_lock const lck{mtx_};
+        for (auto const& segment : data->segments)
+            arena_.adopt(segment);
+        updateArenaMetrics();
+    }
+
+    for (auto diffSeq = data->seq + 1; diffSeq <= maxSequence; ++diffSeq) {
+        auto const diff = fetchDiff(diffSeq);
+        if (not diff.has_value()) {
+            std::scoped_lock const lck{mtx_};
+            tree.forEach([this](impl::LedgerCacheTree::Item const& item) { arena_.release(*item.blob); });
+            updateArenaMetrics();
+            return std::unexpected{fmt::format("Couldn't fetch the diff of ledger {}", diffSeq)};
+        }
+
+        std::scoped_lock const lck{mtx_};
+        writes.clear();
+        for (auto const& obj : *diff) {
+            writes.push_back(
+                {.key = obj.key, .blob = obj.blob.empty() ? impl::BlobRef{} : arena_.store(obj.key, diffSeq, obj.blob)}
+            );
+        }
+        tree = tree.apply(writes, release);
+    }
+
+    std::scoped_lock const lck{mtx_};
+    if (full_) {
+        tree.forEach([this](impl::LedgerCacheTree::Item const& item) { arena_.release(*item.blob); });
+        updateArenaMetrics();
+        return std::unexpected{"Cache became full while the file was loading"};
+    }
+
+    // objects deleted or written since maxSequence take precedence over the file; erasures go first so that an object
+    // deleted and then created again survives
+    auto const current = latestSnapshot();
+    writes.clear();
+    for (auto const& key : deletes_)
+        writes.push_back({.key = key, .blob = {}});
+    current->tree.forEach([&](impl::LedgerCacheTree::Item const& item) {
+        writes.push_back({.key = *item.key, .blob = *item.blob, .relocation = true});
+    });
+    tree = tree.apply(writes, release);
+
+    if (latestSeq_ == 0)
+        latestSeq_ = maxSequence;
+
+    publish(std::move(tree), std::nullopt);
+    updateArenaMetrics();
+    cv_.notify_all();
+    return data->seq;
+}
+
+void
+LedgerCache::updateFull(std::vector<LedgerObject> const& objs, uint32_t seq, bool isBackground)
+{
+    std::vector<impl::LedgerCacheTree::Write> writes;
+    writes.reserve(objs.size());
+    for (auto const& obj : objs) {
+        if (!obj.blob.empty()) {
+            if (isBackground && deletes_.contains(obj.key))
+                continue;
+
+            writes.push_back({.key = obj.key, .blob = arena_.store(obj.key, seq, obj.blob)});
+        } else {
+            writes.push_back({.key = obj.key, .blob = {}});
+            if (!full_ && !isBackground)
+                deletes_.insert(obj.key);
+        }
+    }
+
+    applyWrites(writes);
+    if (full_)
+        compact();
+    updateArenaMetrics();
+}
+
+void
+LedgerCache::updatePartial(std::vector<LedgerObject> const& objs, uint32_t seq)
+{
+    // cached objects are current as of the latest sequence, so older data must not be applied
+    if (seq != latestSeq_)
+        return;
+
+    std::size_t evicted = 0;
+    for (auto const& obj : objs)
+        evicted += partial_->update(obj.key, seq, obj.blob);
+    evictionCounter_.get() += evicted;
+}
+
+LedgerCache::SnapshotPtr
+LedgerCache::latestSnapshot() const
+{
+    return latest_.load();
+}
+
+LedgerCache::SnapshotPtr
+LedgerCache::snapshotFor(uint32_t seq) const
+{
+    auto latest = latestSnapshot();
+    if (seq >= latest->seq)
+        return latest;
+
+    if (auto snapshot = history_[seq % kSNAPSHOT_HISTORY_SIZE].load();
+        snapshot != nullptr and snapshot->seq == seq)
+        return snapshot;
+
+    return latest;
+}
+
+void
+LedgerCache::applyWrites(std::vector<impl::LedgerCacheTree::Write>& writes)
+{
+    auto const current = latestSnapshot();
+    auto tree = current->tree.apply(writes, [this](impl::BlobRef const& blob) { arena_.release(blob); });
+
+    auto books = current->books;
+    if (books.has_value())
+        books = books->update(current->tree, tree, writes);
+
+    publish(std::move(tree), std::move(books));
+}
+
+void
+LedgerCache::publish(impl::LedgerCacheTree tree, std::optional<impl::OrderBookIndex> books)
+{
+    auto const seq = latestSeq_.load();
+    auto next =
+        std::make_shared<Snapshot const>(Snapshot{.seq = seq, .tree = std::move(tree), .books = std::move(books)});
+
+    history_[seq % kSNAPSHOT_HISTORY_SIZE].store(next);
+    latest_.store(std::move(next));
+}
+
+void
+LedgerCache::compact()
+{
+    if (compacted_ == nullptr) {
+        compacted_ = arena_.sparsestSegment(kCOMPACTION_LIVE_RATIO);
+        compactionOffset_ = 0;
+        if (compacted_ == nullptr)
+            return;
+    }
+
+    auto const current = latestSnapshot();
+    std::vector<impl::LedgerCacheTree::Write> relocations;
+    compactionOffset_ = impl::BlobArena::forEachRecord(
+        compacted_,
+        compactionOffset_,
+        kCOMPACTION_BYTES_PER_UPDATE,
+        [&](impl::BlobRef const& record) {
+            auto const key = record.key();
+            if (auto const* blob = current->tree.find(key); blob == nullptr or not blob->isSameRecord(record))
+                return;
+
+            relocations.push_back(
+                {.key = key, .blob = arena_.store(key, record.seq(), record.data()), .relocation = true}
+            );
+        }
+    );
+
+    if (not relocations.empty())
+        applyWrites(relocations);
+
+    if (compactionOffset_ < compacted_->used())
+        return;
+
+    // older snapshots keep the segment alive until they are dropped from the history
+    arena_.retire(compacted_);
+    compacted_ = nullptr;
+}
+
+void
+LedgerCache::updateArenaMetrics()
+{
+    arenaAllocatedBytes_.get().set(static_cast<std::int64_t>(arena_.allocatedBytes()));
+    arenaLiveBytes_.get().set(static_cast<std::int64_t>(arena_.liveBytes()));
+}
+
+LedgerCache::Cursor::Cursor(SnapshotPtr snapshot, std::size_t begin, std::size_t end)
+    : snapshot_{std::move(snapshot)}, cursor_{snapshot_->tree.cursor(begin, end)}
+{
+}
+
+std::optional<LedgerCache::Cursor::Item>
+LedgerCache::Cursor::next()
+{
+    return cursor_.next();
+}
+
 }  // namespace data
@@ -20,21 +20,29 @@
 #pragma once
 
 #include "data/Types.hpp"
+#include "data/impl/BlobArena.hpp"
+#include "data/impl/BoundedObjectCache.hpp"
+#include "data/impl/LedgerCacheTree.hpp"
+#include "data/impl/OrderBookIndex.hpp"
 #include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Gauge.hpp"
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
 
 #include <xrpl/basics/base_uint.h>
 #include <xrpl/basics/hardened_hash.h>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <expected>
 #include <functional>
-#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
-#include <shared_mutex>
+#include <string>
 #include <unordered_set>
 #include <vector>
 
@@ -42,13 +50,52 @@ namespace data {
 
 /**
  * @brief Cache for an entire ledger.
+ *
+ * Every update publishes a new immutable snapshot of the cache (see @ref impl::LedgerCacheTree). Readers take the
+ * latest snapshot with a single atomic load and never wait for the writer. The last few snapshots are kept around so
+ * that lookups for recent, but not the latest, sequences can still be answered.
+ *
+ * Every update is published right away, including the ones made while the cache is still being loaded, so objects are
+ * served as soon as they are in the cache.
+ *
+ * Object data is copied into large arena segments (see @ref impl::BlobArena) rather than allocated one by one. Once the
+ * cache is full, sealed segments whose live data dropped below @ref kCOMPACTION_LIVE_RATIO are compacted one at a time
+ * by moving their live objects to the active segment. Each update looks at no more than
+ * @ref kCOMPACTION_BYTES_PER_UPDATE of records, so a large segment, like one adopted from a cache file, is compacted
+ * over many updates.
+ *
+ * A full cache also maintains an index of the offers of every order book (see @ref impl::OrderBookIndex) as part of
+ * each snapshot, so that book offers can be served without walking the book directories.
+ *
+ * Alternatively the cache can run in partial mode (see @ref setPartial), where it only keeps the most frequently used
+ * objects within a memory budget. Such a cache is never full, so successor lookups always miss.
  */
 class LedgerCache {
-    struct CacheEntry {
+public:
+    /** @brief A read-only view of a cached object that keeps its memory alive */
+    using BlobView = impl::BlobRef;
+
+    /** @brief Fetches the objects changed in a ledger, or returns std::nullopt to give up */
+    using DiffFetcher = std::function<std::optional<std::vector<LedgerObject>>(uint32_t)>;
+
+    /** @brief The number of most recent snapshots that can be read from */
+    static constexpr std::size_t kSNAPSHOT_HISTORY_SIZE = 4;
+
+    /** @brief Sealed arena segments with a smaller share of live data are compacted */
+    static constexpr double kCOMPACTION_LIVE_RATIO = 0.5;
+
+    /** @brief The size of the records of the segment being compacted looked at by one update */
+    static constexpr std::size_t kCOMPACTION_BYTES_PER_UPDATE = impl::BlobArena::kDEFAULT_SEGMENT_SIZE;
+
+private:
+    struct Snapshot {
         uint32_t seq = 0;
-        Blob blob;
+        impl::LedgerCacheTree tree;
+        std::optional<impl::OrderBookIndex> books;  // only set once the cache is full
     };
 
+    using SnapshotPtr = std::shared_ptr<Snapshot const>;
+
     // counters for fetchLedgerObject(s) hit rate
     std::reference_wrapper<util::prometheus::CounterInt> objectReqCounter_{PrometheusService::counterInt(
         "ledger_cache_counter_total_number",
@@ -71,11 +118,48 @@ class LedgerCache {
         util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "successor_key"}})
     )};
 
-    std::map<ripple::uint256, CacheEntry> map_;
+    // counters for getBookOffers hit rate
+    std::reference_wrapper<util::prometheus::CounterInt> bookOffersReqCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "request"}, {"fetch", "book_offers"}})
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> bookOffersHitCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "book_offers"}})
+    )};
+
+    // counters for the partial cache
+    std::reference_wrapper<util::prometheus::CounterInt> evictionCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "eviction"}, {"fetch", "ledger_objects"}})
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> rejectionCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "admission_rejected"}, {"fetch", "ledger_objects"}})
+    )};
+
+    // arena memory usage
+    std::reference_wrapper<util::prometheus::GaugeInt> arenaAllocatedBytes_{PrometheusService::gaugeInt(
+        "ledger_cache_arena_bytes",
+        util::prometheus::Labels{{{"type", "allocated"}}},
+        "Memory held by LedgerCache arena segments"
+    )};
+    std::reference_wrapper<util::prometheus::GaugeInt> arenaLiveBytes_{
+        PrometheusService::gaugeInt("ledger_cache_arena_bytes", util::prometheus::Labels{{{"type", "live"}}})
+    };
+
+    std::atomic<SnapshotPtr> latest_ = std::make_shared<Snapshot const>();
+    std::array<std::atomic<SnapshotPtr>, kSNAPSHOT_HISTORY_SIZE> history_;  // indexed by seq % kSNAPSHOT_HISTORY_SIZE
+
+    std::mutex mtx_;  // serializes writers
+    std::condition_variable cv_;
+    impl::BlobArena arena_;
+    std::shared_ptr<impl::BlobSegment> compacted_;  // the segment being compacted, if any
+    std::size_t compactionOffset_ = 0;              // of the next record of compacted_ to look at
 
-    mutable std::shared_mutex mtx_;
-    std::condition_variable_any cv_;
-    uint32_t latestSeq_ = 0;
+    std::unique_ptr<impl::BoundedObjectCache> partial_;  // set once, before isPartial_
+    std::atomic_bool isPartial_ = false;
+    std::atomic_uint32_t latestSeq_ = 0;
     std::atomic_bool full_ = false;
     std::atomic_bool disabled_ = false;
 
@@ -83,6 +167,37 @@ class LedgerCache {
     std::unordered_set<ripple::uint256, ripple::hardened_hash<>> deletes_;
 
 public:
+    /**
+     * @brief Walks a contiguous key range of one cache snapshot in key order.
+     *
+     * The cursor keeps its snapshot alive, so it is not affected by later updates.
+     */
+    class Cursor {
+        SnapshotPtr snapshot_;
+        impl::LedgerCacheTree::Cursor cursor_;
+
+    public:
+        /**
+         * @brief A cached object. References stay valid for as long as the cursor exists.
+         */
+        using Item = impl::LedgerCacheTree::Item;
+
+        /**
+         * @brief Construct a cursor over the objects at the given positions in key order.
+         *
+         * @param snapshot The snapshot to walk
+         * @param begin The position of the first object
+         * @param end The position after the last object
+         */
+        Cursor(SnapshotPtr snapshot, std::size_t begin, std::size_t end);
+
+        /**
+         * @return The next object if any; nullopt once the range is exhausted
+         */
+        std::optional<Item>
+        next();
+    };
+
     /**
      * @brief Update the cache with new ledger objects.
      *
@@ -103,10 +218,22 @@ public:
     std::optional<Blob>
     get(ripple::uint256 const& key, uint32_t seq) const;
 
+    /**
+     * @brief Fetch a cached object by its key and sequence number without copying it.
+     *
+     * @param key The key to fetch for
+     * @param seq The sequence to fetch for
+     * @return If found in cache, will return a view of the cached object; otherwise nullopt is returned. Always
+     * nullopt for a partial cache
+     */
+    std::optional<BlobView>
+    getView(ripple::uint256 const& key, uint32_t seq) const;
+
     /**
      * @brief Gets a cached successor.
      *
-     * Note: This function always returns std::nullopt when @ref isFull() returns false.
+     * Note: This function always returns std::nullopt when @ref isFull() returns false or when the sequence is older
+     * than the last @ref kSNAPSHOT_HISTORY_SIZE sequences.
      *
      * @param key The key to fetch for
      * @param seq The sequence to fetch for
@@ -115,10 +242,57 @@ public:
     std::optional<LedgerObject>
     getSuccessor(ripple::uint256 const& key, uint32_t seq) const;
 
+    /**
+     * @brief Gets several consecutive cached successors at once.
+     *
+     * Note: This function always returns std::nullopt when @ref isFull() returns false or when the sequence is older
+     * than the last @ref kSNAPSHOT_HISTORY_SIZE sequences.
+     *
+     * @param key The key to start after
+     * @param end No keys greater than or equal to this one are returned
+     * @param seq The sequence to fetch for
+     * @param limit The maximum number of keys to return
+     * @return If the cache can answer, the keys following the given one in order; otherwise nullopt is returned
+     */
+    std::optional<std::vector<ripple::uint256>>
+    getSuccessorKeys(ripple::uint256 const& key, ripple::uint256 const& end, uint32_t seq, std::size_t limit) const;
+
+    /**
+     * @brief Gets the offers of an order book from the book index.
+     *
+     * Offers are returned in the same order as walking the book directories yields them.
+     *
+     * Note: This function always returns std::nullopt when @ref isFull() returns false or when the sequence is older
+     * than the last @ref kSNAPSHOT_HISTORY_SIZE sequences.
+     *
+     * @param book The book base
+     * @param seq The sequence to fetch for
+     * @param limit The maximum number of offers to return
+     * @return If the cache can answer, the offers of the book; otherwise nullopt is returned
+     */
+    std::optional<std::vector<LedgerObject>>
+    getBookOffers(ripple::uint256 const& book, uint32_t seq, std::size_t limit) const;
+
+    /**
+     * @brief Split the cache into ranges of consecutive keys that can be walked independently, e.g. in parallel.
+     *
+     * All cursors read the same snapshot and together cover every object exactly once, in key order.
+     *
+     * Note: This function always returns no cursors when @ref isFull() returns false or when the sequence is not
+     * available in the cache.
+     *
+     * @param seq The sequence to walk the cache at
+     * @param count The number of ranges to split the cache into
+     * @return Cursors over non-overlapping key ranges, ordered by key; fewer than requested for a small cache
+     */
+    std::vector<Cursor>
+    getCursors(uint32_t seq, std::size_t count) const;
+
     /**
      * @brief Gets a cached predcessor.
      *
-     * Note: This function always returns std::nullopt when @ref isFull() returns false.
+     * Note: This function always returns std::nullopt when @ref isFull() returns false or when the sequence is older
+     * than the last @ref kSNAPSHOT_HISTORY_SIZE sequences.
      *
      * @param key The key to fetch for
      * @param seq The sequence to fetch for
@@ -127,6 +301,36 @@ public:
     std::optional<LedgerObject>
     getPredecessor(ripple::uint256 const& key, uint32_t seq) const;
 
+    /**
+     * @brief Offer an object read from the database to a partial cache.
+     *
+     * The object is only cached if it was read at the latest sequence of the cache and the admission policy considers
+     * it worth keeping. Does nothing if the cache is not partial.
+     *
+     * @param key The key of the object
+     * @param seq The sequence the object was read at
+     * @param blob The object
+     */
+    void
+    fill(ripple::uint256 const& key, uint32_t seq, Blob const& blob) const;
+
+    /**
+     * @brief Switch an empty cache to partial mode.
+     *
+     * A partial cache is filled by @ref fill rather than loaded in full, keeps objects up to date through @ref update
+     * and evicts the least valuable objects to stay within the memory budget.
+     *
+     * @param maxBytes The memory budget
+     */
+    void
+    setPartial(std::size_t maxBytes);
+
+    /**
+     * @return true if the cache is in partial mode; false otherwise
+     */
+    bool
+    isPartial() const;
+
     /**
      * @brief Disables the cache.
      */
@@ -179,6 +383,34 @@ public:
     float
     getSuccessorHitRate() const;
 
+    /**
+     * @brief Save the latest version of a full cache to a file.
+     *
+     * The cache keeps serving reads and accepting updates while the file is written.
+     *
+     * @param path The path of the file
+     * @return The ledger sequence saved on success; an error message otherwise
+     */
+    std::expected<uint32_t, std::string>
+    saveToFile(std::string const& path) const;
+
+    /**
+     * @brief Load a cache that is not full yet from a file created by @ref saveToFile.
+     *
+     * The file is memory-mapped and its objects are served from the mapping until they are updated. The file only
+     * becomes visible once it has caught up to maxSequence with the diffs returned by fetchDiff, so readers never see
+     * objects older than the sequence they ask for. Updates made in the meantime take precedence over the file. The
+     * cache is not marked as full: the caller is expected to call @ref setFull.
+     *
+     * @param path The path of the file
+     * @param minSequence The file is rejected if its ledger sequence is older than this
+     * @param maxSequence The file is rejected if its ledger sequence is newer than this
+     * @param fetchDiff Returns the diff of a ledger after the file's one; std::nullopt aborts the load
+     * @return The ledger sequence of the file on success; an error message otherwise
+     */
+    std::expected<uint32_t, std::string>
+    loadFromFile(std::string const& path, uint32_t minSequence, uint32_t maxSequence, DiffFetcher const& fetchDiff);
+
     /**
      * @brief Waits until the cache contains a specific sequence.
      *
@@ -186,6 +418,31 @@ public:
      */
     void
     waitUntilCacheContainsSeq(uint32_t seq);
+
+private:
+    SnapshotPtr
+    latestSnapshot() const;
+
+    SnapshotPtr
+    snapshotFor(uint32_t seq) const;
+
+    void
+    applyWrites(std::vector<impl::LedgerCacheTree::Write>& writes);
+
+    void
+    publish(impl::LedgerCacheTree tree, std::optional<impl::OrderBookIndex> books);
+
+    void
+    updateFull(std::vector<LedgerObject> const& objs, uint32_t seq, bool isBackground);
+
+    void
+    updatePartial(std::vector<LedgerObject> const& objs, uint32_t seq);
+
+    void
+    compact();
+
+    void
+    updateArenaMetrics();
 };
 
 }  // namespace data
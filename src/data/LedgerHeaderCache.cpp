@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2022, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerHeaderCache.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace data {
+
+LedgerHeaderCache::LedgerHeaderCache(std::size_t capacity) : capacity_(capacity)
+{
+}
+
+void
+LedgerHeaderCache::put(ripple::LedgerHeader const& header)
+{
+    if (capacity_ == 0)
+        return;
+
+    std::scoped_lock const lck{mtx_};
+    if (auto const it = bySequence_.find(header.seq); it != bySequence_.end()) {
+        headers_.splice(headers_.begin(), headers_, it->second);
+        return;
+    }
+
+    if (headers_.size() == capacity_) {
+        auto const& evicted = headers_.back();
+        bySequence_.erase(evicted.seq);
+        byHash_.erase(evicted.hash);
+        headers_.pop_back();
+    }
+
+    headers_.push_front(header);
+    bySequence_[header.seq] = headers_.begin();
+    byHash_[header.hash] = headers_.begin();
+}
+
+std::optional<ripple::LedgerHeader>
+LedgerHeaderCache::getBySequence(std::uint32_t sequence)
+{
+    std::scoped_lock const lck{mtx_};
+    auto const it = bySequence_.find(sequence);
+    if (it == bySequence_.end())
+        return std::nullopt;
+
+    headers_.splice(headers_.begin(), headers_, it->second);
+    return *it->second;
+}
+
+std::optional<ripple::LedgerHeader>
+LedgerHeaderCache::getByHash(ripple::uint256 const& hash)
+{
+    std::scoped_lock const lck{mtx_};
+    auto const it = byHash_.find(hash);
+    if (it == byHash_.end())
+        return std::nullopt;
+
+    headers_.splice(headers_.begin(), headers_, it->second);
+    return *it->second;
+}
+
+std::size_t
+LedgerHeaderCache::size() const
+{
+    std::scoped_lock const lck{mtx_};
+    return headers_.size();
+}
+
+}  // namespace data
@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2022, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace data {
+
+/**
+ * @brief A least recently used cache of ledger headers, looked up by sequence or by hash.
+ *
+ * Ledger headers never change once written, so cached headers never need to be invalidated.
+ */
+class LedgerHeaderCache {
+public:
+    /** @brief The default number of headers kept */
+    static constexpr std::size_t kDEFAULT_CAPACITY = 1024;
+
+private:
+    using HeaderList = std::list<ripple::LedgerHeader>;  // front is the most recently used
+
+    std::size_t capacity_;
+    mutable std::mutex mtx_;
+    HeaderList headers_;
+    std::unordered_map<std::uint32_t, HeaderList::iterator> bySequence_;
+    std::unordered_map<ripple::uint256, HeaderList::iterator, ripple::hardened_hash<>> byHash_;
+
+public:
+    /**
+     * @brief Construct a new cache.
+     *
+     * @param capacity The maximum number of headers kept
+     */
+    explicit LedgerHeaderCache(std::size_t capacity = kDEFAULT_CAPACITY);
+
+    /**
+     * @brief Add a header, evicting the least recently used one if the cache is full.
+     *
+     * @param header The header to add
+     */
+    void
+    put(ripple::LedgerHeader const& header);
+
+    /**
+     * @param sequence The sequence of the ledger
+     * @return The header if cached; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<ripple::LedgerHeader>
+    getBySequence(std::uint32_t sequence);
+
+    /**
+     * @param hash The hash of the ledger
+     * @return The header if cached; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<ripple::LedgerHeader>
+    getByHash(ripple::uint256 const& hash);
+
+    /**
+     * @return The number of cached headers
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+};
+
+}  // namespace data
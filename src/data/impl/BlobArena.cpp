@@ -0,0 +1,310 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/BlobArena.hpp"
+
+#include "data/Types.hpp"
+#include "util/Assert.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace data::impl {
+
+namespace {
+
+constexpr std::size_t kSEQ_OFFSET = ripple::uint256::bytes;
+constexpr std::size_t kSIZE_OFFSET = kSEQ_OFFSET + sizeof(uint32_t);
+
+uint32_t
+readUint32(unsigned char const* ptr)
+{
+    uint32_t value = 0;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+}  // namespace
+
+BlobSegment::BlobSegment(std::size_t capacity)
+    : storage_(capacity), data_(storage_.data()), capacity_(capacity)
+{
+}
+
+BlobSegment::BlobSegment(std::shared_ptr<void const> owner, std::span<unsigned char const> records)
+    : owner_(std::move(owner))
+    , data_(records.data())
+    , capacity_(records.size())
+    , used_(records.size())
+    , live_(records.size())
+{
+    ASSERT(
+        records.size() <= std::numeric_limits<uint32_t>::max(),
+        "Records of a segment must be addressable by a 32-bit offset. size = {}",
+        records.size()
+    );
+}
+
+std::optional<uint32_t>
+BlobSegment::append(ripple::uint256 const& key, uint32_t seq, std::span<unsigned char const> blob)
+{
+    auto const recordSize = kRECORD_HEADER_SIZE + blob.size();
+    if (used_ + recordSize > capacity_)
+        return std::nullopt;
+
+    auto const offset = static_cast<uint32_t>(used_);
+    auto* ptr = storage_.data() + used_;
+    auto const size = static_cast<uint32_t>(blob.size());
+
+    std::memcpy(ptr, key.data(), ripple::uint256::bytes);
+    std::memcpy(ptr + kSEQ_OFFSET, &seq, sizeof(seq));
+    std::memcpy(ptr + kSIZE_OFFSET, &size, sizeof(size));
+    std::ranges::copy(blob, ptr + kRECORD_HEADER_SIZE);
+
+    used_ += recordSize;
+    live_ += recordSize;
+    return offset;
+}
+
+unsigned char const*
+BlobSegment::record(uint32_t offset) const
+{
+    return data_ + offset;
+}
+
+std::size_t
+BlobSegment::used() const
+{
+    return used_;
+}
+
+std::size_t
+BlobSegment::live() const
+{
+    return live_;
+}
+
+std::size_t
+BlobSegment::capacity() const
+{
+    return capacity_;
+}
+
+std::span<unsigned char const>
+BlobSegment::records() const
+{
+    return {data_, used_};
+}
+
+void
+BlobSegment::release(std::size_t bytes)
+{
+    ASSERT(live_ >= bytes, "Releasing more than is live in segment. live = {}, bytes = {}", live_, bytes);
+    live_ -= bytes;
+}
+
+BlobRef::BlobRef(std::shared_ptr<BlobSegment> segment, uint32_t offset) : segment_(std::move(segment)), offset_(offset)
+{
+}
+
+bool
+BlobRef::empty() const
+{
+    return segment_ == nullptr;
+}
+
+ripple::uint256
+BlobRef::key() const
+{
+    ripple::uint256 key;
+    std::memcpy(key.data(), segment_->record(offset_), ripple::uint256::bytes);
+    return key;
+}
+
+uint32_t
+BlobRef::seq() const
+{
+    return readUint32(segment_->record(offset_) + kSEQ_OFFSET);
+}
+
+std::span<unsigned char const>
+BlobRef::data() const
+{
+    auto const* record = segment_->record(offset_);
+    return {record + BlobSegment::kRECORD_HEADER_SIZE, readUint32(record + kSIZE_OFFSET)};
+}
+
+std::span<unsigned char const>
+BlobRef::record() const
+{
+    return {segment_->record(offset_), recordSize()};
+}
+
+Blob
+BlobRef::toBlob() const
+{
+    auto const blob = data();
+    return {blob.begin(), blob.end()};
+}
+
+bool
+BlobRef::isSameRecord(BlobRef const& other) const
+{
+    return segment_ == other.segment_ and offset_ == other.offset_;
+}
+
+std::size_t
+BlobRef::recordSize() const
+{
+    return BlobSegment::kRECORD_HEADER_SIZE + readUint32(segment_->record(offset_) + kSIZE_OFFSET);
+}
+
+BlobSegment*
+BlobRef::segment() const
+{
+    return segment_.get();
+}
+
+BlobArena::BlobArena(std::size_t segmentSize) : segmentSize_(segmentSize)
+{
+}
+
+BlobRef
+BlobArena::store(ripple::uint256 const& key, uint32_t seq, std::span<unsigned char const> blob)
+{
+    if (not segments_.empty()) {
+        if (auto const offset = segments_.back()->append(key, seq, blob); offset.has_value()) {
+            live_ += BlobSegment::kRECORD_HEADER_SIZE + blob.size();
+            return BlobRef{segments_.back(), *offset};
+        }
+    }
+
+    // objects larger than a segment get a segment of their own
+    auto const capacity = std::max(segmentSize_, BlobSegment::kRECORD_HEADER_SIZE + blob.size());
+    segments_.push_back(std::make_shared<BlobSegment>(capacity));
+    allocated_ += capacity;
+
+    auto const offset = segments_.back()->append(key, seq, blob);
+    ASSERT(offset.has_value(), "Blob must fit into a new segment");
+    live_ += BlobSegment::kRECORD_HEADER_SIZE + blob.size();
+    return BlobRef{segments_.back(), *offset};
+}
+
+void
+BlobArena::release(BlobRef const& ref)
+{
+    auto* segment = ref.segment();
+    if (segment == nullptr or segment->retired_)
+        return;
+
+    auto const size = ref.recordSize();
+    segment->release(size);
+    live_ -= size;
+}
+
+std::shared_ptr<BlobSegment>
+BlobArena::sparsestSegment(double maxLiveRatio) const
+{
+    std::shared_ptr<BlobSegment> result;
+    double resultRatio = maxLiveRatio;
+
+    // the active segment is still being filled and is never compacted
+    for (std::size_t idx = 0; idx + 1 < segments_.size(); ++idx) {
+        auto const& segment = segments_[idx];
+        auto const ratio = static_cast<double>(segment->live()) / static_cast<double>(segment->capacity());
+        if (ratio < resultRatio) {
+            result = segment;
+            resultRatio = ratio;
+        }
+    }
+
+    return result;
+}
+
+void
+BlobArena::forEachRecord(std::shared_ptr<BlobSegment> const& segment, std::function<void(BlobRef const&)> const& fn)
+{
+    forEachRecord(segment, 0, segment->used(), fn);
+}
+
+std::size_t
+BlobArena::forEachRecord(
+    std::shared_ptr<BlobSegment> const& segment,
+    std::size_t offset,
+    std::size_t maxBytes,
+    std::function<void(BlobRef const&)> const& fn
+)
+{
+    auto const start = offset;
+    while (offset < segment->used() and offset - start < maxBytes) {
+        BlobRef const ref{segment, static_cast<uint32_t>(offset)};
+        fn(ref);
+        offset += ref.recordSize();
+    }
+    return offset;
+}
+
+void
+BlobArena::adopt(std::shared_ptr<BlobSegment> segment)
+{
+    allocated_ += segment->capacity();
+    live_ += segment->live();
+
+    // keep the active segment last
+    segments_.insert(segments_.empty() ? segments_.end() : std::prev(segments_.end()), std::move(segment));
+}
+
+void
+BlobArena::retire(std::shared_ptr<BlobSegment> const& segment)
+{
+    auto const it = std::ranges::find(segments_, segment);
+    if (it == segments_.end())
+        return;
+
+    allocated_ -= segment->capacity();
+    live_ -= segment->live();
+    segment->live_ = 0;
+    segment->retired_ = true;
+    segments_.erase(it);
+}
+
+std::size_t
+BlobArena::allocatedBytes() const
+{
+    return allocated_;
+}
+
+std::size_t
+BlobArena::liveBytes() const
+{
+    return live_;
+}
+
+}  // namespace data::impl
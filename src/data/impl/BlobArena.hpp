@@ -0,0 +1,310 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief A fixed size memory block holding ledger object records back to back.
+ *
+ * Each record is the object key, the sequence it was written at, the size of the blob and the blob itself. Records are
+ * only ever appended, so readers can access published records while the writer keeps appending new ones.
+ *
+ * A segment can also adopt read-only memory that already holds records, e.g. a memory-mapped cache file.
+ */
+class BlobSegment {
+public:
+    /** @brief The size of the header preceding each blob: key, sequence and blob size */
+    static constexpr std::size_t kRECORD_HEADER_SIZE = ripple::uint256::bytes + sizeof(uint32_t) + sizeof(uint32_t);
+
+private:
+    std::vector<unsigned char> storage_;  // empty for adopted memory
+    std::shared_ptr<void const> owner_;   // keeps adopted memory alive
+    unsigned char const* data_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::size_t used_ = 0;
+    std::size_t live_ = 0;
+    bool retired_ = false;
+
+public:
+    /**
+     * @brief Construct a new segment.
+     *
+     * @param capacity The size of the segment in bytes
+     */
+    explicit BlobSegment(std::size_t capacity);
+
+    /**
+     * @brief Construct a sealed segment on top of memory holding records back to back.
+     *
+     * @note The records are trusted to be well formed.
+     *
+     * @param owner Keeps the memory alive for as long as the segment exists
+     * @param records The records
+     */
+    BlobSegment(std::shared_ptr<void const> owner, std::span<unsigned char const> records);
+
+    /**
+     * @brief Append a record if it fits.
+     *
+     * @param key The object key
+     * @param seq The sequence the object was written at
+     * @param blob The object data
+     * @return The offset of the new record; nullopt if the segment has no room for it
+     */
+    std::optional<uint32_t>
+    append(ripple::uint256 const& key, uint32_t seq, std::span<unsigned char const> blob);
+
+    /**
+     * @param offset The offset of the record
+     * @return Pointer to the beginning of the record
+     */
+    [[nodiscard]] unsigned char const*
+    record(uint32_t offset) const;
+
+    /**
+     * @return The total size of the records written to this segment
+     */
+    [[nodiscard]] std::size_t
+    used() const;
+
+    /**
+     * @return The total size of the records still referenced by the latest cache version
+     */
+    [[nodiscard]] std::size_t
+    live() const;
+
+    /**
+     * @return The size of the segment in bytes
+     */
+    [[nodiscard]] std::size_t
+    capacity() const;
+
+    /**
+     * @return The records written to this segment
+     */
+    [[nodiscard]] std::span<unsigned char const>
+    records() const;
+
+private:
+    friend class BlobArena;
+
+    void
+    release(std::size_t bytes);
+};
+
+/**
+ * @brief A refcounted, read-only view of a blob stored in a @ref BlobSegment.
+ *
+ * The view keeps the segment alive, so it remains valid after the object is removed from the cache or compacted away.
+ * A default constructed view is empty and represents a deleted object.
+ */
+class BlobRef {
+    std::shared_ptr<BlobSegment> segment_;
+    uint32_t offset_ = 0;
+
+public:
+    BlobRef() = default;
+
+    /**
+     * @brief Construct a view of a record.
+     *
+     * @param segment The segment holding the record
+     * @param offset The offset of the record in the segment
+     */
+    BlobRef(std::shared_ptr<BlobSegment> segment, uint32_t offset);
+
+    /**
+     * @return true if the view does not reference any record; false otherwise
+     */
+    [[nodiscard]] bool
+    empty() const;
+
+    /**
+     * @return The key of the object
+     */
+    [[nodiscard]] ripple::uint256
+    key() const;
+
+    /**
+     * @return The sequence the object was written at
+     */
+    [[nodiscard]] uint32_t
+    seq() const;
+
+    /**
+     * @return The object data
+     */
+    [[nodiscard]] std::span<unsigned char const>
+    data() const;
+
+    /**
+     * @return The whole record, including its header
+     */
+    [[nodiscard]] std::span<unsigned char const>
+    record() const;
+
+    /**
+     * @return A copy of the object data
+     */
+    [[nodiscard]] Blob
+    toBlob() const;
+
+    /**
+     * @param other The view to compare with
+     * @return true if both views reference the same record; false otherwise
+     */
+    [[nodiscard]] bool
+    isSameRecord(BlobRef const& other) const;
+
+    /**
+     * @return The size of the record including its header
+     */
+    [[nodiscard]] std::size_t
+    recordSize() const;
+
+private:
+    friend class BlobArena;
+
+    [[nodiscard]] BlobSegment*
+    segment() const;
+};
+
+/**
+ * @brief Allocates ledger object blobs in large segments instead of one heap allocation per object.
+ *
+ * The arena tracks how much of every segment is still referenced by the latest cache version so that sparse segments
+ * can be compacted by relocating their live records. Not thread safe; only used by the cache writer.
+ */
+class BlobArena {
+public:
+    /** @brief The default size of a segment */
+    static constexpr std::size_t kDEFAULT_SEGMENT_SIZE = 8uz * 1024 * 1024;
+
+private:
+    std::size_t segmentSize_;
+    std::vector<std::shared_ptr<BlobSegment>> segments_;  // the last one is the active segment
+    std::size_t allocated_ = 0;
+    std::size_t live_ = 0;
+
+public:
+    /**
+     * @brief Construct a new arena.
+     *
+     * @param segmentSize The size of each segment
+     */
+    explicit BlobArena(std::size_t segmentSize = kDEFAULT_SEGMENT_SIZE);
+
+    /**
+     * @brief Copy a blob into the arena.
+     *
+     * @param key The object key
+     * @param seq The sequence the object was written at
+     * @param blob The object data
+     * @return A view of the stored blob
+     */
+    BlobRef
+    store(ripple::uint256 const& key, uint32_t seq, std::span<unsigned char const> blob);
+
+    /**
+     * @brief Mark a stored blob as no longer referenced by the latest cache version.
+     *
+     * @param ref The view of the blob
+     */
+    void
+    release(BlobRef const& ref);
+
+    /**
+     * @brief Find the sealed segment with the smallest share of live data.
+     *
+     * @param maxLiveRatio Only segments with a smaller share of live data are considered
+     * @return The segment if any; nullptr otherwise
+     */
+    [[nodiscard]] std::shared_ptr<BlobSegment>
+    sparsestSegment(double maxLiveRatio) const;
+
+    /**
+     * @brief Call the given function for every record of a segment.
+     *
+     * @param segment The segment to walk
+     * @param fn The function to call with a view of each record
+     */
+    static void
+    forEachRecord(std::shared_ptr<BlobSegment> const& segment, std::function<void(BlobRef const&)> const& fn);
+
+    /**
+     * @brief Call the given function for the records of a segment from the given one on, until enough were visited.
+     *
+     * @param segment The segment to walk
+     * @param offset The offset of the first record to visit
+     * @param maxBytes Stop once the records visited add up to at least this size
+     * @param fn The function to call with a view of each record
+     * @return The offset of the first record not visited; the used size of the segment once all were visited
+     */
+    static std::size_t
+    forEachRecord(
+        std::shared_ptr<BlobSegment> const& segment,
+        std::size_t offset,
+        std::size_t maxBytes,
+        std::function<void(BlobRef const&)> const& fn
+    );
+
+    /**
+     * @brief Start tracking a segment created elsewhere. All its records are considered live.
+     *
+     * @param segment The segment to adopt
+     */
+    void
+    adopt(std::shared_ptr<BlobSegment> segment);
+
+    /**
+     * @brief Stop tracking a segment. Its memory is freed once the last view of it is gone.
+     *
+     * @param segment The segment to retire
+     */
+    void
+    retire(std::shared_ptr<BlobSegment> const& segment);
+
+    /**
+     * @return The total size of the tracked segments
+     */
+    [[nodiscard]] std::size_t
+    allocatedBytes() const;
+
+    /**
+     * @return The total size of the records referenced by the latest cache version
+     */
+    [[nodiscard]] std::size_t
+    liveBytes() const;
+};
+
+}  // namespace data::impl
@@ -0,0 +1,250 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/BoundedObjectCache.hpp"
+
+#include "data/Types.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace data::impl {
+
+namespace {
+
+constexpr std::array<uint64_t, 4> kSEEDS = {
+    0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0xD6E8FEB86659FD93ULL
+};
+
+}  // namespace
+
+FrequencySketch::FrequencySketch(std::size_t expectedEntries)
+    : width_(std::bit_ceil(std::max<std::size_t>(expectedEntries, 64)))
+    , widthBits_(std::countr_zero(width_))
+    , sampleSize_(width_ * 10)
+{
+    table_.resize(width_ * kDEPTH);
+}
+
+void
+FrequencySketch::increment(ripple::uint256 const& key)
+{
+    bool added = false;
+    for (auto const idx : indexes(key)) {
+        if (table_[idx] < kMAX_COUNT) {
+            ++table_[idx];
+            added = true;
+        }
+    }
+
+    if (added and ++additions_ >= sampleSize_) {
+        std::ranges::for_each(table_, [](uint8_t& counter) { counter /= 2; });
+        additions_ /= 2;
+    }
+}
+
+uint8_t
+FrequencySketch::estimate(ripple::uint256 const& key) const
+{
+    uint8_t result = kMAX_COUNT;
+    for (auto const idx : indexes(key))
+        result = std::min(result, table_[idx]);
+    return result;
+}
+
+std::array<std::size_t, FrequencySketch::kDEPTH>
+FrequencySketch::indexes(ripple::uint256 const& key) const
+{
+    static_assert(ripple::uint256::bytes == kDEPTH * sizeof(uint64_t));
+
+    // keys are hashes already; each row uses a different word of the key, mixed so that all of its bits matter
+    std::array<std::size_t, kDEPTH> result{};
+    for (std::size_t row = 0; row < kDEPTH; ++row) {
+        uint64_t word = 0;
+        std::memcpy(&word, key.data() + (row * sizeof(uint64_t)), sizeof(word));
+        result[row] = (row * width_) + static_cast<std::size_t>((word * kSEEDS[row]) >> (64 - widthBits_));
+    }
+    return result;
+}
+
+BoundedObjectCache::BoundedObjectCache(std::size_t maxBytes) : shardBudget_(maxBytes / kNUM_SHARDS)
+{
+    shards_.reserve(kNUM_SHARDS);
+    for (std::size_t i = 0; i < kNUM_SHARDS; ++i)
+        shards_.push_back(std::make_unique<Shard>(shardBudget_ / kESTIMATED_ENTRY_SIZE));
+}
+
+std::optional<Blob>
+BoundedObjectCache::get(ripple::uint256 const& key, uint32_t seq)
+{
+    auto& shard = shardFor(key);
+    std::scoped_lock const lck{shard.mtx};
+    shard.sketch.increment(key);
+
+    auto const it = shard.index.find(key);
+    if (it == shard.index.end() or seq < it->second->seq)
+        return std::nullopt;
+
+    promote(shard, it->second);
+    return it->second->blob;
+}
+
+std::size_t
+BoundedObjectCache::update(ripple::uint256 const& key, uint32_t seq, Blob const& blob)
+{
+    auto& shard = shardFor(key);
+    std::scoped_lock const lck{shard.mtx};
+
+    auto const it = shard.index.find(key);
+    if (it == shard.index.end())
+        return 0;
+
+    auto const entry = it->second;
+    if (blob.empty()) {
+        erase(shard, entry);
+        return 0;
+    }
+
+    auto& bytes = entry->isProtected ? shard.protectedBytes : shard.probationBytes;
+    bytes -= entry->charge();
+    entry->seq = seq;
+    entry->blob = blob;
+    bytes += entry->charge();
+
+    return evictToBudget(shard);
+}
+
+std::size_t
+BoundedObjectCache::size() const
+{
+    std::size_t result = 0;
+    for (auto const& shard : shards_) {
+        std::scoped_lock const lck{shard->mtx};
+        result += shard->index.size();
+    }
+    return result;
+}
+
+std::size_t
+BoundedObjectCache::bytes() const
+{
+    std::size_t result = 0;
+    for (auto const& shard : shards_) {
+        std::scoped_lock const lck{shard->mtx};
+        result += shard->probationBytes + shard->protectedBytes;
+    }
+    return result;
+}
+
+BoundedObjectCache::Shard&
+BoundedObjectCache::shardFor(ripple::uint256 const& key) const
+{
+    return *shards_[key.data()[0] % kNUM_SHARDS];
+}
+
+BoundedObjectCache::PutResult
+BoundedObjectCache::insert(Shard& shard, Entry entry)
+{
+    auto const charge = entry.charge();
+    if (charge > shardBudget_)
+        return {};
+
+    // TinyLFU admission: the candidate has to be more popular than the first object it would push out
+    PutResult result;
+    auto const candidateFrequency = shard.sketch.estimate(entry.key);
+    while (shard.probationBytes + shard.protectedBytes + charge > shardBudget_) {
+        auto& victims = shard.probation.empty() ? shard.protectedEntries : shard.probation;
+        auto const victim = std::prev(victims.end());
+        if (result.evicted == 0 and candidateFrequency <= shard.sketch.estimate(victim->key))
+            return result;
+
+        erase(shard, victim);
+        ++result.evicted;
+    }
+
+    auto const key = entry.key;
+    shard.probation.push_front(std::move(entry));
+    shard.index[key] = shard.probation.begin();
+    shard.probationBytes += charge;
+    result.admitted = true;
+    return result;
+}
+
+void
+BoundedObjectCache::promote(Shard& shard, EntryList::iterator it)
+{
+    if (it->isProtected) {
+        shard.protectedEntries.splice(shard.protectedEntries.begin(), shard.protectedEntries, it);
+        return;
+    }
+
+    shard.protectedEntries.splice(shard.protectedEntries.begin(), shard.probation, it);
+    shard.probationBytes -= it->charge();
+    shard.protectedBytes += it->charge();
+    it->isProtected = true;
+
+    // demote the least recently used protected objects back to probation
+    auto const protectedBudget = static_cast<std::size_t>(static_cast<double>(shardBudget_) * kPROTECTED_RATIO);
+    while (shard.protectedBytes > protectedBudget and shard.protectedEntries.size() > 1) {
+        auto const demoted = std::prev(shard.protectedEntries.end());
+        shard.probation.splice(shard.probation.begin(), shard.protectedEntries, demoted);
+        shard.protectedBytes -= demoted->charge();
+        shard.probationBytes += demoted->charge();
+        demoted->isProtected = false;
+    }
+}
+
+void
+BoundedObjectCache::erase(Shard& shard, EntryList::iterator it)
+{
+    if (it->isProtected) {
+        shard.protectedBytes -= it->charge();
+        shard.index.erase(it->key);
+        shard.protectedEntries.erase(it);
+    } else {
+        shard.probationBytes -= it->charge();
+        shard.index.erase(it->key);
+        shard.probation.erase(it);
+    }
+}
+
+std::size_t
+BoundedObjectCache::evictToBudget(Shard& shard)
+{
+    std::size_t evicted = 0;
+    while (shard.probationBytes + shard.protectedBytes > shardBudget_) {
+        auto& victims = shard.probation.empty() ? shard.protectedEntries : shard.probation;
+        erase(shard, std::prev(victims.end()));
+        ++evicted;
+    }
+    return evicted;
+}
+
+}  // namespace data::impl
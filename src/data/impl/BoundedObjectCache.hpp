@@ -0,0 +1,227 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief Approximate access frequency of keys, used to decide which objects are worth caching (TinyLFU).
+ *
+ * A count-min sketch with four small saturating counters per key. All counters are halved once enough accesses have
+ * been recorded, so that the estimate follows recent popularity rather than all time popularity.
+ */
+class FrequencySketch {
+    static constexpr uint8_t kMAX_COUNT = 15;
+    static constexpr std::size_t kDEPTH = 4;
+
+    std::vector<uint8_t> table_;  // kDEPTH rows of width_ counters
+    std::size_t width_;
+    int widthBits_;
+    std::size_t additions_ = 0;
+    std::size_t sampleSize_;
+
+public:
+    /**
+     * @brief Construct a new sketch.
+     *
+     * @param expectedEntries The expected number of distinct hot keys
+     */
+    explicit FrequencySketch(std::size_t expectedEntries);
+
+    /**
+     * @brief Record an access.
+     *
+     * @param key The accessed key
+     */
+    void
+    increment(ripple::uint256 const& key);
+
+    /**
+     * @param key The key to estimate the frequency of
+     * @return The estimated number of recent accesses
+     */
+    [[nodiscard]] uint8_t
+    estimate(ripple::uint256 const& key) const;
+
+private:
+    [[nodiscard]] std::array<std::size_t, kDEPTH>
+    indexes(ripple::uint256 const& key) const;
+};
+
+/**
+ * @brief A size bounded cache of the most frequently used ledger objects.
+ *
+ * Objects are kept in a segmented LRU: new objects enter the probation segment and are promoted to the protected
+ * segment when they are read again. When the byte budget is exceeded, the least recently used object of the probation
+ * segment is the eviction candidate. A new object is only admitted if it was accessed more often than the candidate
+ * it would replace, which keeps one-off reads from flushing out the hot set.
+ *
+ * The cache is split into shards by key, each with its own lock and an equal part of the budget.
+ */
+class BoundedObjectCache {
+public:
+    /** @brief The number of shards */
+    static constexpr std::size_t kNUM_SHARDS = 16;
+
+    /** @brief The estimated memory used per object in addition to the object data */
+    static constexpr std::size_t kENTRY_OVERHEAD = 128;
+
+    /** @brief The share of the budget reserved for the protected segment */
+    static constexpr double kPROTECTED_RATIO = 0.8;
+
+    /** @brief The average memory used per object, used to size the frequency sketch */
+    static constexpr std::size_t kESTIMATED_ENTRY_SIZE = 512;
+
+    /**
+     * @brief The outcome of adding an object.
+     */
+    struct PutResult {
+        bool admitted = false;
+        std::size_t evicted = 0;
+    };
+
+private:
+    struct Entry {
+        ripple::uint256 key;
+        uint32_t seq = 0;
+        Blob blob;
+        bool isProtected = false;
+
+        [[nodiscard]] std::size_t
+        charge() const
+        {
+            return blob.size() + kENTRY_OVERHEAD;
+        }
+    };
+
+    using EntryList = std::list<Entry>;
+
+    struct Shard {
+        std::mutex mtx;
+        EntryList probation;  // front is the most recently used
+        EntryList protectedEntries;
+        std::unordered_map<ripple::uint256, EntryList::iterator, ripple::hardened_hash<>> index;
+        std::size_t probationBytes = 0;
+        std::size_t protectedBytes = 0;
+        FrequencySketch sketch;
+
+        explicit Shard(std::size_t expectedEntries) : sketch(expectedEntries)
+        {
+        }
+    };
+
+    std::size_t shardBudget_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+public:
+    /**
+     * @brief Construct a new cache.
+     *
+     * @param maxBytes The memory budget
+     */
+    explicit BoundedObjectCache(std::size_t maxBytes);
+
+    /**
+     * @brief Get an object and record the access.
+     *
+     * @param key The key of the object
+     * @param seq The sequence the object must be valid for
+     * @return The object if cached and valid for the sequence; nullopt otherwise
+     */
+    std::optional<Blob>
+    get(ripple::uint256 const& key, uint32_t seq);
+
+    /**
+     * @brief Offer an object for caching, subject to the admission policy.
+     *
+     * @param key The key of the object
+     * @param seq The sequence the object is known to be valid from
+     * @param blob The object
+     * @param isCurrent Called under the shard lock; the object is only added if this returns true
+     * @return Whether the object was admitted and how many objects were evicted for it
+     */
+    template <typename PredicateType>
+    PutResult
+    put(ripple::uint256 const& key, uint32_t seq, Blob const& blob, PredicateType&& isCurrent)
+    {
+        auto& shard = shardFor(key);
+        std::scoped_lock const lck{shard.mtx};
+        if (not isCurrent() or shard.index.contains(key))
+            return {};
+
+        return insert(shard, Entry{.key = key, .seq = seq, .blob = blob});
+    }
+
+    /**
+     * @brief Apply a change from a new ledger. Objects that are not cached are ignored.
+     *
+     * @param key The key of the object
+     * @param seq The sequence of the ledger
+     * @param blob The new object; empty if the object was deleted
+     * @return The number of evicted objects
+     */
+    std::size_t
+    update(ripple::uint256 const& key, uint32_t seq, Blob const& blob);
+
+    /**
+     * @return The number of cached objects
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * @return The estimated memory used by the cached objects
+     */
+    [[nodiscard]] std::size_t
+    bytes() const;
+
+private:
+    Shard&
+    shardFor(ripple::uint256 const& key) const;
+
+    PutResult
+    insert(Shard& shard, Entry entry);
+
+    void
+    promote(Shard& shard, EntryList::iterator it);
+
+    void
+    erase(Shard& shard, EntryList::iterator it);
+
+    std::size_t
+    evictToBudget(Shard& shard);
+};
+
+}  // namespace data::impl
@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/LedgerCacheFile.hpp"
+
+#include "data/impl/BlobArena.hpp"
+#include "data/impl/LedgerCacheTree.hpp"
+
+#include <boost/crc.hpp>
+#include <fcntl.h>
+#include <fmt/core.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace data::impl {
+
+namespace {
+
+constexpr std::array<char, 8> kMAGIC = {'C', 'L', 'I', 'O', 'L', 'C', 'F', '\0'};
+
+struct Header {
+    std::array<char, 8> magic = kMAGIC;
+    uint32_t version = LedgerCacheFile::kVERSION;
+    uint32_t seq = 0;
+    uint64_t count = 0;
+    uint64_t size = 0;
+    uint32_t checksum = 0;
+    uint32_t reserved = 0;
+};
+
+static_assert(sizeof(Header) == 40);
+
+std::string
+errnoMessage()
+{
+    return std::make_error_code(static_cast<std::errc>(errno)).message();
+}
+
+struct Records {
+    std::size_t count = 0;
+    std::vector<std::span<unsigned char const>> segments;
+};
+
+/**
+ * @brief Check that the records are well formed and strictly ordered by key, and split them into segments.
+ *
+ * @return The records if they are valid and each fits into a segment; nullopt otherwise
+ */
+std::optional<Records>
+splitRecords(std::span<unsigned char const> records, std::size_t maxSegmentSize)
+{
+    Records result;
+    std::size_t segmentStart = 0;
+    std::size_t offset = 0;
+    unsigned char const* previousKey = nullptr;
+
+    while (offset < records.size()) {
+        if (records.size() - offset < BlobSegment::kRECORD_HEADER_SIZE)
+            return std::nullopt;
+
+        auto const* record = records.data() + offset;
+        if (previousKey != nullptr and std::memcmp(previousKey, record, ripple::uint256::bytes) >= 0)
+            return std::nullopt;
+
+        uint32_t blobSize = 0;
+        std::memcpy(&blobSize, record + ripple::uint256::bytes + sizeof(uint32_t), sizeof(blobSize));
+        if (records.size() - offset - BlobSegment::kRECORD_HEADER_SIZE < blobSize)
+            return std::nullopt;
+
+        auto const recordSize = BlobSegment::kRECORD_HEADER_SIZE + blobSize;
+        if (recordSize > maxSegmentSize)
+            return std::nullopt;
+
+        if (offset + recordSize - segmentStart > maxSegmentSize) {
+            result.segments.push_back(records.subspan(segmentStart, offset - segmentStart));
+            segmentStart = offset;
+        }
+
+        previousKey = record;
+        offset += recordSize;
+        ++result.count;
+    }
+
+    if (offset > segmentStart)
+        result.segments.push_back(records.subspan(segmentStart, offset - segmentStart));
+
+    return result;
+}
+
+}  // namespace
+
+std::expected<void, std::string>
+LedgerCacheFile::write(std::string const& path, uint32_t seq, LedgerCacheTree const& tree)
+{
+    auto const tmpPath = path + ".tmp";
+    std::ofstream file{tmpPath, std::ios::binary | std::ios::trunc};
+    if (not file)
+        return std::unexpected{fmt::format("Can't open {}: {}", tmpPath, errnoMessage())};
+
+    Header header{.seq = seq};
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+    boost::crc_32_type crc;
+    tree.forEach([&](LedgerCacheTree::Item const& item) {
+        auto const record = item.blob->record();
+        crc.process_bytes(record.data(), record.size());
+        file.write(reinterpret_cast<char const*>(record.data()), static_cast<std::streamsize>(record.size()));
+        header.size += record.size();
+        ++header.count;
+    });
+
+    header.checksum = crc.checksum();
+    file.seekp(0);
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.close();
+    if (not file)
+        return std::unexpected{fmt::format("Can't write {}: {}", tmpPath, errnoMessage())};
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec)
+        return std::unexpected{fmt::format("Can't rename {} to {}: {}", tmpPath, path, ec.message())};
+
+    return {};
+}
+
+std::expected<LedgerCacheFile::Data, std::string>
+LedgerCacheFile::read(std::string const& path, std::size_t maxSegmentSize)
+{
+    int const fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return std::unexpected{fmt::format("Can't open {}: {}", path, errnoMessage())};
+
+    struct stat st = {};
+    if (::fstat(fd, &st) != 0) {
+        auto error = errnoMessage();
+        ::close(fd);
+        return std::unexpected{fmt::format("Can't stat {}: {}", path, error)};
+    }
+
+    auto const fileSize = static_cast<std::size_t>(st.st_size);
+    if (fileSize < sizeof(Header)) {
+        ::close(fd);
+        return std::unexpected{fmt::format("{} is too small to be a cache file", path)};
+    }
+
+    void* addr = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    auto error = errnoMessage();
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        return std::unexpected{fmt::format("Can't mmap {}: {}", path, error)};
+
+    std::shared_ptr<void const> const mapping{addr, [fileSize](void const* ptr) {
+                                                  ::munmap(const_cast<void*>(ptr), fileSize);
+                                              }};
+    auto const* bytes = static_cast<unsigned char const*>(addr);
+
+    Header header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.magic != kMAGIC)
+        return std::unexpected{fmt::format("{} is not a cache file", path)};
+    if (header.version != kVERSION)
+        return std::unexpected{fmt::format("{} has unsupported version {}", path, header.version)};
+    if (header.size != fileSize - sizeof(Header))
+        return std::unexpected{fmt::format("{} is truncated", path)};
+
+    std::span<unsigned char const> const records{bytes + sizeof(Header), header.size};
+    ::madvise(addr, fileSize, MADV_SEQUENTIAL);
+
+    boost::crc_32_type crc;
+    crc.process_bytes(records.data(), records.size());
+    if (crc.checksum() != header.checksum)
+        return std::unexpected{fmt::format("{} has a wrong checksum", path)};
+
+    auto const split = splitRecords(records, std::min(maxSegmentSize, kMAX_SEGMENT_SIZE));
+    if (not split.has_value() or split->count != header.count)
+        return std::unexpected{fmt::format("{} has malformed records", path)};
+
+    ::madvise(addr, fileSize, MADV_RANDOM);
+    Data data{.seq = header.seq, .count = header.count};
+    data.segments.reserve(split->segments.size());
+    for (auto const segment : split->segments)
+        data.segments.push_back(std::make_shared<BlobSegment>(mapping, segment));
+    return data;
+}
+
+}  // namespace data::impl
@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/impl/BlobArena.hpp"
+#include "data/impl/LedgerCacheTree.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief Reads and writes snapshots of the ledger cache to disk.
+ *
+ * The file is a fixed size header followed by the cached objects in key order, each stored as a @ref BlobSegment
+ * record. Because the records are in the same format the arena uses, the file is memory-mapped on load and its
+ * records are used in place instead of being copied. A record is addressed by a 32-bit offset within its segment, so
+ * the mapped records are split into segments of at most @ref kMAX_SEGMENT_SIZE bytes.
+ *
+ * The header holds a magic string, the format version, the ledger sequence of the snapshot, the number of objects, the
+ * size of the records and a CRC32 checksum of the records. Integers are stored in native byte order.
+ */
+class LedgerCacheFile {
+public:
+    /** @brief The version of the file format */
+    static constexpr uint32_t kVERSION = 1;
+
+    /** @brief The largest segment the records of a file are split into */
+    static constexpr std::size_t kMAX_SEGMENT_SIZE = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief The content of a loaded cache file.
+     */
+    struct Data {
+        uint32_t seq = 0;
+        std::size_t count = 0;
+        std::vector<std::shared_ptr<BlobSegment>> segments;  ///< the memory-mapped records, in key order
+    };
+
+    /**
+     * @brief Write a snapshot of the cache to a file.
+     *
+     * The snapshot is written to a temporary file first, which is then renamed, so an existing file is never left
+     * half written.
+     *
+     * @param path The path of the file
+     * @param seq The ledger sequence of the snapshot
+     * @param tree The content of the cache
+     * @return Nothing on success; an error message otherwise
+     */
+    static std::expected<void, std::string>
+    write(std::string const& path, uint32_t seq, LedgerCacheTree const& tree);
+
+    /**
+     * @brief Memory-map a cache file and verify its header and checksum.
+     *
+     * The records are split into segments on record boundaries. A file with a record that does not fit into a segment
+     * is rejected.
+     *
+     * @param path The path of the file
+     * @param maxSegmentSize The largest segment to split the records into
+     * @return The content of the file on success; an error message otherwise
+     */
+    static std::expected<Data, std::string>
+    read(std::string const& path, std::size_t maxSegmentSize = kMAX_SEGMENT_SIZE);
+};
+
+}  // namespace data::impl
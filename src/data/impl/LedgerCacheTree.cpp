@@ -0,0 +1,377 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/LedgerCacheTree.hpp"
+
+#include "data/impl/BlobArena.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace data::impl {
+
+namespace {
+
+/**
+ * @brief Split `count` consecutive items into the smallest number of evenly sized chunks that fit into a node.
+ */
+template <typename FnType>
+void
+forEachChunk(std::size_t count, FnType&& fn)
+{
+    auto const chunks = (count + LedgerCacheTree::kMAX_NODE_SIZE - 1) / LedgerCacheTree::kMAX_NODE_SIZE;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        fn(count * chunk / chunks, count * (chunk + 1) / chunks);
+}
+
+void
+drop(LedgerCacheTree::DroppedCallback const& onDropped, BlobRef const& blob)
+{
+    if (onDropped and not blob.empty())
+        onDropped(blob);
+}
+
+}  // namespace
+
+BlobRef const*
+LedgerCacheTree::find(ripple::uint256 const& key) const
+{
+    Node const* node = root_.get();
+    while (node != nullptr and not node->isLeaf()) {
+        auto const it = std::ranges::lower_bound(node->keys, key);
+        if (it == node->keys.end())
+            return nullptr;
+        node = node->children[std::distance(node->keys.begin(), it)].get();
+    }
+
+    if (node == nullptr)
+        return nullptr;
+
+    auto const it = std::ranges::lower_bound(node->keys, key);
+    if (it == node->keys.end() or *it != key)
+        return nullptr;
+    return &node->entries[std::distance(node->keys.begin(), it)];
+}
+
+std::optional<LedgerCacheTree::Item>
+LedgerCacheTree::successor(ripple::uint256 const& key) const
+{
+    // an inner node's key is the largest key of the child, so the first child with a larger key always has a match
+    Node const* node = root_.get();
+    while (node != nullptr and not node->isLeaf()) {
+        auto const it = std::ranges::upper_bound(node->keys, key);
+        if (it == node->keys.end())
+            return std::nullopt;
+        node = node->children[std::distance(node->keys.begin(), it)].get();
+    }
+
+    if (node == nullptr)
+        return std::nullopt;
+
+    auto const it = std::ranges::upper_bound(node->keys, key);
+    if (it == node->keys.end())
+        return std::nullopt;
+
+    auto const idx = std::distance(node->keys.begin(), it);
+    return Item{.key = &node->keys[idx], .blob = &node->entries[idx]};
+}
+
+std::optional<LedgerCacheTree::Item>
+LedgerCacheTree::predecessor(ripple::uint256 const& key) const
+{
+    if (root_ == nullptr)
+        return std::nullopt;
+
+    return predecessorImpl(*root_, key);
+}
+
+void
+LedgerCacheTree::forEach(std::function<void(Item const&)> const& fn) const
+{
+    if (root_ != nullptr)
+        forEachImpl(*root_, fn);
+}
+
+LedgerCacheTree::Cursor
+LedgerCacheTree::cursor(std::size_t begin, std::size_t end) const
+{
+    Cursor result;
+    end = std::min(end, size());
+    if (begin >= end)
+        return result;
+
+    result.remaining_ = end - begin;
+    Node const* node = root_.get();
+    while (not node->isLeaf()) {
+        std::size_t idx = 0;
+        while (begin >= node->children[idx]->size)
+            begin -= node->children[idx++]->size;
+
+        result.path_.emplace_back(node, idx);
+        node = node->children[idx].get();
+    }
+    result.path_.emplace_back(node, begin);
+
+    return result;
+}
+
+std::size_t
+LedgerCacheTree::rank(ripple::uint256 const& key) const
+{
+    std::size_t result = 0;
+    Node const* node = root_.get();
+    while (node != nullptr and not node->isLeaf()) {
+        auto const it = std::ranges::upper_bound(node->keys, key);
+        auto const idx = static_cast<std::size_t>(std::distance(node->keys.begin(), it));
+        for (std::size_t child = 0; child < idx; ++child)
+            result += node->children[child]->size;
+
+        if (idx == node->children.size())
+            return result;
+        node = node->children[idx].get();
+    }
+
+    if (node == nullptr)
+        return result;
+
+    return result + std::distance(node->keys.begin(), std::ranges::upper_bound(node->keys, key));
+}
+
+std::optional<LedgerCacheTree::Item>
+LedgerCacheTree::Cursor::next()
+{
+    if (remaining_ == 0)
+        return std::nullopt;
+
+    auto& [leaf, idx] = path_.back();
+    Item const item{.key = &leaf->keys[idx], .blob = &leaf->entries[idx]};
+    if (--remaining_ == 0)
+        return item;
+
+    if (++idx < leaf->keys.size())
+        return item;
+
+    // climb to the first ancestor with another child to the right, then descend to the leftmost leaf of that child
+    path_.pop_back();
+    while (path_.back().second + 1 == path_.back().first->children.size())
+        path_.pop_back();
+
+    Node const* node = path_.back().first->children[++path_.back().second].get();
+    while (not node->isLeaf()) {
+        path_.emplace_back(node, 0);
+        node = node->children.front().get();
+    }
+    path_.emplace_back(node, 0);
+
+    return item;
+}
+
+std::size_t
+LedgerCacheTree::Cursor::remaining() const
+{
+    return remaining_;
+}
+
+std::size_t
+LedgerCacheTree::size() const
+{
+    return root_ == nullptr ? 0 : root_->size;
+}
+
+LedgerCacheTree
+LedgerCacheTree::apply(std::vector<Write>& writes, DroppedCallback const& onDropped) const
+{
+    if (writes.empty())
+        return *this;
+
+    std::ranges::stable_sort(writes, {}, &Write::key);
+
+    auto nodes = applyToNode(root_.get(), writes, onDropped);
+    while (nodes.size() > 1)
+        nodes = makeParents(nodes);
+
+    LedgerCacheTree result;
+    if (not nodes.empty()) {
+        result.root_ = std::move(nodes.front());
+        while (not result.root_->isLeaf() and result.root_->children.size() == 1)
+            result.root_ = result.root_->children.front();
+    }
+
+    return result;
+}
+
+std::vector<LedgerCacheTree::NodePtr>
+LedgerCacheTree::applyToNode(Node const* node, std::span<Write const> writes, DroppedCallback const& onDropped)
+{
+    if (node == nullptr or node->isLeaf())
+        return applyToLeaf(node, writes, onDropped);
+
+    std::vector<NodePtr> children;
+    children.reserve(node->children.size() + 1);
+
+    auto begin = writes.begin();
+    for (std::size_t idx = 0; idx < node->children.size(); ++idx) {
+        auto const end = idx + 1 == node->children.size()
+            ? writes.end()
+            : std::partition_point(begin, writes.end(), [&](Write const& w) { return w.key <= node->keys[idx]; });
+
+        if (begin == end) {
+            children.push_back(node->children[idx]);
+        } else {
+            auto replaced = applyToNode(node->children[idx].get(), {begin, end}, onDropped);
+            std::ranges::move(replaced, std::back_inserter(children));
+        }
+        begin = end;
+    }
+
+    return makeParents(children);
+}
+
+std::vector<LedgerCacheTree::NodePtr>
+LedgerCacheTree::applyToLeaf(Node const* leaf, std::span<Write const> writes, DroppedCallback const& onDropped)
+{
+    std::size_t const leafSize = leaf == nullptr ? 0 : leaf->keys.size();
+
+    std::vector<ripple::uint256> keys;
+    std::vector<BlobRef> entries;
+    keys.reserve(leafSize + writes.size());
+    entries.reserve(leafSize + writes.size());
+
+    std::size_t idx = 0;
+    auto write = writes.begin();
+    while (idx < leafSize or write != writes.end()) {
+        if (write == writes.end() or (idx < leafSize and leaf->keys[idx] < write->key)) {
+            keys.push_back(leaf->keys[idx]);
+            entries.push_back(leaf->entries[idx]);
+            ++idx;
+            continue;
+        }
+
+        auto const& key = write->key;
+        BlobRef current;
+        if (idx < leafSize and leaf->keys[idx] == key)
+            current = leaf->entries[idx++];
+
+        for (; write != writes.end() and write->key == key; ++write) {
+            if (write->blob.empty()) {
+                drop(onDropped, current);
+                current = {};
+            } else if (current.empty() or write->relocation or write->blob.seq() > current.seq()) {
+                drop(onDropped, current);
+                current = write->blob;
+            } else {
+                drop(onDropped, write->blob);
+            }
+        }
+
+        if (not current.empty()) {
+            keys.push_back(key);
+            entries.push_back(std::move(current));
+        }
+    }
+
+    std::vector<NodePtr> leaves;
+    forEachChunk(keys.size(), [&](std::size_t begin, std::size_t end) {
+        auto node = std::make_shared<Node>();
+        node->keys.assign(keys.begin() + begin, keys.begin() + end);
+        node->entries.assign(
+            std::make_move_iterator(entries.begin() + begin), std::make_move_iterator(entries.begin() + end)
+        );
+        node->size = end - begin;
+        leaves.push_back(std::move(node));
+    });
+
+    return leaves;
+}
+
+std::vector<LedgerCacheTree::NodePtr>
+LedgerCacheTree::makeParents(std::vector<NodePtr> const& children)
+{
+    std::vector<NodePtr> parents;
+    forEachChunk(children.size(), [&](std::size_t begin, std::size_t end) {
+        auto node = std::make_shared<Node>();
+        node->children.assign(children.begin() + begin, children.begin() + end);
+        node->keys.reserve(end - begin);
+        for (auto const& child : node->children) {
+            node->keys.push_back(child->keys.back());
+            node->size += child->size;
+        }
+        parents.push_back(std::move(node));
+    });
+
+    return parents;
+}
+
+std::optional<LedgerCacheTree::Item>
+LedgerCacheTree::predecessorImpl(Node const& node, ripple::uint256 const& key)
+{
+    auto const it = std::ranges::lower_bound(node.keys, key);
+    auto const idx = static_cast<std::size_t>(std::distance(node.keys.begin(), it));
+
+    if (node.isLeaf()) {
+        if (idx == 0)
+            return std::nullopt;
+        return Item{.key = &node.keys[idx - 1], .blob = &node.entries[idx - 1]};
+    }
+
+    // the child at idx may or may not have a smaller key; the one before it only has smaller keys
+    if (idx < node.children.size()) {
+        if (auto item = predecessorImpl(*node.children[idx], key); item.has_value())
+            return item;
+    }
+
+    if (idx == 0)
+        return std::nullopt;
+
+    return lastItem(*node.children[idx - 1]);
+}
+
+LedgerCacheTree::Item
+LedgerCacheTree::lastItem(Node const& node)
+{
+    Node const* current = &node;
+    while (not current->isLeaf())
+        current = current->children.back().get();
+
+    return Item{.key = &current->keys.back(), .blob = &current->entries.back()};
+}
+
+void
+LedgerCacheTree::forEachImpl(Node const& node, std::function<void(Item const&)> const& fn)
+{
+    if (not node.isLeaf()) {
+        for (auto const& child : node.children)
+            forEachImpl(*child, fn);
+        return;
+    }
+
+    for (std::size_t idx = 0; idx < node.keys.size(); ++idx)
+        fn(Item{.key = &node.keys[idx], .blob = &node.entries[idx]});
+}
+
+}  // namespace data::impl
@@ -0,0 +1,208 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/impl/BlobArena.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief An immutable ordered map from ledger object key to cached object, implemented as a persistent B+tree.
+ *
+ * Nodes are never modified after construction. Applying a batch of writes copies only the nodes on the paths to the
+ * written keys and shares everything else with the previous version, so every version can be read concurrently
+ * without any locking for as long as a reader holds on to it.
+ *
+ * The objects themselves live in a @ref BlobArena; the tree only stores views of them, which carry the sequence the
+ * object was last modified at.
+ */
+class LedgerCacheTree {
+public:
+    /**
+     * @brief A reference to an item stored in the tree. Valid for as long as the tree version is alive.
+     */
+    struct Item {
+        ripple::uint256 const* key = nullptr;
+        BlobRef const* blob = nullptr;
+    };
+
+    /**
+     * @brief A single modification of the tree.
+     */
+    struct Write {
+        ripple::uint256 key;
+        BlobRef blob;             ///< an empty view erases the key
+        bool relocation = false;  ///< the same object moved to a new place; replaces the entry regardless of sequence
+    };
+
+    /** @brief Called with every view that is no longer referenced by the new version of the tree */
+    using DroppedCallback = std::function<void(BlobRef const&)>;
+
+    /** @brief The maximum number of entries in a leaf or children in an inner node */
+    static constexpr std::size_t kMAX_NODE_SIZE = 32;
+
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<Node const>;
+
+    struct Node {
+        std::vector<ripple::uint256> keys;  // leaf: the keys of entries; inner node: the largest key of each child
+        std::vector<BlobRef> entries;       // leaf only
+        std::vector<NodePtr> children;      // inner node only
+        std::size_t size = 0;               // number of entries in the subtree
+
+        [[nodiscard]] bool
+        isLeaf() const
+        {
+            return children.empty();
+        }
+    };
+
+    NodePtr root_;
+
+public:
+    /**
+     * @brief Walks a contiguous range of items in key order. Valid for as long as the tree version is alive.
+     */
+    class Cursor {
+        std::vector<std::pair<Node const*, std::size_t>> path_;  // from the root down to the next item's leaf
+        std::size_t remaining_ = 0;
+
+        friend class LedgerCacheTree;
+
+    public:
+        /**
+         * @return The next item if any; nullopt once the range is exhausted
+         */
+        std::optional<Item>
+        next();
+
+        /**
+         * @return The number of items left in the range
+         */
+        [[nodiscard]] std::size_t
+        remaining() const;
+    };
+
+    /**
+     * @brief Find an entry by key.
+     *
+     * @param key The key to look for
+     * @return Pointer to the view of the object if present; nullptr otherwise
+     */
+    [[nodiscard]] BlobRef const*
+    find(ripple::uint256 const& key) const;
+
+    /**
+     * @brief Find the first item with a key strictly greater than the given one.
+     *
+     * @param key The key to start from
+     * @return The item if any; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<Item>
+    successor(ripple::uint256 const& key) const;
+
+    /**
+     * @brief Find the last item with a key strictly less than the given one.
+     *
+     * @param key The key to start from
+     * @return The item if any; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<Item>
+    predecessor(ripple::uint256 const& key) const;
+
+    /**
+     * @brief Call the given function for every item in key order.
+     *
+     * @param fn The function to call
+     */
+    void
+    forEach(std::function<void(Item const&)> const& fn) const;
+
+    /**
+     * @brief Create a cursor over a range of items given by their positions in key order.
+     *
+     * Finding the start of the range takes logarithmic time and every step of the cursor amortized constant time, so
+     * a large tree can be split into evenly sized ranges that are walked independently.
+     *
+     * @param begin The position of the first item
+     * @param end The position after the last item; clamped to the size of the tree
+     * @return The cursor
+     */
+    [[nodiscard]] Cursor
+    cursor(std::size_t begin, std::size_t end) const;
+
+    /**
+     * @param key The key to look for
+     * @return The number of items with a key less than or equal to the given one, i.e. the position of its successor
+     */
+    [[nodiscard]] std::size_t
+    rank(ripple::uint256 const& key) const;
+
+    /**
+     * @return The number of entries in the tree
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * @brief Create a new version of the tree with the given writes applied.
+     *
+     * Writes to the same key are applied in the order given. A write with a blob only replaces an existing entry if
+     * its sequence is newer; a write without a blob always erases the key.
+     *
+     * @param writes The writes to apply; reordered by key in place
+     * @param onDropped Called for every replaced or erased entry and for every write that was not applied
+     * @return The new version. This version is left unchanged
+     */
+    [[nodiscard]] LedgerCacheTree
+    apply(std::vector<Write>& writes, DroppedCallback const& onDropped = {}) const;
+
+private:
+    static std::vector<NodePtr>
+    applyToNode(Node const* node, std::span<Write const> writes, DroppedCallback const& onDropped);
+
+    static std::vector<NodePtr>
+    applyToLeaf(Node const* leaf, std::span<Write const> writes, DroppedCallback const& onDropped);
+
+    static std::vector<NodePtr>
+    makeParents(std::vector<NodePtr> const& children);
+
+    static std::optional<Item>
+    predecessorImpl(Node const& node, ripple::uint256 const& key);
+
+    static Item
+    lastItem(Node const& node);
+
+    static void
+    forEachImpl(Node const& node, std::function<void(Item const&)> const& fn);
+};
+
+}  // namespace data::impl
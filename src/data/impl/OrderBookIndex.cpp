@@ -0,0 +1,228 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/OrderBookIndex.hpp"
+
+#include "data/DBHelpers.hpp"
+#include "data/impl/BlobArena.hpp"
+#include "data/impl/LedgerCacheTree.hpp"
+#include "util/Assert.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STLedgerEntry.h>
+#include <xrpl/protocol/Serializer.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <set>
+#include <span>
+#include <utility>
+
+namespace data::impl {
+
+namespace {
+
+ripple::STLedgerEntry
+parse(ripple::uint256 const& key, BlobRef const& blob)
+{
+    auto const data = blob.data();
+    return ripple::STLedgerEntry{ripple::SerialIter{data.data(), data.size()}, key};
+}
+
+/**
+ * @brief Find the quality directory a directory page belongs to.
+ *
+ * @return The key of the first page of the directory if the object is a page of a book directory; nullopt otherwise
+ */
+std::optional<ripple::uint256>
+directoryOf(ripple::uint256 const& key, BlobRef const& blob)
+{
+    if (not isDirNode(blob.data()))
+        return std::nullopt;
+
+    // owner directories, NFT offer directories and the like do not describe a book
+    auto const sle = parse(key, blob);
+    if (not sle.isFieldPresent(ripple::sfExchangeRate) or not sle.isFieldPresent(ripple::sfTakerPaysCurrency))
+        return std::nullopt;
+
+    // only the first page lives in the book's key range; every page knows the first one
+    return sle.getFieldH256(ripple::sfRootIndex);
+}
+
+}  // namespace
+
+OrderBookIndex::OrderBookIndex()
+{
+    auto buckets = std::make_shared<Buckets>();
+    buckets->fill(std::make_shared<Bucket const>());
+    buckets_ = std::move(buckets);
+}
+
+OrderBookIndex
+OrderBookIndex::build(LedgerCacheTree const& tree)
+{
+    Written written;
+    tree.forEach([&written](LedgerCacheTree::Item const& item) {
+        if (auto const directory = directoryOf(*item.key, *item.blob); directory.has_value())
+            written[getBookBase(*directory)].insert(*directory);
+    });
+
+    return OrderBookIndex{}.patch(tree, written);
+}
+
+OrderBookIndex
+OrderBookIndex::update(
+    LedgerCacheTree const& before,
+    LedgerCacheTree const& after,
+    std::span<LedgerCacheTree::Write const> writes
+) const
+{
+    Written written;
+    for (auto const& write : writes) {
+        if (write.relocation)
+            continue;
+
+        // an erased page no longer exists in the new tree, but the old tree still knows its directory
+        auto const* blob = write.blob.empty() ? before.find(write.key) : &write.blob;
+        if (blob == nullptr)
+            continue;
+
+        if (auto const directory = directoryOf(write.key, *blob); directory.has_value())
+            written[getBookBase(*directory)].insert(*directory);
+    }
+
+    if (written.empty())
+        return *this;
+
+    return patch(after, written);
+}
+
+OrderBookIndex::Book const*
+OrderBookIndex::offers(ripple::uint256 const& book) const
+{
+    auto const& bucket = *(*buckets_)[bucketOf(book)];
+    auto const it = bucket.find(book);
+    if (it == bucket.end())
+        return nullptr;
+    return it->second.get();
+}
+
+std::size_t
+OrderBookIndex::size() const
+{
+    return size_;
+}
+
+OrderBookIndex
+OrderBookIndex::patch(LedgerCacheTree const& tree, Written const& written) const
+{
+    OrderBookIndex index;
+    index.size_ = size_;
+
+    auto buckets = std::make_shared<Buckets>(*buckets_);
+    std::array<std::shared_ptr<Bucket>, kBUCKET_COUNT> copies;  // the buckets already copied for this version
+    for (auto const& [book, directories] : written) {
+        auto const idx = bucketOf(book);
+        if (copies[idx] == nullptr) {
+            copies[idx] = std::make_shared<Bucket>(*(*buckets)[idx]);
+            (*buckets)[idx] = copies[idx];
+        }
+
+        auto& bucket = *copies[idx];
+        auto const it = bucket.find(book);
+        auto next = patchBook(tree, it == bucket.end() ? Book{} : *it->second, directories);
+        if (next.empty()) {
+            index.size_ -= bucket.erase(book);
+        } else if (it == bucket.end()) {
+            bucket.emplace(book, std::make_shared<Book const>(std::move(next)));
+            ++index.size_;
+        } else {
+            it->second = std::make_shared<Book const>(std::move(next));
+        }
+    }
+
+    index.buckets_ = std::move(buckets);
+    return index;
+}
+
+OrderBookIndex::Book
+OrderBookIndex::patchBook(LedgerCacheTree const& tree, Book const& book, std::set<ripple::uint256> const& written)
+{
+    // both the directories of the book and the written ones are ordered by key, i.e. by quality
+    Book result;
+    result.reserve(book.size() + written.size());
+    auto const reread = [&](ripple::uint256 const& directory) {
+        if (auto offers = collectOffers(tree, directory); not offers.empty())
+            result.push_back({.key = directory, .offers = std::make_shared<Offers const>(std::move(offers))});
+    };
+
+    auto next = written.begin();
+    for (auto const& directory : book) {
+        for (; next != written.end() and *next < directory.key; ++next)
+            reread(*next);
+
+        if (next != written.end() and *next == directory.key) {
+            reread(*next++);
+        } else {
+            result.push_back(directory);
+        }
+    }
+    for (; next != written.end(); ++next)
+        reread(*next);
+
+    return result;
+}
+
+std::size_t
+OrderBookIndex::bucketOf(ripple::uint256 const& book)
+{
+    // book keys are hashes, so their first byte is spread evenly
+    return book.data()[0] % kBUCKET_COUNT;
+}
+
+OrderBookIndex::Offers
+OrderBookIndex::collectOffers(LedgerCacheTree const& tree, ripple::uint256 const& directory)
+{
+    // same walk as BackendInterface::fetchBookOffers does for one quality directory: page by page
+    Offers offers;
+    auto key = directory;
+    auto const* page = tree.find(key);
+    while (page != nullptr) {
+        auto const sle = parse(key, *page);
+        auto const indexes = sle.getFieldV256(ripple::sfIndexes);
+        offers.insert(offers.end(), indexes.begin(), indexes.end());
+
+        auto const next = sle.getFieldU64(ripple::sfIndexNext);
+        if (next == 0u)
+            break;
+
+        key = ripple::keylet::page(directory, next).key;
+        page = tree.find(key);
+        ASSERT(page != nullptr, "Next dir must exist");
+    }
+
+    return offers;
+}
+
+}  // namespace data::impl
@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/impl/LedgerCacheTree.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief An immutable index of the offers of every order book, in the order `book_offers` returns them.
+ *
+ * For each book the index keeps its quality directories in key order and, for each directory, the keys of its offers
+ * in the order of the directory pages. The offers themselves are read from the @ref LedgerCacheTree the index was built
+ * for, so an offer being partially filled does not touch the index; only adding or removing directory pages and their
+ * entries does.
+ *
+ * Like the tree, the index is never modified and is cheap to copy. The books are spread over a fixed number of buckets
+ * by the first byte of their key. Updating the index copies only the buckets of the touched books and, within a touched
+ * book, re-reads only the quality directories that were written; everything else is shared with the previous version.
+ */
+class OrderBookIndex {
+public:
+    /** @brief The keys of the offers of one quality directory, in page order */
+    using Offers = std::vector<ripple::uint256>;
+
+    /** @brief The offers of one quality directory of a book */
+    struct Directory {
+        ripple::uint256 key;                   ///< The key of the first page of the directory
+        std::shared_ptr<Offers const> offers;  ///< Never empty
+    };
+
+    /** @brief The quality directories of one book that have offers, best quality first */
+    using Book = std::vector<Directory>;
+
+    /** @brief The number of buckets the books are spread over */
+    static constexpr std::size_t kBUCKET_COUNT = 256;
+
+private:
+    using Bucket = std::unordered_map<ripple::uint256, std::shared_ptr<Book const>, ripple::hardened_hash<>>;
+    using Buckets = std::array<std::shared_ptr<Bucket const>, kBUCKET_COUNT>;
+
+    // the quality directories to re-read, by book
+    using Written = std::unordered_map<ripple::uint256, std::set<ripple::uint256>, ripple::hardened_hash<>>;
+
+    std::shared_ptr<Buckets const> buckets_;
+    std::size_t size_ = 0;
+
+public:
+    /**
+     * @brief Construct an empty index.
+     */
+    OrderBookIndex();
+
+    /**
+     * @brief Build the index from scratch.
+     *
+     * @param tree A tree holding an entire ledger
+     * @return The index
+     */
+    [[nodiscard]] static OrderBookIndex
+    build(LedgerCacheTree const& tree);
+
+    /**
+     * @brief Create a new version of the index that reflects the given writes.
+     *
+     * Only quality directories with a page among the writes are re-read, from the new version of the tree.
+     *
+     * @param before The tree the writes were applied to; used to find the book of an erased page
+     * @param after The tree with the writes applied
+     * @param writes The writes
+     * @return The new version. This version is left unchanged
+     */
+    [[nodiscard]] OrderBookIndex
+    update(LedgerCacheTree const& before, LedgerCacheTree const& after, std::span<LedgerCacheTree::Write const> writes)
+        const;
+
+    /**
+     * @param book The book base, see `ripple::getBookBase`
+     * @return The book if it has any offers; nullptr otherwise. Valid for as long as this version is alive
+     */
+    [[nodiscard]] Book const*
+    offers(ripple::uint256 const& book) const;
+
+    /**
+     * @return The number of books that have offers
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+
+private:
+    OrderBookIndex
+    patch(LedgerCacheTree const& tree, Written const& written) const;
+
+    static Book
+    patchBook(LedgerCacheTree const& tree, Book const& book, std::set<ripple::uint256> const& written);
+
+    static std::size_t
+    bucketOf(ripple::uint256 const& book);
+
+    static Offers
+    collectOffers(LedgerCacheTree const& tree, ripple::uint256 const& directory);
+};
+
+}  // namespace data::impl
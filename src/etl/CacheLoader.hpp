@@ -26,12 +26,19 @@
 #include "etl/impl/CursorFromDiffProvider.hpp"
 #include "etl/impl/CursorFromFixDiffNumProvider.hpp"
 #include "util/Assert.hpp"
+#include "util/async/AnyExecutionContext.hpp"
+#include "util/async/AnyOperation.hpp"
 #include "util/async/context/BasicExecutionContext.hpp"
 #include "util/log/Logger.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace etl {
 
@@ -54,6 +61,10 @@ class CacheLoader {
 
     CacheLoaderSettings settings_;
     ExecutionContextType ctx_;
+    std::optional<util::async::AnyOperation<void>> fileLoader_;
+
+    std::mutex mtx_;  // guards loader_, which an asynchronous file load creates if the file can't be loaded
+    bool stopping_ = false;
     std::unique_ptr<CacheLoaderType> loader_;
 
 public:
@@ -73,6 +84,16 @@ public:
     {
     }
 
+    ~CacheLoader()
+    {
+        stop();
+        wait();
+    }
+
+    CacheLoader(CacheLoader const&) = delete;
+    CacheLoader&
+    operator=(CacheLoader const&) = delete;
+
     /**
      * @brief Load the cache for the given sequence number
      *
@@ -92,44 +113,74 @@ public:
             return;
         }
 
-        std::shared_ptr<impl::BaseCursorProvider> provider;
-        if (settings_.numCacheCursorsFromDiff != 0) {
-            LOG(log_.info()) << "Loading cache with cursor from num_cursors_from_diff="
-                             << settings_.numCacheCursorsFromDiff;
-            provider = std::make_shared<impl::CursorFromDiffProvider>(backend_, settings_.numCacheCursorsFromDiff);
-        } else if (settings_.numCacheCursorsFromAccount != 0) {
-            LOG(log_.info()) << "Loading cache with cursor from num_cursors_from_account="
-                             << settings_.numCacheCursorsFromAccount;
-            provider = std::make_shared<impl::CursorFromAccountProvider>(
-                backend_, settings_.numCacheCursorsFromAccount, settings_.cachePageFetchSize
-            );
-        } else {
-            LOG(log_.info()) << "Loading cache with cursor from num_diffs=" << settings_.numCacheDiffs;
-            provider = std::make_shared<impl::CursorFromFixDiffNumProvider>(backend_, settings_.numCacheDiffs);
+        if (settings_.isPartial()) {
+            LOG(log_.info()) << "Cache is partial with a budget of " << *settings_.partialCacheMaxBytes
+                             << " bytes. Not loading";
+            cache_.get().setPartial(*settings_.partialCacheMaxBytes);
+            return;
         }
 
-        loader_ = std::make_unique<CacheLoaderType>(
-            ctx_,
-            backend_,
-            cache_,
-            seq,
-            settings_.numCacheMarkers,
-            settings_.cachePageFetchSize,
-            provider->getCursors(seq)
-        );
+        if (not settings_.cacheFilePath.has_value()) {
+            loadFromDatabase(seq);
+        } else if (settings_.isSync()) {
+            auto const fetchDiff = [this](uint32_t diffSeq) {
+                return std::optional{data::synchronousAndRetryOnTimeout([this, diffSeq](auto yield) {
+                    return backend_->fetchLedgerDiff(diffSeq, yield);
+                })};
+            };
+            if (not loadFromFile(*settings_.cacheFilePath, seq, fetchDiff))
+                loadFromDatabase(seq);
+        } else {
+            // mapping the file and catching up can take a while, so neither blocks the caller
+            fileLoader_.emplace(util::async::AnyExecutionContext{ctx_}.execute([this, seq](auto token) {
+                auto const fetchDiff = [this, &token](uint32_t diffSeq) {
+                    std::optional<std::vector<data::LedgerObject>> diff;
+                    if (not token.isStopRequested()) {
+                        diff = data::retryOnTimeout([this, diffSeq, &token]() {
+                            return backend_->fetchLedgerDiff(diffSeq, token);
+                        });
+                    }
+                    return diff;
+                };
+                if (not loadFromFile(*settings_.cacheFilePath, seq, fetchDiff) and not token.isStopRequested())
+                    loadFromDatabase(seq);
+            }));
+        }
 
         if (settings_.isSync()) {
-            loader_->wait();
+            wait();
             ASSERT(cache_.get().isFull(), "Cache must be full after sync load. seq = {}", seq);
         }
     }
 
+    /**
+     * @brief Save the cache to the cache file if one is configured and the cache is fully loaded
+     */
+    void
+    save()
+    {
+        if (not settings_.cacheFilePath.has_value() or not cache_.get().isFull())
+            return;
+
+        LOG(log_.info()) << "Saving cache to " << *settings_.cacheFilePath;
+        if (auto const result = cache_.get().saveToFile(*settings_.cacheFilePath); result.has_value()) {
+            LOG(log_.info()) << "Saved cache for ledger " << *result;
+        } else {
+            LOG(log_.error()) << "Failed to save cache: " << result.error();
+        }
+    }
+
     /**
      * @brief Requests the loader to stop asap
      */
     void
     stop() noexcept
     {
+        if (fileLoader_.has_value())
+            fileLoader_->abort();
+
+        std::scoped_lock const lck{mtx_};
+        stopping_ = true;
         if (loader_ != nullptr)
             loader_->stop();
     }
@@ -140,9 +191,67 @@ public:
     void
     wait() noexcept
     {
+        if (fileLoader_.has_value())
+            fileLoader_->wait();
+
+        std::scoped_lock const lck{mtx_};
         if (loader_ != nullptr)
             loader_->wait();
     }
+
+private:
+    bool
+    loadFromFile(std::string const& path, uint32_t const seq, auto const& fetchDiff)
+    {
+        LOG(log_.info()) << "Loading cache from " << path << " and catching up to " << seq;
+
+        auto const minSequence = seq - std::min(seq, settings_.cacheFileMaxSequenceAge);
+        auto const loaded = cache_.get().loadFromFile(path, minSequence, seq, fetchDiff);
+        if (not loaded.has_value()) {
+            LOG(log_.warn()) << "Can't load cache from " << path << ": " << loaded.error()
+                             << ". Falling back to loading from the database";
+            return false;
+        }
+
+        cache_.get().setFull();
+        LOG(log_.info()) << "Loaded cache for ledger " << *loaded << " from " << path
+                         << " and caught up. Cache is full. seq = " << seq;
+        return true;
+    }
+
+    void
+    loadFromDatabase(uint32_t const seq)
+    {
+        std::scoped_lock const lck{mtx_};
+        if (stopping_)
+            return;
+
+        std::shared_ptr<impl::BaseCursorProvider> provider;
+        if (settings_.numCacheCursorsFromDiff != 0) {
+            LOG(log_.info()) << "Loading cache with cursor from num_cursors_from_diff="
+                             << settings_.numCacheCursorsFromDiff;
+            provider = std::make_shared<impl::CursorFromDiffProvider>(backend_, settings_.numCacheCursorsFromDiff);
+        } else if (settings_.numCacheCursorsFromAccount != 0) {
+            LOG(log_.info()) << "Loading cache with cursor from num_cursors_from_account="
+                             << settings_.numCacheCursorsFromAccount;
+            provider = std::make_shared<impl::CursorFromAccountProvider>(
+                backend_, settings_.numCacheCursorsFromAccount, settings_.cachePageFetchSize
+            );
+        } else {
+            LOG(log_.info()) << "Loading cache with cursor from num_diffs=" << settings_.numCacheDiffs;
+            provider = std::make_shared<impl::CursorFromFixDiffNumProvider>(backend_, settings_.numCacheDiffs);
+        }
+
+        loader_ = std::make_unique<CacheLoaderType>(
+            ctx_,
+            backend_,
+            cache_,
+            seq,
+            settings_.numCacheMarkers,
+            settings_.cachePageFetchSize,
+            provider->getCursors(seq)
+        );
+    }
 };
 
 }  // namespace etl
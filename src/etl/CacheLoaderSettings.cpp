@@ -47,6 +47,12 @@ CacheLoaderSettings::isDisabled() const
     return loadStyle == LoadStyle::NONE;
 }
 
+[[nodiscard]] bool
+CacheLoaderSettings::isPartial() const
+{
+    return partialCacheMaxBytes.has_value();
+}
+
 [[nodiscard]] CacheLoaderSettings
 makeCacheLoaderSettings(util::config::ClioConfigDefinition const& config)
 {
@@ -63,6 +69,12 @@ makeCacheLoaderSettings(util::config::ClioConfigDefinition const& config)
     settings.numCacheMarkers = cache.get<std::size_t>("num_markers");
     settings.cachePageFetchSize = cache.get<std::size_t>("page_fetch_size");
 
+    settings.cacheFilePath = cache.maybeValue<std::string>("file.path");
+    settings.cacheFileMaxSequenceAge = cache.get<uint32_t>("file.max_sequence_age");
+
+    if (auto const maxSizeMb = cache.maybeValue<uint32_t>("max_size_mb"); maxSizeMb.has_value())
+        settings.partialCacheMaxBytes = static_cast<std::size_t>(*maxSizeMb) * 1024 * 1024;
+
     auto const entry = cache.get<std::string>("load");
     if (boost::iequals(entry, "sync"))
         settings.loadStyle = CacheLoaderSettings::LoadStyle::SYNC;
@@ -22,6 +22,9 @@
 #include "util/newconfig/ConfigDefinition.hpp"
 
 #include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
 
 namespace etl {
 
@@ -41,6 +44,11 @@ struct CacheLoaderSettings {
 
     LoadStyle loadStyle = LoadStyle::ASYNC; /**< how to load the cache */
 
+    std::optional<std::string> cacheFilePath; /**< where to save the cache on shutdown and load it from on startup */
+    uint32_t cacheFileMaxSequenceAge = 5000;  /**< max number of ledgers the cache file can be behind to be loaded */
+
+    std::optional<std::size_t> partialCacheMaxBytes; /**< memory budget of the cache; partial cache if set */
+
     auto
     operator<=>(CacheLoaderSettings const&) const = default;
 
@@ -55,6 +63,10 @@ struct CacheLoaderSettings {
     /** @returns True if the cache is disabled; false otherwise */
     [[nodiscard]] bool
     isDisabled() const;
+
+    /** @returns True if only the most used objects are cached within a memory budget; false otherwise */
+    [[nodiscard]] bool
+    isPartial() const;
 };
 
 /**
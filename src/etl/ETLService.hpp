@@ -45,10 +45,12 @@
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 #include <thread>
+#include <utility>
 
 struct AccountTransactionsData;
 struct NFTTransactionsData;
@@ -177,7 +179,7 @@ public:
     }
 
     /**
-     * @brief Stop the ETL service.
+     * @brief Stop the ETL service and save the cache to the cache file if one is configured.
      * @note This method blocks until the ETL service has stopped.
      */
     void
@@ -192,6 +194,9 @@ public:
             worker_.join();
 
         LOG(log_.debug()) << "Joined ETLService worker thread";
+
+        // nothing writes to the cache anymore
+        cacheLoader_.save();
     }
 
     /**
@@ -205,6 +210,17 @@ public:
         return ledgerPublisher_.lastCloseAgeSeconds();
     }
 
+    /**
+     * @brief Set the function called with the sequence of each published ledger.
+     *
+     * @param onLedgerPublished The function to call, once the ledger range includes the ledger
+     */
+    void
+    setOnLedgerPublished(std::function<void(std::uint32_t)> onLedgerPublished)
+    {
+        ledgerPublisher_.setOnPublished(std::move(onLedgerPublished));
+    }
+
     /**
      * @brief Check for the amendment blocked state.
      *
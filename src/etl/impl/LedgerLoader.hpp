@@ -21,6 +21,7 @@
 
 #include "data/BackendInterface.hpp"
 #include "data/DBHelpers.hpp"
+#include "data/LedgerCache.hpp"
 #include "data/Types.hpp"
 #include "etl/MPTHelpers.hpp"
 #include "etl/NFTHelpers.hpp"
@@ -29,6 +30,7 @@
 #include "util/Assert.hpp"
 #include "util/LedgerUtils.hpp"
 #include "util/Profiler.hpp"
+#include "util/async/context/BasicExecutionContext.hpp"
 #include "util/log/Logger.hpp"
 
 #include <xrpl/basics/base_uint.h>
@@ -39,6 +41,8 @@
 #include <xrpl/protocol/Serializer.h>
 #include <xrpl/protocol/TxMeta.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -46,6 +50,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -57,6 +62,7 @@ struct FormattedTransactionsData {
     std::vector<NFTTransactionsData> nfTokenTxData;
     std::vector<NFTsData> nfTokensData;
     std::vector<MPTHolderData> mptHoldersData;
+    std::vector<data::TransactionAndMetadata> transactions;  // ordered by transaction index
 };
 
 namespace etl::impl {
@@ -96,6 +102,9 @@ public:
     {
     }
 
+    /** @brief The number of key ranges per worker thread when writing the book successors of the initial ledger */
+    static constexpr std::size_t kSUCCESSOR_RANGES_PER_WORKER = 4;
+
     /**
      * @brief Insert extracted transaction into the ledger
      *
@@ -104,12 +113,15 @@ public:
      *
      * @param ledger ledger to insert transactions into
      * @param data data extracted from an ETL source
-     * @return The neccessary info to write the account_transactions/account_tx and nft_token_transactions tables
+     * @return The neccessary info to write the account_transactions/account_tx and nft_token_transactions tables, and
+     * the inserted transactions for publishing
      */
     FormattedTransactionsData
     insertTransactions(ripple::LedgerHeader const& ledger, GetLedgerResponseType& data)
     {
         FormattedTransactionsData result;
+        std::vector<std::pair<std::uint32_t, data::TransactionAndMetadata>> transactions;
+        transactions.reserve(data.transactions_list().transactions_size());
 
         for (auto& txn : *(data.mutable_transactions_list()->mutable_transactions())) {
             std::string* raw = txn.mutable_transaction_blob();
@@ -131,6 +143,16 @@ public:
                 result.mptHoldersData.push_back(*maybeMPTHolder);
 
             result.accountTxData.emplace_back(txMeta, sttx.getTransactionID());
+            transactions.emplace_back(
+                txMeta.getIndex(),
+                data::TransactionAndMetadata{
+                    data::Blob{raw->begin(), raw->end()},
+                    data::Blob{txn.metadata_blob().begin(), txn.metadata_blob().end()},
+                    ledger.seq,
+                    ledger.closeTime.time_since_epoch().count()
+                }
+            );
+
             static constexpr std::size_t kEY_SIZE = 32;
             std::string keyStr{reinterpret_cast<char const*>(sttx.getTransactionID().data()), kEY_SIZE};
             backend_->writeTransaction(
@@ -143,6 +165,12 @@ public:
         }
 
         result.nfTokensData = getUniqueNFTsDatas(result.nfTokensData);
+
+        std::ranges::sort(transactions, {}, [](auto const& entry) { return entry.first; });
+        result.transactions.reserve(transactions.size());
+        for (auto& [_, txAndMeta] : transactions)
+            result.transactions.push_back(std::move(txAndMeta));
+
         return result;
     }
 
@@ -204,37 +232,7 @@ public:
                         backend_->writeSuccessor(std::move(key), sequence, uint256ToString(succ->key));
                 }
 
-                ripple::uint256 prev = data::kFIRST_KEY;
-                while (auto cur = backend_->cache().getSuccessor(prev, sequence)) {
-                    ASSERT(cur.has_value(), "Succesor for key {} must exist", ripple::strHex(prev));
-                    if (prev == data::kFIRST_KEY)
-                        backend_->writeSuccessor(uint256ToString(prev), sequence, uint256ToString(cur->key));
-
-                    if (isBookDir(cur->key, cur->blob)) {
-                        auto base = getBookBase(cur->key);
-                        // make sure the base is not an actual object
-                        if (!backend_->cache().get(base, sequence)) {
-                            auto succ = backend_->cache().getSuccessor(base, sequence);
-                            ASSERT(succ.has_value(), "Book base {} must have a successor", ripple::strHex(base));
-                            if (succ->key == cur->key) {
-                                LOG(log_.debug()) << "Writing book successor = " << ripple::strHex(base) << " - "
-                                                  << ripple::strHex(cur->key);
-
-                                backend_->writeSuccessor(uint256ToString(base), sequence, uint256ToString(cur->key));
-                            }
-                        }
-
-                        ++numWrites;
-                    }
-
-                    prev = cur->key;
-                    static constexpr std::size_t kLOG_INTERVAL = 100000;
-                    if (numWrites % kLOG_INTERVAL == 0 && numWrites != 0)
-                        LOG(log_.info()) << "Wrote " << numWrites << " book successors";
-                }
-
-                backend_->writeSuccessor(uint256ToString(prev), sequence, uint256ToString(data::kLAST_KEY));
-                ++numWrites;
+                numWrites = writeBookSuccessors(sequence);
             });
 
             LOG(log_.info()) << "Looping through cache and submitting all writes took " << seconds
@@ -255,6 +253,87 @@ public:
         LOG(log_.debug()) << "Time to download and store ledger = " << timeDiff;
         return lgrInfo;
     }
+
+private:
+    /**
+     * @brief Write the successors of all book bases, of the first key and to the last key using the full cache.
+     *
+     * The cache is split into ranges of consecutive keys that are walked in parallel. Walking in key order, a book
+     * base's successor is the book dir right after it iff the object before the book dir sorts before the book base.
+     *
+     * @param sequence The sequence of the initial ledger
+     * @return The number of book dirs found plus one
+     */
+    std::size_t
+    writeBookSuccessors(uint32_t sequence)
+    {
+        auto const numWorkers = std::max(1u, std::thread::hardware_concurrency());
+        auto cursors = backend_->cache().getCursors(sequence, numWorkers * kSUCCESSOR_RANGES_PER_WORKER);
+        if (cursors.empty()) {
+            backend_->writeSuccessor(uint256ToString(data::kFIRST_KEY), sequence, uint256ToString(data::kLAST_KEY));
+            return 1;
+        }
+
+        std::atomic_size_t nextRange = 0;
+        std::atomic_size_t numBookDirs = 0;
+        auto const writeRanges = [&]() {
+            for (auto idx = nextRange++; idx < cursors.size(); idx = nextRange++)
+                writeBookSuccessors(cursors[idx], idx == 0, idx + 1 == cursors.size(), sequence, numBookDirs);
+        };
+
+        util::async::PoolExecutionContext ctx{numWorkers};
+        std::vector<util::async::PoolExecutionContext::Operation<void>> workers;
+        workers.reserve(numWorkers);
+        for (std::size_t i = 0; i < numWorkers; ++i)
+            workers.push_back(ctx.execute(writeRanges));
+
+        for (auto& worker : workers)
+            worker.wait();
+
+        return numBookDirs + 1;
+    }
+
+    void
+    writeBookSuccessors(
+        data::LedgerCache::Cursor& cursor,
+        bool isFirstRange,
+        bool isLastRange,
+        uint32_t sequence,
+        std::atomic_size_t& numBookDirs
+    )
+    {
+        auto cur = cursor.next();
+        ASSERT(cur.has_value(), "Cache ranges must not be empty");
+
+        std::optional<ripple::uint256> prev;
+        if (isFirstRange) {
+            backend_->writeSuccessor(uint256ToString(data::kFIRST_KEY), sequence, uint256ToString(*cur->key));
+        } else if (auto const pred = backend_->cache().getPredecessor(*cur->key, sequence); pred.has_value()) {
+            prev = pred->key;
+        }
+
+        for (; cur.has_value(); cur = cursor.next()) {
+            auto const& key = *cur->key;
+            if (isBookDir(key, cur->blob->data())) {
+                // the book dir is the successor of its base unless the base itself or another object is in between
+                auto const base = getBookBase(key);
+                if (base < key and (not prev.has_value() or *prev < base)) {
+                    LOG(log_.debug()) << "Writing book successor = " << ripple::strHex(base) << " - "
+                                      << ripple::strHex(key);
+                    backend_->writeSuccessor(uint256ToString(base), sequence, uint256ToString(key));
+                }
+
+                static constexpr std::size_t kLOG_INTERVAL = 100000;
+                if (auto const count = ++numBookDirs; count % kLOG_INTERVAL == 0)
+                    LOG(log_.info()) << "Wrote " << count << " book successors";
+            }
+
+            prev = key;
+        }
+
+        if (isLastRange)
+            backend_->writeSuccessor(uint256ToString(*prev), sequence, uint256ToString(data::kLAST_KEY));
+    }
 };
 
 }  // namespace etl::impl
@@ -38,6 +38,7 @@
 #include <xrpl/protocol/STObject.h>
 #include <xrpl/protocol/Serializer.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -87,6 +88,8 @@ class LedgerPublisher {
     std::optional<uint32_t> lastPublishedSequence_;
     mutable std::shared_mutex lastPublishedSeqMtx_;
 
+    std::function<void(std::uint32_t)> onPublished_;  // only accessed on publishStrand_
+
 public:
     /**
      * @brief Create an instance of the publisher
@@ -156,13 +159,99 @@ public:
      * @brief Publish the passed ledger asynchronously.
      *
      * All ledgers are published thru publishStrand_ which ensures that all publishes are performed in a serial fashion.
+     * The transactions of the ledger are read from the database.
      *
      * @param lgrInfo the ledger to publish
      */
     void
     publish(ripple::LedgerHeader const& lgrInfo)
     {
-        boost::asio::post(publishStrand_, [this, lgrInfo = lgrInfo]() {
+        publishInternal(lgrInfo, std::nullopt);
+    }
+
+    /**
+     * @brief Publish a ledger that was just written asynchronously, without reading its transactions back from the
+     * database.
+     *
+     * @param lgrInfo the ledger to publish
+     * @param transactions the transactions of the ledger, ordered by transaction index
+     */
+    void
+    publish(ripple::LedgerHeader const& lgrInfo, std::vector<data::TransactionAndMetadata> transactions)
+    {
+        publishInternal(lgrInfo, std::move(transactions));
+    }
+
+    /**
+     * @brief Get time passed since last publish, in seconds
+     */
+    std::uint32_t
+    lastPublishAgeSeconds() const
+    {
+        return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - getLastPublish())
+            .count();
+    }
+
+    /**
+     * @brief Get last publish time as a time point
+     */
+    std::chrono::time_point<std::chrono::system_clock>
+    getLastPublish() const
+    {
+        return std::chrono::time_point<std::chrono::system_clock>{std::chrono::seconds{lastPublishSeconds_.get().value()
+        }};
+    }
+
+    /**
+     * @brief Get time passed since last ledger close, in seconds
+     */
+    std::uint32_t
+    lastCloseAgeSeconds() const
+    {
+        std::shared_lock const lck(closeTimeMtx_);
+        auto now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch())
+                       .count();
+        auto closeTime = lastCloseTime_.time_since_epoch().count();
+        if (now < (kRIPPLE_EPOCH_START + closeTime))
+            return 0;
+        return now - (kRIPPLE_EPOCH_START + closeTime);
+    }
+
+    /**
+     * @brief Set the function called with the sequence of each ledger once the ledger range includes it.
+     *
+     * The function is called on the publishing strand, also for ledgers that are too old to be published to the
+     * subscribers.
+     *
+     * @param onPublished The function to call
+     */
+    void
+    setOnPublished(std::function<void(std::uint32_t)> onPublished)
+    {
+        boost::asio::post(publishStrand_, [this, onPublished = std::move(onPublished)]() mutable {
+            onPublished_ = std::move(onPublished);
+        });
+    }
+
+    /**
+     * @brief Get the sequence of the last schueduled ledger to publish, Be aware that the ledger may not have been
+     * published to network
+     */
+    std::optional<uint32_t>
+    getLastPublishedSequence() const
+    {
+        std::scoped_lock const lck(lastPublishedSeqMtx_);
+        return lastPublishedSequence_;
+    }
+
+private:
+    void
+    publishInternal(
+        ripple::LedgerHeader const& lgrInfo,
+        std::optional<std::vector<data::TransactionAndMetadata>> knownTransactions
+    )
+    {
+        boost::asio::post(publishStrand_, [this, lgrInfo, knownTransactions = std::move(knownTransactions)]() mutable {
             LOG(log_.info()) << "Publishing ledger " << std::to_string(lgrInfo.seq);
 
             if (!state_.get().isWriting) {
@@ -179,6 +268,9 @@ public:
                 backend_->updateRange(lgrInfo.seq);
             }
 
+            if (onPublished_)
+                onPublished_(lgrInfo.seq);
+
             setLastClose(lgrInfo.closeTime);
             auto age = lastCloseAgeSeconds();
 
@@ -191,10 +283,8 @@ public:
                 });
                 ASSERT(fees.has_value(), "Fees must exist for ledger {}", lgrInfo.seq);
 
-                std::vector<data::TransactionAndMetadata> transactions =
-                    data::synchronousAndRetryOnTimeout([&](auto yield) {
-                        return backend_->fetchAllTransactionsInLedger(lgrInfo.seq, yield);
-                    });
+                auto const transactions = knownTransactions.has_value() ? std::move(*knownTransactions)
+                                                                        : fetchTransactions(lgrInfo.seq);
 
                 auto const ledgerRange = backend_->fetchLedgerRange();
                 ASSERT(ledgerRange.has_value(), "Ledger range must exist");
@@ -204,17 +294,7 @@ public:
 
                 subscriptions_->pubLedger(lgrInfo, *fees, range, transactions.size());
 
-                // order with transaction index
-                std::sort(transactions.begin(), transactions.end(), [](auto const& t1, auto const& t2) {
-                    ripple::SerialIter iter1{t1.metadata.data(), t1.metadata.size()};
-                    ripple::STObject const object1(iter1, ripple::sfMetadata);
-                    ripple::SerialIter iter2{t2.metadata.data(), t2.metadata.size()};
-                    ripple::STObject const object2(iter2, ripple::sfMetadata);
-                    return object1.getFieldU32(ripple::sfTransactionIndex) <
-                        object2.getFieldU32(ripple::sfTransactionIndex);
-                });
-
-                for (auto& txAndMeta : transactions)
+                for (auto const& txAndMeta : transactions)
                     subscriptions_->pubTransaction(txAndMeta, lgrInfo);
 
                 subscriptions_->pubBookChanges(lgrInfo, transactions);
@@ -230,53 +310,29 @@ public:
         setLastPublishedSequence(lgrInfo.seq);
     }
 
-    /**
-     * @brief Get time passed since last publish, in seconds
-     */
-    std::uint32_t
-    lastPublishAgeSeconds() const
+    std::vector<data::TransactionAndMetadata>
+    fetchTransactions(std::uint32_t ledgerSequence) const
     {
-        return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - getLastPublish())
-            .count();
-    }
+        auto transactions = data::synchronousAndRetryOnTimeout([&](auto yield) {
+            return backend_->fetchAllTransactionsInLedger(ledgerSequence, yield);
+        });
 
-    /**
-     * @brief Get last publish time as a time point
-     */
-    std::chrono::time_point<std::chrono::system_clock>
-    getLastPublish() const
-    {
-        return std::chrono::time_point<std::chrono::system_clock>{std::chrono::seconds{lastPublishSeconds_.get().value()
-        }};
-    }
+        // order with transaction index, deserializing each metadata once
+        std::vector<std::pair<std::uint32_t, data::TransactionAndMetadata>> indexed;
+        indexed.reserve(transactions.size());
+        for (auto& txAndMeta : transactions) {
+            ripple::SerialIter iter{txAndMeta.metadata.data(), txAndMeta.metadata.size()};
+            ripple::STObject const metadata(iter, ripple::sfMetadata);
+            indexed.emplace_back(metadata.getFieldU32(ripple::sfTransactionIndex), std::move(txAndMeta));
+        }
+        std::ranges::sort(indexed, {}, [](auto const& entry) { return entry.first; });
 
-    /**
-     * @brief Get time passed since last ledger close, in seconds
-     */
-    std::uint32_t
-    lastCloseAgeSeconds() const
-    {
-        std::shared_lock const lck(closeTimeMtx_);
-        auto now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch())
-                       .count();
-        auto closeTime = lastCloseTime_.time_since_epoch().count();
-        if (now < (kRIPPLE_EPOCH_START + closeTime))
-            return 0;
-        return now - (kRIPPLE_EPOCH_START + closeTime);
-    }
+        for (std::size_t i = 0; i < indexed.size(); ++i)
+            transactions[i] = std::move(indexed[i].second);
 
-    /**
-     * @brief Get the sequence of the last schueduled ledger to publish, Be aware that the ledger may not have been
-     * published to network
-     */
-    std::optional<uint32_t>
-    getLastPublishedSequence() const
-    {
-        std::scoped_lock const lck(lastPublishedSeqMtx_);
-        return lastPublishedSequence_;
+        return transactions;
     }
 
-private:
     void
     setLastClose(std::chrono::time_point<ripple::NetClock> lastCloseTime)
     {
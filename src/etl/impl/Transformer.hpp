@@ -46,6 +46,7 @@
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -150,7 +151,7 @@ private:
                 continue;
 
             auto const start = std::chrono::system_clock::now();
-            auto [lgrInfo, success] = buildNextLedger(*fetchResponse);
+            auto [lgrInfo, transactions, success] = buildNextLedger(*fetchResponse);
 
             if (success) {
                 auto const numTxns = fetchResponse->transactions_list().transactions_size();
@@ -165,7 +166,7 @@ private:
                                  << ". load objs per second = " << numObjects / duration;
 
                 // success is false if the ledger was already written
-                publisher_.get().publish(lgrInfo);
+                publisher_.get().publish(lgrInfo, std::move(transactions));
             } else {
                 LOG(log_.error()) << "Error writing ledger. " << util::toString(lgrInfo);
             }
@@ -179,9 +180,9 @@ private:
      * @note rawData should be data that corresponds to the ledger immediately following the previous seq.
      *
      * @param rawData Data extracted from an ETL source
-     * @return The newly built ledger and data to write to the database
+     * @return The newly built ledger, its transactions ordered by transaction index and whether it was written
      */
-    std::pair<ripple::LedgerHeader, bool>
+    std::tuple<ripple::LedgerHeader, std::vector<data::TransactionAndMetadata>, bool>
     buildNextLedger(GetLedgerResponseType& rawData)
     {
         LOG(log_.debug()) << "Beginning ledger update";
@@ -204,7 +205,7 @@ private:
             LOG(log_.fatal()) << "Failed to build next ledger: " << e.what();
 
             amendmentBlockHandler_.get().notifyAmendmentBlocked();
-            return {ripple::LedgerHeader{}, false};
+            return {ripple::LedgerHeader{}, {}, false};
         }
 
         LOG(log_.debug()) << "Inserted all transactions. Number of transactions  = "
@@ -221,7 +222,7 @@ private:
         LOG(log_.debug()) << "Finished writes. Total time: " << std::to_string(duration);
         LOG(log_.debug()) << "Finished ledger update: " << ::util::toString(lgrInfo);
 
-        return {lgrInfo, success};
+        return {lgrInfo, std::move(insertTxResultOp->transactions), success};
     }
 
     /**
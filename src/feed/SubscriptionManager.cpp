@@ -29,6 +29,8 @@
 #include <xrpl/protocol/Fees.h>
 #include <xrpl/protocol/LedgerHeader.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -40,6 +42,12 @@ SubscriptionManager::subBookChanges(SubscriberSharedPtr const& subscriber)
     bookChangesFeed_.sub(subscriber);
 }
 
+void
+SubscriptionManager::resumeBookChanges(std::uint32_t fromLedgerSeq, SubscriberSharedPtr const& subscriber)
+{
+    bookChangesFeed_.sub(subscriber, fromLedgerSeq);
+}
+
 void
 SubscriptionManager::unsubBookChanges(SubscriberSharedPtr const& subscriber)
 {
@@ -80,6 +88,17 @@ SubscriptionManager::subProposedAccount(ripple::AccountID const& account, Subscr
     transactionFeed_.subProposed(account, subscriber);
 }
 
+void
+SubscriptionManager::subProposedAccounts(
+    std::vector<ripple::AccountID> const& accounts,
+    SubscriberSharedPtr const& subscriber
+)
+{
+    for (auto const& account : accounts)
+        proposedTransactionFeed_.sub(account, subscriber);
+    transactionFeed_.subProposed(accounts, subscriber);
+}
+
 void
 SubscriptionManager::unsubProposedAccount(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber)
 {
@@ -99,6 +118,16 @@ SubscriptionManager::subLedger(boost::asio::yield_context yield, SubscriberShare
     return ledgerFeed_.sub(yield, backend_, subscriber);
 }
 
+boost::json::object
+SubscriptionManager::resumeLedger(
+    boost::asio::yield_context yield,
+    std::uint32_t fromLedgerSeq,
+    SubscriberSharedPtr const& subscriber
+)
+{
+    return ledgerFeed_.sub(yield, backend_, subscriber, fromLedgerSeq);
+}
+
 void
 SubscriptionManager::unsubLedger(SubscriberSharedPtr const& subscriber)
 {
@@ -113,6 +142,14 @@ SubscriptionManager::pubLedger(
     std::uint32_t const txnCount
 )
 {
+    if (replayLedgers_ != 0) {
+        auto published = publishedLedgers_.lock();
+        // the feeds would replay across the gap of the skipped ledgers otherwise
+        if (published->latestSeq == 0 or lgrInfo.seq != published->latestSeq + 1)
+            published->firstSeq = lgrInfo.seq;
+        published->latestSeq = lgrInfo.seq;
+    }
+
     ledgerFeed_.pub(lgrInfo, fees, ledgerRange, txnCount);
 }
 
@@ -158,6 +195,12 @@ SubscriptionManager::subTransactions(SubscriberSharedPtr const& subscriber)
     transactionFeed_.sub(subscriber);
 }
 
+void
+SubscriptionManager::resumeTransactions(std::uint32_t fromLedgerSeq, SubscriberSharedPtr const& subscriber)
+{
+    transactionFeed_.sub(subscriber, fromLedgerSeq);
+}
+
 void
 SubscriptionManager::unsubTransactions(SubscriberSharedPtr const& subscriber)
 {
@@ -176,6 +219,21 @@ SubscriptionManager::unsubAccount(ripple::AccountID const& account, SubscriberSh
     transactionFeed_.unsub(account, subscriber);
 }
 
+void
+SubscriptionManager::subAccounts(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber)
+{
+    transactionFeed_.sub(accounts, subscriber);
+}
+
+void
+SubscriptionManager::unsubAccounts(
+    std::vector<ripple::AccountID> const& accounts,
+    SubscriberSharedPtr const& subscriber
+)
+{
+    transactionFeed_.unsub(accounts, subscriber);
+}
+
 void
 SubscriptionManager::subBook(ripple::Book const& book, SubscriberSharedPtr const& subscriber)
 {
@@ -194,6 +252,20 @@ SubscriptionManager::pubTransaction(data::TransactionAndMetadata const& txMeta,
     transactionFeed_.pub(txMeta, lgrInfo, backend_);
 }
 
+bool
+SubscriptionManager::canResumeFrom(std::uint32_t ledgerSeq) const
+{
+    if (replayLedgers_ == 0)
+        return false;
+
+    auto const published = publishedLedgers_.lock();
+    if (published->latestSeq == 0)
+        return false;
+
+    auto const buffered = static_cast<std::uint32_t>(std::min<std::size_t>(replayLedgers_, published->latestSeq));
+    return ledgerSeq >= std::max(published->firstSeq, published->latestSeq - buffered + 1);
+}
+
 boost::json::object
 SubscriptionManager::report() const
 {
@@ -28,6 +28,7 @@
 #include "feed/impl/LedgerFeed.hpp"
 #include "feed/impl/ProposedTransactionFeed.hpp"
 #include "feed/impl/TransactionFeed.hpp"
+#include "util/Mutex.hpp"
 #include "util/async/AnyExecutionContext.hpp"
 #include "util/async/context/BasicExecutionContext.hpp"
 #include "util/log/Logger.hpp"
@@ -42,6 +43,7 @@
 #include <xrpl/protocol/Fees.h>
 #include <xrpl/protocol/LedgerHeader.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -59,6 +61,12 @@ namespace feed {
  * @brief A subscription manager is responsible for managing the subscriptions and publishing the feeds
  */
 class SubscriptionManager : public SubscriptionManagerInterface {
+    // the contiguous ledgers published since the start or the last gap, the newest of them are buffered by the feeds
+    struct PublishedLedgers {
+        std::uint32_t firstSeq = 0;
+        std::uint32_t latestSeq = 0;
+    };
+
     std::shared_ptr<data::BackendInterface const> backend_;
     util::async::AnyExecutionContext ctx_;
     impl::ForwardFeed manifestFeed_;
@@ -67,6 +75,8 @@ class SubscriptionManager : public SubscriptionManagerInterface {
     impl::BookChangesFeed bookChangesFeed_;
     impl::TransactionFeed transactionFeed_;
     impl::ProposedTransactionFeed proposedTransactionFeed_;
+    std::size_t replayLedgers_;
+    util::Mutex<PublishedLedgers> publishedLedgers_;
 
 public:
     /**
@@ -83,11 +93,19 @@ public:
     )
     {
         auto const workersNum = config.get<uint64_t>("subscription_workers");
+        auto const replayLedgers = config.get<uint32_t>("subscription_replay_ledgers");
 
         util::Logger const logger{"Subscriptions"};
-        LOG(logger.info()) << "Starting subscription manager with " << workersNum << " workers";
-
-        return std::make_shared<feed::SubscriptionManager>(util::async::PoolExecutionContext(workersNum), backend);
+        LOG(logger.info()) << "Starting subscription manager with " << workersNum << " workers, replaying up to "
+                           << replayLedgers << " ledgers";
+
+        // one shard per worker, so that publishing to many subscribers uses all the workers
+        return std::make_shared<feed::SubscriptionManager>(
+            util::async::PoolExecutionContext(workersNum),
+            backend,
+            static_cast<std::size_t>(workersNum),
+            static_cast<std::size_t>(replayLedgers)
+        );
     }
 
     /**
@@ -95,19 +113,24 @@ public:
      *
      * @param executor The executor to use to publish the feeds
      * @param backend The backend to use
+     * @param numShards The number of shards the subscribers of each feed are partitioned into
+     * @param replayLedgers The number of most recent ledgers buffered for resuming subscribers; 0 disables resuming
      */
     SubscriptionManager(
         util::async::AnyExecutionContext&& executor,
-        std::shared_ptr<data::BackendInterface const> const& backend
+        std::shared_ptr<data::BackendInterface const> const& backend,
+        std::size_t numShards = 1,
+        std::size_t replayLedgers = 0
     )
         : backend_(backend)
         , ctx_(std::move(executor))
-        , manifestFeed_(ctx_, "manifest")
-        , validationsFeed_(ctx_, "validations")
-        , ledgerFeed_(ctx_)
-        , bookChangesFeed_(ctx_)
-        , transactionFeed_(ctx_)
+        , manifestFeed_(ctx_, "manifest", numShards)
+        , validationsFeed_(ctx_, "validations", numShards)
+        , ledgerFeed_(ctx_, numShards, replayLedgers)
+        , bookChangesFeed_(ctx_, numShards, replayLedgers)
+        , transactionFeed_(ctx_, numShards, replayLedgers)
         , proposedTransactionFeed_(ctx_)
+        , replayLedgers_(replayLedgers)
     {
     }
 
@@ -136,6 +159,14 @@ public:
     void
     subBookChanges(SubscriberSharedPtr const& subscriber) final;
 
+    /**
+     * @brief Subscribe to the book changes feed, first replaying the buffered book changes since the given ledger.
+     * @param fromLedgerSeq The sequence of the first ledger to replay; must be accepted by @ref canResumeFrom
+     * @param subscriber
+     */
+    void
+    resumeBookChanges(std::uint32_t fromLedgerSeq, SubscriberSharedPtr const& subscriber) final;
+
     /**
      * @brief Unsubscribe to the book changes feed.
      * @param subscriber
@@ -174,6 +205,14 @@ public:
     void
     subProposedAccount(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber) final;
 
+    /**
+     * @brief Subscribe to the proposed transactions feed, only receive the feed when any of the accounts is affected.
+     * @param accounts The accounts to watch.
+     * @param subscriber
+     */
+    void
+    subProposedAccounts(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber) final;
+
     /**
      * @brief Unsubscribe to the proposed transactions feed for particular account.
      * @param account The account to stop watching.
@@ -198,6 +237,17 @@ public:
     boost::json::object
     subLedger(boost::asio::yield_context yield, SubscriberSharedPtr const& subscriber) final;
 
+    /**
+     * @brief Subscribe to the ledger feed, first replaying the buffered ledgers since the given one.
+     * @param yield The coroutine context
+     * @param fromLedgerSeq The sequence of the first ledger to replay; must be accepted by @ref canResumeFrom
+     * @param subscriber The subscriber to the ledger feed
+     * @return The ledger feed
+     */
+    boost::json::object
+    resumeLedger(boost::asio::yield_context yield, std::uint32_t fromLedgerSeq, SubscriberSharedPtr const& subscriber)
+        final;
+
     /**
      * @brief Unsubscribe to the ledger feed.
      * @param subscriber
@@ -269,6 +319,14 @@ public:
     void
     subTransactions(SubscriberSharedPtr const& subscriber) final;
 
+    /**
+     * @brief Subscribe to the transactions feed, first replaying the buffered transactions since the given ledger.
+     * @param fromLedgerSeq The sequence of the first ledger to replay; must be accepted by @ref canResumeFrom
+     * @param subscriber
+     */
+    void
+    resumeTransactions(std::uint32_t fromLedgerSeq, SubscriberSharedPtr const& subscriber) final;
+
     /**
      * @brief Unsubscribe to the transactions feed.
      * @param subscriber
@@ -292,6 +350,22 @@ public:
     void
     unsubAccount(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber) final;
 
+    /**
+     * @brief Subscribe to the transactions feed, only receive the feed when any of the accounts is affected.
+     * @param accounts The accounts to watch.
+     * @param subscriber
+     */
+    void
+    subAccounts(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber) final;
+
+    /**
+     * @brief Unsubscribe to the transactions feed for particular accounts.
+     * @param accounts The accounts to stop watching.
+     * @param subscriber
+     */
+    void
+    unsubAccounts(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber) final;
+
     /**
      * @brief Subscribe to the transactions feed, only receive feed when particular order book is affected.
      * @param book The book to watch.
@@ -316,6 +390,20 @@ public:
     void
     pubTransaction(data::TransactionAndMetadata const& txMeta, ripple::LedgerHeader const& lgrInfo) final;
 
+    /**
+     * @brief Check whether the ledger, transactions and book changes feeds still buffer what was published since the
+     * given ledger.
+     *
+     * The feeds evict the oldest ledger on their own strands, so a ledger accepted by this check may be gone by the
+     * time a subscriber is resumed. Each feed checks again on its strand and then sends a `ledgerNotBuffered` message
+     * instead of replaying.
+     *
+     * @param ledgerSeq The sequence of the ledger to resume the subscriptions from.
+     * @return true if the subscriptions can be resumed from the ledger; false otherwise
+     */
+    bool
+    canResumeFrom(std::uint32_t ledgerSeq) const final;
+
     /**
      * @brief Get the number of subscribers.
      *
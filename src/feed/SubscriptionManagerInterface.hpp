@@ -58,6 +58,14 @@ public:
     virtual void
     subBookChanges(SubscriberSharedPtr const& subscriber) = 0;
 
+    /**
+     * @brief Subscribe to the book changes feed, first replaying the buffered book changes since the given ledger.
+     * @param fromLedgerSeq The sequence of the first ledger to replay; must be accepted by @ref canResumeFrom
+     * @param subscriber
+     */
+    virtual void
+    resumeBookChanges(std::uint32_t fromLedgerSeq, SubscriberSharedPtr const& subscriber) = 0;
+
     /**
      * @brief Unsubscribe to the book changes feed.
      * @param subscriber
@@ -98,6 +106,14 @@ public:
     virtual void
     subProposedAccount(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber) = 0;
 
+    /**
+     * @brief Subscribe to the proposed transactions feed, only receive the feed when any of the accounts is affected.
+     * @param accounts The accounts to watch.
+     * @param subscriber
+     */
+    virtual void
+    subProposedAccounts(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber) = 0;
+
     /**
      * @brief Unsubscribe to the proposed transactions feed for particular account.
      * @param account The account to stop watching.
@@ -123,6 +139,21 @@ public:
     virtual boost::json::object
     subLedger(boost::asio::yield_context yield, SubscriberSharedPtr const& subscriber) = 0;
 
+    /**
+     * @brief Subscribe to the ledger feed, first replaying the buffered ledgers since the given one.
+     * @param yield The coroutine context
+     * @param fromLedgerSeq The sequence of the first ledger to replay; must be accepted by @ref canResumeFrom
+     * @param subscriber The subscriber to the ledger feed
+     *
+     * @return The ledger feed
+     */
+    virtual boost::json::object
+    resumeLedger(
+        boost::asio::yield_context yield,
+        std::uint32_t fromLedgerSeq,
+        SubscriberSharedPtr const& subscriber
+    ) = 0;
+
     /**
      * @brief Unsubscribe to the ledger feed.
      * @param subscriber
@@ -194,6 +225,14 @@ public:
     virtual void
     subTransactions(SubscriberSharedPtr const& subscriber) = 0;
 
+    /**
+     * @brief Subscribe to the transactions feed, first replaying the buffered transactions since the given ledger.
+     * @param fromLedgerSeq The sequence of the first ledger to replay; must be accepted by @ref canResumeFrom
+     * @param subscriber
+     */
+    virtual void
+    resumeTransactions(std::uint32_t fromLedgerSeq, SubscriberSharedPtr const& subscriber) = 0;
+
     /**
      * @brief Unsubscribe to the transactions feed.
      * @param subscriber
@@ -217,6 +256,22 @@ public:
     virtual void
     unsubAccount(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber) = 0;
 
+    /**
+     * @brief Subscribe to the transactions feed, only receive the feed when any of the accounts is affected.
+     * @param accounts The accounts to watch.
+     * @param subscriber
+     */
+    virtual void
+    subAccounts(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber) = 0;
+
+    /**
+     * @brief Unsubscribe to the transactions feed for particular accounts.
+     * @param accounts The accounts to stop watching
+     * @param subscriber The subscriber to unsubscribe
+     */
+    virtual void
+    unsubAccounts(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber) = 0;
+
     /**
      * @brief Subscribe to the transactions feed, only receive feed when particular order book is affected.
      * @param book The book to watch.
@@ -241,6 +296,16 @@ public:
     virtual void
     pubTransaction(data::TransactionAndMetadata const& txMeta, ripple::LedgerHeader const& lgrInfo) = 0;
 
+    /**
+     * @brief Check whether the ledger, transactions and book changes feeds still buffer what was published since the
+     * given ledger.
+     * @param ledgerSeq The sequence of the ledger to resume the subscriptions from.
+     *
+     * @return true if the subscriptions can be resumed from the ledger; false otherwise
+     */
+    virtual bool
+    canResumeFrom(std::uint32_t ledgerSeq) const = 0;
+
     /**
      * @brief Get the number of subscribers.
      *
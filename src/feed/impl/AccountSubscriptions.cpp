@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "feed/impl/AccountSubscriptions.hpp"
+
+#include "feed/Types.hpp"
+
+#include <xrpl/protocol/AccountID.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace feed::impl {
+
+AccountSubscriptions::SubResult
+AccountSubscriptions::sub(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber)
+{
+    SubResult result;
+
+    auto state = state_.lock<std::scoped_lock>();
+    auto [it, inserted] = state->subscriptions.try_emplace(subscriber.get());
+    auto& subscription = it->second;
+    subscription.subscriber = subscriber;
+
+    for (auto const& account : accounts) {
+        if (subscription.accounts.insert(account).second) {
+            state->subscribers[account].push_back(subscriber.get());
+            ++result.added;
+        }
+    }
+
+    if (subscription.accounts.empty()) {
+        state->subscriptions.erase(it);
+    } else {
+        result.newSubscriber = inserted;
+    }
+
+    return result;
+}
+
+std::size_t
+AccountSubscriptions::unsub(std::vector<ripple::AccountID> const& accounts, SubscriberPtr subscriber)
+{
+    std::size_t removed = 0;
+
+    auto state = state_.lock<std::scoped_lock>();
+    auto const it = state->subscriptions.find(subscriber);
+    if (it == state->subscriptions.end())
+        return removed;
+
+    for (auto const& account : accounts) {
+        if (it->second.accounts.erase(account) == 0)
+            continue;
+
+        auto const subscribers = state->subscribers.find(account);
+        std::erase(subscribers->second, subscriber);
+        if (subscribers->second.empty())
+            state->subscribers.erase(subscribers);
+        ++removed;
+    }
+
+    if (it->second.accounts.empty())
+        state->subscriptions.erase(it);
+
+    return removed;
+}
+
+std::size_t
+AccountSubscriptions::unsubAll(SubscriberPtr subscriber)
+{
+    auto state = state_.lock<std::scoped_lock>();
+    auto const it = state->subscriptions.find(subscriber);
+    if (it == state->subscriptions.end())
+        return 0;
+
+    for (auto const& account : it->second.accounts) {
+        auto const subscribers = state->subscribers.find(account);
+        std::erase(subscribers->second, subscriber);
+        if (subscribers->second.empty())
+            state->subscribers.erase(subscribers);
+    }
+
+    auto const removed = it->second.accounts.size();
+    state->subscriptions.erase(it);
+    return removed;
+}
+
+bool
+AccountSubscriptions::containsAny(std::unordered_set<ripple::AccountID> const& accounts) const
+{
+    auto const state = state_.lock<std::shared_lock>();
+    return std::ranges::any_of(accounts, [&state](auto const& account) {
+        return state->subscribers.contains(account);
+    });
+}
+
+std::vector<SubscriberSharedPtr>
+AccountSubscriptions::match(std::unordered_set<ripple::AccountID> const& accounts) const
+{
+    std::vector<SubscriberSharedPtr> matched;
+
+    auto const state = state_.lock<std::shared_lock>();
+    std::vector<SubscriberPtr> candidates;
+    for (auto const& account : accounts) {
+        if (auto const it = state->subscribers.find(account); it != state->subscribers.end())
+            candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+    }
+
+    // a subscriber watching several of the accounts is matched once
+    std::ranges::sort(candidates);
+    auto const duplicates = std::ranges::unique(candidates);
+    candidates.erase(duplicates.begin(), duplicates.end());
+
+    matched.reserve(candidates.size());
+    for (auto const candidate : candidates) {
+        if (auto subscriber = state->subscriptions.at(candidate).subscriber.lock(); subscriber != nullptr)
+            matched.push_back(std::move(subscriber));
+    }
+
+    return matched;
+}
+
+}  // namespace feed::impl
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "feed/Types.hpp"
+#include "util/Mutex.hpp"
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/unordered/unordered_flat_set.hpp>
+#include <xrpl/protocol/AccountID.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace feed::impl {
+
+/**
+ * @brief An index of the subscribers watching particular accounts.
+ *
+ * Matching the accounts affected by a transaction costs one lookup per affected account, no matter how many accounts
+ * are watched. Accounts are subscribed and unsubscribed in bulk, taking the lock once for all of them, and matching
+ * only takes the lock shared.
+ *
+ * Subscribers are tracked by a weak pointer, so a subscriber that is destroyed without unsubscribing is skipped when
+ * matching until it is removed with @ref unsubAll.
+ */
+class AccountSubscriptions {
+    using Accounts = boost::unordered_flat_set<ripple::AccountID, std::hash<ripple::AccountID>>;
+
+    struct Subscription {
+        std::weak_ptr<Subscriber> subscriber;
+        Accounts accounts;
+    };
+
+    struct State {
+        boost::unordered_flat_map<ripple::AccountID, std::vector<SubscriberPtr>, std::hash<ripple::AccountID>>
+            subscribers;
+        boost::unordered_flat_map<SubscriberPtr, Subscription> subscriptions;
+    };
+
+    util::Mutex<State, std::shared_mutex> state_;
+
+public:
+    /**
+     * @brief The outcome of a subscription to accounts.
+     */
+    struct SubResult {
+        std::size_t added = 0;       ///< The number of accounts the subscriber was not watching yet
+        bool newSubscriber = false;  ///< Whether the subscriber was not watching any account before
+    };
+
+    /**
+     * @brief Subscribe to accounts.
+     *
+     * @param accounts The accounts to watch
+     * @param subscriber The subscriber
+     * @return The number of accounts added, and whether the subscriber is new
+     */
+    SubResult
+    sub(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber);
+
+    /**
+     * @brief Unsubscribe from accounts.
+     *
+     * @param accounts The accounts to stop watching
+     * @param subscriber The subscriber; a raw pointer so that it can be called from the destructor of the subscriber
+     * @return The number of accounts the subscriber was watching
+     */
+    std::size_t
+    unsub(std::vector<ripple::AccountID> const& accounts, SubscriberPtr subscriber);
+
+    /**
+     * @brief Unsubscribe from all the accounts watched by a subscriber.
+     *
+     * @param subscriber The subscriber; a raw pointer so that it can be called from the destructor of the subscriber
+     * @return The number of accounts the subscriber was watching
+     */
+    std::size_t
+    unsubAll(SubscriberPtr subscriber);
+
+    /**
+     * @brief Check whether any of the accounts is watched.
+     *
+     * @param accounts The accounts
+     * @return true if a subscriber watches any of the accounts; false otherwise
+     */
+    bool
+    containsAny(std::unordered_set<ripple::AccountID> const& accounts) const;
+
+    /**
+     * @brief Get the subscribers watching any of the accounts.
+     *
+     * @param accounts The accounts, usually the accounts affected by a transaction
+     * @return The live subscribers, each of them once
+     */
+    std::vector<SubscriberSharedPtr>
+    match(std::unordered_set<ripple::AccountID> const& accounts) const;
+};
+
+}  // namespace feed::impl
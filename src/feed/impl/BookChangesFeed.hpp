@@ -28,6 +28,7 @@
 #include <boost/json/serialize.hpp>
 #include <xrpl/protocol/LedgerHeader.h>
 
+#include <cstddef>
 #include <vector>
 
 namespace feed::impl {
@@ -38,7 +39,12 @@ namespace feed::impl {
  * '0A5010342D8AAFABDCA58A68F6F588E1C6E58C21B63ED6CA8DB2478F58F3ECD5', 'ledger_time': 756395682, 'changes': []}
  */
 struct BookChangesFeed : public SingleFeedBase {
-    BookChangesFeed(util::async::AnyExecutionContext& executionCtx) : SingleFeedBase(executionCtx, "book_changes")
+    BookChangesFeed(
+        util::async::AnyExecutionContext& executionCtx,
+        std::size_t numShards = 1,
+        std::size_t replayLedgers = 0
+    )
+        : SingleFeedBase(executionCtx, "book_changes", numShards, replayLedgers)
     {
     }
 
@@ -50,7 +56,7 @@ struct BookChangesFeed : public SingleFeedBase {
     void
     pub(ripple::LedgerHeader const& lgrInfo, std::vector<data::TransactionAndMetadata> const& transactions)
     {
-        SingleFeedBase::pub(boost::json::serialize(rpc::computeBookChanges(lgrInfo, transactions)));
+        SingleFeedBase::pub(boost::json::serialize(rpc::computeBookChanges(lgrInfo, transactions)), lgrInfo.seq);
     }
 };
 }  // namespace feed::impl
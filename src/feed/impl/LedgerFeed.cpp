@@ -68,7 +68,27 @@ LedgerFeed::sub(
 )
 {
     SingleFeedBase::sub(subscriber);
+    return makeLatestLedgerInfo(yield, backend);
+}
 
+boost::json::object
+LedgerFeed::sub(
+    boost::asio::yield_context yield,
+    std::shared_ptr<data::BackendInterface const> const& backend,
+    SubscriberSharedPtr const& subscriber,
+    std::uint32_t fromLedgerSeq
+)
+{
+    SingleFeedBase::sub(subscriber, fromLedgerSeq);
+    return makeLatestLedgerInfo(yield, backend);
+}
+
+boost::json::object
+LedgerFeed::makeLatestLedgerInfo(
+    boost::asio::yield_context yield,
+    std::shared_ptr<data::BackendInterface const> const& backend
+)
+{
     // For ledger stream, we need to send the last closed ledger info as response
     auto const ledgerRange = backend->fetchLedgerRange();
     ASSERT(ledgerRange.has_value(), "Ledger range must be valid");
@@ -96,6 +116,8 @@ LedgerFeed::pub(
     std::uint32_t const txnCount
 )
 {
-    SingleFeedBase::pub(boost::json::serialize(makeLedgerPubMessage(lgrInfo, fees, ledgerRange, txnCount)));
+    SingleFeedBase::pub(
+        boost::json::serialize(makeLedgerPubMessage(lgrInfo, fees, ledgerRange, txnCount)), lgrInfo.seq
+    );
 }
 }  // namespace feed::impl
@@ -31,6 +31,7 @@
 #include <xrpl/protocol/Fees.h>
 #include <xrpl/protocol/LedgerHeader.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -47,9 +48,12 @@ class LedgerFeed : public SingleFeedBase {
 public:
     /**
      * @brief Construct a new Ledger Feed object
-     * @param executionCtx The actual publish will be called in the strand of this.
+     * @param executionCtx The actual publish will be called in the strands of this.
+     * @param numShards The number of shards the subscribers are partitioned into.
+     * @param replayLedgers The number of most recent ledgers to keep the messages of for resuming subscribers.
      */
-    LedgerFeed(util::async::AnyExecutionContext& executionCtx) : SingleFeedBase(executionCtx, "ledger")
+    LedgerFeed(util::async::AnyExecutionContext& executionCtx, std::size_t numShards = 1, std::size_t replayLedgers = 0)
+        : SingleFeedBase(executionCtx, "ledger", numShards, replayLedgers)
     {
     }
 
@@ -65,6 +69,20 @@ public:
         std::shared_ptr<data::BackendInterface const> const& backend,
         SubscriberSharedPtr const& subscriber);
 
+    /**
+     * @brief Subscribe the ledger feed, first replaying the buffered ledgers since the given one.
+     * @param yield The coroutine yield.
+     * @param backend The backend.
+     * @param subscriber
+     * @param fromLedgerSeq The sequence of the first ledger to replay.
+     * @return The information of the latest ledger.
+     */
+    boost::json::object
+    sub(boost::asio::yield_context yield,
+        std::shared_ptr<data::BackendInterface const> const& backend,
+        SubscriberSharedPtr const& subscriber,
+        std::uint32_t fromLedgerSeq);
+
     /**
      * @brief Publishes the ledger feed.
      * @param lgrInfo The ledger header.
@@ -79,6 +97,12 @@ public:
         std::uint32_t txnCount);
 
 private:
+    static boost::json::object
+    makeLatestLedgerInfo(
+        boost::asio::yield_context yield,
+        std::shared_ptr<data::BackendInterface const> const& backend
+    );
+
     static boost::json::object
     makeLedgerPubMessage(
         ripple::LedgerHeader const& lgrInfo,
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+namespace feed::impl {
+
+/**
+ * @brief Bounded buffer of the messages published for the most recent ledgers, used to replay them to a subscriber
+ * resuming its subscription.
+ *
+ * Messages of the ledgers older than the last `numLedgers` ledgers are evicted as newer ledgers are pushed. The buffer
+ * is not thread-safe; every feed shard owns one and only touches it on its strand.
+ *
+ * @tparam MessageType The type of the buffered messages
+ */
+template <typename MessageType>
+class ReplayBuffer {
+    struct Entry {
+        std::uint32_t ledgerSeq;
+        MessageType message;
+    };
+
+    std::size_t numLedgers_;
+    std::uint32_t latestLedgerSeq_ = 0;
+    std::deque<Entry> entries_;
+
+public:
+    /**
+     * @brief Construct a new Replay Buffer object
+     *
+     * @param numLedgers The number of most recent ledgers to keep the messages of; 0 disables the buffer
+     */
+    explicit ReplayBuffer(std::size_t numLedgers = 0) : numLedgers_(numLedgers)
+    {
+    }
+
+    /**
+     * @return true if the buffer keeps any message; false otherwise
+     */
+    [[nodiscard]] bool
+    enabled() const
+    {
+        return numLedgers_ != 0;
+    }
+
+    /**
+     * @brief Buffer a message, evicting the messages of the ledgers that are now too old.
+     *
+     * @param ledgerSeq The sequence of the ledger the message was published for; never older than the previous one
+     * @param message The message
+     */
+    void
+    push(std::uint32_t ledgerSeq, MessageType message)
+    {
+        if (not enabled())
+            return;
+
+        latestLedgerSeq_ = ledgerSeq;
+        while (not entries_.empty() and entries_.front().ledgerSeq + numLedgers_ <= ledgerSeq)
+            entries_.pop_front();
+
+        entries_.push_back(Entry{.ledgerSeq = ledgerSeq, .message = std::move(message)});
+    }
+
+    /**
+     * @brief Check whether none of the messages published for the given ledger and the ones after it were evicted.
+     *
+     * @param fromLedgerSeq The sequence of the first ledger to replay the messages of
+     * @return true if all the messages since the ledger can be replayed; false otherwise
+     */
+    [[nodiscard]] bool
+    containsSince(std::uint32_t fromLedgerSeq) const
+    {
+        return enabled() and fromLedgerSeq + numLedgers_ > latestLedgerSeq_;
+    }
+
+    /**
+     * @brief Visit the buffered messages published for the given ledger and the ones after it, in publishing order.
+     *
+     * @param fromLedgerSeq The sequence of the first ledger to visit the messages of
+     * @param fn The function called with each message
+     */
+    template <typename FnType>
+    void
+    forEachSince(std::uint32_t fromLedgerSeq, FnType const& fn) const
+    {
+        for (auto const& entry : entries_) {
+            if (entry.ledgerSeq >= fromLedgerSeq)
+                fn(entry.message);
+        }
+    }
+
+    /**
+     * @return The number of buffered messages
+     */
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return entries_.size();
+    }
+};
+
+}  // namespace feed::impl
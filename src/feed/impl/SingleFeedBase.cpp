@@ -25,6 +25,8 @@
 #include "util/async/AnyExecutionContext.hpp"
 #include "util/log/Logger.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -32,27 +34,45 @@
 
 namespace feed::impl {
 
-SingleFeedBase::SingleFeedBase(util::async::AnyExecutionContext& executionCtx, std::string const& name)
-    : strand_(executionCtx.makeStrand()), subCount_(getSubscriptionsGaugeInt(name)), name_(name)
+SingleFeedBase::SingleFeedBase(
+    util::async::AnyExecutionContext& executionCtx,
+    std::string const& name,
+    std::size_t numShards,
+    std::size_t replayLedgers
+)
+    : subCount_(getSubscriptionsGaugeInt(name)), name_(name)
 {
+    numShards = std::max<std::size_t>(numShards, 1);
+    shards_.reserve(numShards);
+    for (std::size_t i = 0; i < numShards; ++i)
+        shards_.push_back(std::make_unique<Shard>(executionCtx, replayLedgers));
 }
 
 void
 SingleFeedBase::sub(SubscriberSharedPtr const& subscriber)
 {
-    auto const weakPtr = std::weak_ptr(subscriber);
-    auto const added = signal_.connectTrackableSlot(subscriber, [weakPtr](std::shared_ptr<std::string> const& msg) {
-        if (auto connectionPtr = weakPtr.lock())
-            connectionPtr->send(msg);
-    });
+    subInternal(subscriber);
+}
 
-    if (added) {
-        LOG(logger_.info()) << subscriber->tag() << "Subscribed " << name_;
-        ++subCount_.get();
-        subscriber->onDisconnect([this](SubscriberPtr connectionDisconnecting) {
-            unsubInternal(connectionDisconnecting);
+void
+SingleFeedBase::sub(SubscriberSharedPtr const& subscriber, std::uint32_t fromLedgerSeq)
+{
+    auto& shard = shardOf(subscriber.get());
+    [[maybe_unused]] auto task = shard.strand.execute([this, &shard, subscriber, fromLedgerSeq]() {
+        // no message is emitted by the shard between the replay and the subscription
+        if (not subInternal(subscriber))
+            return;
+
+        // the ledger may have been evicted since the subscription request was accepted
+        if (not shard.history.containsSince(fromLedgerSeq)) {
+            subscriber->send(makeLedgerNotBufferedMessage(name_, fromLedgerSeq));
+            return;
+        }
+
+        shard.history.forEachSince(fromLedgerSeq, [&subscriber](std::shared_ptr<std::string> const& msg) {
+            subscriber->send(msg);
         });
-    };
+    });
 }
 
 void
@@ -64,10 +84,29 @@ SingleFeedBase::unsub(SubscriberSharedPtr const& subscriber)
 void
 SingleFeedBase::pub(std::string msg)
 {
-    [[maybe_unused]] auto task = strand_.execute([this, msg = std::move(msg)]() {
-        auto const msgPtr = std::make_shared<std::string>(msg);
-        signal_.emit(msgPtr);
-    });
+    auto const msgPtr = std::make_shared<std::string>(std::move(msg));
+    for (auto& shard : shards_) {
+        if (shard->signal.count() == 0)
+            continue;
+
+        [[maybe_unused]] auto task = shard->strand.execute([&shard = *shard, msgPtr]() { shard.signal.emit(msgPtr); });
+    }
+}
+
+void
+SingleFeedBase::pub(std::string msg, std::uint32_t ledgerSeq)
+{
+    auto const msgPtr = std::make_shared<std::string>(std::move(msg));
+    for (auto& shard : shards_) {
+        // a shard without subscribers still records the message for the subscribers resuming later
+        if (shard->signal.count() == 0 and not shard->history.enabled())
+            continue;
+
+        [[maybe_unused]] auto task = shard->strand.execute([&shard = *shard, msgPtr, ledgerSeq]() {
+            shard.signal.emit(msgPtr);
+            shard.history.push(ledgerSeq, msgPtr);
+        });
+    }
 }
 
 std::uint64_t
@@ -76,10 +115,36 @@ SingleFeedBase::count() const
     return subCount_.get().value();
 }
 
+SingleFeedBase::Shard&
+SingleFeedBase::shardOf(SubscriberPtr subscriber)
+{
+    return *shards_[getShardIndex(subscriber, shards_.size())];
+}
+
+bool
+SingleFeedBase::subInternal(SubscriberSharedPtr const& subscriber)
+{
+    auto const weakPtr = std::weak_ptr(subscriber);
+    auto const slot = [weakPtr](std::shared_ptr<std::string> const& msg) {
+        if (auto connectionPtr = weakPtr.lock())
+            connectionPtr->send(msg);
+    };
+    auto const added = shardOf(subscriber.get()).signal.connectTrackableSlot(subscriber, slot);
+
+    if (added) {
+        LOG(logger_.info()) << subscriber->tag() << "Subscribed " << name_;
+        ++subCount_.get();
+        subscriber->onDisconnect([this](SubscriberPtr connectionDisconnecting) {
+            unsubInternal(connectionDisconnecting);
+        });
+    }
+    return added;
+}
+
 void
 SingleFeedBase::unsubInternal(SubscriberPtr subscriber)
 {
-    if (signal_.disconnect(subscriber)) {
+    if (shardOf(subscriber).signal.disconnect(subscriber)) {
         LOG(logger_.info()) << subscriber->tag() << "Unsubscribed " << name_;
         --subCount_.get();
     }
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "feed/Types.hpp"
+#include "feed/impl/ReplayBuffer.hpp"
 #include "feed/impl/TrackableSignal.hpp"
 #include "util/async/AnyExecutionContext.hpp"
 #include "util/async/AnyStrand.hpp"
@@ -29,30 +30,55 @@
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/strand.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace feed::impl {
 
 /**
  * @brief Base class for single feed.
+ *
+ * Subscribers are partitioned into shards, each delivering its messages on its own strand. A message is delivered by
+ * all shards in parallel, while every subscriber still receives the messages in the order they were published.
+ *
+ * Each shard can also keep the messages published for the most recent ledgers, so that a subscriber can resume its
+ * subscription from a ledger it missed.
  */
 class SingleFeedBase {
-    util::async::AnyStrand strand_;
+    struct Shard {
+        util::async::AnyStrand strand;
+        TrackableSignal<Subscriber, std::shared_ptr<std::string> const&> signal;
+        ReplayBuffer<std::shared_ptr<std::string>> history;  // only modified on the strand
+
+        Shard(util::async::AnyExecutionContext& executionCtx, std::size_t replayLedgers)
+            : strand(executionCtx.makeStrand()), history(replayLedgers)
+        {
+        }
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
     std::reference_wrapper<util::prometheus::GaugeInt> subCount_;
-    TrackableSignal<Subscriber, std::shared_ptr<std::string> const&> signal_;
     util::Logger logger_{"Subscriptions"};
     std::string name_;
 
 public:
     /**
      * @brief Construct a new Single Feed Base object
-     * @param executionCtx The actual publish will be called in the strand of this.
+     * @param executionCtx The actual publish will be called in the strands of this.
      * @param name The promethues counter name of the feed.
+     * @param numShards The number of shards the subscribers are partitioned into.
+     * @param replayLedgers The number of most recent ledgers to keep the messages of for resuming subscribers.
      */
-    SingleFeedBase(util::async::AnyExecutionContext& executionCtx, std::string const& name);
+    SingleFeedBase(
+        util::async::AnyExecutionContext& executionCtx,
+        std::string const& name,
+        std::size_t numShards = 1,
+        std::size_t replayLedgers = 0
+    );
 
     /**
      * @brief Subscribe the feed.
@@ -61,6 +87,18 @@ public:
     void
     sub(SubscriberSharedPtr const& subscriber);
 
+    /**
+     * @brief Subscribe the feed, first replaying the buffered messages published since the given ledger.
+     *
+     * The subscription happens on the strand of the subscriber's shard, so every message is either replayed or
+     * delivered live, exactly once. Nothing is replayed if the subscriber is already subscribed.
+     *
+     * @param subscriber
+     * @param fromLedgerSeq The sequence of the first ledger to replay the messages of.
+     */
+    void
+    sub(SubscriberSharedPtr const& subscriber, std::uint32_t fromLedgerSeq);
+
     /**
      * @brief Unsubscribe the feed.
      * @param subscriber
@@ -69,12 +107,20 @@ public:
     unsub(SubscriberSharedPtr const& subscriber);
 
     /**
-     * @brief Publishes the feed in strand.
+     * @brief Publishes the feed in the strands of the shards that have subscribers.
      * @param msg The message.
      */
     void
     pub(std::string msg);
 
+    /**
+     * @brief Publishes the feed in the strands of the shards, buffering the message for resuming subscribers.
+     * @param msg The message.
+     * @param ledgerSeq The sequence of the ledger the message is published for.
+     */
+    void
+    pub(std::string msg, std::uint32_t ledgerSeq);
+
     /**
      * @brief Get the count of subscribers.
      */
@@ -82,6 +128,12 @@ public:
     count() const;
 
 private:
+    Shard&
+    shardOf(SubscriberPtr subscriber);
+
+    bool
+    subInternal(SubscriberSharedPtr const& subscriber);
+
     void
     unsubInternal(SubscriberPtr subscriber);
 };
@@ -93,6 +93,18 @@ public:
         return disconnected;
     }
 
+    /**
+     * @brief Check whether any slot is connected to the signal of the given key.
+     *
+     * @param key The key to the signal.
+     * @return true if a slot is connected for the key; false otherwise.
+     */
+    bool
+    contains(Key const& key) const
+    {
+        return signalsMap_.template lock<std::scoped_lock>()->contains(key);
+    }
+
     /**
      * @brief Emit the signal with the given key and arguments.
      *
@@ -22,8 +22,10 @@
 #include "data/BackendInterface.hpp"
 #include "data/Types.hpp"
 #include "feed/Types.hpp"
+#include "feed/impl/Util.hpp"
 #include "rpc/JS.hpp"
 #include "rpc/RPCHelpers.hpp"
+#include "util/async/AnyExecutionContext.hpp"
 #include "util/log/Logger.hpp"
 
 #include <boost/asio/spawn.hpp>
@@ -41,8 +43,11 @@
 #include <xrpl/protocol/TxFormats.h>
 #include <xrpl/protocol/jss.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_set>
@@ -51,49 +56,150 @@
 namespace feed::impl {
 
 void
-TransactionFeed::TransactionSlot::operator()(AllVersionTransactionsType const& allVersionMsgs) const
+TransactionFeed::TransactionSlot::operator()(AllVersionTransactions const& allVersionMsgs) const
 {
-    if (auto connection = subscriptionContextWeakPtr.lock(); connection) {
-        // Check if this connection already sent
-        if (feed.get().notified_.contains(connection.get()))
-            return;
+    if (auto connection = subscriptionContextWeakPtr.lock(); connection)
+        shard.get().notify(*connection, allVersionMsgs);
+}
 
-        feed.get().notified_.insert(connection.get());
+std::shared_ptr<std::string> const&
+TransactionFeed::AllVersionTransactions::get(std::uint32_t apiVersion) const
+{
+    std::size_t const index = apiVersion < 2u ? 0 : 1;
+    std::call_once(built_[index], [this, index, apiVersion]() {
+        // the transaction is shared by both versions, so they are not built concurrently
+        std::scoped_lock const lck(buildMtx_);
+        messages_[index] = std::make_shared<std::string>(boost::json::serialize(build_(apiVersion)));
+    });
 
-        if (connection->apiSubversion() < 2u) {
-            connection->send(allVersionMsgs[0]);
-            return;
-        }
-        connection->send(allVersionMsgs[1]);
+    return messages_[index];
+}
+
+bool
+TransactionFeed::Shard::hasSubscribers(
+    std::unordered_set<ripple::AccountID> const& affectedAccounts,
+    std::unordered_set<ripple::Book> const& affectedBooks
+) const
+{
+    if (signal.count() != 0 or txProposedSignal.count() != 0)
+        return true;
+
+    if (accounts.containsAny(affectedAccounts) or proposedAccounts.containsAny(affectedAccounts))
+        return true;
+
+    return std::ranges::any_of(affectedBooks, [this](ripple::Book const& book) { return bookSignal.contains(book); });
+}
+
+void
+TransactionFeed::Shard::notify(Subscriber& subscriber, AllVersionTransactions const& allVersionMsgs)
+{
+    // Check if this connection already sent
+    if (not notified.insert(&subscriber).second)
+        return;
+
+    subscriber.send(allVersionMsgs.get(subscriber.apiSubversion() < 2u ? 1u : 2u));
+}
+
+void
+TransactionFeed::Shard::pub(
+    AllVersionTransactions const& allVersionMsgs,
+    std::unordered_set<ripple::AccountID> const& affectedAccounts,
+    std::unordered_set<ripple::Book> const& affectedBooks
+)
+{
+    notified.clear();
+    signal.emit(allVersionMsgs);
+    // clear the notified set. If the same connection subscribes both transactions + proposed_transactions,
+    // rippled SENDS the same message twice
+    notified.clear();
+    txProposedSignal.emit(allVersionMsgs);
+    notified.clear();
+    // check duplicate for account and proposed_account, this prevents sending the same message multiple times
+    // if it affects multiple accounts watched by the same connection
+    for (auto const& subscriber : accounts.match(affectedAccounts))
+        notify(*subscriber, allVersionMsgs);
+    for (auto const& subscriber : proposedAccounts.match(affectedAccounts))
+        notify(*subscriber, allVersionMsgs);
+    notified.clear();
+    // check duplicate for books, this prevents sending the same message multiple times if it affects multiple
+    // books watched by the same connection
+    for (auto const& book : affectedBooks) {
+        bookSignal.emit(book, allVersionMsgs);
     }
 }
 
+TransactionFeed::TransactionFeed(
+    util::async::AnyExecutionContext& executionCtx,
+    std::size_t numShards,
+    std::size_t replayLedgers
+)
+    : replayLedgers_(replayLedgers)
+    , subAllCount_(getSubscriptionsGaugeInt("tx"))
+    , subAccountCount_(getSubscriptionsGaugeInt("account"))
+    , subBookCount_(getSubscriptionsGaugeInt("book"))
+{
+    numShards = std::max<std::size_t>(numShards, 1);
+    shards_.reserve(numShards);
+    for (std::size_t i = 0; i < numShards; ++i)
+        shards_.push_back(std::make_unique<Shard>(executionCtx, replayLedgers));
+}
+
 void
 TransactionFeed::sub(SubscriberSharedPtr const& subscriber)
 {
-    auto const added = signal_.connectTrackableSlot(subscriber, TransactionSlot(*this, subscriber));
-    if (added) {
-        LOG(logger_.info()) << subscriber->tag() << "Subscribed transactions";
-        ++subAllCount_.get();
-        subscriber->onDisconnect([this](SubscriberPtr connection) { unsubInternal(connection); });
-    }
+    subInternal(subscriber);
+}
+
+void
+TransactionFeed::sub(SubscriberSharedPtr const& subscriber, std::uint32_t fromLedgerSeq)
+{
+    auto& shard = shardOf(subscriber.get());
+    [[maybe_unused]] auto task = shard.strand.execute([this, &shard, subscriber, fromLedgerSeq]() {
+        // no transaction is published by the shard between the replay and the subscription
+        if (not subInternal(subscriber))
+            return;
+
+        // the ledger may have been evicted since the subscription request was accepted
+        if (not shard.history.containsSince(fromLedgerSeq)) {
+            subscriber->send(makeLedgerNotBufferedMessage("transactions", fromLedgerSeq));
+            return;
+        }
+
+        auto const apiVersion = subscriber->apiSubversion() < 2u ? 1u : 2u;
+        shard.history.forEachSince(
+            fromLedgerSeq,
+            [&subscriber, apiVersion](std::shared_ptr<AllVersionTransactions const> const& allVersionMsgs) {
+                subscriber->send(allVersionMsgs->get(apiVersion));
+            }
+        );
+    });
 }
 
 void
 TransactionFeed::sub(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber)
 {
-    auto const added = accountSignal_.connectTrackableSlot(subscriber, account, TransactionSlot(*this, subscriber));
-    if (added) {
-        LOG(logger_.info()) << subscriber->tag() << "Subscribed account " << account;
-        ++subAccountCount_.get();
-        subscriber->onDisconnect([this, account](SubscriberPtr connection) { unsubInternal(account, connection); });
+    sub(std::vector{account}, subscriber);
+}
+
+void
+TransactionFeed::sub(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber)
+{
+    auto const [added, newSubscriber] = shardOf(subscriber.get()).accounts.sub(accounts, subscriber);
+    if (added != 0) {
+        LOG(logger_.info()) << subscriber->tag() << "Subscribed " << added << " accounts";
+        subAccountCount_.get() += static_cast<std::int64_t>(added);
     }
+
+    // one slot unsubscribes from all the accounts, so it is only registered with the first of them
+    if (newSubscriber)
+        subscriber->onDisconnect([this](SubscriberPtr connection) { unsubAccountsInternal(connection); });
 }
 
 void
 TransactionFeed::subProposed(SubscriberSharedPtr const& subscriber)
 {
-    auto const added = txProposedSignal_.connectTrackableSlot(subscriber, TransactionSlot(*this, subscriber));
+    auto& shard = shardOf(subscriber.get());
+    auto const added = shard.txProposedSignal.connectTrackableSlot(subscriber, TransactionSlot(shard, subscriber));
     if (added) {
         subscriber->onDisconnect([this](SubscriberPtr connection) { unsubProposedInternal(connection); });
     }
@@ -102,11 +208,15 @@ TransactionFeed::subProposed(SubscriberSharedPtr const& subscriber)
 void
 TransactionFeed::subProposed(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber)
 {
-    auto const added =
-        accountProposedSignal_.connectTrackableSlot(subscriber, account, TransactionSlot(*this, subscriber));
-    if (added) {
-        subscriber->onDisconnect([this, account](SubscriberPtr connection) {
-            unsubProposedInternal(account, connection);
+    subProposed(std::vector{account}, subscriber);
+}
+
+void
+TransactionFeed::subProposed(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber)
+{
+    if (shardOf(subscriber.get()).proposedAccounts.sub(accounts, subscriber).newSubscriber) {
+        subscriber->onDisconnect([this](SubscriberPtr connection) {
+            shardOf(connection).proposedAccounts.unsubAll(connection);
         });
     }
 }
@@ -114,7 +224,8 @@ TransactionFeed::subProposed(ripple::AccountID const& account, SubscriberSharedP
 void
 TransactionFeed::sub(ripple::Book const& book, SubscriberSharedPtr const& subscriber)
 {
-    auto const added = bookSignal_.connectTrackableSlot(subscriber, book, TransactionSlot(*this, subscriber));
+    auto& shard = shardOf(subscriber.get());
+    auto const added = shard.bookSignal.connectTrackableSlot(subscriber, book, TransactionSlot(shard, subscriber));
     if (added) {
         LOG(logger_.info()) << subscriber->tag() << "Subscribed book " << book;
         ++subBookCount_.get();
@@ -131,7 +242,13 @@ TransactionFeed::unsub(SubscriberSharedPtr const& subscriber)
 void
 TransactionFeed::unsub(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber)
 {
-    unsubInternal(account, subscriber.get());
+    unsubInternal(std::vector{account}, subscriber.get());
+}
+
+void
+TransactionFeed::unsub(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber)
+{
+    unsubInternal(accounts, subscriber.get());
 }
 
 void
@@ -143,7 +260,7 @@ TransactionFeed::unsubProposed(SubscriberSharedPtr const& subscriber)
 void
 TransactionFeed::unsubProposed(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber)
 {
-    unsubProposedInternal(account, subscriber.get());
+    shardOf(subscriber.get()).proposedAccounts.unsub({account}, subscriber.get());
 }
 
 void
@@ -179,6 +296,47 @@ TransactionFeed::pub(
 {
     auto [tx, meta] = rpc::deserializeTxPlusMeta(txMeta, lgrInfo.seq);
 
+    auto const affectedAccountsFlat = meta->getAffectedAccounts();
+    auto affectedAccounts =
+        std::unordered_set<ripple::AccountID>(affectedAccountsFlat.cbegin(), affectedAccountsFlat.cend());
+
+    std::unordered_set<ripple::Book> affectedBooks;
+
+    for (auto const& node : meta->getNodes()) {
+        if (node.getFieldU16(ripple::sfLedgerEntryType) == ripple::ltOFFER) {
+            ripple::SField const* field = nullptr;
+
+            // We need a field that contains the TakerGets and TakerPays
+            // parameters.
+            if (node.getFName() == ripple::sfModifiedNode) {
+                field = &ripple::sfPreviousFields;
+            } else if (node.getFName() == ripple::sfCreatedNode) {
+                field = &ripple::sfNewFields;
+            } else if (node.getFName() == ripple::sfDeletedNode) {
+                field = &ripple::sfFinalFields;
+            }
+
+            if (field != nullptr) {
+                auto const data = dynamic_cast<ripple::STObject const*>(node.peekAtPField(*field));
+
+                if ((data != nullptr) && data->isFieldPresent(ripple::sfTakerPays) &&
+                    data->isFieldPresent(ripple::sfTakerGets)) {
+                    // determine the OrderBook
+                    ripple::Book const book{
+                        data->getFieldAmount(ripple::sfTakerGets).issue(),
+                        data->getFieldAmount(ripple::sfTakerPays).issue()
+                    };
+                    if (affectedBooks.find(book) == affectedBooks.end()) {
+                        affectedBooks.insert(book);
+                    }
+                }
+            }
+        }
+    }
+
+    if (replayLedgers_ == 0 and not hasSubscribers(affectedAccounts, affectedBooks))
+        return;
+
     std::optional<ripple::STAmount> ownerFunds;
 
     if (tx->getTxnType() == ripple::ttOFFER_CREATE) {
@@ -194,12 +352,12 @@ TransactionFeed::pub(
         }
     }
 
-    auto const genJsonByVersion = [&, tx, meta](std::uint32_t version) {
+    auto const genJsonByVersion = [tx, meta, ownerFunds, date = txMeta.date, lgrInfo](std::uint32_t version) {
         boost::json::object pubObj;
         auto const txKey = version < 2u ? JS(transaction) : JS(tx_json);
         pubObj[txKey] = rpc::toJson(*tx);
         pubObj[JS(meta)] = rpc::toJson(*meta);
-        rpc::insertDeliveredAmount(pubObj[JS(meta)].as_object(), tx, meta, txMeta.date);
+        rpc::insertDeliveredAmount(pubObj[JS(meta)].as_object(), tx, meta, date);
         rpc::insertDeliverMaxAlias(pubObj[txKey].as_object(), version);
         rpc::insertMPTIssuanceID(pubObj[JS(meta)].as_object(), tx, meta);
 
@@ -231,109 +389,90 @@ TransactionFeed::pub(
         return pubObj;
     };
 
-    AllVersionTransactionsType allVersionsMsgs{
-        std::make_shared<std::string>(boost::json::serialize(genJsonByVersion(1u))),
-        std::make_shared<std::string>(boost::json::serialize(genJsonByVersion(2u)))
-    };
+    auto const allVersionsMsgs = std::make_shared<AllVersionTransactions const>(genJsonByVersion);
+    auto const accounts = std::make_shared<std::unordered_set<ripple::AccountID> const>(std::move(affectedAccounts));
+    auto const books = std::make_shared<std::unordered_set<ripple::Book> const>(std::move(affectedBooks));
 
-    auto const affectedAccountsFlat = meta->getAffectedAccounts();
-    auto affectedAccounts =
-        std::unordered_set<ripple::AccountID>(affectedAccountsFlat.cbegin(), affectedAccountsFlat.cend());
-
-    std::unordered_set<ripple::Book> affectedBooks;
+    for (auto& shard : shards_) {
+        if (replayLedgers_ == 0 and not shard->hasSubscribers(*accounts, *books))
+            continue;
 
-    for (auto const& node : meta->getNodes()) {
-        if (node.getFieldU16(ripple::sfLedgerEntryType) == ripple::ltOFFER) {
-            ripple::SField const* field = nullptr;
+        [[maybe_unused]] auto task =
+            shard->strand.execute([&shard = *shard, allVersionsMsgs, accounts, books, seq = lgrInfo.seq]() {
+                shard.pub(*allVersionsMsgs, *accounts, *books);
+                shard.history.push(seq, allVersionsMsgs);
+            });
+    }
+}
 
-            // We need a field that contains the TakerGets and TakerPays
-            // parameters.
-            if (node.getFName() == ripple::sfModifiedNode) {
-                field = &ripple::sfPreviousFields;
-            } else if (node.getFName() == ripple::sfCreatedNode) {
-                field = &ripple::sfNewFields;
-            } else if (node.getFName() == ripple::sfDeletedNode) {
-                field = &ripple::sfFinalFields;
-            }
+bool
+TransactionFeed::hasSubscribers(
+    std::unordered_set<ripple::AccountID> const& affectedAccounts,
+    std::unordered_set<ripple::Book> const& affectedBooks
+) const
+{
+    return std::ranges::any_of(shards_, [&](auto const& shard) {
+        return shard->hasSubscribers(affectedAccounts, affectedBooks);
+    });
+}
 
-            if (field != nullptr) {
-                auto const data = dynamic_cast<ripple::STObject const*>(node.peekAtPField(*field));
+TransactionFeed::Shard&
+TransactionFeed::shardOf(SubscriberPtr subscriber)
+{
+    return *shards_[getShardIndex(subscriber, shards_.size())];
+}
 
-                if ((data != nullptr) && data->isFieldPresent(ripple::sfTakerPays) &&
-                    data->isFieldPresent(ripple::sfTakerGets)) {
-                    // determine the OrderBook
-                    ripple::Book const book{
-                        data->getFieldAmount(ripple::sfTakerGets).issue(),
-                        data->getFieldAmount(ripple::sfTakerPays).issue()
-                    };
-                    if (affectedBooks.find(book) == affectedBooks.end()) {
-                        affectedBooks.insert(book);
-                    }
-                }
-            }
-        }
+bool
+TransactionFeed::subInternal(SubscriberSharedPtr const& subscriber)
+{
+    auto& shard = shardOf(subscriber.get());
+    auto const added = shard.signal.connectTrackableSlot(subscriber, TransactionSlot(shard, subscriber));
+    if (added) {
+        LOG(logger_.info()) << subscriber->tag() << "Subscribed transactions";
+        ++subAllCount_.get();
+        subscriber->onDisconnect([this](SubscriberPtr connection) { unsubInternal(connection); });
     }
-
-    [[maybe_unused]] auto task = strand_.execute([this,
-                                                  allVersionsMsgs = std::move(allVersionsMsgs),
-                                                  affectedAccounts = std::move(affectedAccounts),
-                                                  affectedBooks = std::move(affectedBooks)]() {
-        notified_.clear();
-        signal_.emit(allVersionsMsgs);
-        // clear the notified set. If the same connection subscribes both transactions + proposed_transactions,
-        // rippled SENDS the same message twice
-        notified_.clear();
-        txProposedSignal_.emit(allVersionsMsgs);
-        notified_.clear();
-        // check duplicate for account and proposed_account, this prevents sending the same message multiple times
-        // if it affects multiple accounts watched by the same connection
-        for (auto const& account : affectedAccounts) {
-            accountSignal_.emit(account, allVersionsMsgs);
-            accountProposedSignal_.emit(account, allVersionsMsgs);
-        }
-        notified_.clear();
-        // check duplicate for books, this prevents sending the same message multiple times if it affects multiple
-        // books watched by the same connection
-        for (auto const& book : affectedBooks) {
-            bookSignal_.emit(book, allVersionsMsgs);
-        }
-    });
+    return added;
 }
 
 void
 TransactionFeed::unsubInternal(SubscriberPtr subscriber)
 {
-    if (signal_.disconnect(subscriber)) {
+    if (shardOf(subscriber).signal.disconnect(subscriber)) {
         LOG(logger_.info()) << subscriber->tag() << "Unsubscribed transactions";
         --subAllCount_.get();
     }
 }
 
 void
-TransactionFeed::unsubInternal(ripple::AccountID const& account, SubscriberPtr subscriber)
+TransactionFeed::unsubInternal(std::vector<ripple::AccountID> const& accounts, SubscriberPtr subscriber)
 {
-    if (accountSignal_.disconnect(subscriber, account)) {
-        LOG(logger_.info()) << subscriber->tag() << "Unsubscribed account " << account;
-        --subAccountCount_.get();
+    if (auto const removed = shardOf(subscriber).accounts.unsub(accounts, subscriber); removed != 0) {
+        LOG(logger_.info()) << subscriber->tag() << "Unsubscribed " << removed << " accounts";
+        subAccountCount_.get() -= static_cast<std::int64_t>(removed);
     }
 }
 
 void
-TransactionFeed::unsubProposedInternal(SubscriberPtr subscriber)
+TransactionFeed::unsubAccountsInternal(SubscriberPtr subscriber)
 {
-    txProposedSignal_.disconnect(subscriber);
+    if (auto const removed = shardOf(subscriber).accounts.unsubAll(subscriber); removed != 0) {
+        LOG(logger_.info()) << subscriber->tag() << "Unsubscribed " << removed << " accounts";
+        subAccountCount_.get() -= static_cast<std::int64_t>(removed);
+    }
 }
 
 void
-TransactionFeed::unsubProposedInternal(ripple::AccountID const& account, SubscriberPtr subscriber)
+TransactionFeed::unsubProposedInternal(SubscriberPtr subscriber)
 {
-    accountProposedSignal_.disconnect(subscriber, account);
+    shardOf(subscriber).txProposedSignal.disconnect(subscriber);
 }
 
+
 void
 TransactionFeed::unsubInternal(ripple::Book const& book, SubscriberPtr subscriber)
 {
-    if (bookSignal_.disconnect(subscriber, book)) {
+    if (shardOf(subscriber).bookSignal.disconnect(subscriber, book)) {
         LOG(logger_.info()) << subscriber->tag() << "Unsubscribed book " << book;
         --subBookCount_.get();
     }
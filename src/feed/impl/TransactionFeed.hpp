@@ -22,9 +22,10 @@
 #include "data/BackendInterface.hpp"
 #include "data/Types.hpp"
 #include "feed/Types.hpp"
+#include "feed/impl/AccountSubscriptions.hpp"
+#include "feed/impl/ReplayBuffer.hpp"
 #include "feed/impl/TrackableSignal.hpp"
 #include "feed/impl/TrackableSignalMap.hpp"
-#include "feed/impl/Util.hpp"
 #include "util/async/AnyExecutionContext.hpp"
 #include "util/async/AnyStrand.hpp"
 #include "util/log/Logger.hpp"
@@ -32,67 +33,130 @@
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/strand.hpp>
+#include <boost/json/object.hpp>
 #include <fmt/core.h>
 #include <xrpl/protocol/AccountID.h>
 #include <xrpl/protocol/Book.h>
 #include <xrpl/protocol/LedgerHeader.h>
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace feed::impl {
 
+/**
+ * @brief Feed that publishes the transactions, either all of them or those affecting particular accounts or books.
+ *
+ * Subscribers are partitioned into shards, each delivering the transactions on its own strand. A transaction is
+ * delivered by all shards in parallel, while every subscriber still receives the transactions in the order they were
+ * published.
+ *
+ * Each shard can also keep the transactions published for the most recent ledgers, so that a subscriber of all the
+ * transactions can resume its subscription from a ledger it missed.
+ */
 class TransactionFeed {
-    // Hold two versions of transaction messages
-    using AllVersionTransactionsType = std::array<std::shared_ptr<std::string>, 2>;
+    /**
+     * @brief The messages of a transaction for both API versions.
+     *
+     * A message is only built and serialized when the first subscriber of its API version is notified, by whichever
+     * shard gets there first.
+     */
+    class AllVersionTransactions {
+        std::function<boost::json::object(std::uint32_t)> build_;
+        mutable std::mutex buildMtx_;
+        mutable std::array<std::once_flag, 2> built_;
+        mutable std::array<std::shared_ptr<std::string>, 2> messages_;
+
+    public:
+        explicit AllVersionTransactions(std::function<boost::json::object(std::uint32_t)> build)
+            : build_(std::move(build))
+        {
+        }
+
+        std::shared_ptr<std::string> const&
+        get(std::uint32_t apiVersion) const;
+    };
+
+    /**
+     * @brief The subscribers of a shard, all notified on the strand of the shard.
+     */
+    struct Shard {
+        util::async::AnyStrand strand;
+
+        AccountSubscriptions accounts;
+        TrackableSignalMap<ripple::Book, Subscriber, AllVersionTransactions const&> bookSignal;
+        TrackableSignal<Subscriber, AllVersionTransactions const&> signal;
+
+        // Subscriptions for proposed tx subscribers
+        AccountSubscriptions proposedAccounts;
+        TrackableSignal<Subscriber, AllVersionTransactions const&> txProposedSignal;
+
+        std::unordered_set<SubscriberPtr>
+            notified;  // Used by slots to prevent double notifications if tx contains multiple subscribed accounts
+
+        ReplayBuffer<std::shared_ptr<AllVersionTransactions const>> history;
+
+        Shard(util::async::AnyExecutionContext& executionCtx, std::size_t replayLedgers)
+            : strand(executionCtx.makeStrand()), history(replayLedgers)
+        {
+        }
+
+        bool
+        hasSubscribers(
+            std::unordered_set<ripple::AccountID> const& affectedAccounts,
+            std::unordered_set<ripple::Book> const& affectedBooks
+        ) const;
+
+        void
+        notify(Subscriber& subscriber, AllVersionTransactions const& allVersionMsgs);
+
+        void
+        pub(AllVersionTransactions const& allVersionMsgs,
+            std::unordered_set<ripple::AccountID> const& affectedAccounts,
+            std::unordered_set<ripple::Book> const& affectedBooks);
+    };
 
     struct TransactionSlot {
-        std::reference_wrapper<TransactionFeed> feed;
+        std::reference_wrapper<Shard> shard;
         std::weak_ptr<Subscriber> subscriptionContextWeakPtr;
 
-        TransactionSlot(TransactionFeed& feed, SubscriberSharedPtr const& connection)
-            : feed(feed), subscriptionContextWeakPtr(connection)
+        TransactionSlot(Shard& shard, SubscriberSharedPtr const& connection)
+            : shard(shard), subscriptionContextWeakPtr(connection)
         {
         }
 
         void
-        operator()(AllVersionTransactionsType const& allVersionMsgs) const;
+        operator()(AllVersionTransactions const& allVersionMsgs) const;
     };
 
     util::Logger logger_{"Subscriptions"};
 
-    util::async::AnyStrand strand_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::size_t replayLedgers_;
     std::reference_wrapper<util::prometheus::GaugeInt> subAllCount_;
     std::reference_wrapper<util::prometheus::GaugeInt> subAccountCount_;
     std::reference_wrapper<util::prometheus::GaugeInt> subBookCount_;
 
-    TrackableSignalMap<ripple::AccountID, Subscriber, AllVersionTransactionsType const&> accountSignal_;
-    TrackableSignalMap<ripple::Book, Subscriber, AllVersionTransactionsType const&> bookSignal_;
-    TrackableSignal<Subscriber, AllVersionTransactionsType const&> signal_;
-
-    // Signals for proposed tx subscribers
-    TrackableSignalMap<ripple::AccountID, Subscriber, AllVersionTransactionsType const&> accountProposedSignal_;
-    TrackableSignal<Subscriber, AllVersionTransactionsType const&> txProposedSignal_;
-
-    std::unordered_set<SubscriberPtr>
-        notified_;  // Used by slots to prevent double notifications if tx contains multiple subscribed accounts
-
 public:
     /**
      * @brief Construct a new Transaction Feed object.
-     * @param executionCtx The actual publish will be called in the strand of this.
+     * @param executionCtx The actual publish will be called in the strands of this.
+     * @param numShards The number of shards the subscribers are partitioned into.
+     * @param replayLedgers The number of most recent ledgers to keep the transactions of for resuming subscribers.
      */
-    TransactionFeed(util::async::AnyExecutionContext& executionCtx)
-        : strand_(executionCtx.makeStrand())
-        , subAllCount_(getSubscriptionsGaugeInt("tx"))
-        , subAccountCount_(getSubscriptionsGaugeInt("account"))
-        , subBookCount_(getSubscriptionsGaugeInt("book"))
-    {
-    }
+    TransactionFeed(
+        util::async::AnyExecutionContext& executionCtx,
+        std::size_t numShards = 1,
+        std::size_t replayLedgers = 0
+    );
 
     /**
      * @brief Subscribe to the transaction feed.
@@ -101,6 +165,18 @@ public:
     void
     sub(SubscriberSharedPtr const& subscriber);
 
+    /**
+     * @brief Subscribe to the transaction feed, first replaying the buffered transactions since the given ledger.
+     *
+     * The subscription happens on the strand of the subscriber's shard, so every transaction is either replayed or
+     * delivered live, exactly once. Nothing is replayed if the subscriber is already subscribed.
+     *
+     * @param subscriber
+     * @param fromLedgerSeq The sequence of the first ledger to replay the transactions of.
+     */
+    void
+    sub(SubscriberSharedPtr const& subscriber, std::uint32_t fromLedgerSeq);
+
     /**
      * @brief Subscribe to the transaction feed, only receive the feed when particular account is affected.
      * @param subscriber
@@ -109,6 +185,14 @@ public:
     void
     sub(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber);
 
+    /**
+     * @brief Subscribe to the transaction feed, only receive the feed when any of the accounts is affected.
+     * @param subscriber
+     * @param accounts The accounts to watch.
+     */
+    void
+    sub(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber);
+
     /**
      * @brief Subscribe to the transaction feed, only receive the feed when particular order book is affected.
      * @param subscriber
@@ -133,6 +217,15 @@ public:
     void
     subProposed(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber);
 
+    /**
+     * @brief Subscribe to the transaction feed for proposed accounts, only receive the feed when any of the accounts is
+     * affected.
+     * @param subscriber
+     * @param accounts The accounts to watch.
+     */
+    void
+    subProposed(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber);
+
     /**
      * @brief Unsubscribe to the transaction feed.
      * @param subscriber
@@ -148,6 +241,14 @@ public:
     void
     unsub(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber);
 
+    /**
+     * @brief Unsubscribe to the transaction for particular accounts.
+     * @param subscriber
+     * @param accounts The accounts to unsubscribe.
+     */
+    void
+    unsub(std::vector<ripple::AccountID> const& accounts, SubscriberSharedPtr const& subscriber);
+
     /**
      * @brief Unsubscribe to the transaction feed for proposed transaction stream.
      * @param subscriber
@@ -173,6 +274,10 @@ public:
 
     /**
      * @brief Publishes the transaction feed.
+     *
+     * Nothing is built if no subscriber receives the transaction and transactions are not buffered for resuming
+     * subscribers. The message for an API version is only built if a subscriber of that version receives it.
+     *
      * @param txMeta The transaction and metadata.
      * @param lgrInfo The ledger header.
      * @param backend The backend.
@@ -201,17 +306,29 @@ public:
     bookSubCount() const;
 
 private:
+    bool
+    hasSubscribers(
+        std::unordered_set<ripple::AccountID> const& affectedAccounts,
+        std::unordered_set<ripple::Book> const& affectedBooks
+    ) const;
+
+    Shard&
+    shardOf(SubscriberPtr subscriber);
+
+    bool
+    subInternal(SubscriberSharedPtr const& subscriber);
+
     void
     unsubInternal(SubscriberPtr subscriber);
 
     void
-    unsubInternal(ripple::AccountID const& account, SubscriberPtr subscriber);
+    unsubInternal(std::vector<ripple::AccountID> const& accounts, SubscriberPtr subscriber);
 
     void
-    unsubProposedInternal(SubscriberPtr subscriber);
+    unsubAccountsInternal(SubscriberPtr subscriber);
 
     void
-    unsubProposedInternal(ripple::AccountID const& account, SubscriberPtr subscriber);
+    unsubProposedInternal(SubscriberPtr subscriber);
 
     void
     unsubInternal(ripple::Book const& book, SubscriberPtr subscriber);
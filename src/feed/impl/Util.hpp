@@ -19,12 +19,18 @@
 
 #pragma once
 
+#include "feed/Types.hpp"
 #include "util/prometheus/Gauge.hpp"
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
 
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
 #include <fmt/core.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 
 namespace feed::impl {
@@ -38,4 +44,43 @@ getSubscriptionsGaugeInt(std::string const& counterName)
         fmt::format("Current subscribers number on the {} stream", counterName)
     );
 }
+
+/**
+ * @brief Get the shard a subscriber is delivered from.
+ *
+ * Subscribers are allocated with the same size, so their addresses are mixed before picking the shard to spread them
+ * evenly.
+ *
+ * @param subscriber The subscriber
+ * @param numShards The number of shards
+ * @return The index of the shard of the subscriber
+ */
+inline std::size_t
+getShardIndex(SubscriberPtr subscriber, std::size_t numShards)
+{
+    auto key = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(subscriber));
+    key ^= key >> 33u;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33u;
+    return static_cast<std::size_t>(key % numShards);
+}
+
+/**
+ * @brief Make the message telling a resuming subscriber that the messages since a ledger are no longer buffered.
+ *
+ * The subscriber is subscribed from the live messages on and has to fetch what it missed from the database.
+ *
+ * @param stream The name of the stream
+ * @param fromLedgerSeq The sequence of the ledger the subscriber asked to resume from
+ * @return The serialized message
+ */
+inline std::shared_ptr<std::string>
+makeLedgerNotBufferedMessage(std::string const& stream, std::uint32_t fromLedgerSeq)
+{
+    return std::make_shared<std::string>(boost::json::serialize(boost::json::object{
+        {"type", "ledgerNotBuffered"},
+        {"stream", stream},
+        {"resume_from_ledger", fromLedgerSeq},
+    }));
+}
 }  // namespace feed::impl
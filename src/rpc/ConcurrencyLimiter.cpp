@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/ConcurrencyLimiter.hpp"
+
+#include "util/Assert.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace rpc {
+
+namespace {
+
+std::unordered_map<std::string, std::uint32_t> const kMETHOD_COSTS{
+    {"ledger_data", 8},
+    {"account_tx", 4},
+    {"nft_history", 4},
+    {"nfts_by_issuer", 4},
+    {"mpt_holders", 4},
+    {"ledger", 2},
+    {"book_offers", 2},
+    {"account_objects", 2},
+    {"account_lines", 2},
+    {"account_offers", 2},
+    {"account_nfts", 2},
+    {"account_channels", 2},
+};
+
+constexpr double kRECENT_WEIGHT = 0.2;
+constexpr double kBASELINE_WEIGHT = 0.01;
+
+util::prometheus::CounterInt&
+shedCounter(std::string const& reason)
+{
+    return PrometheusService::counterInt(
+        "rpc_shed_requests_total_number",
+        util::prometheus::Labels({{"reason", reason}}),
+        "The number of requests rejected to keep the load within the concurrency limit"
+    );
+}
+
+}  // namespace
+
+ConcurrencyLimiter::ConcurrencyLimiter(std::uint32_t minLimit, std::uint32_t maxLimit)
+    : minLimit_{std::max<std::uint32_t>(minLimit, 1)}
+    , maxLimit_{std::max(maxLimit, minLimit_)}
+    , state_{State{.limit = static_cast<double>(maxLimit_)}}
+    , limitGauge_{PrometheusService::gaugeInt(
+          "rpc_concurrency_limit",
+          util::prometheus::Labels(),
+          "The current limit of the total cost of the requests executed at the same time"
+      )}
+    , shedLimit_{shedCounter("limit")}
+    , shedCost_{shedCounter("cost")}
+    , shedBackendTooBusy_{shedCounter("backend_too_busy")}
+{
+    limitGauge_.get().set(maxLimit_);
+}
+
+std::uint32_t
+ConcurrencyLimiter::costOf(std::string const& method)
+{
+    if (auto const it = kMETHOD_COSTS.find(method); it != kMETHOD_COSTS.end())
+        return it->second;
+    return 1;
+}
+
+std::expected<ConcurrencyLimiter::Ticket, ConcurrencyLimiter::ShedReason>
+ConcurrencyLimiter::tryAcquire(std::string const& method)
+{
+    auto const cost = costOf(method);
+    std::optional<ShedReason> reason;
+    {
+        auto state = state_.lock();
+        if (state->inFlight == 0 or state->inFlight + cost <= state->limit) {
+            state->inFlight += cost;
+            return Ticket{.cost = cost, .generation = state->generation};
+        }
+
+        reason = state->inFlight + 1 <= state->limit ? ShedReason::Cost : ShedReason::Limit;
+    }
+
+    registerShed(*reason);
+    return std::unexpected{*reason};
+}
+
+void
+ConcurrencyLimiter::release(Ticket ticket, std::chrono::microseconds latency, std::chrono::microseconds queueWait)
+{
+    auto state = state_.lock();
+    ASSERT(state->inFlight >= ticket.cost, "Released more than was acquired");
+
+    auto const sampleUs = static_cast<double>(latency.count());
+    auto& [baselineUs, recentUs] = state->latencies[ticket.cost];
+    recentUs = recentUs.has_value() ? *recentUs + kRECENT_WEIGHT * (sampleUs - *recentUs) : sampleUs;
+
+    // the baseline follows the recent latency down, so that a single fast request does not pin it, and up only slowly
+    if (not baselineUs.has_value() or *recentUs < *baselineUs) {
+        baselineUs = recentUs;
+    } else {
+        *baselineUs += kBASELINE_WEIGHT * (*recentUs - *baselineUs);
+    }
+
+    auto const slower = *recentUs > *baselineUs * kLATENCY_TOLERANCE;
+    if (slower or queueWait > kMAX_QUEUE_WAIT) {
+        decrease(*state, ticket);
+    } else if (state->inFlight * 2 >= state->limit and state->limit < maxLimit_) {
+        state->limit = std::min<double>(maxLimit_, state->limit + ticket.cost / state->limit);
+        limitGauge_.get().set(static_cast<std::int64_t>(state->limit));
+    }
+
+    state->inFlight -= ticket.cost;
+}
+
+void
+ConcurrencyLimiter::releaseOverloaded(Ticket ticket)
+{
+    auto state = state_.lock();
+    ASSERT(state->inFlight >= ticket.cost, "Released more than was acquired");
+
+    decrease(*state, ticket);
+    state->inFlight -= ticket.cost;
+}
+
+void
+ConcurrencyLimiter::registerShed(ShedReason reason)
+{
+    switch (reason) {
+        case ShedReason::Limit:
+            ++shedLimit_.get();
+            break;
+        case ShedReason::Cost:
+            ++shedCost_.get();
+            break;
+        case ShedReason::BackendTooBusy:
+            ++shedBackendTooBusy_.get();
+            break;
+    }
+}
+
+std::uint32_t
+ConcurrencyLimiter::limit() const
+{
+    return static_cast<std::uint32_t>(state_.lock()->limit);
+}
+
+std::uint32_t
+ConcurrencyLimiter::inFlight() const
+{
+    return state_.lock()->inFlight;
+}
+
+void
+ConcurrencyLimiter::decrease(State& state, Ticket ticket)
+{
+    // requests admitted before the last decrease were slowed down by the load that caused it
+    if (ticket.generation < state.generation)
+        return;
+
+    ++state.generation;
+    state.limit = std::max<double>(minLimit_, std::floor(state.limit * kBACKOFF));
+    limitGauge_.get().set(static_cast<std::int64_t>(state.limit));
+}
+
+}  // namespace rpc
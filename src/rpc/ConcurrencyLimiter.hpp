@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/Mutex.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Gauge.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace rpc {
+
+/**
+ * @brief Limits how many requests are executed at the same time, adapting the limit to how fast they are executed.
+ *
+ * Requests are weighted by cost: cheap requests cost 1, scans like `ledger_data` or `account_tx` cost more. A request
+ * is admitted if the cost of the requests being executed plus its own stays within the limit, so when the limit is
+ * almost reached expensive requests are shed first. A request is always admitted when nothing else is executed, even
+ * if its cost alone is above the limit.
+ *
+ * The limit follows AIMD (additive increase, multiplicative decrease):
+ * - It is decreased by 10% when requests get slower: when the recent latency of the requests of a cost is more than
+ *   twice the baseline latency of that cost, when requests waited too long in the work queue or when the database timed
+ *   out. Latencies are only compared within a cost, so a mix of cheap and expensive requests does not look like a
+ *   slowdown. Only requests admitted after the last decrease can cause another one, so the limit is decreased at most
+ *   once per round of requests.
+ * - Otherwise it grows by one per limit's worth of completed cost, as long as at least half of it is used.
+ */
+class ConcurrencyLimiter {
+public:
+    /** @brief Why a request was shed */
+    enum class ShedReason : std::uint8_t {
+        Limit,          /**< the limit is reached */
+        Cost,           /**< the limit leaves room for cheaper requests only */
+        BackendTooBusy  /**< the database has too many outstanding reads */
+    };
+
+    /** @brief The slot of an admitted request */
+    struct Ticket {
+        std::uint32_t cost;
+        std::uint64_t generation;  // the number of decreases before the request was admitted
+    };
+
+    static constexpr double kLATENCY_TOLERANCE = 2.0;
+    static constexpr double kBACKOFF = 0.9;
+    static constexpr std::chrono::milliseconds kMAX_QUEUE_WAIT{100};
+
+private:
+    struct Latency {
+        std::optional<double> baselineUs;
+        std::optional<double> recentUs;
+    };
+
+    struct State {
+        double limit;
+        std::uint32_t inFlight = 0;
+        std::uint64_t generation = 0;
+        std::unordered_map<std::uint32_t, Latency> latencies;  // by cost
+    };
+
+    std::uint32_t minLimit_;
+    std::uint32_t maxLimit_;
+    util::Mutex<State> state_;
+
+    std::reference_wrapper<util::prometheus::GaugeInt> limitGauge_;
+    std::reference_wrapper<util::prometheus::CounterInt> shedLimit_;
+    std::reference_wrapper<util::prometheus::CounterInt> shedCost_;
+    std::reference_wrapper<util::prometheus::CounterInt> shedBackendTooBusy_;
+
+public:
+    /**
+     * @brief Construct a new limiter; the limit starts at its maximum
+     *
+     * @param minLimit The lowest the limit can go
+     * @param maxLimit The highest the limit can go
+     */
+    ConcurrencyLimiter(std::uint32_t minLimit, std::uint32_t maxLimit);
+
+    /**
+     * @brief Get the cost of a method
+     *
+     * @param method The method
+     * @return The cost, 1 for cheap methods
+     */
+    [[nodiscard]] static std::uint32_t
+    costOf(std::string const& method);
+
+    /**
+     * @brief Admit a request if the limit allows it
+     *
+     * @param method The method of the request
+     * @return The ticket to release once the request is executed; the reason the request is shed otherwise
+     */
+    [[nodiscard]] std::expected<Ticket, ShedReason>
+    tryAcquire(std::string const& method);
+
+    /**
+     * @brief Release the slot of a request that was executed
+     *
+     * @param ticket The ticket of the request
+     * @param latency How long the request took to execute
+     * @param queueWait How long requests recently waited in the work queue
+     */
+    void
+    release(Ticket ticket, std::chrono::microseconds latency, std::chrono::microseconds queueWait);
+
+    /**
+     * @brief Release the slot of a request that failed because the database is overloaded, decreasing the limit
+     *
+     * @param ticket The ticket of the request
+     */
+    void
+    releaseOverloaded(Ticket ticket);
+
+    /**
+     * @brief Count a request shed for a reason outside the limiter
+     *
+     * @param reason The reason
+     */
+    void
+    registerShed(ShedReason reason);
+
+    /**
+     * @return The current limit
+     */
+    [[nodiscard]] std::uint32_t
+    limit() const;
+
+    /**
+     * @return The cost of the requests being executed
+     */
+    [[nodiscard]] std::uint32_t
+    inFlight() const;
+
+private:
+    void
+    decrease(State& state, Ticket ticket);
+};
+
+}  // namespace rpc
@@ -20,8 +20,11 @@
 #pragma once
 
 #include "data/BackendInterface.hpp"
+#include "rpc/ConcurrencyLimiter.hpp"
 #include "rpc/Errors.hpp"
 #include "rpc/RPCHelpers.hpp"
+#include "rpc/RequestCoalescer.hpp"
+#include "rpc/ResponseCache.hpp"
 #include "rpc/WorkQueue.hpp"
 #include "rpc/common/HandlerProvider.hpp"
 #include "rpc/common/Types.hpp"
@@ -39,6 +42,8 @@
 #include <xrpl/protocol/ErrorCodes.h>
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <memory>
@@ -68,8 +73,11 @@ class RPCEngine {
     std::shared_ptr<HandlerProvider const> handlerProvider_;
 
     impl::ForwardingProxy<LoadBalancerType, CountersType, HandlerProvider> forwardingProxy_;
+    std::optional<ConcurrencyLimiter> limiter_;
 
     std::optional<util::ResponseExpirationCache> responseCache_;
+    std::optional<ResponseCache> ledgerResponseCache_;
+    std::optional<RequestCoalescer> coalescer_;
 
 public:
     /**
@@ -110,6 +118,21 @@ public:
                 std::unordered_set<std::string>{"server_info"}
             );
         }
+
+        if (auto const maxSizeMb = config.maybeValue<uint32_t>("rpc.response_cache.max_size_mb");
+            maxSizeMb.has_value() and *maxSizeMb > 0) {
+            LOG(log_.info()) << fmt::format("Init ledger response cache, max size: {} MB", *maxSizeMb);
+            ledgerResponseCache_.emplace(static_cast<std::size_t>(*maxSizeMb) * 1024 * 1024);
+        }
+
+        if (config.get<bool>("rpc.coalesce_requests"))
+            coalescer_.emplace();
+
+        if (config.get<bool>("rpc.concurrency_limit.enabled")) {
+            limiter_.emplace(
+                config.get<uint32_t>("rpc.concurrency_limit.min"), config.get<uint32_t>("rpc.concurrency_limit.max")
+            );
+        }
     }
 
     /**
@@ -160,50 +183,19 @@ public:
                 return Result{std::move(res).value()};
         }
 
-        if (backend_->isTooBusy()) {
-            LOG(log_.error()) << "Database is too busy. Rejecting request";
-            notifyTooBusy();  // TODO: should we add ctx.method if we have it?
-            return Result{Status{RippledError::rpcTOO_BUSY}};
+        if (not ctx.isAdmin and ledgerResponseCache_) {
+            if (auto res = ledgerResponseCache_->get(ctx.method, ctx.params, ctx.apiVersion, ctx.range);
+                res.has_value())
+                return Result{std::move(res).value()};
         }
 
-        auto const method = handlerProvider_->getHandler(ctx.method);
-        if (!method) {
-            notifyUnknownCommand();
-            return Result{Status{RippledError::rpcUNKNOWN_COMMAND}};
+        if (not ctx.isAdmin and coalescer_) {
+            return coalescer_->execute(ctx.method, ctx.params, ctx.apiVersion, ctx.range, ctx.yield, [&] {
+                return execute(ctx);
+            });
         }
 
-        try {
-            LOG(perfLog_.debug()) << ctx.tag() << " start executing rpc `" << ctx.method << '`';
-
-            auto const context = Context{
-                .yield = ctx.yield,
-                .session = ctx.session,
-                .isAdmin = ctx.isAdmin,
-                .clientIp = ctx.clientIp,
-                .apiVersion = ctx.apiVersion
-            };
-            auto v = (*method).process(ctx.params, context);
-
-            LOG(perfLog_.debug()) << ctx.tag() << " finish executing rpc `" << ctx.method << '`';
-
-            if (not v) {
-                notifyErrored(ctx.method);
-            } else if (not ctx.isAdmin and responseCache_) {
-                responseCache_->put(ctx.method, v.result->as_object());
-            }
-
-            return Result{std::move(v)};
-        } catch (data::DatabaseTimeout const& t) {
-            LOG(log_.error()) << "Database timeout";
-            notifyTooBusy();
-
-            return Result{Status{RippledError::rpcTOO_BUSY}};
-        } catch (std::exception const& ex) {
-            LOG(log_.error()) << ctx.tag() << "Caught exception: " << ex.what();
-            notifyInternalError();
-
-            return Result{Status{RippledError::rpcINTERNAL}};
-        }
+        return execute(ctx);
     }
 
     /**
@@ -212,13 +204,18 @@ public:
      * @tparam FnType The type of function
      * @param func The lambda to execute when this request is handled
      * @param ip The ip address for which this request is being executed
+     * @param priority The priority of the request; requests from whitelisted IPs get at least
+     * @ref WorkQueue::Priority::Whitelisted
      * @return true if the request was successfully scheduled; false otherwise
      */
     template <typename FnType>
     bool
-    post(FnType&& func, std::string const& ip)
+    post(FnType&& func, std::string const& ip, WorkQueue::Priority priority = WorkQueue::Priority::Public)
     {
-        return workQueue_.get().postCoro(std::forward<FnType>(func), dosGuard_.get().isWhiteListed(ip));
+        if (priority != WorkQueue::Priority::Admin and dosGuard_.get().isWhiteListed(ip))
+            priority = WorkQueue::Priority::Whitelisted;
+
+        return workQueue_.get().postCoro(std::forward<FnType>(func), priority, ip);
     }
 
     /**
@@ -234,6 +231,18 @@ public:
             counters_.get().rpcComplete(method, duration);
     }
 
+    /**
+     * @brief Notify the system that a newer ledger was published, so that responses for the latest ledger expire.
+     *
+     * @param ledgerSeq The sequence of the published ledger
+     */
+    void
+    notifyLedgerPublished(std::uint32_t ledgerSeq)
+    {
+        if (ledgerResponseCache_)
+            ledgerResponseCache_->onLedgerPublished(ledgerSeq);
+    }
+
     /**
      * @brief Notify the system that specified method failed to execute due to a recoverable user error.
      *
@@ -311,6 +320,90 @@ public:
     }
 
 private:
+    Result
+    execute(web::Context const& ctx)
+    {
+        if (backend_->isTooBusy()) {
+            LOG(log_.error()) << "Database is too busy. Rejecting request";
+            notifyTooBusy();  // TODO: should we add ctx.method if we have it?
+            if (limiter_)
+                limiter_->registerShed(ConcurrencyLimiter::ShedReason::BackendTooBusy);
+            return Result{Status{RippledError::rpcTOO_BUSY}};
+        }
+
+        auto const method = handlerProvider_->getHandler(ctx.method);
+        if (!method) {
+            notifyUnknownCommand();
+            return Result{Status{RippledError::rpcUNKNOWN_COMMAND}};
+        }
+
+        // admin requests are never shed
+        std::optional<ConcurrencyLimiter::Ticket> ticket;
+        if (not ctx.isAdmin and limiter_) {
+            auto acquired = limiter_->tryAcquire(ctx.method);
+            if (not acquired.has_value()) {
+                LOG(log_.warn()) << "Concurrency limit reached. Rejecting `" << ctx.method << '`';
+                notifyTooBusy();
+                return Result{Status{RippledError::rpcTOO_BUSY}};
+            }
+            ticket = *acquired;
+        }
+
+        auto const start = std::chrono::steady_clock::now();
+        auto const release = [&](bool overloaded) {
+            if (not ticket.has_value())
+                return;
+
+            if (overloaded) {
+                limiter_->releaseOverloaded(*ticket);
+            } else {
+                auto const latency =
+                    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+                limiter_->release(*ticket, latency, workQueue_.get().recentWait());
+            }
+            ticket.reset();
+        };
+
+        try {
+            LOG(perfLog_.debug()) << ctx.tag() << " start executing rpc `" << ctx.method << '`';
+
+            auto const context = Context{
+                .yield = ctx.yield,
+                .session = ctx.session,
+                .isAdmin = ctx.isAdmin,
+                .clientIp = ctx.clientIp,
+                .apiVersion = ctx.apiVersion
+            };
+            auto v = (*method).process(ctx.params, context);
+            release(false);
+
+            LOG(perfLog_.debug()) << ctx.tag() << " finish executing rpc `" << ctx.method << '`';
+
+            if (not v) {
+                notifyErrored(ctx.method);
+            } else if (not ctx.isAdmin) {
+                if (responseCache_)
+                    responseCache_->put(ctx.method, v.result->as_object());
+                if (ledgerResponseCache_)
+                    ledgerResponseCache_->put(ctx.method, ctx.params, ctx.apiVersion, ctx.range, v.result->as_object());
+            }
+
+            return Result{std::move(v)};
+        } catch (data::DatabaseTimeout const& t) {
+            LOG(log_.error()) << "Database timeout";
+            notifyTooBusy();
+            release(true);
+
+            return Result{Status{RippledError::rpcTOO_BUSY}};
+        } catch (std::exception const& ex) {
+            LOG(log_.error()) << ctx.tag() << "Caught exception: " << ex.what();
+            notifyInternalError();
+            release(false);
+
+            return Result{Status{RippledError::rpcINTERNAL}};
+        }
+    }
+
     bool
     validHandler(std::string const& method) const
     {
@@ -54,6 +54,7 @@
 #include <xrpl/protocol/AccountID.h>
 #include <xrpl/protocol/Book.h>
 #include <xrpl/protocol/ErrorCodes.h>
+#include <xrpl/protocol/Fees.h>
 #include <xrpl/protocol/Indexes.h>
 #include <xrpl/protocol/Issue.h>
 #include <xrpl/protocol/Keylet.h>
@@ -102,6 +103,35 @@
 // local to compilation unit loggers
 namespace {
 util::Logger gLog{"RPC"};
+
+/**
+ * @brief The XRP an account can spend, i.e. its balance above the reserve.
+ *
+ * @param accountRoot The account root object
+ * @param getReserve Called with the owner count to get the reserve, unless the account is exempt from it
+ */
+template <typename ReserveGetterType>
+ripple::XRPAmount
+liquidXrp(ripple::SLE const& accountRoot, ReserveGetterType&& getReserve)
+{
+    std::uint32_t const ownerCount = accountRoot.getFieldU32(ripple::sfOwnerCount);
+
+    auto balance = accountRoot.getFieldAmount(ripple::sfBalance);
+
+    ripple::STAmount const amount = [&]() {
+        // AMM doesn't require the reserves
+        if ((accountRoot.getFlags() & ripple::lsfAMMNode) != 0u)
+            return balance;
+        auto const reserve = getReserve(ownerCount);
+        ripple::STAmount amount = balance - reserve;
+        if (balance < reserve)
+            amount.clear();
+        return amount;
+    }();
+
+    return amount.xrp();
+}
+
 }  // namespace
 
 namespace rpc {
@@ -960,22 +990,9 @@ xrpLiquid(
     ripple::SerialIter it{blob->data(), blob->size()};
     ripple::SLE const sle{it, key};
 
-    std::uint32_t const ownerCount = sle.getFieldU32(ripple::sfOwnerCount);
-
-    auto balance = sle.getFieldAmount(ripple::sfBalance);
-
-    ripple::STAmount const amount = [&]() {
-        // AMM doesn't require the reserves
-        if ((sle.getFlags() & ripple::lsfAMMNode) != 0u)
-            return balance;
-        auto const reserve = backend.fetchFees(sequence, yield)->accountReserve(ownerCount);
-        ripple::STAmount amount = balance - reserve;
-        if (balance < reserve)
-            amount.clear();
-        return amount;
-    }();
-
-    return amount.xrp();
+    return liquidXrp(sle, [&](std::uint32_t ownerCount) {
+        return backend.fetchFees(sequence, yield)->accountReserve(ownerCount);
+    });
 }
 
 ripple::STAmount
@@ -1036,6 +1053,106 @@ accountHolds(
     return amount;
 }
 
+std::vector<ripple::STAmount>
+accountHolds(
+    BackendInterface const& backend,
+    std::uint32_t sequence,
+    std::vector<ripple::AccountID> const& accounts,
+    ripple::Currency const& currency,
+    ripple::AccountID const& issuer,
+    bool const zeroIfFrozen,
+    boost::asio::yield_context yield
+)
+{
+    std::vector<ripple::STAmount> amounts;
+    amounts.reserve(accounts.size());
+    if (accounts.empty())
+        return amounts;
+
+    std::vector<ripple::uint256> keys;
+    keys.reserve(accounts.size() + 1);
+
+    if (ripple::isXRP(currency)) {
+        std::ranges::transform(accounts, std::back_inserter(keys), [](auto const& account) {
+            return ripple::keylet::account(account).key;
+        });
+        auto const blobs = backend.fetchLedgerObjects(keys, sequence, yield);
+
+        // the fees are only needed for accounts subject to the reserve, and then only once
+        std::optional<ripple::Fees> fees;
+        auto const getReserve = [&](std::uint32_t ownerCount) {
+            if (not fees.has_value())
+                fees = backend.fetchFees(sequence, yield);
+            return fees->accountReserve(ownerCount);
+        };
+
+        for (std::size_t i = 0; i < accounts.size(); ++i) {
+            if (blobs[i].empty()) {
+                amounts.emplace_back(ripple::XRPAmount{beast::zero});
+                continue;
+            }
+
+            ripple::SerialIter it{blobs[i].data(), blobs[i].size()};
+            ripple::SLE const sle{it, keys[i]};
+            amounts.emplace_back(liquidXrp(sle, getReserve));
+        }
+
+        return amounts;
+    }
+
+    // the issuer is looked up along with the trust lines, for the freeze checks done by isFrozen
+    if (zeroIfFrozen)
+        keys.push_back(ripple::keylet::account(issuer).key);
+
+    auto const firstLine = keys.size();
+    std::ranges::transform(accounts, std::back_inserter(keys), [&](auto const& account) {
+        return ripple::keylet::line(account, issuer, currency).key;
+    });
+    auto const blobs = backend.fetchLedgerObjects(keys, sequence, yield);
+
+    std::optional<bool> issuerGlobalFrozen;  // nullopt if the issuer does not exist, then nothing is frozen
+    if (zeroIfFrozen and not blobs.front().empty()) {
+        ripple::SerialIter it{blobs.front().data(), blobs.front().size()};
+        ripple::SLE const sle{it, keys.front()};
+        issuerGlobalFrozen = sle.isFlag(ripple::lsfGlobalFreeze);
+    }
+
+    for (std::size_t i = 0; i < accounts.size(); ++i) {
+        auto const& account = accounts[i];
+        auto const& blob = blobs[firstLine + i];
+
+        ripple::STAmount amount;
+        if (blob.empty()) {
+            amount.setIssue(ripple::Issue(currency, issuer));
+            amount.clear();
+            amounts.push_back(std::move(amount));
+            continue;
+        }
+
+        ripple::SerialIter it{blob.data(), blob.size()};
+        ripple::SLE const sle{it, keys[firstLine + i]};
+
+        auto const frozen = issuerGlobalFrozen.has_value() and
+            (*issuerGlobalFrozen or
+             (issuer != account and sle.isFlag((issuer > account) ? ripple::lsfHighFreeze : ripple::lsfLowFreeze)));
+
+        if (frozen) {
+            amount.setIssue(ripple::Issue(currency, issuer));
+            amount.clear();
+        } else {
+            amount = sle.getFieldAmount(ripple::sfBalance);
+            if (account > issuer) {
+                // Put balance in account terms.
+                amount.negate();
+            }
+            amount.setIssuer(issuer);
+        }
+        amounts.push_back(std::move(amount));
+    }
+
+    return amounts;
+}
+
 ripple::Rate
 transferRate(
     BackendInterface const& backend,
@@ -1077,10 +1194,33 @@ postProcessOrderBook(
 
     auto rate = transferRate(backend, ledgerSequence, book.out.account, yield);
 
+    // parse all offers up front so that the funds of every owner can be fetched at once
+    std::vector<ripple::SLE> parsedOffers;
+    parsedOffers.reserve(offers.size());
+    std::vector<ripple::AccountID> owners;
+    std::map<ripple::AccountID, ripple::STAmount> ownerFunds;
     for (auto const& obj : offers) {
         try {
             ripple::SerialIter it{obj.blob.data(), obj.blob.size()};
-            ripple::SLE const offer{it, obj.key};
+            auto const& offer = parsedOffers.emplace_back(it, obj.key);
+
+            auto const owner = offer.getAccountID(ripple::sfAccount);
+            if (not globalFreeze and book.out.account != owner and ownerFunds.emplace(owner, ripple::STAmount{}).second)
+                owners.push_back(owner);
+        } catch (std::exception const& e) {
+            LOG(gLog.error()) << "caught exception: " << e.what();
+        }
+    }
+
+    auto const funds = accountHolds(backend, ledgerSequence, owners, book.out.currency, book.out.account, true, yield);
+    for (std::size_t i = 0; i < owners.size(); ++i) {
+        auto& saOwnerFunds = ownerFunds[owners[i]] = funds[i];
+        if (saOwnerFunds < beast::zero)
+            saOwnerFunds.clear();
+    }
+
+    for (auto const& offer : parsedOffers) {
+        try {
             ripple::uint256 const bookDir = offer.getFieldH256(ripple::sfBookDirectory);
 
             auto const uOfferOwnerID = offer.getAccountID(ripple::sfAccount);
@@ -1105,12 +1245,7 @@ postProcessOrderBook(
                     saOwnerFunds = umBalanceEntry->second;
                     firstOwnerOffer = false;
                 } else {
-                    saOwnerFunds = accountHolds(
-                        backend, ledgerSequence, uOfferOwnerID, book.out.currency, book.out.account, true, yield
-                    );
-
-                    if (saOwnerFunds < beast::zero)
-                        saOwnerFunds.clear();
+                    saOwnerFunds = ownerFunds.at(uOfferOwnerID);
                 }
             }
 
@@ -1392,4 +1527,32 @@ toJsonWithBinaryTx(data::TransactionAndMetadata const& txnPlusMeta, std::uint32_
     return obj;
 }
 
+void
+insertLedgerHeaderInfo(
+    BackendInterface const& backend,
+    boost::json::array& transactions,
+    boost::asio::yield_context yield
+)
+{
+    std::vector<std::uint32_t> sequences;
+    sequences.reserve(transactions.size());
+    for (auto const& txn : transactions)
+        sequences.push_back(boost::json::value_to<std::uint32_t>(txn.at(JS(ledger_index))));
+
+    std::ranges::sort(sequences);
+    auto const duplicates = std::ranges::unique(sequences);
+    sequences.erase(duplicates.begin(), duplicates.end());
+
+    auto const headers = backend.fetchLedgersBySequence(sequences, yield);
+    for (auto& txn : transactions) {
+        auto& obj = txn.as_object();
+        auto const sequence = boost::json::value_to<std::uint32_t>(obj.at(JS(ledger_index)));
+        auto const it = std::ranges::lower_bound(sequences, sequence);
+        if (auto const& header = headers[std::distance(sequences.begin(), it)]; header.has_value()) {
+            obj[JS(ledger_hash)] = ripple::strHex(header->hash);
+            obj[JS(close_time_iso)] = ripple::to_string_iso(header->closeTime);
+        }
+    }
+}
+
 }  // namespace rpc
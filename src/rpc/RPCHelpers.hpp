@@ -165,6 +165,20 @@ toExpandedJson(
 boost::json::object
 toJsonWithBinaryTx(data::TransactionAndMetadata const& txnPlusMeta, std::uint32_t apiVersion);
 
+/**
+ * @brief Add "ledger_hash" and "close_time_iso" of the ledger that included the transaction to each transaction json.
+ * The headers of all the ledgers involved are fetched in one batch.
+ * @param backend The backend to use
+ * @param transactions The transaction json objects, each with a "ledger_index" field
+ * @param yield The coroutine context
+ */
+void
+insertLedgerHeaderInfo(
+    BackendInterface const& backend,
+    boost::json::array& transactions,
+    boost::asio::yield_context yield
+);
+
 /**
  * @brief Add "DeliverMax" which is the alias of "Amount" for "Payment" transaction to transaction json. Remove the
  * "Amount" field when version is greater than 1
@@ -469,6 +483,32 @@ accountHolds(
     boost::asio::yield_context yield
 );
 
+/**
+ * @brief Get the amounts that several accounts hold of the same asset
+ *
+ * Gives the same results as calling @ref accountHolds for each account, but looks up all the accounts, and the issuer
+ * if needed, with a single call to the backend.
+ *
+ * @param backend The backend to use
+ * @param sequence The sequence
+ * @param accounts The accounts
+ * @param currency The currency
+ * @param issuer The issuer
+ * @param zeroIfFrozen Whether to return zero if frozen
+ * @param yield The coroutine context
+ * @return The amount each account holds, in the order of the accounts
+ */
+std::vector<ripple::STAmount>
+accountHolds(
+    BackendInterface const& backend,
+    std::uint32_t sequence,
+    std::vector<ripple::AccountID> const& accounts,
+    ripple::Currency const& currency,
+    ripple::AccountID const& issuer,
+    bool zeroIfFrozen,
+    boost::asio::yield_context yield
+);
+
 /**
  * @brief Get the transfer rate
  *
@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/RequestCoalescer.hpp"
+
+#include "rpc/common/Types.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <boost/asio/spawn.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace rpc {
+
+std::unordered_set<std::string> const RequestCoalescer::kDEFAULT_METHODS{
+    "account_info", "amm_info", "book_offers", "ledger", "ledger_entry"
+};
+
+RequestCoalescer::RequestCoalescer(std::unordered_set<std::string> const& methods)
+{
+    for (auto const& method : methods) {
+        coalesced_.emplace(
+            method,
+            PrometheusService::counterInt(
+                "rpc_coalesced_requests_total_number",
+                util::prometheus::Labels({{"method", method}}),
+                "Requests answered with the result of an identical request that was already executing"
+            )
+        );
+    }
+}
+
+std::size_t
+RequestCoalescer::inFlight() const
+{
+    return flights_.lock()->size();
+}
+
+std::pair<std::shared_ptr<RequestCoalescer::Flight>, bool>
+RequestCoalescer::join(std::string const& key)
+{
+    auto flights = flights_.lock();
+    if (auto const it = flights->find(key); it != flights->end())
+        return {it->second, false};
+
+    auto flight = std::make_shared<Flight>();
+    flights->emplace(key, flight);
+    return {std::move(flight), true};
+}
+
+std::optional<Result>
+RequestCoalescer::await(Flight& flight, boost::asio::yield_context yield)
+{
+    std::shared_ptr<Channel> channel;
+    {
+        auto const lock = flights_.lock();
+        if (not flight.landed) {
+            channel = std::make_shared<Channel>(yield.get_executor(), 1);
+            flight.waiters.push_back(channel);
+        }
+    }
+
+    if (channel != nullptr) {
+        boost::system::error_code error;
+        channel->async_receive(yield[error]);
+    }
+
+    // the result is never changed once the flight has landed
+    return flight.result;
+}
+
+void
+RequestCoalescer::land(
+    std::string const& key,
+    std::shared_ptr<Flight> const& flight,
+    std::optional<Result> const& result
+)
+{
+    std::vector<std::shared_ptr<Channel>> waiters;
+    {
+        auto flights = flights_.lock();
+        flights->erase(key);
+        flight->result = result;
+        flight->landed = true;
+        waiters = std::move(flight->waiters);
+    }
+
+    for (auto const& waiter : waiters)
+        waiter->try_send(boost::system::error_code{});
+}
+
+}  // namespace rpc
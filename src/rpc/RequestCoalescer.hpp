@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+#include "rpc/RequestKey.hpp"
+#include "rpc/common/Types.hpp"
+#include "util/Mutex.hpp"
+#include "util/prometheus/Counter.hpp"
+
+#include <boost/asio/experimental/concurrent_channel.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/json/object.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace rpc {
+
+/**
+ * @brief Lets identical requests that are handled at the same time share one execution.
+ *
+ * The first request for a @ref RequestKey executes; requests with the same key that arrive while it is still running
+ * wait for it and get a copy of its result instead of reading the same data from the database again. Only successful
+ * results are shared; if the execution fails, each waiting request executes on its own. Nothing is kept once the
+ * execution finishes, so unlike @ref ResponseCache this never returns a result computed before the request was made.
+ */
+class RequestCoalescer {
+public:
+    /** @brief The methods coalesced by default */
+    static std::unordered_set<std::string> const kDEFAULT_METHODS;
+
+private:
+    using Channel = boost::asio::experimental::concurrent_channel<void(boost::system::error_code)>;
+
+    struct Flight {
+        bool landed = false;
+        std::optional<Result> result;  // not set if the execution failed or threw
+        std::vector<std::shared_ptr<Channel>> waiters;
+    };
+
+    using Flights = std::unordered_map<std::string, std::shared_ptr<Flight>>;
+
+    std::unordered_map<std::string, std::reference_wrapper<util::prometheus::CounterInt>> coalesced_;
+    util::Mutex<Flights> flights_;
+
+public:
+    /**
+     * @brief Construct a new coalescer
+     *
+     * @param methods The methods to coalesce; only methods whose result only depends on the request and the ledger may
+     * be coalesced
+     */
+    explicit RequestCoalescer(std::unordered_set<std::string> const& methods = kDEFAULT_METHODS);
+
+    /**
+     * @brief Execute a request, or wait for the identical request that is already executing
+     *
+     * @tparam FnType The type of the function executing the request
+     * @param method The method of the request
+     * @param params The parameters of the request
+     * @param apiVersion The API version of the request
+     * @param range The ledger range available at the time of the request
+     * @param yield The coroutine context to wait in
+     * @param fn The function executing the request
+     * @return The result of the request
+     */
+    template <typename FnType>
+        requires std::invocable<FnType> and std::same_as<std::invoke_result_t<FnType>, Result>
+    Result
+    execute(
+        std::string const& method,
+        boost::json::object const& params,
+        std::uint32_t apiVersion,
+        data::LedgerRange const& range,
+        boost::asio::yield_context yield,
+        FnType&& fn
+    )
+    {
+        auto const coalesced = coalesced_.find(method);
+        if (coalesced == coalesced_.end())
+            return fn();
+
+        auto const key = RequestKey::make(method, params, apiVersion, range);
+        if (not key.has_value())
+            return fn();
+
+        auto const [flight, leader] = join(key->value);
+        if (not leader) {
+            if (auto result = await(*flight, yield); result.has_value()) {
+                ++coalesced->second.get();
+                return std::move(result).value();
+            }
+
+            // the execution we waited for failed or threw, so try on our own
+            return fn();
+        }
+
+        std::optional<Result> result;
+        try {
+            result.emplace(fn());
+        } catch (...) {
+            land(key->value, flight, std::nullopt);
+            throw;
+        }
+
+        // an error may be specific to the moment it happened, so the requests waiting execute on their own instead
+        land(key->value, flight, result->response.has_value() ? result : std::nullopt);
+        return std::move(result).value();
+    }
+
+    /**
+     * @return The number of requests being executed that others can join
+     */
+    [[nodiscard]] std::size_t
+    inFlight() const;
+
+private:
+    /**
+     * @return The flight for the key, and whether the caller is the one to execute it
+     */
+    std::pair<std::shared_ptr<Flight>, bool>
+    join(std::string const& key);
+
+    std::optional<Result>
+    await(Flight& flight, boost::asio::yield_context yield);
+
+    void
+    land(std::string const& key, std::shared_ptr<Flight> const& flight, std::optional<Result> const& result);
+};
+
+}  // namespace rpc
@@ -0,0 +1,151 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/RequestKey.hpp"
+
+#include "data/Types.hpp"
+#include "rpc/JS.hpp"
+
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/json/value.hpp>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace rpc {
+
+namespace {
+
+// parts of a request that are not passed to the handler or that are part of the key on their own
+constexpr std::array<std::string_view, 6> kIGNORED_FIELDS{
+    "id", "command", "method", "api_version", "jsonrpc", "ripplerpc"
+};
+
+void
+appendCanonical(std::string& out, boost::json::value const& value);
+
+void
+appendCanonical(std::string& out, boost::json::object const& object, bool topLevel)
+{
+    std::vector<boost::json::key_value_pair const*> fields;
+    fields.reserve(object.size());
+    for (auto const& field : object) {
+        auto const ignored = field.key() == JS(ledger_index) or
+            std::ranges::find(kIGNORED_FIELDS, std::string_view{field.key()}) != kIGNORED_FIELDS.end();
+        if (topLevel and ignored)
+            continue;
+        fields.push_back(&field);
+    }
+    std::ranges::sort(fields, {}, [](auto const* field) { return field->key(); });
+
+    out += '{';
+    for (auto const* field : fields) {
+        out += boost::json::serialize(field->key());
+        out += ':';
+        appendCanonical(out, field->value());
+        out += ',';
+    }
+    out += '}';
+}
+
+void
+appendCanonical(std::string& out, boost::json::value const& value)
+{
+    if (value.is_object()) {
+        appendCanonical(out, value.as_object(), false);
+    } else if (value.is_array()) {
+        out += '[';
+        for (auto const& item : value.as_array()) {
+            appendCanonical(out, item);
+            out += ',';
+        }
+        out += ']';
+    } else {
+        out += boost::json::serialize(value);
+    }
+}
+
+}  // namespace
+
+std::optional<RequestKey>
+RequestKey::make(
+    std::string const& method,
+    boost::json::object const& params,
+    std::uint32_t apiVersion,
+    data::LedgerRange const& range
+)
+{
+    RequestKey key;
+    std::string pinnedBy;
+    auto const ledgerIndex = params.find(JS(ledger_index));
+
+    if (params.contains(JS(ledger_hash))) {
+        // the hash names the ledger; the ledger_index, if any, is left to the handler
+        if (ledgerIndex != params.end())
+            appendCanonical(pinnedBy, ledgerIndex->value());
+    } else if (ledgerIndex == params.end() or
+               (ledgerIndex->value().is_string() and ledgerIndex->value().as_string() == "validated")) {
+        key.ledgerSeq = range.maxSequence;
+        key.latest = true;
+    } else if (auto const seq = parseLedgerIndex(ledgerIndex->value());
+               seq.has_value() and *seq >= range.minSequence and *seq <= range.maxSequence) {
+        key.ledgerSeq = seq;
+    } else {
+        // invalid or not available ledgers are left to the handler to report
+        return std::nullopt;
+    }
+
+    key.value = fmt::format(
+        "{}|{}|{}{}|{}|", method, apiVersion, key.latest ? "latest:" : "", key.ledgerSeq.value_or(0), pinnedBy
+    );
+    appendCanonical(key.value, params, true);
+    return key;
+}
+
+std::optional<std::uint32_t>
+RequestKey::parseLedgerIndex(boost::json::value const& value)
+{
+    if (value.is_uint64() and value.as_uint64() <= std::numeric_limits<std::uint32_t>::max())
+        return static_cast<std::uint32_t>(value.as_uint64());
+
+    if (value.is_int64() and value.as_int64() >= 0 and value.as_int64() <= std::numeric_limits<std::uint32_t>::max())
+        return static_cast<std::uint32_t>(value.as_int64());
+
+    if (value.is_string()) {
+        auto const& str = value.as_string();
+        std::uint32_t seq = 0;
+        auto const [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), seq);
+        if (ec == std::errc{} and ptr == str.data() + str.size())
+            return seq;
+    }
+
+    return std::nullopt;
+}
+
+}  // namespace rpc
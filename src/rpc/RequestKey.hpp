@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+
+#include <boost/json/object.hpp>
+#include <boost/json/value.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace rpc {
+
+/**
+ * @brief Identifies the requests that get the same response, as long as the method only depends on the ledger.
+ *
+ * Two requests have the same key if they have the same method, API version and parameters, and resolve to the same
+ * ledger. The order of parameters and fields that are not passed to the handler, like `id`, do not matter.
+ */
+struct RequestKey {
+    std::string value;
+
+    /** @brief The ledger the request resolves to; std::nullopt if it is named by hash */
+    std::optional<std::uint32_t> ledgerSeq;
+
+    /** @brief Whether the request is for the latest validated ledger rather than a specific one */
+    bool latest = false;
+
+    /**
+     * @brief Build the key of a request
+     *
+     * @param method The method of the request
+     * @param params The parameters of the request
+     * @param apiVersion The API version of the request
+     * @param range The ledger range available at the time of the request
+     * @return The key, or std::nullopt if the request names a ledger that is invalid or not available
+     */
+    static std::optional<RequestKey>
+    make(
+        std::string const& method,
+        boost::json::object const& params,
+        std::uint32_t apiVersion,
+        data::LedgerRange const& range
+    );
+
+    /**
+     * @brief Parse a `ledger_index` given as a number or a numeric string
+     *
+     * @param value The value of the `ledger_index` field
+     * @return The ledger sequence, or std::nullopt if the value is not a valid sequence
+     */
+    static std::optional<std::uint32_t>
+    parseLedgerIndex(boost::json::value const& value);
+};
+
+}  // namespace rpc
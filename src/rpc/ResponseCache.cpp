@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/ResponseCache.hpp"
+
+#include "data/Types.hpp"
+#include "rpc/JS.hpp"
+#include "rpc/RequestKey.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/json/value.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+namespace rpc {
+
+std::unordered_set<std::string> const ResponseCache::kDEFAULT_METHODS{
+    "account_info", "amm_info", "book_offers", "ledger"
+};
+
+ResponseCache::ResponseCache(std::size_t maxBytes, std::unordered_set<std::string> const& methods)
+    : maxBytes_{maxBytes}
+    , sizeBytes_{PrometheusService::gaugeInt(
+          "rpc_response_cache_size_bytes",
+          util::prometheus::Labels(),
+          "The total size of the responses in the rpc response cache"
+      )}
+{
+    for (auto const& method : methods) {
+        auto const counter = [&method](std::string const& type) -> util::prometheus::CounterInt& {
+            return PrometheusService::counterInt(
+                "rpc_response_cache_total_number",
+                util::prometheus::Labels({{"method", method}, {"type", type}}),
+                "Hits, misses and evictions of the rpc response cache"
+            );
+        };
+        counters_.emplace(
+            method, MethodCounters{.hit = counter("hit"), .miss = counter("miss"), .eviction = counter("eviction")}
+        );
+    }
+}
+
+std::optional<boost::json::object>
+ResponseCache::get(
+    std::string const& method,
+    boost::json::object const& params,
+    std::uint32_t apiVersion,
+    data::LedgerRange const& range
+)
+{
+    auto const counters = counters_.find(method);
+    if (counters == counters_.end())
+        return std::nullopt;
+
+    std::shared_ptr<boost::json::object const> response;
+    if (auto const key = RequestKey::make(method, params, apiVersion, range); key.has_value()) {
+        auto state = state_.lock();
+        dropLatest(*state, range.maxSequence);
+
+        if (auto const it = state->index.find(key->value); it != state->index.end()) {
+            auto const entry = it->second;
+            if (entry->ledgerSeq.has_value() and *entry->ledgerSeq < range.minSequence) {
+                // the ledger was removed from the database by online deletion
+                erase(*state, entry);
+            } else {
+                state->lru.splice(state->lru.begin(), state->lru, entry);
+                response = entry->response;
+            }
+        }
+    }
+
+    if (response == nullptr) {
+        ++counters->second.miss.get();
+        return std::nullopt;
+    }
+
+    ++counters->second.hit.get();
+    return *response;
+}
+
+void
+ResponseCache::put(
+    std::string const& method,
+    boost::json::object const& params,
+    std::uint32_t apiVersion,
+    data::LedgerRange const& range,
+    boost::json::object const& response
+)
+{
+    auto const counters = counters_.find(method);
+    if (counters == counters_.end())
+        return;
+
+    auto key = RequestKey::make(method, params, apiVersion, range);
+    if (not key.has_value())
+        return;
+
+    std::optional<std::uint32_t> responseSeq;
+    if (auto const it = response.find(JS(ledger_index)); it != response.end())
+        responseSeq = RequestKey::parseLedgerIndex(it->value());
+
+    // a ledger published while the request was being handled may have been picked instead of the one in the key
+    if (key->ledgerSeq.has_value() and responseSeq.has_value() and *key->ledgerSeq != *responseSeq)
+        return;
+
+    auto const bytes = boost::json::serialize(response).size() + key->value.size();
+    if (bytes > maxBytes_)
+        return;
+
+    auto state = state_.lock();
+    dropLatest(*state, range.maxSequence);
+    if (key->latest and *key->ledgerSeq < state->latestSeq)
+        return;
+
+    if (auto const it = state->index.find(key->value); it != state->index.end())
+        erase(*state, it->second);
+
+    state->lru.push_front(Entry{
+        .key = std::move(key->value),
+        .counters = &counters->second,
+        .response = std::make_shared<boost::json::object const>(response),
+        .bytes = bytes,
+        .ledgerSeq = key->ledgerSeq.has_value() ? key->ledgerSeq : responseSeq,
+        .latest = key->latest
+    });
+    state->index.emplace(state->lru.front().key, state->lru.begin());
+    if (state->lru.front().latest)
+        state->latest.emplace(state->lru.front().key);
+    state->bytes += bytes;
+
+    while (state->bytes > maxBytes_) {
+        auto const victim = std::prev(state->lru.end());
+        ++victim->counters->eviction.get();
+        erase(*state, victim);
+    }
+
+    sizeBytes_.get().set(static_cast<std::int64_t>(state->bytes));
+}
+
+void
+ResponseCache::onLedgerPublished(std::uint32_t latestSeq)
+{
+    auto state = state_.lock();
+    dropLatest(*state, latestSeq);
+}
+
+std::size_t
+ResponseCache::sizeBytes() const
+{
+    return state_.lock()->bytes;
+}
+
+void
+ResponseCache::dropLatest(State& state, std::uint32_t latestSeq)
+{
+    if (latestSeq <= state.latestSeq)
+        return;
+
+    state.latestSeq = latestSeq;
+
+    // entries for an older latest ledger are never added, so all of them are for the ledger that was the latest so far
+    auto const latest = std::exchange(state.latest, {});
+    for (auto const key : latest)
+        erase(state, state.index.at(key));
+    sizeBytes_.get().set(static_cast<std::int64_t>(state.bytes));
+}
+
+void
+ResponseCache::erase(State& state, Entries::iterator it)
+{
+    state.bytes -= it->bytes;
+    if (it->latest)
+        state.latest.erase(it->key);
+    state.index.erase(it->key);
+    state.lru.erase(it);
+}
+
+}  // namespace rpc
@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+#include "util/Mutex.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Gauge.hpp"
+
+#include <boost/json/object.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace rpc {
+
+/**
+ * @brief Cache of responses to read-only requests that only depend on the ledger they are made against.
+ *
+ * Responses are keyed by method, API version, the request's parameters (with the order of keys and fields that do not
+ * change the response, like `id`, ignored) and the ledger the request resolves to:
+ * - Requests that name a ledger by sequence or hash are pinned to that ledger. A validated ledger never changes, so
+ *   these entries never expire; they are only evicted to stay within the byte budget or once the ledger is no longer
+ *   in the database.
+ * - Requests for the latest validated ledger are keyed by the sequence of the latest ledger at the time of the
+ *   request. All of them are dropped as soon as a newer ledger is published and the ledger range moves on.
+ *
+ * Only successful responses are cached. The least recently used entries are evicted once the responses take more than
+ * the byte budget.
+ */
+class ResponseCache {
+public:
+    /** @brief The methods cached by default */
+    static std::unordered_set<std::string> const kDEFAULT_METHODS;
+
+private:
+    struct MethodCounters {
+        std::reference_wrapper<util::prometheus::CounterInt> hit;
+        std::reference_wrapper<util::prometheus::CounterInt> miss;
+        std::reference_wrapper<util::prometheus::CounterInt> eviction;
+    };
+
+    struct Entry {
+        std::string key;
+        MethodCounters const* counters = nullptr;
+        std::shared_ptr<boost::json::object const> response;
+        std::size_t bytes = 0;
+        std::optional<std::uint32_t> ledgerSeq;
+        bool latest = false;
+    };
+
+    using Entries = std::list<Entry>;
+
+    struct State {
+        Entries lru;  // most recently used first
+        std::unordered_map<std::string_view, Entries::iterator> index;
+        std::unordered_set<std::string_view> latest;  // the keys of the entries for the latest ledger
+        std::size_t bytes = 0;
+        std::uint32_t latestSeq = 0;
+    };
+
+    std::size_t maxBytes_;
+    std::unordered_map<std::string, MethodCounters> counters_;
+    util::Mutex<State> state_;
+
+    std::reference_wrapper<util::prometheus::GaugeInt> sizeBytes_;
+
+public:
+    /**
+     * @brief Construct a new cache
+     *
+     * @param maxBytes The maximum total size of the cached responses
+     * @param methods The methods to cache
+     */
+    ResponseCache(std::size_t maxBytes, std::unordered_set<std::string> const& methods = kDEFAULT_METHODS);
+
+    /**
+     * @brief Get the cached response to a request
+     *
+     * @param method The method of the request
+     * @param params The parameters of the request
+     * @param apiVersion The API version of the request
+     * @param range The ledger range available at the time of the request
+     * @return The response if it is cached; std::nullopt otherwise
+     */
+    [[nodiscard]] std::optional<boost::json::object>
+    get(std::string const& method,
+        boost::json::object const& params,
+        std::uint32_t apiVersion,
+        data::LedgerRange const& range);
+
+    /**
+     * @brief Cache the successful response to a request, if the method is cached
+     *
+     * @param method The method of the request
+     * @param params The parameters of the request
+     * @param apiVersion The API version of the request
+     * @param range The ledger range available at the time of the request; the same that was passed to @ref get
+     * @param response The response
+     */
+    void
+    put(std::string const& method,
+        boost::json::object const& params,
+        std::uint32_t apiVersion,
+        data::LedgerRange const& range,
+        boost::json::object const& response);
+
+    /**
+     * @brief Drop the responses for the latest ledger if a newer ledger was published
+     *
+     * Called by the ledger publisher, so the memory is freed as soon as the ledger range moves on. @ref get and
+     * @ref put also call it with the latest ledger they see.
+     *
+     * @param latestSeq The sequence of the latest validated ledger
+     */
+    void
+    onLedgerPublished(std::uint32_t latestSeq);
+
+    /**
+     * @return The total size of the cached responses
+     */
+    [[nodiscard]] std::size_t
+    sizeBytes() const;
+
+private:
+    void
+    dropLatest(State& state, std::uint32_t latestSeq);
+
+    void
+    erase(State& state, Entries::iterator it);
+};
+
+}  // namespace rpc
@@ -19,19 +19,37 @@
 
 #include "rpc/WorkQueue.hpp"
 
+#include "util/Assert.hpp"
 #include "util/log/Logger.hpp"
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
 
+#include <boost/asio/spawn.hpp>
 #include <boost/json/object.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace rpc {
 
+namespace {
+
+std::vector<std::int64_t> const kWAIT_BUCKETS_US{100, 1'000, 10'000, 100'000, 1'000'000};
+
+// the share of the workers each class gets is proportional to 1 / stride
+constexpr std::array<std::uint64_t, 4> kSTRIDES{1, 2, 4, 8};
+constexpr std::array<char const*, 4> kPRIORITY_NAMES{"admin", "whitelisted", "subscription", "public"};
+constexpr double kRECENT_WAIT_WEIGHT = 0.1;
+
+}  // namespace
+
 void
 WorkQueue::OneTimeCallable::setCallable(std::function<void()> func)
 {
@@ -71,6 +89,19 @@ WorkQueue::WorkQueue(std::uint32_t numWorkers, uint32_t maxSize)
 {
     if (maxSize != 0)
         maxSize_ = maxSize;
+
+    for (auto const* name : kPRIORITY_NAMES) {
+        waitUs_.emplace_back(PrometheusService::histogramInt(
+            "work_queue_wait_duration_us_histogram",
+            util::prometheus::Labels({{"priority", name}}),
+            kWAIT_BUCKETS_US,
+            "The number of microseconds tasks were waiting to be executed"
+        ));
+    }
+
+    auto scheduler = scheduler_.lock();
+    for (auto& priorityClass : scheduler->classes)
+        priorityClass.waitBuckets.resize(kWAIT_BUCKETS_US.size() + 1);
 }
 
 WorkQueue::~WorkQueue()
@@ -111,9 +142,38 @@ WorkQueue::report() const
     obj["current_queue_size"] = curSize_.get().value();
     obj["max_queue_size"] = maxSize_;
 
+    boost::json::object priorities;
+    auto const scheduler = scheduler_.lock();
+    for (std::size_t idx = 0; idx < kNUM_PRIORITIES; ++idx) {
+        auto const& priorityClass = scheduler->classes[idx];
+
+        // cumulative, like the buckets of the prometheus histogram
+        boost::json::object waitHistogram;
+        std::uint64_t count = 0;
+        for (std::size_t bucket = 0; bucket < priorityClass.waitBuckets.size(); ++bucket) {
+            count += priorityClass.waitBuckets[bucket];
+            auto const bound = bucket < kWAIT_BUCKETS_US.size() ? std::to_string(kWAIT_BUCKETS_US[bucket]) : "+Inf";
+            waitHistogram[bound] = count;
+        }
+
+        priorities[kPRIORITY_NAMES[idx]] = boost::json::object{
+            {"queued", priorityClass.queued},
+            {"queued_duration_us", priorityClass.waitUs},
+            {"current_queue_size", priorityClass.size},
+            {"wait_us_histogram", std::move(waitHistogram)}
+        };
+    }
+    obj["priorities"] = std::move(priorities);
+
     return obj;
 }
 
+std::chrono::microseconds
+WorkQueue::recentWait() const
+{
+    return std::chrono::microseconds{static_cast<std::int64_t>(scheduler_.lock()->recentWaitUs)};
+}
+
 void
 WorkQueue::join()
 {
@@ -126,4 +186,115 @@ WorkQueue::size() const
     return curSize_.get().value();
 }
 
+void
+WorkQueue::enqueue(Job job, Priority priority, std::string const& client)
+{
+    auto scheduler = scheduler_.lock();
+    auto& priorityClass = scheduler->classes[static_cast<std::size_t>(priority)];
+
+    // an idle class or client does not save up service to use later
+    if (priorityClass.size == 0)
+        priorityClass.pass = std::max(priorityClass.pass, scheduler->pass);
+
+    auto& [id, state] = *priorityClass.clients.try_emplace(client).first;
+    if (state.jobs.empty()) {
+        state.serviceUs = std::max(state.serviceUs, priorityClass.virtualTimeUs);
+        state.readyKey = {state.serviceUs, priorityClass.nextOrder++, &id};
+        priorityClass.ready.insert(state.readyKey);
+    }
+
+    state.jobs.push_back(QueuedJob{.func = std::move(job), .queuedAt = std::chrono::system_clock::now()});
+    ++priorityClass.size;
+}
+
+WorkQueue::Dequeued
+WorkQueue::dequeue()
+{
+    auto scheduler = scheduler_.lock();
+
+    std::size_t next = kNUM_PRIORITIES;
+    for (std::size_t idx = 0; idx < kNUM_PRIORITIES; ++idx) {
+        auto const& priorityClass = scheduler->classes[idx];
+        if (priorityClass.size > 0 and (next == kNUM_PRIORITIES or priorityClass.pass < scheduler->classes[next].pass))
+            next = idx;
+    }
+    ASSERT(next != kNUM_PRIORITIES, "Every job is dequeued by the job posted along with it");
+
+    auto& priorityClass = scheduler->classes[next];
+    scheduler->pass = priorityClass.pass;
+    priorityClass.pass += kSTRIDES[next];
+    --priorityClass.size;
+
+    auto const* id = std::get<std::string const*>(*priorityClass.ready.begin());
+    priorityClass.ready.erase(priorityClass.ready.begin());
+
+    auto& client = priorityClass.clients.at(*id);
+    priorityClass.virtualTimeUs = client.serviceUs;
+    auto job = std::move(client.jobs.front());
+    client.jobs.pop_front();
+    ++client.running;
+
+    // clients with the same service take turns
+    if (not client.jobs.empty()) {
+        client.readyKey = {client.serviceUs, priorityClass.nextOrder++, id};
+        priorityClass.ready.insert(client.readyKey);
+    }
+
+    auto const waitUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - job.queuedAt).count();
+    auto const bucket = std::ranges::lower_bound(kWAIT_BUCKETS_US, waitUs) - kWAIT_BUCKETS_US.begin();
+    ++priorityClass.queued;
+    priorityClass.waitUs += static_cast<std::uint64_t>(waitUs);
+    ++priorityClass.waitBuckets[bucket];
+    scheduler->recentWaitUs += kRECENT_WAIT_WEIGHT * (static_cast<double>(waitUs) - scheduler->recentWaitUs);
+
+    return Dequeued{
+        .func = std::move(job.func), .priority = static_cast<Priority>(next), .client = id, .waitUs = waitUs
+    };
+}
+
+void
+WorkQueue::complete(Dequeued const& job, std::uint64_t durationUs)
+{
+    auto scheduler = scheduler_.lock();
+    auto& priorityClass = scheduler->classes[static_cast<std::size_t>(job.priority)];
+
+    auto const it = priorityClass.clients.find(*job.client);
+    auto& client = it->second;
+    --client.running;
+    client.serviceUs += durationUs;
+
+    if (not client.jobs.empty()) {
+        priorityClass.ready.erase(client.readyKey);
+        std::get<0>(client.readyKey) = client.serviceUs;
+        priorityClass.ready.insert(client.readyKey);
+    } else if (client.running == 0) {
+        priorityClass.clients.erase(it);
+    }
+}
+
+void
+WorkQueue::runNext(boost::asio::yield_context yield)
+{
+    auto const job = dequeue();
+
+    ++queued_.get();
+    durationUs_.get() += job.waitUs;
+    waitUs_[static_cast<std::size_t>(job.priority)].get().observe(job.waitUs);
+    LOG(log_.info()) << "WorkQueue wait time = " << job.waitUs << " queue size = " << curSize_.get().value();
+
+    auto const start = std::chrono::steady_clock::now();
+    job.func(yield);
+    auto const durationUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    complete(job, static_cast<std::uint64_t>(durationUs));
+
+    --curSize_.get();
+    if (curSize_.get().value() == 0 && stopping_) {
+        auto onTasksComplete = onQueueEmpty_.lock();
+        ASSERT(onTasksComplete->operator bool(), "onTasksComplete must be set when stopping is true.");
+        onTasksComplete->operator()();
+    }
+}
+
 }  // namespace rpc
@@ -24,6 +24,7 @@
 #include "util/newconfig/ConfigDefinition.hpp"
 #include "util/prometheus/Counter.hpp"
 #include "util/prometheus/Gauge.hpp"
+#include "util/prometheus/Histogram.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/asio/spawn.hpp>
@@ -31,27 +32,97 @@
 #include <boost/json.hpp>
 #include <boost/json/object.hpp>
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <limits>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace rpc {
 
 /**
  * @brief An asynchronous, thread-safe queue for RPC requests.
+ *
+ * Jobs are not run in the order they were queued. Every job belongs to a priority class and to a client (the IP it
+ * came from):
+ * - The classes share the workers by weight: whenever a worker is free, the class that got the least service relative
+ *   to its weight runs next, so lower classes are slowed down but never starved.
+ * - Within a class, the client whose jobs took the least time so far runs next, so a client sending expensive
+ *   requests (e.g. `ledger_data` or `account_tx` scans) only delays its own requests, not cheap requests of others.
+ *
+ * Clients are charged the time their jobs actually took rather than a static weight per method. Both servers parse the
+ * request inside the job, so its method is not known yet when the job is queued, and the measured time also tells a
+ * cheap `account_tx` from a long scan.
  */
 class WorkQueue {
+public:
+    /** @brief The priority classes of jobs, from the highest to the lowest */
+    enum class Priority : std::uint8_t { Admin, Whitelisted, Subscription, Public };
+
+private:
+    static constexpr std::size_t kNUM_PRIORITIES = 4;
+
+    using Job = std::function<void(boost::asio::yield_context)>;  // so the queued callables must be copyable
+    using ReadyKey = std::tuple<std::uint64_t, std::uint64_t, std::string const*>;  // service, order, client
+
+    struct QueuedJob {
+        Job func;
+        std::chrono::system_clock::time_point queuedAt;
+    };
+
+    struct Client {
+        std::deque<QueuedJob> jobs;
+        std::uint64_t serviceUs = 0;  // the time the jobs of the client took so far
+        std::size_t running = 0;
+        ReadyKey readyKey;
+    };
+
+    struct PriorityClass {
+        std::unordered_map<std::string, Client> clients;
+        std::set<ReadyKey> ready;  // the clients with queued jobs, least served first
+        std::uint64_t virtualTimeUs = 0;  // the service of the client that got a job run last
+        std::uint64_t nextOrder = 0;
+        std::uint64_t pass = 0;  // the service of the class, relative to its weight
+        std::size_t size = 0;
+
+        // these are cumulative for the lifetime of the process
+        std::uint64_t queued = 0;
+        std::uint64_t waitUs = 0;
+        std::vector<std::uint64_t> waitBuckets;
+    };
+
+    struct Scheduler {
+        std::array<PriorityClass, kNUM_PRIORITIES> classes;
+        std::uint64_t pass = 0;  // the pass of the class that got a job run last
+        double recentWaitUs = 0;
+    };
+
+    struct Dequeued {
+        Job func;
+        Priority priority;
+        std::string const* client;  // the key of the client in its class; valid while the job is running
+        std::int64_t waitUs;
+    };
+
     // these are cumulative for the lifetime of the process
     std::reference_wrapper<util::prometheus::CounterInt> queued_;
     std::reference_wrapper<util::prometheus::CounterInt> durationUs_;
+    std::vector<std::reference_wrapper<util::prometheus::HistogramInt>> waitUs_;
 
     std::reference_wrapper<util::prometheus::GaugeInt> curSize_;
     uint32_t maxSize_ = std::numeric_limits<uint32_t>::max();
 
     util::Logger log_{"RPC"};
+    util::Mutex<Scheduler> scheduler_;
     boost::asio::thread_pool ioc_;
 
     std::atomic_bool stopping_;
@@ -111,41 +182,44 @@ public:
     template <typename FnType>
     bool
     postCoro(FnType&& func, bool isWhiteListed)
+    {
+        return postCoro(std::forward<FnType>(func), isWhiteListed ? Priority::Whitelisted : Priority::Public, "");
+    }
+
+    /**
+     * @brief Submit a job of a client to the work queue.
+     *
+     * The job will be rejected if it is a @ref Priority::Subscription or @ref Priority::Public job and the current size
+     * of the queue reached capacity.
+     *
+     * @tparam FnType The function object type; must be copyable, as jobs are kept in a `std::function`
+     * @param func The function object to queue as a job
+     * @param priority The priority class of the job
+     * @param client The client the job is run for, e.g. its IP
+     * @return true if the job was successfully queued; false otherwise
+     */
+    template <typename FnType>
+    bool
+    postCoro(FnType&& func, Priority priority, std::string const& client)
     {
         if (stopping_) {
             LOG(log_.warn()) << "Queue is stopping, rejecting incoming task.";
             return false;
         }
 
-        if (curSize_.get().value() >= maxSize_ && !isWhiteListed) {
+        auto const limited = priority == Priority::Subscription or priority == Priority::Public;
+        if (limited && curSize_.get().value() >= maxSize_) {
             LOG(log_.warn()) << "Queue is full. rejecting job. current size = " << curSize_.get().value()
                              << "; max size = " << maxSize_;
             return false;
         }
 
         ++curSize_.get();
+        enqueue(Job{std::forward<FnType>(func)}, priority, client);
 
-        // Each time we enqueue a job, we want to post a symmetrical job that will dequeue and run the job at the front
-        // of the job queue.
-        boost::asio::spawn(
-            ioc_,
-            [this, func = std::forward<FnType>(func), start = std::chrono::system_clock::now()](auto yield) mutable {
-                auto const run = std::chrono::system_clock::now();
-                auto const wait = std::chrono::duration_cast<std::chrono::microseconds>(run - start).count();
-
-                ++queued_.get();
-                durationUs_.get() += wait;
-                LOG(log_.info()) << "WorkQueue wait time = " << wait << " queue size = " << curSize_.get().value();
-
-                func(yield);
-                --curSize_.get();
-                if (curSize_.get().value() == 0 && stopping_) {
-                    auto onTasksComplete = onQueueEmpty_.lock();
-                    ASSERT(onTasksComplete->operator bool(), "onTasksComplete must be set when stopping is true.");
-                    onTasksComplete->operator()();
-                }
-            }
-        );
+        // Each time we enqueue a job, we want to post a symmetrical job that will dequeue and run the job that is next
+        // in line, which is not necessarily the job that was just queued.
+        boost::asio::spawn(ioc_, [this](boost::asio::yield_context yield) { runNext(yield); });
 
         return true;
     }
@@ -158,6 +232,14 @@ public:
     boost::json::object
     report() const;
 
+    /**
+     * @brief Get how long jobs recently waited in the queue.
+     *
+     * @return The moving average of the wait time of the jobs that were run last
+     */
+    std::chrono::microseconds
+    recentWait() const;
+
     /**
      * @brief Wait until all the jobs in the queue are finished.
      */
@@ -171,6 +253,19 @@ public:
      */
     size_t
     size() const;
+
+private:
+    void
+    enqueue(Job job, Priority priority, std::string const& client);
+
+    Dequeued
+    dequeue();
+
+    void
+    complete(Dequeued const& job, std::uint64_t durationUs);
+
+    void
+    runNext(boost::asio::yield_context yield);
 };
 
 }  // namespace rpc
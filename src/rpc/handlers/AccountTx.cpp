@@ -35,8 +35,6 @@
 #include <boost/json/value.hpp>
 #include <boost/json/value_from.hpp>
 #include <boost/json/value_to.hpp>
-#include <xrpl/basics/chrono.h>
-#include <xrpl/basics/strHex.h>
 #include <xrpl/protocol/AccountID.h>
 #include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/jss.h>
@@ -172,12 +170,6 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
                         obj[JS(hash)] = obj[txKey].as_object()[JS(hash)];
                         obj[txKey].as_object().erase(JS(hash));
                     }
-                    if (auto const ledgerHeader =
-                            sharedPtrBackend_->fetchLedgerBySequence(txnPlusMeta.ledgerSequence, ctx.yield);
-                        ledgerHeader) {
-                        obj[JS(ledger_hash)] = ripple::strHex(ledgerHeader->hash);
-                        obj[JS(close_time_iso)] = ripple::to_string_iso(ledgerHeader->closeTime);
-                    }
                 }
                 obj[JS(validated)] = true;
                 response.transactions.push_back(std::move(obj));
@@ -191,6 +183,10 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
         response.transactions.push_back(std::move(obj));
     }
 
+    // only the expanded transactions of API v2 refer to their ledger header
+    if (!input.binary && ctx.apiVersion >= 2u)
+        insertLedgerHeaderInfo(*sharedPtrBackend_, response.transactions, ctx.yield);
+
     response.limit = input.limit;
     response.account = ripple::to_string(*accountID);
     response.ledgerIndexMin = minIndex;
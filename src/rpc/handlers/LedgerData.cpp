@@ -130,8 +130,9 @@ LedgerDataHandler::process(Input input, Context const& ctx) const
 
     output.states.reserve(results.size());
 
-    for (auto const& [key, object] : results) {
+    for (auto& [key, object] : results) {
         ripple::STLedgerEntry const sle{ripple::SerialIter{object.data(), object.size()}, key};
+        data::Blob{}.swap(object);  // so the page is not held both fetched and converted
 
         // note the filter is after limit is applied, same as rippled
         if (input.type == ripple::LedgerEntryType::ltANY || sle.getType() == input.type) {
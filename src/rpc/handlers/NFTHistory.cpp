@@ -34,8 +34,6 @@
 #include <boost/json/value_from.hpp>
 #include <boost/json/value_to.hpp>
 #include <xrpl/basics/base_uint.h>
-#include <xrpl/basics/chrono.h>
-#include <xrpl/basics/strHex.h>
 #include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/jss.h>
 
@@ -144,12 +142,6 @@ NFTHistoryHandler::process(NFTHistoryHandler::Input input, Context const& ctx) c
                     obj[JS(hash)] = obj[txKey].at(JS(hash));
                     obj[txKey].as_object().erase(JS(hash));
                 }
-                if (auto const lgrInfo =
-                        sharedPtrBackend_->fetchLedgerBySequence(txnPlusMeta.ledgerSequence, ctx.yield);
-                    lgrInfo) {
-                    obj[JS(close_time_iso)] = ripple::to_string_iso(lgrInfo->closeTime);
-                    obj[JS(ledger_hash)] = ripple::strHex(lgrInfo->hash);
-                }
             }
         } else {
             obj = toJsonWithBinaryTx(txnPlusMeta, ctx.apiVersion);
@@ -161,6 +153,10 @@ NFTHistoryHandler::process(NFTHistoryHandler::Input input, Context const& ctx) c
         response.transactions.push_back(obj);
     }
 
+    // only the expanded transactions of API v2 refer to their ledger header
+    if (!input.binary && ctx.apiVersion > 1u)
+        insertLedgerHeaderInfo(*sharedPtrBackend_, response.transactions, ctx.yield);
+
     response.limit = input.limit;
     response.nftID = ripple::to_string(tokenID);
     response.ledgerIndexMin = minIndex;
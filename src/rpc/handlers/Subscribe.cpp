@@ -40,6 +40,7 @@
 #include <boost/json/value.hpp>
 #include <boost/json/value_to.hpp>
 #include <xrpl/beast/utility/Zero.h>
+#include <xrpl/protocol/AccountID.h>
 #include <xrpl/protocol/Book.h>
 #include <xrpl/protocol/jss.h>
 
@@ -102,6 +103,7 @@ SubscribeHandler::spec([[maybe_unused]] uint32_t apiVersion)
         {JS(accounts), validation::CustomValidators::subscribeAccountsValidator},
         {JS(accounts_proposed), validation::CustomValidators::subscribeAccountsValidator},
         {JS(books), kBOOKS_VALIDATOR},
+        {"resume_from_ledger", validation::Type<uint32_t>{}},
         {"user", check::Deprecated{}},
         {JS(password), check::Deprecated{}},
         {JS(rt_accounts), check::Deprecated{}}
@@ -118,8 +120,12 @@ SubscribeHandler::process(Input input, Context const& ctx) const
     // Mimic rippled. No matter what the request is, the api version changes for the whole session
     ctx.session->setApiSubversion(ctx.apiVersion);
 
+    // fail before subscribing anything, so the client can backfill the missed ledgers and subscribe again
+    if (input.resumeFromLedger and not subscriptions_->canResumeFrom(*input.resumeFromLedger))
+        return Error{Status{RippledError::rpcLGR_NOT_FOUND, "ledgerNotBuffered"}};
+
     if (input.streams) {
-        auto const ledger = subscribeToStreams(ctx.yield, *(input.streams), ctx.session);
+        auto const ledger = subscribeToStreams(ctx.yield, *(input.streams), input.resumeFromLedger, ctx.session);
         if (!ledger.empty())
             output.ledger = ledger;
     }
@@ -140,6 +146,7 @@ boost::json::object
 SubscribeHandler::subscribeToStreams(
     boost::asio::yield_context yield,
     std::vector<std::string> const& streams,
+    std::optional<std::uint32_t> resumeFromLedger,
     feed::SubscriberSharedPtr const& session
 ) const
 {
@@ -147,9 +154,14 @@ SubscribeHandler::subscribeToStreams(
 
     for (auto const& stream : streams) {
         if (stream == "ledger") {
-            response = subscriptions_->subLedger(yield, session);
+            response = resumeFromLedger ? subscriptions_->resumeLedger(yield, *resumeFromLedger, session)
+                                        : subscriptions_->subLedger(yield, session);
         } else if (stream == "transactions") {
-            subscriptions_->subTransactions(session);
+            if (resumeFromLedger) {
+                subscriptions_->resumeTransactions(*resumeFromLedger, session);
+            } else {
+                subscriptions_->subTransactions(session);
+            }
         } else if (stream == "transactions_proposed") {
             subscriptions_->subProposedTransactions(session);
         } else if (stream == "validations") {
@@ -157,7 +169,11 @@ SubscribeHandler::subscribeToStreams(
         } else if (stream == "manifests") {
             subscriptions_->subManifest(session);
         } else if (stream == "book_changes") {
-            subscriptions_->subBookChanges(session);
+            if (resumeFromLedger) {
+                subscriptions_->resumeBookChanges(*resumeFromLedger, session);
+            } else {
+                subscriptions_->subBookChanges(session);
+            }
         }
     }
 
@@ -170,10 +186,12 @@ SubscribeHandler::subscribeToAccountsProposed(
     feed::SubscriberSharedPtr const& session
 ) const
 {
-    for (auto const& account : accounts) {
-        auto const accountID = accountFromStringStrict(account);
-        subscriptions_->subProposedAccount(*accountID, session);
-    }
+    std::vector<ripple::AccountID> accountIDs;
+    accountIDs.reserve(accounts.size());
+    for (auto const& account : accounts)
+        accountIDs.push_back(*accountFromStringStrict(account));
+
+    subscriptions_->subProposedAccounts(accountIDs, session);
 }
 
 void
@@ -182,10 +200,12 @@ SubscribeHandler::subscribeToAccounts(
     feed::SubscriberSharedPtr const& session
 ) const
 {
-    for (auto const& account : accounts) {
-        auto const accountID = accountFromStringStrict(account);
-        subscriptions_->subAccount(*accountID, session);
-    }
+    std::vector<ripple::AccountID> accountIDs;
+    accountIDs.reserve(accounts.size());
+    for (auto const& account : accounts)
+        accountIDs.push_back(*accountFromStringStrict(account));
+
+    subscriptions_->subAccounts(accountIDs, session);
 }
 
 void
@@ -279,6 +299,9 @@ tag_invoke(boost::json::value_to_tag<SubscribeHandler::Input>, boost::json::valu
             input.accountsProposed->push_back(boost::json::value_to<std::string>(account));
     }
 
+    if (jsonObject.contains("resume_from_ledger"))
+        input.resumeFromLedger = jsonObject.at("resume_from_ledger").as_int64();
+
     if (auto const& books = jsonObject.find(JS(books)); books != jsonObject.end()) {
         input.books = std::vector<SubscribeHandler::OrderBook>();
         for (auto const& book : books->value().as_array()) {
@@ -90,6 +90,8 @@ public:
         std::optional<std::vector<std::string>> streams;
         std::optional<std::vector<std::string>> accountsProposed;
         std::optional<std::vector<OrderBook>> books;
+        // the ledger, transactions and book_changes streams replay what was published since this ledger
+        std::optional<std::uint32_t> resumeFromLedger;
     };
 
     using Result = HandlerReturnType<Output>;
@@ -129,6 +131,7 @@ private:
     subscribeToStreams(
         boost::asio::yield_context yield,
         std::vector<std::string> const& streams,
+        std::optional<std::uint32_t> resumeFromLedger,
         feed::SubscriberSharedPtr const& session
     ) const;
 
@@ -33,6 +33,7 @@
 #include <boost/json/conversion.hpp>
 #include <boost/json/value.hpp>
 #include <boost/json/value_to.hpp>
+#include <xrpl/protocol/AccountID.h>
 #include <xrpl/protocol/Book.h>
 #include <xrpl/protocol/jss.h>
 
@@ -133,10 +134,12 @@ void
 UnsubscribeHandler::unsubscribeFromAccounts(std::vector<std::string> accounts, feed::SubscriberSharedPtr const& session)
     const
 {
-    for (auto const& account : accounts) {
-        auto const accountID = accountFromStringStrict(account);
-        subscriptions_->unsubAccount(*accountID, session);
-    }
+    std::vector<ripple::AccountID> accountIDs;
+    accountIDs.reserve(accounts.size());
+    for (auto const& account : accounts)
+        accountIDs.push_back(*accountFromStringStrict(account));
+
+    subscriptions_->unsubAccounts(accountIDs, session);
 }
 
 void
@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/JsonArenaPool.hpp"
+
+#include <boost/json/storage_ptr.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace util {
+
+JsonArenaPool::Arena::Arena(std::size_t size, boost::json::storage_ptr upstream)
+    : block{std::make_unique_for_overwrite<unsigned char[]>(size)}, resource{block.get(), size, std::move(upstream)}
+{
+}
+
+JsonArenaPool::Lease::Lease(JsonArenaPool& pool, std::unique_ptr<Arena> arena)
+    : pool_{&pool}, arena_{std::move(arena)}
+{
+}
+
+JsonArenaPool::Lease::~Lease()
+{
+    if (arena_ != nullptr)
+        pool_->release(std::move(arena_));
+}
+
+boost::json::storage_ptr
+JsonArenaPool::Lease::storage() const
+{
+    return boost::json::storage_ptr{&arena_->resource};
+}
+
+JsonArenaPool::JsonArenaPool(std::size_t blockSize, std::size_t maxIdle, boost::json::storage_ptr upstream)
+    : blockSize_{blockSize}, maxIdle_{maxIdle}, upstream_{std::move(upstream)}
+{
+}
+
+JsonArenaPool::Lease
+JsonArenaPool::acquire()
+{
+    {
+        auto idle = idle_.lock();
+        if (not idle->empty()) {
+            auto arena = std::move(idle->back());
+            idle->pop_back();
+            return Lease{*this, std::move(arena)};
+        }
+    }
+
+    return Lease{*this, std::make_unique<Arena>(blockSize_, upstream_)};
+}
+
+std::size_t
+JsonArenaPool::idle() const
+{
+    return idle_.lock()->size();
+}
+
+void
+JsonArenaPool::release(std::unique_ptr<Arena> arena)
+{
+    // frees the blocks allocated past the first one and starts over at the beginning of the first
+    arena->resource.release();
+
+    auto idle = idle_.lock();
+    if (idle->size() < maxIdle_)
+        idle->push_back(std::move(arena));
+}
+
+}  // namespace util
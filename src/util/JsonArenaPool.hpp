@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/Mutex.hpp"
+
+#include <boost/json/monotonic_resource.hpp>
+#include <boost/json/storage_ptr.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace util {
+
+/**
+ * @brief A pool of memory arenas for short-lived JSON values, such as parsed requests.
+ *
+ * Every arena is a boost::json::monotonic_resource over a preallocated block: allocating from it only bumps a pointer
+ * and nothing is freed until the arena goes back to the pool. An arena is leased for the duration of one request and
+ * then reused by later ones, so parsing a request of usual size does not touch the global heap at all.
+ */
+class JsonArenaPool {
+    struct Arena {
+        std::unique_ptr<unsigned char[]> block;
+        boost::json::monotonic_resource resource;
+
+        Arena(std::size_t size, boost::json::storage_ptr upstream);
+    };
+
+    std::size_t blockSize_;
+    std::size_t maxIdle_;
+    boost::json::storage_ptr upstream_;
+    util::Mutex<std::vector<std::unique_ptr<Arena>>> idle_;
+
+public:
+    /** @brief The default size of the block an arena starts with */
+    static constexpr std::size_t kDEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    /** @brief The default number of arenas kept for reuse */
+    static constexpr std::size_t kDEFAULT_MAX_IDLE = 64;
+
+    /**
+     * @brief The lease of an arena; the arena goes back to the pool when the lease is destroyed.
+     */
+    class Lease {
+        JsonArenaPool* pool_;
+        std::unique_ptr<Arena> arena_;
+
+        friend class JsonArenaPool;
+
+        Lease(JsonArenaPool& pool, std::unique_ptr<Arena> arena);
+
+    public:
+        ~Lease();
+
+        Lease(Lease&&) = default;
+        Lease(Lease const&) = delete;
+
+        Lease&
+        operator=(Lease&&) = delete;
+
+        Lease&
+        operator=(Lease const&) = delete;
+
+        /**
+         * @brief Get the storage to create JSON values in.
+         *
+         * @note The values must not outlive the lease. Copies of a JSON value use the storage of the original, so they
+         * must not outlive it either.
+         * @return The storage of the arena
+         */
+        [[nodiscard]] boost::json::storage_ptr
+        storage() const;
+    };
+
+    /**
+     * @brief Construct a new pool
+     *
+     * @param blockSize The size of the block every arena starts with; an arena allocates more blocks if it needs to
+     * @param maxIdle The maximum number of arenas kept for reuse
+     * @param upstream The storage the arenas allocate their further blocks from
+     */
+    explicit JsonArenaPool(
+        std::size_t blockSize = kDEFAULT_BLOCK_SIZE,
+        std::size_t maxIdle = kDEFAULT_MAX_IDLE,
+        boost::json::storage_ptr upstream = {}
+    );
+
+    /**
+     * @brief Lease an arena, reusing an idle one if there is any
+     *
+     * @return The lease
+     */
+    [[nodiscard]] Lease
+    acquire();
+
+    /**
+     * @return The number of arenas waiting for reuse
+     */
+    [[nodiscard]] std::size_t
+    idle() const;
+
+private:
+    void
+    release(std::unique_ptr<Arena> arena);
+};
+
+}  // namespace util
@@ -356,6 +356,7 @@ static constinit OneOf gValidateProcessingPolicy{"server.processing_policy", kPR
 static constinit PositiveDouble gValidatePositiveDouble{};
 
 static constinit NumberValueConstraint<uint32_t> gValidateNumMarkers{1, 256};
+static constinit NumberValueConstraint<uint32_t> gValidateCompressionLevel{1, 9};
 static constinit NumberValueConstraint<uint32_t> gValidateIOThreads{1, std::numeric_limits<uint16_t>::max()};
 
 static constinit NumberValueConstraint<uint16_t> gValidateUint16{
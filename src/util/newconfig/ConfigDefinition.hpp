@@ -328,6 +328,12 @@ static ClioConfigDefinition gClioConfig = ClioConfigDefinition{
       ConfigValue{ConfigType::Double}.defaultValue(10.0).withConstraint(gValidatePositiveDouble)},
 
      {"rpc.cache_timeout", ConfigValue{ConfigType::Double}.defaultValue(0.0).withConstraint(gValidatePositiveDouble)},
+     {"rpc.response_cache.max_size_mb", ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateUint32)},
+     {"rpc.coalesce_requests", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+     {"rpc.concurrency_limit.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+     {"rpc.concurrency_limit.min", ConfigValue{ConfigType::Integer}.defaultValue(16).withConstraint(gValidateUint32)},
+     {"rpc.concurrency_limit.max", ConfigValue{ConfigType::Integer}.defaultValue(1024).withConstraint(gValidateUint32)},
+     {"rpc.max_batch_size", ConfigValue{ConfigType::Integer}.defaultValue(32).withConstraint(gValidateUint32)},
 
      {"num_markers", ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateNumMarkers)},
 
@@ -354,6 +360,11 @@ static ClioConfigDefinition gClioConfig = ClioConfigDefinition{
      {"server.ws_max_sending_queue_size",
       ConfigValue{ConfigType::Integer}.defaultValue(1500).withConstraint(gValidateUint32)},
      {"server.__ng_web_server", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+     {"server.compression.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+     {"server.compression.level",
+      ConfigValue{ConfigType::Integer}.defaultValue(6).withConstraint(gValidateCompressionLevel)},
+     {"server.compression.min_size",
+      ConfigValue{ConfigType::Integer}.defaultValue(1024).withConstraint(gValidateUint32)},
 
      {"prometheus.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(true)},
      {"prometheus.compress_reply", ConfigValue{ConfigType::Boolean}.defaultValue(true)},
@@ -361,6 +372,7 @@ static ClioConfigDefinition gClioConfig = ClioConfigDefinition{
      {"io_threads", ConfigValue{ConfigType::Integer}.defaultValue(2).withConstraint(gValidateIOThreads)},
 
      {"subscription_workers", ConfigValue{ConfigType::Integer}.defaultValue(1).withConstraint(gValidateUint32)},
+     {"subscription_replay_ledgers", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(gValidateUint32)},
 
      {"graceful_period", ConfigValue{ConfigType::Double}.defaultValue(10.0).withConstraint(gValidatePositiveDouble)},
 
@@ -371,6 +383,10 @@ static ClioConfigDefinition gClioConfig = ClioConfigDefinition{
      },
      {"cache.page_fetch_size", ConfigValue{ConfigType::Integer}.defaultValue(512).withConstraint(gValidateUint16)},
      {"cache.load", ConfigValue{ConfigType::String}.defaultValue("async").withConstraint(gValidateLoadMode)},
+     {"cache.max_size_mb", ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateUint32)},
+     {"cache.file.path", ConfigValue{ConfigType::String}.optional()},
+     {"cache.file.max_sequence_age",
+      ConfigValue{ConfigType::Integer}.defaultValue(5000).withConstraint(gValidateUint32)},
 
      {"log_channels.[].channel", Array{ConfigValue{ConfigType::String}.optional().withConstraint(gValidateChannelName)}
      },
@@ -107,14 +107,31 @@ private:
         KV{.key = "forwarding.request_timeout",
            .value = "Timeout duration for the forwarding request used in Rippled communication."},
         KV{.key = "rpc.cache_timeout", .value = "Timeout duration for the rpc request."},
+        KV{.key = "rpc.response_cache.max_size_mb",
+           .value = "If set, responses to account_info, amm_info, book_offers and ledger are cached per ledger, "
+                    "within this many megabytes."},
+        KV{.key = "rpc.coalesce_requests",
+           .value = "If true, identical requests handled at the same time share one execution."},
+        KV{.key = "rpc.concurrency_limit.enabled",
+           .value = "If true, requests are shed once the adaptive limit of their total cost is reached."},
+        KV{.key = "rpc.concurrency_limit.min",
+           .value = "The lowest the adaptive limit of the total cost of requests executed at the same time can go."},
+        KV{.key = "rpc.concurrency_limit.max",
+           .value = "The highest the adaptive limit of the total cost of requests executed at the same time can go."},
+        KV{.key = "rpc.max_batch_size",
+           .value = "The maximum number of requests in a JSON-RPC batch sent over HTTP. 0 disables batches."},
         KV{.key = "num_markers",
            .value = "The number of markers is the number of coroutines to load the cache concurrently."},
         KV{.key = "dos_guard.[].whitelist", .value = "List of IP addresses to whitelist for DOS protection."},
-        KV{.key = "dos_guard.max_fetches", .value = "Maximum number of fetch operations allowed by DOS guard."},
+        KV{.key = "dos_guard.max_fetches",
+           .value = "Maximum number of fetch operations allowed by DOS guard per sweep interval."},
         KV{.key = "dos_guard.max_connections", .value = "Maximum number of concurrent connections allowed by DOS guard."
         },
-        KV{.key = "dos_guard.max_requests", .value = "Maximum number of requests allowed by DOS guard."},
-        KV{.key = "dos_guard.sweep_interval", .value = "Interval in seconds for DOS guard to sweep/clear its state."},
+        KV{.key = "dos_guard.max_requests",
+           .value = "Maximum number of requests allowed by DOS guard per sweep interval."},
+        KV{.key = "dos_guard.sweep_interval",
+           .value = "Interval in seconds over which DOS guard drains the fetch and request counts of a client, and for "
+                    "forgetting idle clients."},
         KV{.key = "workers", .value = "Number of threads to process RPC requests."},
         KV{.key = "server.ip", .value = "IP address of the Clio HTTP server."},
         KV{.key = "server.port", .value = "Port number of the Clio HTTP server."},
@@ -131,12 +148,23 @@ private:
          "parallel". It limits the number of requests for a single client connection that are processed in parallel. If not specified, the limit is infinite.)"
         },
         KV{.key = "server.ws_max_sending_queue_size", .value = "Maximum size of the websocket sending queue."},
+        KV{.key = "server.compression.enabled",
+           .value = "Compress responses with gzip or deflate for HTTP and permessage-deflate for websocket, if the client "
+                    "supports it."},
+        KV{.key = "server.compression.level", .value = "Compression level, from 1 (fastest) to 9 (smallest)."},
+        KV{.key = "server.compression.min_size",
+           .value = "Responses smaller than this number of bytes are not compressed."},
         KV{.key = "prometheus.enabled", .value = "Enable or disable Prometheus metrics."},
         KV{.key = "prometheus.compress_reply", .value = "Enable or disable compression of Prometheus responses."},
         KV{.key = "io_threads", .value = "Number of I/O threads. Value must be greater than 1"},
         KV{.key = "subscription_workers",
            .value = "The number of worker threads or processes that are responsible for managing and processing "
-                    "subscription-based tasks."},
+                    "subscription-based tasks. The subscribers of each stream are split across the workers, so that "
+                    "publishing to many subscribers happens in parallel."},
+        KV{.key = "subscription_replay_ledgers",
+           .value = "The number of most recent ledgers whose ledger, transactions and book_changes stream messages are "
+                    "kept in memory, so that a subscriber can resume these streams from a ledger it missed. 0 disables "
+                    "resuming."},
         KV{.key = "graceful_period", .value = "Number of milliseconds server will wait to shutdown gracefully."},
         KV{.key = "cache.num_diffs", .value = "Number of diffs to cache."},
         KV{.key = "cache.num_markers", .value = "Number of markers to cache."},
@@ -144,6 +172,14 @@ private:
         KV{.key = "cache.num_cursors_from_account", .value = "Number of cursors from an account."},
         KV{.key = "cache.page_fetch_size", .value = "Page fetch size for cache operations."},
         KV{.key = "cache.load", .value = "Cache loading strategy ('sync' or 'async')."},
+        KV{.key = "cache.max_size_mb",
+           .value = "If set, only the most frequently used ledger objects are cached, within this many megabytes, "
+                    "instead of the full ledger. Successor lookups then always go to the database."},
+        KV{.key = "cache.file.path",
+           .value = "Path of the file the cache is saved to on shutdown and loaded from on startup. Like the database "
+                    "load, the file load runs in the background unless `cache.load` is `sync`."},
+        KV{.key = "cache.file.max_sequence_age",
+           .value = "Max number of ledgers the cache file can be behind the database to be loaded."},
         KV{.key = "log_channels.[].channel", .value = "Name of the log channel."},
         KV{.key = "log_channels.[].log_level", .value = "Log level for the log channel."},
         KV{.key = "log_level", .value = "General logging level of Clio."},
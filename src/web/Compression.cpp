@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/Compression.hpp"
+
+#include "util/Assert.hpp"
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/beast/websocket/option.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace web {
+
+namespace {
+
+util::prometheus::CounterInt&
+bytesCounter(std::string const& type)
+{
+    return PrometheusService::counterInt(
+        "web_compression_bytes_total_number",
+        util::prometheus::Labels({{"type", type}}),
+        "Bytes of the HTTP responses before and after compression"
+    );
+}
+
+/** @return true if the parameters of a coding in Accept-Encoding have a zero quality value, i.e. reject it */
+bool
+isRejected(std::string_view params)
+{
+    auto const q = params.find("q=");
+    if (q == std::string_view::npos)
+        return false;
+
+    auto const value = boost::algorithm::trim_copy(params.substr(q + 2));
+    return not value.empty() and value.find_first_not_of("0.") == std::string_view::npos;
+}
+
+}  // namespace
+
+Compression::Stream::Stream(
+    Encoding encoding,
+    int level,
+    util::prometheus::CounterInt& originalBytes,
+    util::prometheus::CounterInt& compressedBytes
+)
+    : originalBytes_(originalBytes), compressedBytes_(compressedBytes)
+{
+    if (encoding == Encoding::Gzip) {
+        stream_.push(boost::iostreams::gzip_compressor{boost::iostreams::gzip_params{level}});
+    } else {
+        stream_.push(boost::iostreams::zlib_compressor{boost::iostreams::zlib_params{level}});
+    }
+    stream_.push(boost::iostreams::back_inserter(output_));
+}
+
+void
+Compression::Stream::write(std::string_view data, std::string& out)
+{
+    stream_.write(data.data(), static_cast<std::streamsize>(data.size()));
+    originalBytes_.get() += static_cast<std::int64_t>(data.size());
+    take(out);
+}
+
+void
+Compression::Stream::finish(std::string& out)
+{
+    stream_.reset();
+    take(out);
+}
+
+void
+Compression::Stream::take(std::string& out)
+{
+    compressedBytes_.get() += static_cast<std::int64_t>(output_.size());
+    out.append(output_);
+    output_.clear();
+}
+
+Compression::Compression(util::config::ClioConfigDefinition const& config)
+    : enabled_(config.get<bool>("server.compression.enabled"))
+    , level_(config.get<int>("server.compression.level"))
+    , minSize_(config.get<std::size_t>("server.compression.min_size"))
+{
+    if (enabled_)
+        counters_.emplace(bytesCounter("uncompressed"), bytesCounter("compressed"));
+}
+
+std::optional<Compression::Encoding>
+Compression::negotiate(std::string_view acceptEncoding, std::size_t size) const
+{
+    if (not enabled_ or size < minSize_)
+        return std::nullopt;
+
+    bool gzip = false;
+    bool deflate = false;
+    while (not acceptEncoding.empty()) {
+        auto const end = acceptEncoding.find(',');
+        auto coding = acceptEncoding.substr(0, end);
+        acceptEncoding = end == std::string_view::npos ? std::string_view{} : acceptEncoding.substr(end + 1);
+
+        std::string_view params;
+        if (auto const separator = coding.find(';'); separator != std::string_view::npos) {
+            params = coding.substr(separator + 1);
+            coding = coding.substr(0, separator);
+        }
+        if (isRejected(params))
+            continue;
+
+        auto const name = boost::algorithm::trim_copy(coding);
+        if (boost::algorithm::iequals(name, "gzip") or boost::algorithm::iequals(name, "x-gzip") or name == "*") {
+            gzip = true;
+        } else if (boost::algorithm::iequals(name, "deflate")) {
+            deflate = true;
+        }
+    }
+
+    if (gzip)
+        return Encoding::Gzip;
+    if (deflate)
+        return Encoding::Deflate;
+    return std::nullopt;
+}
+
+std::string
+Compression::compress(std::string_view data, Encoding encoding) const
+{
+    std::string out;
+    auto stream = makeStream(encoding);
+    stream->write(data, out);
+    stream->finish(out);
+    return out;
+}
+
+std::unique_ptr<Compression::Stream>
+Compression::makeStream(Encoding encoding) const
+{
+    ASSERT(counters_.has_value(), "Compression is disabled");
+    return std::make_unique<Stream>(encoding, level_, counters_->originalBytes, counters_->compressedBytes);
+}
+
+boost::beast::websocket::permessage_deflate
+Compression::permessageDeflate() const
+{
+    boost::beast::websocket::permessage_deflate options;
+    options.server_enable = enabled_;
+    options.compLevel = level_;
+    options.msg_size_threshold = minSize_;
+    return options;
+}
+
+std::string_view
+Compression::toString(Encoding encoding)
+{
+    return encoding == Encoding::Gzip ? "gzip" : "deflate";
+}
+
+}  // namespace web
@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/prometheus/Counter.hpp"
+
+#include <boost/beast/websocket/option.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace web {
+
+/**
+ * @brief Compression of the responses sent to clients, configured in the `server.compression` section.
+ *
+ * HTTP responses are compressed with gzip or deflate, whichever the client accepts, and web socket messages with the
+ * permessage-deflate extension if the client offers it. Responses smaller than `server.compression.min_size` are sent
+ * as they are.
+ */
+class Compression {
+public:
+    /** @brief The content codings a response can be compressed with */
+    enum class Encoding { Gzip, Deflate };
+
+    /**
+     * @brief Compresses a response that is written piece by piece, e.g. one sent with chunked transfer encoding.
+     */
+    class Stream {
+        std::string output_;
+        boost::iostreams::filtering_ostream stream_;
+        std::reference_wrapper<util::prometheus::CounterInt> originalBytes_;
+        std::reference_wrapper<util::prometheus::CounterInt> compressedBytes_;
+
+    public:
+        /**
+         * @brief Construct a new stream
+         *
+         * @param encoding The content coding to compress with
+         * @param level The compression level
+         * @param originalBytes The counter of the bytes before compression
+         * @param compressedBytes The counter of the bytes after compression
+         */
+        Stream(
+            Encoding encoding,
+            int level,
+            util::prometheus::CounterInt& originalBytes,
+            util::prometheus::CounterInt& compressedBytes
+        );
+
+        Stream(Stream const&) = delete;
+        Stream(Stream&&) = delete;
+        Stream&
+        operator=(Stream const&) = delete;
+        Stream&
+        operator=(Stream&&) = delete;
+        ~Stream() = default;
+
+        /**
+         * @brief Compress the next piece of the response
+         *
+         * The compressor keeps some data until it has enough to compress, so the output may be empty.
+         *
+         * @param data The piece to compress
+         * @param out The buffer to append the compressed data that is ready to
+         */
+        void
+        write(std::string_view data, std::string& out);
+
+        /**
+         * @brief Complete the compressed response; the stream can't be written to after this
+         *
+         * @param out The buffer to append the rest of the compressed data to
+         */
+        void
+        finish(std::string& out);
+
+    private:
+        void
+        take(std::string& out);
+    };
+
+private:
+    struct Counters {
+        std::reference_wrapper<util::prometheus::CounterInt> originalBytes;
+        std::reference_wrapper<util::prometheus::CounterInt> compressedBytes;
+    };
+
+    bool enabled_;
+    int level_;
+    std::size_t minSize_;
+    std::optional<Counters> counters_;  // only registered if compression is enabled
+
+public:
+    /**
+     * @brief Construct a new Compression object
+     *
+     * @param config The Clio config
+     */
+    explicit Compression(util::config::ClioConfigDefinition const& config);
+
+    /**
+     * @brief Pick the content coding to compress an HTTP response with
+     *
+     * @param acceptEncoding The value of the Accept-Encoding header of the request
+     * @param size The size of the response, or of its first piece if it is sent in pieces
+     * @return The content coding; std::nullopt if the response should not be compressed
+     */
+    [[nodiscard]] std::optional<Encoding>
+    negotiate(std::string_view acceptEncoding, std::size_t size) const;
+
+    /**
+     * @brief Compress a whole response; compression must be enabled
+     *
+     * @param data The response
+     * @param encoding The content coding to compress with
+     * @return The compressed response
+     */
+    [[nodiscard]] std::string
+    compress(std::string_view data, Encoding encoding) const;
+
+    /**
+     * @brief Start compressing a response that is written piece by piece; compression must be enabled
+     *
+     * @param encoding The content coding to compress with
+     * @return The stream to write the response to
+     */
+    [[nodiscard]] std::unique_ptr<Stream>
+    makeStream(Encoding encoding) const;
+
+    /**
+     * @return The permessage-deflate settings for web socket connections
+     */
+    [[nodiscard]] boost::beast::websocket::permessage_deflate
+    permessageDeflate() const;
+
+    /**
+     * @brief Get the name of a content coding, as used in the Content-Encoding header
+     *
+     * @param encoding The content coding
+     * @return The name
+     */
+    [[nodiscard]] static std::string_view
+    toString(Encoding encoding);
+};
+
+}  // namespace web
@@ -24,13 +24,17 @@
 #include "rpc/Factories.hpp"
 #include "rpc/JS.hpp"
 #include "rpc/RPCHelpers.hpp"
+#include "rpc/WorkQueue.hpp"
 #include "rpc/common/impl/APIVersionParser.hpp"
+#include "util/JsonArenaPool.hpp"
 #include "util/JsonUtils.hpp"
 #include "util/Profiler.hpp"
 #include "util/Taggable.hpp"
 #include "util/log/Logger.hpp"
 #include "util/newconfig/ConfigDefinition.hpp"
+#include "web/dosguard/DOSGuardInterface.hpp"
 #include "web/impl/ErrorHandling.hpp"
+#include "web/impl/RequestBatch.hpp"
 #include "web/interface/ConnectionBase.hpp"
 
 #include <boost/asio/spawn.hpp>
@@ -39,10 +43,15 @@
 #include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
+#include <boost/json/storage_ptr.hpp>
+#include <boost/json/value.hpp>
 #include <boost/system/system_error.hpp>
+#include <fmt/core.h>
 #include <xrpl/protocol/jss.h>
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <memory>
@@ -65,6 +74,9 @@ class RPCServerHandler {
     std::shared_ptr<ETLType const> const etl_;
     util::TagDecoratorFactory const tagFactory_;
     rpc::impl::ProductionAPIVersionParser apiVersionParser_;  // can be injected if needed
+    util::JsonArenaPool arenaPool_;
+    std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard_;
+    std::uint32_t const maxBatchSize_;
 
     util::Logger log_{"RPC"};
     util::Logger perfLog_{"Performance"};
@@ -77,18 +89,22 @@ public:
      * @param backend The backend to use
      * @param rpcEngine The RPC engine to use
      * @param etl The ETL to use
+     * @param dosGuard The DOS guard to charge the requests of a batch to
      */
     RPCServerHandler(
         util::config::ClioConfigDefinition const& config,
         std::shared_ptr<BackendInterface const> const& backend,
         std::shared_ptr<RPCEngineType> const& rpcEngine,
-        std::shared_ptr<ETLType const> const& etl
+        std::shared_ptr<ETLType const> const& etl,
+        dosguard::DOSGuardInterface& dosGuard
     )
         : backend_(backend)
         , rpcEngine_(rpcEngine)
         , etl_(etl)
         , tagFactory_(config)
         , apiVersionParser_(config.getObject("api_version"))
+        , dosGuard_(std::ref(dosGuard))
+        , maxBatchSize_(config.get<std::uint32_t>("rpc.max_batch_size"))
     {
     }
 
@@ -101,22 +117,45 @@ public:
     void
     operator()(std::string const& request, std::shared_ptr<web::ConnectionBase> const& connection)
     {
+        LOG(perfLog_.debug()) << connection->tag() << "Adding to work queue";
+
+        // the request is parsed on the work queue, so that large requests don't hold up the io threads
+        if (!rpcEngine_->post(
+                [this, request, connection](boost::asio::yield_context yield) {
+                    processRequest(yield, request, connection);
+                },
+                connection->clientIp,
+                priorityOf(*connection)
+            )) {
+            rpcEngine_->notifyTooBusy();
+            web::impl::ErrorHelper(connection).sendTooBusyError();
+        }
+    }
+
+private:
+    void
+    processRequest(
+        boost::asio::yield_context yield,
+        std::string const& request,
+        std::shared_ptr<web::ConnectionBase> const& connection
+    )
+    {
+        // the parsed request and everything copied from it live in the arena until the response is sent
+        auto const arena = arenaPool_.acquire();
+
         try {
-            auto req = boost::json::parse(request).as_object();
-            LOG(perfLog_.debug()) << connection->tag() << "Adding to work queue";
+            auto parsed = boost::json::parse(request, arena.storage());
+            if (parsed.is_array() and not connection->upgraded and maxBatchSize_ != 0) {
+                handleBatch(parsed.as_array(), connection);
+                return;
+            }
+
+            auto req = std::move(parsed.as_object());
 
             if (not connection->upgraded and shouldReplaceParams(req))
                 req[JS(params)] = boost::json::array({boost::json::object{}});
 
-            if (!rpcEngine_->post(
-                    [this, request = std::move(req), connection](boost::asio::yield_context yield) mutable {
-                        handleRequest(yield, std::move(request), connection);
-                    },
-                    connection->clientIp
-                )) {
-                rpcEngine_->notifyTooBusy();
-                web::impl::ErrorHelper(connection).sendTooBusyError();
-            }
+            handleRequest(yield, std::move(req), connection);
         } catch (boost::system::system_error const& ex) {
             // system_error thrown when json parsing failed
             rpcEngine_->notifyBadSyntax();
@@ -130,11 +169,70 @@ public:
         } catch (std::exception const& ex) {
             LOG(perfLog_.error()) << connection->tag() << "Caught exception: " << ex.what();
             rpcEngine_->notifyInternalError();
-            throw;
+            web::impl::ErrorHelper(connection).sendInternalError();
+        }
+    }
+
+    void
+    handleBatch(boost::json::array const& batch, std::shared_ptr<web::ConnectionBase> const& connection)
+    {
+        if (batch.empty() or batch.size() > maxBatchSize_) {
+            rpcEngine_->notifyBadSyntax();
+            web::impl::ErrorHelper(connection).sendError(rpc::Status{
+                rpc::RippledError::rpcINVALID_PARAMS,
+                fmt::format("A batch must contain between 1 and {} requests", maxBatchSize_)
+            });
+            return;
+        }
+
+        auto const requestBatch = std::make_shared<web::impl::RequestBatch>(connection, batch.size());
+        for (std::size_t index = 0; index < batch.size(); ++index) {
+            auto elementConnection = requestBatch->makeConnection(index, tagFactory_.with(connection->tag()));
+
+            // the first request was counted when the batch was received
+            if (index != 0 and not dosGuard_.get().request(connection->clientIp)) {
+                elementConnection->send(
+                    web::impl::ErrorHelper(elementConnection).composeError(rpc::RippledError::rpcSLOW_DOWN)
+                );
+                continue;
+            }
+
+            // the batch lives in the arena of this coroutine, while the requests are handled by coroutines of their
+            // own on other threads
+            boost::json::value element{batch[index], boost::json::storage_ptr{}};
+            if (!rpcEngine_->post(
+                    [this, element = std::move(element), elementConnection](boost::asio::yield_context yield) mutable {
+                        handleBatchElement(yield, std::move(element), elementConnection);
+                    },
+                    connection->clientIp,
+                    priorityOf(*connection)
+                )) {
+                rpcEngine_->notifyTooBusy();
+                web::impl::ErrorHelper(elementConnection).sendTooBusyError();
+            }
         }
     }
 
-private:
+    void
+    handleBatchElement(
+        boost::asio::yield_context yield,
+        boost::json::value&& element,
+        std::shared_ptr<web::ConnectionBase> const& connection
+    )
+    {
+        if (not element.is_object()) {
+            rpcEngine_->notifyBadSyntax();
+            web::impl::ErrorHelper(connection).sendError(rpc::Status{rpc::RippledError::rpcBAD_SYNTAX});
+            return;
+        }
+
+        auto& req = element.as_object();
+        if (shouldReplaceParams(req))
+            req[JS(params)] = boost::json::array({boost::json::object{}});
+
+        handleRequest(yield, std::move(req), connection);
+    }
+
     void
     handleRequest(
         boost::asio::yield_context yield,
@@ -203,10 +301,9 @@ private:
             if (auto const status = std::get_if<rpc::Status>(&result.response)) {
                 // note: error statuses are counted/notified in buildResponse itself
                 response = web::impl::ErrorHelper(connection, request).composeError(*status);
-                auto const responseStr = boost::json::serialize(response);
 
-                LOG(perfLog_.debug()) << context->tag() << "Encountered error: " << responseStr;
-                LOG(log_.debug()) << context->tag() << "Encountered error: " << responseStr;
+                LOG(perfLog_.debug()) << context->tag() << "Encountered error: " << boost::json::serialize(response);
+                LOG(log_.debug()) << context->tag() << "Encountered error: " << boost::json::serialize(response);
             } else {
                 // This can still technically be an error. Clio counts forwarded requests as successful.
                 rpcEngine_->notifyComplete(context->method, us);
@@ -259,7 +356,7 @@ private:
                 warnings.emplace_back(rpc::makeWarning(rpc::WarnRpcOutdated));
 
             response["warnings"] = warnings;
-            connection->send(boost::json::serialize(response));
+            connection->send(std::move(response));
         } catch (std::exception const& ex) {
             // note: while we are catching this in buildResponse too, this is here to make sure
             // that any other code that may throw is outside of buildResponse is also worked around.
@@ -273,6 +370,16 @@ private:
         }
     }
 
+    static rpc::WorkQueue::Priority
+    priorityOf(web::ConnectionBase const& connection)
+    {
+        if (connection.isAdmin())
+            return rpc::WorkQueue::Priority::Admin;
+
+        // websocket clients are the ones holding subscriptions
+        return connection.upgraded ? rpc::WorkQueue::Priority::Subscription : rpc::WorkQueue::Priority::Public;
+    }
+
     bool
     shouldReplaceParams(boost::json::object const& req) const
     {
@@ -22,6 +22,7 @@
 #include "util/Taggable.hpp"
 #include "util/log/Logger.hpp"
 #include "web/AdminVerificationStrategy.hpp"
+#include "web/Compression.hpp"
 #include "web/HttpSession.hpp"
 #include "web/SslHttpSession.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
@@ -87,6 +88,7 @@ class Detector : public std::enable_shared_from_this<Detector<PlainSessionType,
     boost::beast::flat_buffer buffer_;
     std::shared_ptr<AdminVerificationStrategy> const adminVerification_;
     std::uint32_t maxWsSendingQueueSize_;
+    std::shared_ptr<Compression const> compression_;
 
 public:
     /**
@@ -99,6 +101,7 @@ public:
      * @param handler The server handler to use
      * @param adminVerification The admin verification strategy to use
      * @param maxWsSendingQueueSize The maximum size of the sending queue for websocket
+     * @param compression The compression of responses
      */
     Detector(
         tcp::socket&& socket,
@@ -107,7 +110,8 @@ public:
         std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard,
         std::shared_ptr<HandlerType> handler,
         std::shared_ptr<AdminVerificationStrategy> adminVerification,
-        std::uint32_t maxWsSendingQueueSize
+        std::uint32_t maxWsSendingQueueSize,
+        std::shared_ptr<Compression const> compression
     )
         : stream_(std::move(socket))
         , ctx_(ctx)
@@ -116,6 +120,7 @@ public:
         , handler_(std::move(handler))
         , adminVerification_(std::move(adminVerification))
         , maxWsSendingQueueSize_(maxWsSendingQueueSize)
+        , compression_(std::move(compression))
     {
     }
 
@@ -174,7 +179,8 @@ public:
                 dosGuard_,
                 handler_,
                 std::move(buffer_),
-                maxWsSendingQueueSize_
+                maxWsSendingQueueSize_,
+                compression_
             )
                 ->run();
             return;
@@ -188,7 +194,8 @@ public:
             dosGuard_,
             handler_,
             std::move(buffer_),
-            maxWsSendingQueueSize_
+            maxWsSendingQueueSize_,
+            compression_
         )
             ->run();
     }
@@ -219,6 +226,7 @@ class Server : public std::enable_shared_from_this<Server<PlainSessionType, SslS
     tcp::acceptor acceptor_;
     std::shared_ptr<AdminVerificationStrategy> adminVerification_;
     std::uint32_t maxWsSendingQueueSize_;
+    std::shared_ptr<Compression const> compression_;
 
 public:
     /**
@@ -232,6 +240,7 @@ public:
      * @param handler The server handler to use
      * @param adminVerification The admin verification strategy to use
      * @param maxWsSendingQueueSize The maximum size of the sending queue for websocket
+     * @param compression The compression of responses
      */
     Server(
         boost::asio::io_context& ioc,
@@ -241,7 +250,8 @@ public:
         dosguard::DOSGuardInterface& dosGuard,
         std::shared_ptr<HandlerType> handler,
         std::shared_ptr<AdminVerificationStrategy> adminVerification,
-        std::uint32_t maxWsSendingQueueSize
+        std::uint32_t maxWsSendingQueueSize,
+        std::shared_ptr<Compression const> compression
     )
         : ioc_(std::ref(ioc))
         , ctx_(std::move(ctx))
@@ -251,6 +261,7 @@ public:
         , acceptor_(boost::asio::make_strand(ioc))
         , adminVerification_(std::move(adminVerification))
         , maxWsSendingQueueSize_(maxWsSendingQueueSize)
+        , compression_(std::move(compression))
     {
         boost::beast::error_code ec;
 
@@ -310,7 +321,8 @@ private:
                 dosGuard_,
                 handler_,
                 adminVerification_,
-                maxWsSendingQueueSize_
+                maxWsSendingQueueSize_,
+                compression_
             )
                 ->run();
         }
@@ -372,7 +384,8 @@ makeHttpServer(
         dosGuard,
         handler,
         std::move(expectedAdminVerification).value(),
-        maxWsSendingQueueSize
+        maxWsSendingQueueSize,
+        std::make_shared<Compression const>(config)
     );
 
     server->run();
@@ -21,6 +21,7 @@
 
 #include "util/Taggable.hpp"
 #include "web/AdminVerificationStrategy.hpp"
+#include "web/Compression.hpp"
 #include "web/SslWsSession.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
 #include "web/impl/HttpBase.hpp"
@@ -76,6 +77,7 @@ public:
      * @param handler The server handler to use
      * @param buffer Buffer with initial data received from the peer
      * @param maxWsSendingQueueSize The maximum size of the sending queue for websocket
+     * @param compression The compression of responses
      */
     explicit SslHttpSession(
         tcp::socket&& socket,
@@ -86,7 +88,8 @@ public:
         std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
         boost::beast::flat_buffer buffer,
-        std::uint32_t maxWsSendingQueueSize
+        std::uint32_t maxWsSendingQueueSize,
+        std::shared_ptr<Compression const> compression
     )
         : impl::HttpBase<SslHttpSession, HandlerType>(
               ip,
@@ -94,7 +97,8 @@ public:
               adminVerification,
               dosGuard,
               handler,
-              std::move(buffer)
+              std::move(buffer),
+              std::move(compression)
           )
         , stream_(std::move(socket), ctx)
         , tagFactory_(tagFactory)
@@ -180,7 +184,8 @@ public:
             std::move(this->buffer_),
             std::move(this->req_),
             ConnectionBase::isAdmin(),
-            maxWsSendingQueueSize_
+            maxWsSendingQueueSize_,
+            this->compression_
         )
             ->run();
     }
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "util/Taggable.hpp"
+#include "web/Compression.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
 #include "web/impl/WsBase.hpp"
 #include "web/interface/ConnectionBase.hpp"
@@ -66,6 +67,7 @@ public:
      * @param buffer Buffer with initial data received from the peer
      * @param isAdmin Whether the connection has admin privileges
      * @param maxWsSendingQueueSize The maximum size of the sending queue for websocket
+     * @param compression The compression of responses
      */
     explicit SslWsSession(
         boost::beast::ssl_stream<boost::beast::tcp_stream>&& stream,
@@ -75,7 +77,8 @@ public:
         std::shared_ptr<HandlerType> const& handler,
         boost::beast::flat_buffer&& buffer,
         bool isAdmin,
-        std::uint32_t maxWsSendingQueueSize
+        std::uint32_t maxWsSendingQueueSize,
+        std::shared_ptr<Compression const> compression
     )
         : impl::WsBase<SslWsSession, HandlerType>(
               ip,
@@ -83,7 +86,8 @@ public:
               dosGuard,
               handler,
               std::move(buffer),
-              maxWsSendingQueueSize
+              maxWsSendingQueueSize,
+              std::move(compression)
           )
         , ws_(std::move(stream))
     {
@@ -117,6 +121,7 @@ class SslWsUpgrader : public std::enable_shared_from_this<SslWsUpgrader<HandlerT
     http::request<http::string_body> req_;
     bool isAdmin_;
     std::uint32_t maxWsSendingQueueSize_;
+    std::shared_ptr<Compression const> compression_;
 
 public:
     /**
@@ -131,6 +136,7 @@ public:
      * @param request The request. Ownership is transferred
      * @param isAdmin Whether the connection has admin privileges
      * @param maxWsSendingQueueSize The maximum size of the sending queue for websocket
+     * @param compression The compression of responses
      */
     SslWsUpgrader(
         boost::beast::ssl_stream<boost::beast::tcp_stream> stream,
@@ -141,7 +147,8 @@ public:
         boost::beast::flat_buffer&& buffer,
         http::request<http::string_body> request,
         bool isAdmin,
-        std::uint32_t maxWsSendingQueueSize
+        std::uint32_t maxWsSendingQueueSize,
+        std::shared_ptr<Compression const> compression
     )
         : https_(std::move(stream))
         , buffer_(std::move(buffer))
@@ -152,6 +159,7 @@ public:
         , req_(std::move(request))
         , isAdmin_(isAdmin)
         , maxWsSendingQueueSize_(maxWsSendingQueueSize)
+        , compression_(std::move(compression))
     {
     }
 
@@ -200,7 +208,8 @@ private:
             handler_,
             std::move(buffer_),
             isAdmin_,
-            maxWsSendingQueueSize_
+            maxWsSendingQueueSize_,
+            compression_
         )
             ->run(std::move(req_));
     }
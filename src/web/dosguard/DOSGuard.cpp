@@ -26,22 +26,41 @@
 #include "util/newconfig/ValueView.hpp"
 #include "web/dosguard/WhitelistHandlerInterface.hpp"
 
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/ip/address_v6.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 using namespace util::config;
 
 namespace web::dosguard {
 
-DOSGuard::DOSGuard(ClioConfigDefinition const& config, WhitelistHandlerInterface const& whitelistHandler)
+DOSGuard::DOSGuard(
+    ClioConfigDefinition const& config,
+    WhitelistHandlerInterface const& whitelistHandler,
+    ClockType now
+)
     : whitelistHandler_{std::cref(whitelistHandler)}
     , maxFetches_{config.get<uint32_t>("dos_guard.max_fetches")}
     , maxConnCount_{config.get<uint32_t>("dos_guard.max_connections")}
     , maxRequestCount_{config.get<uint32_t>("dos_guard.max_requests")}
+    , drainInterval_{std::max(
+          std::chrono::milliseconds{1u},
+          ClioConfigDefinition::toMilliseconds(config.get<double>("dos_guard.sweep_interval"))
+      )}
+    , now_{std::move(now)}
 {
 }
 
@@ -57,25 +76,12 @@ DOSGuard::isOk(std::string const& ip) const noexcept
     if (whitelistHandler_.get().isWhiteListed(ip))
         return true;
 
-    {
-        auto lock = mtx_.lock<std::scoped_lock>();
-        if (lock->ipState.find(ip) != lock->ipState.end()) {
-            auto [transferredByte, requests] = lock->ipState.at(ip);
-            if (transferredByte > maxFetches_ || requests > maxRequestCount_) {
-                LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
-                                 << " Transfered Byte: " << transferredByte << "; Requests: " << requests;
-                return false;
-            }
-        }
-        auto it = lock->ipConnCount.find(ip);
-        if (it != lock->ipConnCount.end()) {
-            if (it->second > maxConnCount_) {
-                LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
-                                 << " Concurrent connection: " << it->second;
-                return false;
-            }
-        }
-    }
+    auto const key = makeKey(ip);
+    auto const now = now_();
+    auto const lock = shardFor(key).lock<std::scoped_lock>();
+    if (auto const it = lock->find(key); it != lock->end())
+        return withinLimits(ip, drained(it->second, now));
+
     return true;
 }
 
@@ -84,8 +90,10 @@ DOSGuard::increment(std::string const& ip) noexcept
 {
     if (whitelistHandler_.get().isWhiteListed(ip))
         return;
-    auto lock = mtx_.lock<std::scoped_lock>();
-    lock->ipConnCount[ip]++;
+
+    auto const key = makeKey(ip);
+    auto lock = shardFor(key).lock<std::scoped_lock>();
+    (*lock)[key].connectionCount++;
 }
 
 void
@@ -93,11 +101,17 @@ DOSGuard::decrement(std::string const& ip) noexcept
 {
     if (whitelistHandler_.get().isWhiteListed(ip))
         return;
-    auto lock = mtx_.lock<std::scoped_lock>();
-    ASSERT(lock->ipConnCount[ip] > 0, "Connection count for ip {} can't be 0", ip);
-    lock->ipConnCount[ip]--;
-    if (lock->ipConnCount[ip] == 0)
-        lock->ipConnCount.erase(ip);
+
+    auto const key = makeKey(ip);
+    auto const now = now_();
+    auto lock = shardFor(key).lock<std::scoped_lock>();
+    auto& state = (*lock)[key];
+    ASSERT(state.connectionCount > 0, "Connection count for ip {} can't be 0", ip);
+    state.connectionCount--;
+
+    state = drained(state, now);
+    if (state.isIdle())
+        lock->erase(key);
 }
 
 [[maybe_unused]] bool
@@ -106,12 +120,14 @@ DOSGuard::add(std::string const& ip, uint32_t numObjects) noexcept
     if (whitelistHandler_.get().isWhiteListed(ip))
         return true;
 
-    {
-        auto lock = mtx_.lock<std::scoped_lock>();
-        lock->ipState[ip].transferedByte += numObjects;
-    }
+    auto const key = makeKey(ip);
+    auto const now = now_();
+    auto lock = shardFor(key).lock<std::scoped_lock>();
+    auto& state = (*lock)[key];
+    state = drained(state, now);
+    state.transferedByte += numObjects;
 
-    return isOk(ip);
+    return withinLimits(ip, state);
 }
 
 [[maybe_unused]] bool
@@ -120,19 +136,96 @@ DOSGuard::request(std::string const& ip) noexcept
     if (whitelistHandler_.get().isWhiteListed(ip))
         return true;
 
-    {
-        auto lock = mtx_.lock<std::scoped_lock>();
-        lock->ipState[ip].requestsCount++;
-    }
+    auto const key = makeKey(ip);
+    auto const now = now_();
+    auto lock = shardFor(key).lock<std::scoped_lock>();
+    auto& state = (*lock)[key];
+    state = drained(state, now);
+    state.requestsCount++;
 
-    return isOk(ip);
+    return withinLimits(ip, state);
 }
 
 void
 DOSGuard::clear() noexcept
 {
-    auto lock = mtx_.lock<std::scoped_lock>();
-    lock->ipState.clear();
+    auto const now = now_();
+    for (auto& shard : shards_) {
+        auto lock = shard.lock<std::scoped_lock>();
+        std::erase_if(*lock, [&](auto const& entry) { return drained(entry.second, now).isIdle(); });
+    }
+}
+
+std::size_t
+DOSGuard::IpKeyHash::operator()(IpKey const& key) const noexcept
+{
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+    std::memcpy(&high, key.data(), sizeof(high));
+    std::memcpy(&low, key.data() + sizeof(high), sizeof(low));
+    return static_cast<std::size_t>(high ^ (low * 0x9E3779B97F4A7C15ull));
+}
+
+DOSGuard::IpKey
+DOSGuard::makeKey(std::string const& ip)
+{
+    boost::system::error_code ec;
+    auto const address = boost::asio::ip::make_address(ip, ec);
+    if (not ec) {
+        if (address.is_v4())
+            return boost::asio::ip::make_address_v6(boost::asio::ip::v4_mapped, address.to_v4()).to_bytes();
+        return address.to_v6().to_bytes();
+    }
+
+    // not an ip address; use the multicast range, which clients never connect from, to keep it apart from real ones
+    IpKey key{};
+    key.fill(0xFF);
+    auto const hash = std::hash<std::string>{}(ip);
+    std::memcpy(key.data() + key.size() - sizeof(hash), &hash, sizeof(hash));
+    return key;
+}
+
+util::Mutex<DOSGuard::Shard>&
+DOSGuard::shardFor(IpKey const& key)
+{
+    // the high bits, because the maps inside the shards bucket by the low ones
+    return shards_[(IpKeyHash{}(key) >> 32) % kNUM_SHARDS];
+}
+
+util::Mutex<DOSGuard::Shard> const&
+DOSGuard::shardFor(IpKey const& key) const
+{
+    return shards_[(IpKeyHash{}(key) >> 32) % kNUM_SHARDS];
+}
+
+DOSGuard::ClientState
+DOSGuard::drained(ClientState state, std::chrono::steady_clock::time_point now) const
+{
+    if (now <= state.updated)
+        return state;
+
+    // the share of the drain interval that passed since the last update
+    auto const share = std::chrono::duration<double>(now - state.updated) / drainInterval_;
+    state.transferedByte = std::max(0.0, state.transferedByte - (share * maxFetches_));
+    state.requestsCount = std::max(0.0, state.requestsCount - (share * maxRequestCount_));
+    state.updated = now;
+    return state;
+}
+
+bool
+DOSGuard::withinLimits(std::string const& ip, ClientState const& state) const
+{
+    if (state.transferedByte > maxFetches_ || state.requestsCount > maxRequestCount_) {
+        LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
+                         << " Transfered Byte: " << state.transferedByte << "; Requests: " << state.requestsCount;
+        return false;
+    }
+    if (state.connectionCount > maxConnCount_) {
+        LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
+                         << " Concurrent connection: " << state.connectionCount;
+        return false;
+    }
+    return true;
 }
 
 [[nodiscard]] std::unordered_set<std::string>
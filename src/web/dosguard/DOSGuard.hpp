@@ -29,6 +29,9 @@
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/system/error_code.hpp>
 
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -41,28 +44,52 @@ namespace web::dosguard {
 /**
  * @brief A simple denial of service guard used for rate limiting.
  *
- * @tparam WhitelistHandlerType The type of the whitelist handler
+ * The fetches and requests of every IP are counted in leaky buckets: the counts drain continuously at the rate of
+ * the maximum per sweep interval, instead of being reset all at once, and a client is limited while a count is above
+ * its maximum. The state is split in shards keyed by the bytes of the IP address, so clients in different shards never
+ * wait for each other.
  */
 class DOSGuard : public DOSGuardInterface {
+public:
+    /** @brief The clock used to drain the counts */
+    using ClockType = std::function<std::chrono::steady_clock::time_point()>;
+
+private:
+    using IpKey = std::array<std::uint8_t, 16>;  // IPv6 bytes; IPv4 addresses are mapped into IPv6
+
+    struct IpKeyHash {
+        std::size_t
+        operator()(IpKey const& key) const noexcept;
+    };
+
     /**
-     * @brief Accumulated state per IP, state will be reset accordingly
+     * @brief Accumulated state per IP, the counts drain over time
      */
     struct ClientState {
-        std::uint32_t transferedByte = 0; /**< Accumulated transferred byte */
-        std::uint32_t requestsCount = 0;  /**< Accumulated served requests count */
+        double transferedByte = 0;         /**< Transferred byte not drained yet */
+        double requestsCount = 0;          /**< Served requests not drained yet */
+        std::uint32_t connectionCount = 0; /**< Open connections */
+        std::chrono::steady_clock::time_point updated; /**< When the counts were last drained */
+
+        [[nodiscard]] bool
+        isIdle() const
+        {
+            return connectionCount == 0 and transferedByte == 0 and requestsCount == 0;
+        }
     };
 
-    struct State {
-        std::unordered_map<std::string, ClientState> ipState;
-        std::unordered_map<std::string, std::uint32_t> ipConnCount;
-    };
-    util::Mutex<State> mtx_;
+    using Shard = std::unordered_map<IpKey, ClientState, IpKeyHash>;
+
+    static constexpr std::size_t kNUM_SHARDS = 64;
+    std::array<util::Mutex<Shard>, kNUM_SHARDS> shards_;
 
     std::reference_wrapper<WhitelistHandlerInterface const> whitelistHandler_;
 
     std::uint32_t const maxFetches_;
     std::uint32_t const maxConnCount_;
     std::uint32_t const maxRequestCount_;
+    std::chrono::milliseconds const drainInterval_;
+    ClockType now_;
     util::Logger log_{"RPC"};
 
 public:
@@ -71,8 +98,13 @@ public:
      *
      * @param config Clio config
      * @param whitelistHandler Whitelist handler that checks whitelist for IP addresses
+     * @param now The clock to use; only tests need to change it
      */
-    DOSGuard(util::config::ClioConfigDefinition const& config, WhitelistHandlerInterface const& whitelistHandler);
+    DOSGuard(
+        util::config::ClioConfigDefinition const& config,
+        WhitelistHandlerInterface const& whitelistHandler,
+        ClockType now = [] { return std::chrono::steady_clock::now(); }
+    );
 
     /**
      * @brief Check whether an ip address is in the whitelist or not.
@@ -113,7 +145,7 @@ public:
     /**
      * @brief Adds numObjects of usage for the given ip address.
      *
-     * If the total sums up to a value equal or larger than maxFetches_
+     * If the total not drained yet is larger than maxFetches_
      * the operation is no longer allowed and false is returned; true is
      * returned otherwise.
      *
@@ -128,7 +160,7 @@ public:
     /**
      * @brief Adds one request for the given ip address.
      *
-     * If the total sums up to a value equal or larger than maxRequestCount_
+     * If the total not drained yet is larger than maxRequestCount_
      * the operation is no longer allowed and false is returned; true is
      * returned otherwise.
      *
@@ -140,12 +172,29 @@ public:
     request(std::string const& ip) noexcept override;
 
     /**
-     * @brief Instantly clears all fetch counters added by @see add(std::string const&, uint32_t).
+     * @brief Forgets the clients without connections whose counts drained completely.
+     *
+     * The counts drain on their own, so this only frees memory.
      */
     void
     clear() noexcept override;
 
 private:
+    [[nodiscard]] static IpKey
+    makeKey(std::string const& ip);
+
+    [[nodiscard]] util::Mutex<Shard>&
+    shardFor(IpKey const& key);
+
+    [[nodiscard]] util::Mutex<Shard> const&
+    shardFor(IpKey const& key) const;
+
+    [[nodiscard]] ClientState
+    drained(ClientState state, std::chrono::steady_clock::time_point now) const;
+
+    [[nodiscard]] bool
+    withinLimits(std::string const& ip, ClientState const& state) const;
+
     [[nodiscard]] static std::unordered_set<std::string>
     getWhitelist(util::config::ClioConfigDefinition const& config);
 };
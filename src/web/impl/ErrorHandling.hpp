@@ -26,7 +26,6 @@
 
 #include <boost/beast/http/status.hpp>
 #include <boost/json/object.hpp>
-#include <boost/json/serialize.hpp>
 #include <fmt/core.h>
 #include <xrpl/protocol/ErrorCodes.h>
 #include <xrpl/protocol/jss.h>
@@ -59,7 +58,7 @@ public:
     sendError(rpc::Status const& err) const
     {
         if (connection_->upgraded) {
-            connection_->send(boost::json::serialize(composeError(err)));
+            connection_->send(composeError(err));
         } else {
             // Note: a collection of crutches to match rippled output follows
             if (auto const clioCode = std::get_if<rpc::ClioError>(&err.code)) {
@@ -101,7 +100,7 @@ public:
                         break;
                 }
             } else {
-                connection_->send(boost::json::serialize(composeError(err)), boost::beast::http::status::bad_request);
+                connection_->send(composeError(err), boost::beast::http::status::bad_request);
             }
         }
     }
@@ -110,30 +109,24 @@ public:
     sendInternalError() const
     {
         connection_->send(
-            boost::json::serialize(composeError(rpc::RippledError::rpcINTERNAL)),
-            boost::beast::http::status::internal_server_error
+            composeError(rpc::RippledError::rpcINTERNAL), boost::beast::http::status::internal_server_error
         );
     }
 
     void
     sendNotReadyError() const
     {
-        connection_->send(
-            boost::json::serialize(composeError(rpc::RippledError::rpcNOT_READY)), boost::beast::http::status::ok
-        );
+        connection_->send(composeError(rpc::RippledError::rpcNOT_READY), boost::beast::http::status::ok);
     }
 
     void
     sendTooBusyError() const
     {
         if (connection_->upgraded) {
-            connection_->send(
-                boost::json::serialize(rpc::makeError(rpc::RippledError::rpcTOO_BUSY)), boost::beast::http::status::ok
-            );
+            connection_->send(rpc::makeError(rpc::RippledError::rpcTOO_BUSY), boost::beast::http::status::ok);
         } else {
             connection_->send(
-                boost::json::serialize(rpc::makeError(rpc::RippledError::rpcTOO_BUSY)),
-                boost::beast::http::status::service_unavailable
+                rpc::makeError(rpc::RippledError::rpcTOO_BUSY), boost::beast::http::status::service_unavailable
             );
         }
     }
@@ -142,7 +135,7 @@ public:
     sendJsonParsingError() const
     {
         if (connection_->upgraded) {
-            connection_->send(boost::json::serialize(rpc::makeError(rpc::RippledError::rpcBAD_SYNTAX)));
+            connection_->send(rpc::makeError(rpc::RippledError::rpcBAD_SYNTAX));
         } else {
             connection_->send(
                 fmt::format("Unable to parse JSON from the request"), boost::beast::http::status::bad_request
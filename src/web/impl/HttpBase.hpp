@@ -26,24 +26,32 @@
 #include "util/log/Logger.hpp"
 #include "util/prometheus/Http.hpp"
 #include "web/AdminVerificationStrategy.hpp"
+#include "web/Compression.hpp"
 #include "web/SubscriptionContextInterface.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
+#include "web/impl/ResponseSerializer.hpp"
 #include "web/interface/Concepts.hpp"
 #include "web/interface/ConnectionBase.hpp"
 
+#include <boost/asio/buffer.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/error.hpp>
+#include <boost/asio/write.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/core/error.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/http.hpp>
+#include <boost/beast/http/chunk_encode.hpp>
+#include <boost/beast/http/empty_body.hpp>
 #include <boost/beast/http/error.hpp>
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/message.hpp>
+#include <boost/beast/http/serializer.hpp>
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/http/string_body.hpp>
 #include <boost/beast/http/verb.hpp>
+#include <boost/beast/http/write.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/core/ignore_unused.hpp>
 #include <boost/json.hpp>
@@ -58,6 +66,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 namespace web::impl {
@@ -107,6 +116,8 @@ class HttpBase : public ConnectionBase {
 
             // Store a type-erased version of the shared pointer in the class to keep it alive.
             self.res_ = sp;
+            if constexpr (std::is_same_v<http::message<IsRequest, Body, Fields>, http::response<http::string_body>>)
+                self.stringRes_ = sp;  // to reuse the memory of its body for the next response
 
             // Write the response
             http::async_write(
@@ -117,7 +128,20 @@ class HttpBase : public ConnectionBase {
         }
     };
 
+    // a response sent with chunked transfer encoding, each chunk serialized after the previous one is sent; HTTP/1.0
+    // clients get the chunks without the encoding, followed by the end of the connection
+    struct ChunkedResponse {
+        http::response<http::empty_body> header;
+        http::response_serializer<http::empty_body> headerSerializer{header};
+        std::unique_ptr<ResponseStream> stream;
+        std::unique_ptr<Compression::Stream> compressor;
+        std::string piece;  // serialized, not compressed yet
+        std::string chunk;  // the next chunk to send
+    };
+
     std::shared_ptr<void> res_;
+    std::shared_ptr<http::response<http::string_body>> stringRes_;
+    std::string responseBuffer_;
     SendLambda sender_;
     std::shared_ptr<AdminVerificationStrategy> adminVerification_;
 
@@ -126,6 +150,7 @@ protected:
     http::request<http::string_body> req_;
     std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard_;
     std::shared_ptr<HandlerType> const handler_;
+    std::shared_ptr<Compression const> const compression_;
     util::Logger log_{"WebServer"};
     util::Logger perfLog_{"Performance"};
 
@@ -166,7 +191,8 @@ public:
         std::shared_ptr<AdminVerificationStrategy> adminVerification,
         std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard,
         std::shared_ptr<HandlerType> handler,
-        boost::beast::flat_buffer buffer
+        boost::beast::flat_buffer buffer,
+        std::shared_ptr<Compression const> compression
     )
         : ConnectionBase(tagFactory, ip)
         , sender_(*this)
@@ -174,6 +200,7 @@ public:
         , buffer_(std::move(buffer))
         , dosGuard_(dosGuard)
         , handler_(std::move(handler))
+        , compression_(std::move(compression))
     {
         LOG(perfLog_.debug()) << tag() << "http session created";
         dosGuard_.get().increment(ip);
@@ -268,7 +295,7 @@ public:
     /**
      * @brief Send a response to the client
      * The message length will be added to the DOSGuard, if the limit is reached, a warning will be added to the
-     * response
+     * response; the message is parsed back for that, so JSON responses should rather be sent as JSON
      */
     void
     send(std::string&& msg, http::status status = http::status::ok) override
@@ -285,7 +312,30 @@ public:
             // Reserialize when we need to include this warning
             msg = boost::json::serialize(jsonResponse);
         }
-        sender_(httpResponse(status, "application/json", std::move(msg)));
+        sender_(jsonResponse(status, std::move(msg)));
+    }
+
+    /**
+     * @brief Send a JSON response to the client
+     * The response is serialized into the buffer of the connection and its length is added to the DOSGuard; if the
+     * limit is reached, a warning is added to the response. A response larger than kSTREAMED_CHUNK_SIZE is sent with
+     * chunked transfer encoding, one chunk serialized at a time; HTTP/1.0 clients get it unencoded, delimited by the
+     * end of the connection.
+     */
+    void
+    send(boost::json::object&& msg, http::status status = http::status::ok) override
+    {
+        sendStream(status, std::make_unique<ResponseStream>(std::move(msg), clientIp, dosGuard_.get()));
+    }
+
+    /**
+     * @brief Send the responses to a batch of requests to the client
+     * Sent like a single JSON response; each response is added to the DOSGuard and gets the warning on its own.
+     */
+    void
+    send(boost::json::array&& batch, http::status status = http::status::ok) override
+    {
+        sendStream(status, std::make_unique<ResponseStream>(std::move(batch), clientIp, dosGuard_.get()));
     }
 
     SubscriptionContextPtr
@@ -308,11 +358,145 @@ public:
         if (close)
             return derived().doClose();
 
+        if (stringRes_ != nullptr and stringRes_->body().capacity() <= kMAX_REUSED_BUFFER_SIZE) {
+            responseBuffer_ = std::move(stringRes_->body());
+            responseBuffer_.clear();
+        }
+        stringRes_ = nullptr;
         res_ = nullptr;
         doRead();
     }
 
 private:
+    http::response<http::string_body>
+    jsonResponse(http::status status, std::string message) const
+    {
+        auto const encoding = compression_->negotiate(req_[http::field::accept_encoding], message.size());
+        if (not encoding.has_value())
+            return httpResponse(status, "application/json", std::move(message));
+
+        auto res = httpResponse(status, "application/json", compression_->compress(message, *encoding));
+        res.set(http::field::content_encoding, Compression::toString(*encoding));
+        res.set(http::field::vary, "Accept-Encoding");
+        return res;
+    }
+
+    void
+    sendStream(http::status status, std::unique_ptr<ResponseStream> stream)
+    {
+        responseBuffer_.clear();
+        stream->next(responseBuffer_, kSTREAMED_CHUNK_SIZE);
+        if (stream->done())
+            return sender_(jsonResponse(status, std::move(responseBuffer_)));
+
+        sendChunked(status, std::move(stream));
+    }
+
+    void
+    sendChunked(http::status status, std::unique_ptr<ResponseStream> stream)
+    {
+        if (dead())
+            return;
+
+        auto res = std::make_shared<ChunkedResponse>();
+        res->header.result(status);
+        res->header.version(req_.version());
+        res->header.set(http::field::server, "clio-server-" + util::build::getClioVersionString());
+        res->header.set(http::field::content_type, "application/json");
+        if (req_.version() >= 11) {
+            res->header.keep_alive(req_.keep_alive());
+            res->header.chunked(true);
+        } else {
+            // HTTP/1.0 has no chunked encoding: the body is sent as is and ends when the connection is closed
+            res->header.keep_alive(false);
+        }
+
+        if (auto const encoding = compression_->negotiate(req_[http::field::accept_encoding], responseBuffer_.size());
+            encoding.has_value()) {
+            res->header.set(http::field::content_encoding, Compression::toString(*encoding));
+            res->header.set(http::field::vary, "Accept-Encoding");
+            res->compressor = compression_->makeStream(*encoding);
+        }
+
+        res->stream = std::move(stream);
+        res->piece = std::move(responseBuffer_);
+        nextChunk(*res);
+        res_ = res;
+
+        http::async_write_header(
+            derived().stream(),
+            res->headerSerializer,
+            boost::beast::bind_front_handler(&HttpBase::onHeaderWritten, derived().shared_from_this(), res)
+        );
+    }
+
+    // serialize and compress the response until there is something to send; the chunk is left empty once all is sent
+    static void
+    nextChunk(ChunkedResponse& res)
+    {
+        res.chunk.clear();
+        while (res.chunk.empty()) {
+            if (res.piece.empty()) {
+                if (res.stream->done())
+                    return;
+                res.stream->next(res.piece, kSTREAMED_CHUNK_SIZE);
+            }
+
+            if (res.compressor == nullptr) {
+                std::swap(res.chunk, res.piece);
+                continue;
+            }
+
+            res.compressor->write(res.piece, res.chunk);
+            if (res.stream->done())
+                res.compressor->finish(res.chunk);
+            res.piece.clear();
+        }
+    }
+
+    void
+    onHeaderWritten(std::shared_ptr<ChunkedResponse> const& res, boost::beast::error_code ec, std::size_t)
+    {
+        if (ec)
+            return httpFail(ec, "write");
+
+        writeChunk(res);
+    }
+
+    void
+    writeChunk(std::shared_ptr<ChunkedResponse> const& res)
+    {
+        auto handler = boost::beast::bind_front_handler(&HttpBase::onChunkWritten, derived().shared_from_this(), res);
+        if (res->header.chunked()) {
+            boost::asio::async_write(
+                derived().stream(), http::make_chunk(boost::asio::buffer(res->chunk)), std::move(handler)
+            );
+        } else {
+            boost::asio::async_write(derived().stream(), boost::asio::buffer(res->chunk), std::move(handler));
+        }
+    }
+
+    void
+    onChunkWritten(std::shared_ptr<ChunkedResponse> const& res, boost::beast::error_code ec, std::size_t)
+    {
+        if (ec)
+            return httpFail(ec, "write");
+
+        nextChunk(*res);
+        if (not res->chunk.empty())
+            return writeChunk(res);
+
+        if (not res->header.chunked())
+            return derived().doClose();
+
+        auto const close = res->header.need_eof();
+        boost::asio::async_write(
+            derived().stream(),
+            http::make_chunk_last(),
+            boost::beast::bind_front_handler(&HttpBase::onWrite, derived().shared_from_this(), close)
+        );
+    }
+
     http::response<http::string_body>
     httpResponse(http::status status, std::string contentType, std::string message) const
     {
@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/RequestBatch.hpp"
+
+#include "rpc/Errors.hpp"
+#include "rpc/JS.hpp"
+#include "util/Assert.hpp"
+#include "util/Taggable.hpp"
+#include "web/SubscriptionContextInterface.hpp"
+#include "web/interface/ConnectionBase.hpp"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <xrpl/protocol/jss.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace web::impl {
+
+namespace {
+
+class BatchElementConnection : public ConnectionBase {
+    std::shared_ptr<RequestBatch> batch_;
+    std::size_t index_;
+
+public:
+    BatchElementConnection(
+        util::TagDecoratorFactory const& tagFactory,
+        std::shared_ptr<RequestBatch> batch,
+        std::size_t index,
+        ConnectionBase const& parent
+    )
+        : ConnectionBase(tagFactory, parent.clientIp), batch_(std::move(batch)), index_(index)
+    {
+        isAdmin_ = parent.isAdmin();
+    }
+
+    void
+    send(std::string&& msg, [[maybe_unused]] http::status status = http::status::ok) override
+    {
+        // plain text errors of HTTP requests, like "Null method", become errors of the request
+        batch_->complete(
+            index_, {{JS(result), rpc::makeError(rpc::RippledError::rpcINVALID_PARAMS, std::nullopt, msg)}}
+        );
+    }
+
+    void
+    send(boost::json::object&& msg, [[maybe_unused]] http::status status = http::status::ok) override
+    {
+        // some errors, like tooBusy, are sent bare over HTTP; in a batch every response has its result in "result"
+        if (not msg.contains(JS(result))) {
+            batch_->complete(index_, {{JS(result), std::move(msg)}});
+            return;
+        }
+
+        batch_->complete(index_, std::move(msg));
+    }
+
+    SubscriptionContextPtr
+    makeSubscriptionContext(util::TagDecoratorFactory const&) override
+    {
+        ASSERT(false, "SubscriptionContext can't be created for a request of a batch");
+        std::unreachable();
+    }
+};
+
+}  // namespace
+
+RequestBatch::RequestBatch(std::shared_ptr<ConnectionBase> connection, std::size_t size)
+    : connection_(std::move(connection)), responses_(size), remaining_(size)
+{
+    // the requests are handled as HTTP requests; subscriptions and websocket error shapes don't apply to them
+    ASSERT(not connection_->upgraded, "Batches are only accepted over HTTP");
+}
+
+std::shared_ptr<ConnectionBase>
+RequestBatch::makeConnection(std::size_t index, util::TagDecoratorFactory const& tagFactory)
+{
+    return std::make_shared<BatchElementConnection>(tagFactory, shared_from_this(), index, *connection_);
+}
+
+void
+RequestBatch::complete(std::size_t index, boost::json::object&& response)
+{
+    responses_[index] = std::move(response);
+    if (--remaining_ != 0)
+        return;
+
+    boost::json::array batch;
+    batch.reserve(responses_.size());
+    for (auto& element : responses_)
+        batch.emplace_back(std::move(element));
+
+    connection_->send(std::move(batch));
+}
+
+}  // namespace web::impl
@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/Taggable.hpp"
+#include "web/interface/ConnectionBase.hpp"
+
+#include <boost/json/object.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace web::impl {
+
+/**
+ * @brief Collects the responses to the requests of a JSON-RPC batch and sends them as one array.
+ *
+ * Every request of the batch is handled as if it came over a connection of its own, made by @ref makeConnection, so
+ * the requests can be handled at the same time. The array is sent once the last response is in, with the responses in
+ * the order of the requests. Batches are only accepted over HTTP, and every response has its result or error in
+ * `result`.
+ */
+class RequestBatch : public std::enable_shared_from_this<RequestBatch> {
+    std::shared_ptr<ConnectionBase> connection_;
+    std::vector<boost::json::object> responses_;
+    std::atomic_size_t remaining_;
+
+public:
+    /**
+     * @brief Construct a new batch
+     *
+     * @param connection The connection the batch came over
+     * @param size The number of requests in the batch
+     */
+    RequestBatch(std::shared_ptr<ConnectionBase> connection, std::size_t size);
+
+    /**
+     * @brief Make the connection to handle a request of the batch with
+     *
+     * The connection has the IP address and the admin rights of the connection the batch came over. Whatever is sent
+     * to it becomes the response to the request.
+     *
+     * @param index The position of the request in the batch
+     * @param tagFactory The factory that generates tags to track requests
+     * @return The connection
+     */
+    [[nodiscard]] std::shared_ptr<ConnectionBase>
+    makeConnection(std::size_t index, util::TagDecoratorFactory const& tagFactory);
+
+    /**
+     * @brief Set the response to a request of the batch; sends the responses if it was the last one missing
+     *
+     * @param index The position of the request in the batch
+     * @param response The response
+     */
+    void
+    complete(std::size_t index, boost::json::object&& response);
+};
+
+}  // namespace web::impl
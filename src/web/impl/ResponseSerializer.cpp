@@ -0,0 +1,183 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/ResponseSerializer.hpp"
+
+#include "rpc/Errors.hpp"
+#include "util/Assert.hpp"
+#include "web/dosguard/DOSGuardInterface.hpp"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/json/serializer.hpp>
+#include <boost/json/value.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace web::impl {
+
+namespace {
+
+constexpr std::size_t kMIN_CHUNK_SIZE = 4096;
+constexpr std::string_view kWARNINGS_KEY = R"("warnings":)";
+
+}  // namespace
+
+void
+serializeInto(boost::json::object const& json, std::string& buffer)
+{
+    buffer.clear();
+
+    boost::json::serializer serializer;
+    serializer.reset(&json);
+    while (not serializer.done()) {
+        auto const offset = buffer.size();
+        buffer.resize(std::max(buffer.capacity(), offset + kMIN_CHUNK_SIZE));
+        auto const written = serializer.read(buffer.data() + offset, buffer.size() - offset);
+        buffer.resize(offset + written.size());
+    }
+}
+
+ResponseStream::ResponseStream(
+    boost::json::object&& response,
+    std::string clientIp,
+    dosguard::DOSGuardInterface& dosGuard
+)
+    : clientIp_(std::move(clientIp)), dosGuard_(dosGuard)
+{
+    responses_.push_back(std::move(response));
+    startResponse();
+}
+
+ResponseStream::ResponseStream(
+    boost::json::array&& batch,
+    std::string clientIp,
+    dosguard::DOSGuardInterface& dosGuard
+)
+    : isBatch_(true), clientIp_(std::move(clientIp)), dosGuard_(dosGuard)
+{
+    responses_.reserve(batch.size());
+    for (auto& response : batch) {
+        ASSERT(response.is_object(), "Every response of a batch must be an object");
+        responses_.push_back(std::move(response.as_object()));
+    }
+
+    if (not responses_.empty())
+        startResponse();
+}
+
+void
+ResponseStream::next(std::string& buffer, std::size_t maxSize)
+{
+    auto const start = buffer.size();
+    if (not started_) {
+        started_ = true;
+        if (isBatch_)
+            buffer.push_back('[');
+        if (responses_.empty()) {
+            buffer.push_back(']');
+            done_ = true;
+        }
+    }
+
+    while (not done_ and buffer.size() - start < maxSize) {
+        auto const offset = buffer.size();
+        auto const room = std::min(maxSize - (offset - start), std::max(buffer.capacity() - offset, kMIN_CHUNK_SIZE));
+        buffer.resize(offset + room);
+        auto const written = serializer_.read(buffer.data() + offset, room);
+        buffer.resize(offset + written.size());
+        size_ += written.size();
+
+        if (serializer_.done())
+            finishResponse(buffer);
+    }
+}
+
+bool
+ResponseStream::done() const
+{
+    return done_;
+}
+
+void
+ResponseStream::startResponse()
+{
+    auto& response = responses_[current_];
+    if (auto const it = response.find("warnings"); it != response.end()) {
+        warnings_ = std::move(it->value());
+        response.erase(it);
+    } else {
+        warnings_ = nullptr;
+    }
+    size_ = 0;
+    serializer_.reset(&response);
+}
+
+void
+ResponseStream::finishResponse(std::string& buffer)
+{
+    buffer.pop_back();  // the closing brace
+    std::string_view const separator = responses_[current_].empty() ? "" : ",";
+    responses_[current_] = {};  // serialized already
+
+    auto const serializedWarnings = warnings_.is_null() ? std::string{} : boost::json::serialize(warnings_);
+    auto const size =
+        size_ + (warnings_.is_null() ? 0 : separator.size() + kWARNINGS_KEY.size() + serializedWarnings.size());
+
+    if (dosGuard_.get().add(clientIp_, size)) {
+        if (not warnings_.is_null())
+            buffer.append(separator).append(kWARNINGS_KEY).append(serializedWarnings);
+        buffer.push_back('}');
+    } else {
+        buffer.append(separator).append(R"("warning":"load",)").append(kWARNINGS_KEY).push_back('[');
+        if (warnings_.is_array() and not warnings_.as_array().empty())
+            buffer.append(serializedWarnings, 1, serializedWarnings.size() - 2).push_back(',');
+        buffer.append(boost::json::serialize(rpc::makeWarning(rpc::WarnRpcRateLimit))).append("]}");
+    }
+
+    if (++current_ < responses_.size()) {
+        buffer.push_back(',');
+        startResponse();
+        return;
+    }
+
+    if (isBatch_)
+        buffer.push_back(']');
+    done_ = true;
+}
+
+void
+serializeResponse(
+    boost::json::object& response,
+    std::string const& clientIp,
+    dosguard::DOSGuardInterface& dosGuard,
+    std::string& buffer
+)
+{
+    buffer.clear();
+    ResponseStream stream{std::move(response), clientIp, dosGuard};
+    stream.next(buffer, buffer.max_size());
+}
+
+}  // namespace web::impl
@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "web/dosguard/DOSGuardInterface.hpp"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/serializer.hpp>
+#include <boost/json/value.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace web::impl {
+
+/** @brief The largest buffer a connection keeps to serialize its next response into */
+static constexpr std::size_t kMAX_REUSED_BUFFER_SIZE = 64 * 1024;
+
+/** @brief Responses larger than this are sent in pieces of about this size, each serialized right before it is sent */
+static constexpr std::size_t kSTREAMED_CHUNK_SIZE = 256 * 1024;
+
+/**
+ * @brief Serialize a JSON object into a buffer, replacing its content.
+ *
+ * The JSON is written straight into the memory the buffer already has, which is only grown when it is too small.
+ *
+ * @param json The JSON object to serialize
+ * @param buffer The buffer to serialize into
+ */
+void
+serializeInto(boost::json::object const& json, std::string& buffer);
+
+/**
+ * @brief Serializes the response to a client piece by piece and charges its size to the DOS guard.
+ *
+ * The `warnings` of the response are written after all its other fields, so whether the client gets the warning that
+ * it is about to be rate limited is decided once the rest of the response is serialized, and the response is never
+ * serialized twice or parsed back. That also lets a large response be sent while it is being serialized, so the
+ * serialized form of the whole response is never held in memory.
+ *
+ * The responses to a batch of requests are streamed the same way, as one array. Each response is charged to the DOS
+ * guard once it is serialized and gets the warning on its own, so the warning is added to the responses from the one
+ * that reaches the limit on.
+ *
+ * The stream refers to itself and can't be moved.
+ */
+class ResponseStream {
+    std::vector<boost::json::object> responses_;
+    bool isBatch_ = false;
+    std::size_t current_ = 0;     // the response being serialized
+    boost::json::value warnings_;  // of the current response
+    boost::json::serializer serializer_;
+    std::string clientIp_;
+    std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard_;
+    std::size_t size_ = 0;  // of the current response
+    bool started_ = false;
+    bool done_ = false;
+
+public:
+    /**
+     * @brief Construct a stream for a response
+     *
+     * @param response The response
+     * @param clientIp The IP address of the client
+     * @param dosGuard The DOS guard to charge the response to
+     */
+    ResponseStream(boost::json::object&& response, std::string clientIp, dosguard::DOSGuardInterface& dosGuard);
+
+    /**
+     * @brief Construct a stream for the responses to a batch of requests
+     *
+     * @param batch The responses, all JSON objects
+     * @param clientIp The IP address of the client
+     * @param dosGuard The DOS guard to charge the responses to
+     */
+    ResponseStream(boost::json::array&& batch, std::string clientIp, dosguard::DOSGuardInterface& dosGuard);
+
+    ResponseStream(ResponseStream const&) = delete;
+    ResponseStream(ResponseStream&&) = delete;
+    ResponseStream&
+    operator=(ResponseStream const&) = delete;
+    ResponseStream&
+    operator=(ResponseStream&&) = delete;
+    ~ResponseStream() = default;
+
+    /**
+     * @brief Append the next piece of the response to a buffer
+     *
+     * The piece that completes a response charges its size to the DOS guard.
+     *
+     * @param buffer The buffer to append to
+     * @param maxSize The size of the piece; it may be slightly larger when it completes a response, which also holds
+     * the warnings
+     */
+    void
+    next(std::string& buffer, std::size_t maxSize);
+
+    /**
+     * @return true if the whole response was serialized; false otherwise
+     */
+    [[nodiscard]] bool
+    done() const;
+
+private:
+    void
+    startResponse();
+
+    void
+    finishResponse(std::string& buffer);
+};
+
+/**
+ * @brief Serialize the response to a client into a buffer and charge its size to the DOS guard.
+ *
+ * See @ref ResponseStream for how the warning that the client is about to be rate limited is added.
+ *
+ * @param response The response; it is moved out
+ * @param clientIp The IP address of the client
+ * @param dosGuard The DOS guard to charge the response to
+ * @param buffer The buffer to serialize into
+ */
+void
+serializeResponse(
+    boost::json::object& response,
+    std::string const& clientIp,
+    dosguard::DOSGuardInterface& dosGuard,
+    std::string& buffer
+);
+
+}  // namespace web::impl
@@ -21,11 +21,14 @@
 
 #include "rpc/Errors.hpp"
 #include "rpc/common/Types.hpp"
+#include "util/Mutex.hpp"
 #include "util/Taggable.hpp"
 #include "util/log/Logger.hpp"
+#include "web/Compression.hpp"
 #include "web/SubscriptionContext.hpp"
 #include "web/SubscriptionContextInterface.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
+#include "web/impl/ResponseSerializer.hpp"
 #include "web/interface/Concepts.hpp"
 #include "web/interface/ConnectionBase.hpp"
 
@@ -67,6 +70,8 @@ namespace web::impl {
  * The write operation is via a queue, each write operation of this session will be sent in order.
  * The write operation also supports shared_ptr of string, so the caller can keep the string alive until it is sent.
  * It is useful when we have multiple sessions sending the same content.
+ * A JSON response larger than kSTREAMED_CHUNK_SIZE is sent as a fragmented message, each fragment serialized after the
+ * previous one is sent.
  *
  * @tparam Derived The derived class
  * @tparam HandlerType The handler type, will be called when a request is received.
@@ -75,14 +80,21 @@ template <template <typename> typename Derived, SomeServerHandler HandlerType>
 class WsBase : public ConnectionBase, public std::enable_shared_from_this<WsBase<Derived, HandlerType>> {
     using std::enable_shared_from_this<WsBase<Derived, HandlerType>>::shared_from_this;
 
+    struct Message {
+        std::shared_ptr<std::string> data;
+        std::shared_ptr<ResponseStream> stream;  // set if the rest of the message is still to be serialized
+    };
+
     boost::beast::flat_buffer buffer_;
     std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard_;
     bool sending_ = false;
-    std::queue<std::shared_ptr<std::string>> messages_;
+    std::queue<Message> messages_;
+    util::Mutex<std::shared_ptr<std::string>> spareBuffer_;  // a sent response, its memory is reused for the next one
     std::shared_ptr<HandlerType> const handler_;
 
     SubscriptionContextPtr subscriptionContext_;
     std::uint32_t maxSendingQueueSize_;
+    std::shared_ptr<Compression const> compression_;
 
 protected:
     util::Logger log_{"WebServer"};
@@ -108,13 +120,15 @@ public:
         std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
         boost::beast::flat_buffer&& buffer,
-        std::uint32_t maxSendingQueueSize
+        std::uint32_t maxSendingQueueSize,
+        std::shared_ptr<Compression const> compression
     )
         : ConnectionBase(tagFactory, ip)
         , buffer_(std::move(buffer))
         , dosGuard_(dosGuard)
         , handler_(handler)
         , maxSendingQueueSize_(maxSendingQueueSize)
+        , compression_(std::move(compression))
     {
         upgraded = true;  // NOLINT (cppcoreguidelines-pro-type-member-init)
 
@@ -137,15 +151,43 @@ public:
     doWrite()
     {
         sending_ = true;
+        auto const& message = messages_.front();
+        if (message.stream != nullptr) {
+            derived().ws().async_write_some(
+                message.stream->done(),
+                boost::asio::buffer(message.data->data(), message.data->size()),
+                boost::beast::bind_front_handler(&WsBase::onWriteFragment, derived().shared_from_this())
+            );
+            return;
+        }
+
         derived().ws().async_write(
-            boost::asio::buffer(messages_.front()->data(), messages_.front()->size()),
+            boost::asio::buffer(message.data->data(), message.data->size()),
             boost::beast::bind_front_handler(&WsBase::onWrite, derived().shared_from_this())
         );
     }
 
+    void
+    onWriteFragment(boost::system::error_code ec, std::size_t bytesTransferred)
+    {
+        auto const& message = messages_.front();
+        if (ec or message.stream->done())
+            return onWrite(ec, bytesTransferred);
+
+        message.data->clear();
+        message.stream->next(*message.data, kSTREAMED_CHUNK_SIZE);
+        doWrite();
+    }
+
     void
     onWrite(boost::system::error_code ec, std::size_t)
     {
+        // a message nobody else holds is a response; keep its memory for the next one
+        if (auto& sent = messages_.front().data;
+            sent.use_count() == 1 and sent->capacity() <= kMAX_REUSED_BUFFER_SIZE) {
+            sent->clear();
+            *spareBuffer_.lock() = std::move(sent);
+        }
         messages_.pop();
         sending_ = false;
         if (ec) {
@@ -173,18 +215,7 @@ public:
     void
     send(std::shared_ptr<std::string> msg) override
     {
-        boost::asio::dispatch(
-            derived().ws().get_executor(),
-            [this, self = derived().shared_from_this(), msg = std::move(msg)]() {
-                if (messages_.size() > maxSendingQueueSize_) {
-                    wsFail(boost::asio::error::timed_out, "Client is too slow");
-                    return;
-                }
-
-                messages_.push(msg);
-                maybeSendNext();
-            }
-        );
+        enqueue(Message{.data = std::move(msg), .stream = nullptr});
     }
 
     /**
@@ -206,7 +237,8 @@ public:
      * @brief Send a message to the client
      * @param msg The message to send
      * Send this message to the client. The message length will be added to the DOSGuard
-     * If the DOSGuard is triggered, the message will be modified to include a warning
+     * If the DOSGuard is triggered, the message will be parsed back and modified to include a warning, so JSON
+     * messages should rather be sent as JSON
      */
     void
     send(std::string&& msg, http::status) override
@@ -228,6 +260,28 @@ public:
         send(std::move(sharedMsg));
     }
 
+    /**
+     * @brief Send a JSON message to the client
+     * @param msg The message to send
+     * The message is serialized into a buffer of the session and its length is added to the DOSGuard.
+     * If the DOSGuard is triggered, a warning is added to the message. A message larger than kSTREAMED_CHUNK_SIZE is
+     * sent in fragments, one fragment serialized at a time.
+     */
+    void
+    send(boost::json::object&& msg, http::status) override
+    {
+        auto buffer = std::exchange(*spareBuffer_.lock(), nullptr);
+        if (buffer == nullptr)
+            buffer = std::make_shared<std::string>();
+
+        auto stream = std::make_shared<ResponseStream>(std::move(msg), clientIp, dosGuard_.get());
+        stream->next(*buffer, kSTREAMED_CHUNK_SIZE);
+        if (stream->done())
+            stream = nullptr;
+
+        enqueue(Message{.data = std::move(buffer), .stream = std::move(stream)});
+    }
+
     /**
      * @brief Accept the session asynchroniously
      */
@@ -243,6 +297,8 @@ public:
             res.set(http::field::server, std::string(BOOST_BEAST_VERSION_STRING) + " websocket-server-async");
         }));
 
+        derived().ws().set_option(compression_->permessageDeflate());
+
         derived().ws().async_accept(req, bind_front_handler(&WsBase::onAccept, this->shared_from_this()));
     }
 
@@ -310,5 +366,23 @@ public:
 
         doRead();
     }
+
+private:
+    void
+    enqueue(Message message)
+    {
+        boost::asio::dispatch(
+            derived().ws().get_executor(),
+            [this, self = derived().shared_from_this(), message = std::move(message)]() mutable {
+                if (messages_.size() > maxSendingQueueSize_) {
+                    wsFail(boost::asio::error::timed_out, "Client is too slow");
+                    return;
+                }
+
+                messages_.push(std::move(message));
+                maybeSendNext();
+            }
+        );
+    }
 };
 }  // namespace web::impl
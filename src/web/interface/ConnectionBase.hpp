@@ -24,6 +24,9 @@
 
 #include <boost/beast/http.hpp>
 #include <boost/beast/http/status.hpp>
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
 #include <boost/signals2.hpp>
 #include <boost/signals2/variadic_signal.hpp>
 
@@ -70,6 +73,34 @@ public:
     virtual void
     send(std::string&& msg, http::status status = http::status::ok) = 0;
 
+    /**
+     * @brief Send a JSON response to the client.
+     *
+     * Connections override this to serialize the response straight into their own buffer.
+     *
+     * @param msg The message to send
+     * @param status The HTTP status code; defaults to OK
+     */
+    virtual void
+    send(boost::json::object&& msg, http::status status = http::status::ok)
+    {
+        send(boost::json::serialize(msg), status);
+    }
+
+    /**
+     * @brief Send the responses to a batch of requests to the client, as one JSON array.
+     *
+     * Connections override this to serialize the responses straight into their own buffer.
+     *
+     * @param batch The responses, in the order of the requests
+     * @param status The HTTP status code; defaults to OK
+     */
+    virtual void
+    send(boost::json::array&& batch, http::status status = http::status::ok)
+    {
+        send(boost::json::serialize(batch), status);
+    }
+
     /**
      * @brief Send via shared_ptr of string, that enables SubscriptionManager to publish to clients.
      *
@@ -24,9 +24,11 @@
 #include "rpc/Factories.hpp"
 #include "rpc/JS.hpp"
 #include "rpc/RPCHelpers.hpp"
+#include "rpc/WorkQueue.hpp"
 #include "rpc/common/impl/APIVersionParser.hpp"
 #include "util/Assert.hpp"
 #include "util/CoroutineGroup.hpp"
+#include "util/JsonArenaPool.hpp"
 #include "util/JsonUtils.hpp"
 #include "util/Profiler.hpp"
 #include "util/Taggable.hpp"
@@ -72,6 +74,7 @@ class RPCServerHandler {
     std::shared_ptr<ETLType const> const etl_;
     util::TagDecoratorFactory const tagFactory_;
     rpc::impl::ProductionAPIVersionParser apiVersionParser_;  // can be injected if needed
+    util::JsonArenaPool arenaPool_;
 
     util::Logger log_{"RPC"};
     util::Logger perfLog_{"Performance"};
@@ -128,8 +131,11 @@ public:
              &onTaskComplete = onTaskComplete.value(),
              &connectionMetadata,
              subscriptionContext = std::move(subscriptionContext)](boost::asio::yield_context yield) mutable {
+                // the parsed request and everything copied from it live in the arena until the response is made
+                auto const arena = arenaPool_.acquire();
+
                 try {
-                    auto parsedRequest = boost::json::parse(request.message()).as_object();
+                    auto parsedRequest = boost::json::parse(request.message(), arena.storage()).as_object();
                     LOG(perfLog_.debug()) << connectionMetadata.tag() << "Adding to work queue";
 
                     if (not connectionMetadata.wasUpgraded() and shouldReplaceParams(parsedRequest))
@@ -158,7 +164,8 @@ public:
                 // notify the coroutine group that the foreign task is done
                 onTaskComplete();
             },
-            connectionMetadata.ip()
+            connectionMetadata.ip(),
+            priorityOf(connectionMetadata)
         );
 
         if (not postSuccessful) {
@@ -310,6 +317,17 @@ private:
         }
     }
 
+    static rpc::WorkQueue::Priority
+    priorityOf(ConnectionMetadata const& connectionMetadata)
+    {
+        if (connectionMetadata.isAdmin())
+            return rpc::WorkQueue::Priority::Admin;
+
+        // websocket clients are the ones holding subscriptions
+        return connectionMetadata.wasUpgraded() ? rpc::WorkQueue::Priority::Subscription
+                                                : rpc::WorkQueue::Priority::Public;
+    }
+
     bool
     shouldReplaceParams(boost::json::object const& req) const
     {
@@ -24,6 +24,7 @@
 #include "util/log/Logger.hpp"
 #include "util/newconfig/ConfigDefinition.hpp"
 #include "util/newconfig/ObjectView.hpp"
+#include "web/Compression.hpp"
 #include "web/ng/Connection.hpp"
 #include "web/ng/MessageHandler.hpp"
 #include "web/ng/ProcessingPolicy.hpp"
@@ -43,6 +44,7 @@
 #include <boost/beast/core/error.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/websocket/option.hpp>
 #include <boost/system/system_error.hpp>
 #include <fmt/core.h>
 
@@ -165,6 +167,7 @@ std::expected<ConnectionPtr, std::string>
 tryUpgradeConnection(
     impl::UpgradableConnectionPtr connection,
     std::optional<boost::asio::ssl::context>& sslContext,
+    boost::beast::websocket::permessage_deflate const& wsCompression,
     util::TagDecoratorFactory& tagDecoratorFactory,
     boost::asio::yield_context yield
 )
@@ -177,7 +180,7 @@ tryUpgradeConnection(
     }
 
     if (*expectedIsUpgrade) {
-        auto expectedUpgradedConnection = connection->upgrade(sslContext, tagDecoratorFactory, yield);
+        auto expectedUpgradedConnection = connection->upgrade(sslContext, wsCompression, tagDecoratorFactory, yield);
         if (expectedUpgradedConnection.has_value())
             return std::move(expectedUpgradedConnection).value();
 
@@ -194,6 +197,7 @@ Server::Server(
     boost::asio::io_context& ctx,
     boost::asio::ip::tcp::endpoint endpoint,
     std::optional<boost::asio::ssl::context> sslContext,
+    boost::beast::websocket::permessage_deflate wsCompression,
     ProcessingPolicy processingPolicy,
     std::optional<size_t> parallelRequestLimit,
     util::TagDecoratorFactory tagDecoratorFactory,
@@ -203,6 +207,7 @@ Server::Server(
 )
     : ctx_{ctx}
     , sslContext_{std::move(sslContext)}
+    , wsCompression_{wsCompression}
     , tagDecoratorFactory_{tagDecoratorFactory}
     , connectionHandler_{processingPolicy, parallelRequestLimit, tagDecoratorFactory_, maxSubscriptionSendQueueSize, std::move(onDisconnectHook)}
     , endpoint_{std::move(endpoint)}
@@ -316,8 +321,9 @@ Server::handleConnection(boost::asio::ip::tcp::socket socket, boost::asio::yield
         return;
     }
 
-    auto connection =
-        tryUpgradeConnection(std::move(connectionExpected).value(), sslContext_, tagDecoratorFactory_, yield);
+    auto connection = tryUpgradeConnection(
+        std::move(connectionExpected).value(), sslContext_, wsCompression_, tagDecoratorFactory_, yield
+    );
     if (not connection.has_value()) {
         LOG(log_.info()) << connection.error();
         return;
@@ -367,6 +373,7 @@ makeServer(
         context,
         std::move(endpoint).value(),
         std::move(expectedSslContext).value(),
+        Compression{config}.permessageDeflate(),
         processingPolicy,
         parallelRequestLimit,
         util::TagDecoratorFactory(config),
@@ -32,6 +32,7 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/spawn.hpp>
 #include <boost/asio/ssl/context.hpp>
+#include <boost/beast/websocket/option.hpp>
 
 #include <concepts>
 #include <cstddef>
@@ -73,6 +74,7 @@ private:
 
     std::reference_wrapper<boost::asio::io_context> ctx_;
     std::optional<boost::asio::ssl::context> sslContext_;
+    boost::beast::websocket::permessage_deflate wsCompression_;
 
     util::TagDecoratorFactory tagDecoratorFactory_;
 
@@ -90,6 +92,7 @@ public:
      * @param ctx The boost::asio::io_context to use.
      * @param endpoint The endpoint to listen on.
      * @param sslContext The SSL context to use (optional).
+     * @param wsCompression The permessage-deflate settings of websocket connections.
      * @param processingPolicy The requests processing policy (parallel or sequential).
      * @param parallelRequestLimit The limit of requests for one connection that can be processed in parallel. Only used
      * if processingPolicy is parallel.
@@ -102,6 +105,7 @@ public:
         boost::asio::io_context& ctx,
         boost::asio::ip::tcp::endpoint endpoint,
         std::optional<boost::asio::ssl::context> sslContext,
+        boost::beast::websocket::permessage_deflate wsCompression,
         ProcessingPolicy processingPolicy,
         std::optional<size_t> parallelRequestLimit,
         util::TagDecoratorFactory tagDecoratorFactory,
@@ -59,6 +59,7 @@ public:
     virtual std::expected<ConnectionPtr, Error>
     upgrade(
         std::optional<boost::asio::ssl::context>& sslContext,
+        boost::beast::websocket::permessage_deflate const& compression,
         util::TagDecoratorFactory const& tagDecoratorFactory,
         boost::asio::yield_context yield
     ) = 0;
@@ -185,6 +186,7 @@ public:
     std::expected<ConnectionPtr, Error>
     upgrade(
         [[maybe_unused]] std::optional<boost::asio::ssl::context>& sslContext,
+        boost::beast::websocket::permessage_deflate const& compression,
         util::TagDecoratorFactory const& tagDecoratorFactory,
         boost::asio::yield_context yield
     ) override
@@ -199,6 +201,7 @@ public:
                 std::move(buffer_),
                 std::move(request_).value(),
                 sslContext.value(),
+                compression,
                 tagDecoratorFactory,
                 yield
             );
@@ -208,6 +211,7 @@ public:
                 std::move(ip_),
                 std::move(buffer_),
                 std::move(request_).value(),
+                compression,
                 tagDecoratorFactory,
                 yield
             );
@@ -28,6 +28,7 @@
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/http/message.hpp>
 #include <boost/beast/http/string_body.hpp>
+#include <boost/beast/websocket/option.hpp>
 
 #include <memory>
 #include <string>
@@ -41,12 +42,13 @@ makePlainWsConnection(
     std::string ip,
     boost::beast::flat_buffer buffer,
     boost::beast::http::request<boost::beast::http::string_body> request,
+    boost::beast::websocket::permessage_deflate const& compression,
     util::TagDecoratorFactory const& tagDecoratorFactory,
     boost::asio::yield_context yield
 )
 {
     auto connection = std::make_unique<PlainWsConnection>(
-        std::move(socket), std::move(ip), std::move(buffer), std::move(request), tagDecoratorFactory
+        std::move(socket), std::move(ip), std::move(buffer), std::move(request), compression, tagDecoratorFactory
     );
     auto maybeError = connection->performHandshake(yield);
     if (maybeError.has_value())
@@ -61,12 +63,19 @@ makeSslWsConnection(
     boost::beast::flat_buffer buffer,
     boost::beast::http::request<boost::beast::http::string_body> request,
     boost::asio::ssl::context& sslContext,
+    boost::beast::websocket::permessage_deflate const& compression,
     util::TagDecoratorFactory const& tagDecoratorFactory,
     boost::asio::yield_context yield
 )
 {
     auto connection = std::make_unique<SslWsConnection>(
-        std::move(socket), std::move(ip), std::move(buffer), sslContext, std::move(request), tagDecoratorFactory
+        std::move(socket),
+        std::move(ip),
+        std::move(buffer),
+        sslContext,
+        std::move(request),
+        compression,
+        tagDecoratorFactory
     );
     auto maybeError = connection->performHandshake(yield);
     if (maybeError.has_value())
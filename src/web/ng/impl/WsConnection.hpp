@@ -40,6 +40,7 @@
 #include <boost/beast/http/message.hpp>
 #include <boost/beast/http/string_body.hpp>
 #include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket/option.hpp>
 #include <boost/beast/websocket/rfc6455.hpp>
 #include <boost/beast/websocket/stream.hpp>
 #include <boost/beast/websocket/stream_base.hpp>
@@ -72,6 +73,7 @@ public:
         std::string ip,
         boost::beast::flat_buffer buffer,
         boost::beast::http::request<boost::beast::http::string_body> initialRequest,
+        boost::beast::websocket::permessage_deflate const& compression,
         util::TagDecoratorFactory const& tagDecoratorFactory
     )
         requires IsTcpStream<StreamType>
@@ -79,7 +81,7 @@ public:
         , stream_(std::move(socket))
         , initialRequest_(std::move(initialRequest))
     {
-        setupWsStream();
+        setupWsStream(compression);
     }
 
     WsConnection(
@@ -88,6 +90,7 @@ public:
         boost::beast::flat_buffer buffer,
         boost::asio::ssl::context& sslContext,
         boost::beast::http::request<boost::beast::http::string_body> initialRequest,
+        boost::beast::websocket::permessage_deflate const& compression,
         util::TagDecoratorFactory const& tagDecoratorFactory
     )
         requires IsSslTcpStream<StreamType>
@@ -95,7 +98,7 @@ public:
         , stream_(std::move(socket), sslContext)
         , initialRequest_(std::move(initialRequest))
     {
-        setupWsStream();
+        setupWsStream(compression);
     }
 
     std::optional<Error>
@@ -173,7 +176,7 @@ public:
 
 private:
     void
-    setupWsStream()
+    setupWsStream(boost::beast::websocket::permessage_deflate const& compression)
     {
         // Disable the timeout. The websocket::stream uses its own timeout settings.
         boost::beast::get_lowest_layer(stream_).expires_never();
@@ -183,6 +186,7 @@ private:
                 res.set(boost::beast::http::field::server, util::build::getClioFullVersionString());
             })
         );
+        stream_.set_option(compression);
     }
 };
 
@@ -195,6 +199,7 @@ makePlainWsConnection(
     std::string ip,
     boost::beast::flat_buffer buffer,
     boost::beast::http::request<boost::beast::http::string_body> request,
+    boost::beast::websocket::permessage_deflate const& compression,
     util::TagDecoratorFactory const& tagDecoratorFactory,
     boost::asio::yield_context yield
 );
@@ -206,6 +211,7 @@ makeSslWsConnection(
     boost::beast::flat_buffer buffer,
     boost::beast::http::request<boost::beast::http::string_body> request,
     boost::asio::ssl::context& sslContext,
+    boost::beast::websocket::permessage_deflate const& compression,
     util::TagDecoratorFactory const& tagDecoratorFactory,
     boost::asio::yield_context yield
 );
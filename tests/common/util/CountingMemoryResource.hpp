@@ -0,0 +1,59 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/json/memory_resource.hpp>
+
+#include <cstddef>
+#include <new>
+
+/**
+ * @brief A memory resource that counts the allocations it makes from the global heap.
+ */
+class CountingMemoryResource : public boost::json::memory_resource {
+    std::size_t allocations_ = 0;
+
+public:
+    [[nodiscard]] std::size_t
+    allocations() const
+    {
+        return allocations_;
+    }
+
+private:
+    void*
+    do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations_;
+        return ::operator new(bytes, std::align_val_t{alignment});
+    }
+
+    void
+    do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        ::operator delete(ptr, bytes, std::align_val_t{alignment});
+    }
+
+    [[nodiscard]] bool
+    do_is_equal(boost::json::memory_resource const& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
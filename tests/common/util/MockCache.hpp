@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "data/LedgerCache.hpp"
 #include "data/Types.hpp"
 
 #include <gmock/gmock.h>
@@ -26,7 +27,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <expected>
 #include <optional>
+#include <string>
 #include <vector>
 
 struct MockCache {
@@ -61,4 +64,18 @@ struct MockCache {
     MOCK_METHOD(float, getObjectHitRate, (), (const));
 
     MOCK_METHOD(float, getSuccessorHitRate, (), (const));
+
+    MOCK_METHOD(void, setPartial, (std::size_t maxBytes), ());
+
+    MOCK_METHOD((std::expected<uint32_t, std::string>), saveToFile, (std::string const& path), (const));
+
+    MOCK_METHOD(
+        (std::expected<uint32_t, std::string>),
+        loadFromFile,
+        (std::string const& path,
+         uint32_t minSequence,
+         uint32_t maxSequence,
+         data::LedgerCache::DiffFetcher const& fetchDiff),
+        ()
+    );
 };
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #pragma once
+#include "rpc/WorkQueue.hpp"
 #include "rpc/common/Types.hpp"
 #include "web/Context.hpp"
 
@@ -27,14 +28,27 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <cstddef>
 #include <functional>
+#include <limits>
 #include <string>
 
 struct MockAsyncRPCEngine {
+    // posts beyond this number are rejected, as by a full work queue
+    std::size_t postsLeft = std::numeric_limits<std::size_t>::max();
+
     template <typename Fn>
     bool
-    post(Fn&& func, [[maybe_unused]] std::string const& ip = "")
+    post(
+        Fn&& func,
+        [[maybe_unused]] std::string const& ip = "",
+        [[maybe_unused]] rpc::WorkQueue::Priority priority = rpc::WorkQueue::Priority::Public
+    )
     {
+        if (postsLeft == 0)
+            return false;
+        --postsLeft;
+
         using namespace boost::asio;
         io_context ioc;
 
@@ -61,7 +75,12 @@ struct MockAsyncRPCEngine {
 };
 
 struct MockRPCEngine {
-    MOCK_METHOD(bool, post, (std::function<void(boost::asio::yield_context)>&&, std::string const&), ());
+    MOCK_METHOD(
+        bool,
+        post,
+        (std::function<void(boost::asio::yield_context)>&&, std::string const&, rpc::WorkQueue::Priority),
+        ()
+    );
     MOCK_METHOD(void, notifyComplete, (std::string const&, std::chrono::microseconds const&), ());
     MOCK_METHOD(void, notifyErrored, (std::string const&), ());
     MOCK_METHOD(void, notifyForwarded, (std::string const&), ());
@@ -59,24 +59,51 @@ struct MockSubscriptionManager : feed::SubscriptionManagerInterface {
         (override)
     );
 
+    MOCK_METHOD(
+        boost::json::object,
+        resumeLedger,
+        (boost::asio::yield_context, std::uint32_t, feed::SubscriberSharedPtr const&),
+        (override)
+    );
+
     MOCK_METHOD(void, unsubLedger, (feed::SubscriberSharedPtr const&), (override));
 
     MOCK_METHOD(void, subTransactions, (feed::SubscriberSharedPtr const&), (override));
 
+    MOCK_METHOD(void, resumeTransactions, (std::uint32_t, feed::SubscriberSharedPtr const&), (override));
+
     MOCK_METHOD(void, unsubTransactions, (feed::SubscriberSharedPtr const&), (override));
 
     MOCK_METHOD(void, pubTransaction, (data::TransactionAndMetadata const&, ripple::LedgerHeader const&), (override));
 
+    MOCK_METHOD(bool, canResumeFrom, (std::uint32_t), (const, override));
+
     MOCK_METHOD(void, subAccount, (ripple::AccountID const&, feed::SubscriberSharedPtr const&), (override));
 
     MOCK_METHOD(void, unsubAccount, (ripple::AccountID const&, feed::SubscriberSharedPtr const&), (override));
 
+    MOCK_METHOD(
+        void,
+        subAccounts,
+        (std::vector<ripple::AccountID> const&, feed::SubscriberSharedPtr const&),
+        (override)
+    );
+
+    MOCK_METHOD(
+        void,
+        unsubAccounts,
+        (std::vector<ripple::AccountID> const&, feed::SubscriberSharedPtr const&),
+        (override)
+    );
+
     MOCK_METHOD(void, subBook, (ripple::Book const&, feed::SubscriberSharedPtr const&), (override));
 
     MOCK_METHOD(void, unsubBook, (ripple::Book const&, feed::SubscriberSharedPtr const&), (override));
 
     MOCK_METHOD(void, subBookChanges, (feed::SubscriberSharedPtr const&), (override));
 
+    MOCK_METHOD(void, resumeBookChanges, (std::uint32_t, feed::SubscriberSharedPtr const&), (override));
+
     MOCK_METHOD(void, unsubBookChanges, (feed::SubscriberSharedPtr const&), (override));
 
     MOCK_METHOD(void, subManifest, (feed::SubscriberSharedPtr const&), (override));
@@ -95,6 +122,13 @@ struct MockSubscriptionManager : feed::SubscriptionManagerInterface {
 
     MOCK_METHOD(void, subProposedAccount, (ripple::AccountID const&, feed::SubscriberSharedPtr const&), (override));
 
+    MOCK_METHOD(
+        void,
+        subProposedAccounts,
+        (std::vector<ripple::AccountID> const&, feed::SubscriberSharedPtr const&),
+        (override)
+    );
+
     MOCK_METHOD(void, unsubProposedAccount, (ripple::AccountID const&, feed::SubscriberSharedPtr const&), (override));
 
     MOCK_METHOD(void, subProposedTransactions, (feed::SubscriberSharedPtr const&), (override));
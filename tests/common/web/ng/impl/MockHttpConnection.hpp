@@ -31,6 +31,7 @@
 #include <boost/asio/ssl/context.hpp>
 #include <boost/beast/http/message.hpp>
 #include <boost/beast/http/string_body.hpp>
+#include <boost/beast/websocket/option.hpp>
 #include <gmock/gmock.h>
 
 #include <chrono>
@@ -68,6 +69,7 @@ struct MockHttpConnectionImpl : web::ng::impl::UpgradableConnection {
         UpgradeReturnType,
         upgrade,
         (OptionalSslContext & sslContext,
+         boost::beast::websocket::permessage_deflate const& compression,
          util::TagDecoratorFactory const& tagDecoratorFactory,
          boost::asio::yield_context yield),
         (override)
@@ -29,6 +29,8 @@
 #include <xrpl/basics/Blob.h>
 #include <xrpl/basics/base_uint.h>
 #include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/UintTypes.h>
 #include <xrpl/protocol/XRPAmount.h>
 
 #include <optional>
@@ -42,6 +44,7 @@ namespace {
 
 constexpr auto kMAX_SEQ = 30;
 constexpr auto kMIN_SEQ = 10;
+constexpr auto kLEDGER_HASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
 
 }  // namespace
 
@@ -141,3 +144,112 @@ TEST_F(BackendInterfaceTest, FetchLedgerPageWithoutCorruptionDetectorDoesNotDisa
     runSpawn([this](auto yield) { backend_->fetchLedgerPage(std::nullopt, kMAX_SEQ, 10, false, yield); });
     EXPECT_FALSE(backend_->cache().isDisabled());
 }
+
+TEST_F(BackendInterfaceTest, FetchLedgersBySequenceFetchesEachLedger)
+{
+    auto const header = createLedgerHeader(kLEDGER_HASH, kMAX_SEQ);
+    EXPECT_CALL(*backend_, fetchLedgerBySequence(kMAX_SEQ, _)).WillOnce(Return(header));
+    EXPECT_CALL(*backend_, fetchLedgerBySequence(kMIN_SEQ, _)).WillOnce(Return(std::nullopt));
+
+    runSpawn([this, &header](auto yield) {
+        auto const headers = backend_->fetchLedgersBySequence({kMAX_SEQ, kMIN_SEQ}, yield);
+
+        ASSERT_EQ(headers.size(), 2);
+        ASSERT_TRUE(headers[0].has_value());
+        EXPECT_EQ(headers[0]->hash, header.hash);
+        EXPECT_FALSE(headers[1].has_value());
+    });
+}
+
+TEST_F(BackendInterfaceTest, FetchSuccessorKeysFollowsChainUntilEnd)
+{
+    using namespace ripple;
+
+    auto const key1 = uint256{1uz};
+    auto const key2 = uint256{2uz};
+    auto const key3 = uint256{3uz};
+    EXPECT_CALL(*backend_, doFetchSuccessorKey(kFIRST_KEY, kMAX_SEQ, _)).WillOnce(Return(key1));
+    EXPECT_CALL(*backend_, doFetchSuccessorKey(key1, kMAX_SEQ, _)).WillOnce(Return(key2));
+    EXPECT_CALL(*backend_, doFetchSuccessorKey(key2, kMAX_SEQ, _)).WillOnce(Return(key3));
+
+    runSpawn([&, this](auto yield) {
+        EXPECT_EQ(backend_->fetchSuccessorKeys(kFIRST_KEY, key3, kMAX_SEQ, 10, yield), (std::vector{key1, key2}));
+    });
+}
+
+TEST_F(BackendInterfaceTest, FetchSuccessorKeysFromFullCache)
+{
+    using namespace ripple;
+
+    backend_->cache().update(
+        {{.key = uint256{1uz}, .blob = Blob{'s'}},
+         {.key = uint256{2uz}, .blob = Blob{'s'}},
+         {.key = uint256{3uz}, .blob = Blob{'s'}}},
+        kMAX_SEQ
+    );
+    backend_->cache().setFull();
+    EXPECT_CALL(*backend_, doFetchSuccessorKey).Times(0);
+
+    runSpawn([this](auto yield) {
+        EXPECT_EQ(
+            backend_->fetchSuccessorKeys(uint256{1uz}, kLAST_KEY, kMAX_SEQ, 10, yield),
+            (std::vector{uint256{2uz}, uint256{3uz}})
+        );
+        EXPECT_EQ(backend_->fetchSuccessorKeys(kFIRST_KEY, kLAST_KEY, kMAX_SEQ, 1, yield), std::vector{uint256{1uz}});
+    });
+}
+
+TEST_F(BackendInterfaceTest, FetchBookOffersReadsOneDirectoryAtATimeFromDatabase)
+{
+    using namespace ripple;
+
+    auto const book = uint256{"1000000000000000000000000000000000000000000000000000000000000000"};
+    auto constexpr kDIR = "1000000000000000000000000000000000000000000000000000000000000001";
+    auto const dir = uint256{kDIR};
+    auto const offer1 = uint256{"A000000000000000000000000000000000000000000000000000000000000001"};
+    auto const offer2 = uint256{"A000000000000000000000000000000000000000000000000000000000000002"};
+
+    // the first directory holds enough offers, so no other directory is looked up
+    EXPECT_CALL(*backend_, doFetchSuccessorKey(book, kMAX_SEQ, _)).WillOnce(Return(dir));
+    EXPECT_CALL(*backend_, doFetchLedgerObject(dir, kMAX_SEQ, _))
+        .WillOnce(Return(createOwnerDirLedgerObject({offer1, offer2}, kDIR).getSerializer().peekData()));
+    EXPECT_CALL(*backend_, doFetchLedgerObjects(std::vector{offer1, offer2}, kMAX_SEQ, _))
+        .WillOnce(Return(std::vector{Blob{'s'}, Blob{'s'}}));
+
+    runSpawn([&, this](auto yield) {
+        auto const page = backend_->fetchBookOffers(book, kMAX_SEQ, 2, yield);
+
+        ASSERT_EQ(page.offers.size(), 2);
+        EXPECT_EQ(page.offers.front().key, offer1);
+    });
+}
+
+TEST_F(BackendInterfaceTest, FetchBookOffersFromFullCache)
+{
+    using namespace ripple;
+
+    auto const book = uint256{"1000000000000000000000000000000000000000000000000000000000000000"};
+    auto constexpr kDIR = "1000000000000000000000000000000000000000000000000000000000000001";
+    auto const dir = uint256{kDIR};
+    auto const offer = uint256{"A000000000000000000000000000000000000000000000000000000000000001"};
+
+    auto bookDir = createOwnerDirLedgerObject({offer}, kDIR);
+    bookDir.setFieldH160(sfTakerPaysCurrency, xrpCurrency());
+    bookDir.setFieldU64(sfExchangeRate, 1);
+
+    backend_->cache().update(
+        {{.key = dir, .blob = bookDir.getSerializer().peekData()}, {.key = offer, .blob = Blob{'s'}}},
+        kMAX_SEQ
+    );
+    backend_->cache().setFull();
+    EXPECT_CALL(*backend_, doFetchSuccessorKey).Times(0);
+    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(0);
+
+    runSpawn([&, this](auto yield) {
+        auto const page = backend_->fetchBookOffers(book, kMAX_SEQ, 10, yield);
+
+        ASSERT_EQ(page.offers.size(), 1);
+        EXPECT_EQ(page.offers.front().key, offer);
+        EXPECT_EQ(page.offers.front().blob, Blob{'s'});
+    });
+}
@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "data/impl/BlobArena.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <vector>
+
+using namespace data::impl;
+
+namespace {
+
+constexpr std::size_t kSEGMENT_SIZE = 256;
+constexpr std::size_t kBLOB_SIZE = 60;
+constexpr std::size_t kRECORD_SIZE = BlobSegment::kRECORD_HEADER_SIZE + kBLOB_SIZE;
+
+data::Blob
+blobOf(unsigned char value, std::size_t size = kBLOB_SIZE)
+{
+    return data::Blob(size, value);
+}
+
+}  // namespace
+
+struct BlobArenaTest : ::testing::Test {
+    BlobArena arena{kSEGMENT_SIZE};
+};
+
+TEST_F(BlobArenaTest, StoreAndRead)
+{
+    auto const ref = arena.store(ripple::uint256{1}, 10, blobOf(1));
+
+    ASSERT_FALSE(ref.empty());
+    EXPECT_EQ(ref.key(), ripple::uint256{1});
+    EXPECT_EQ(ref.seq(), 10);
+    EXPECT_EQ(ref.toBlob(), blobOf(1));
+    EXPECT_EQ(ref.recordSize(), kRECORD_SIZE);
+    EXPECT_EQ(arena.allocatedBytes(), kSEGMENT_SIZE);
+    EXPECT_EQ(arena.liveBytes(), kRECORD_SIZE);
+}
+
+TEST_F(BlobArenaTest, EmptyBlob)
+{
+    auto const ref = arena.store(ripple::uint256{1}, 10, {});
+    EXPECT_TRUE(ref.toBlob().empty());
+    EXPECT_EQ(ref.recordSize(), BlobSegment::kRECORD_HEADER_SIZE);
+}
+
+TEST_F(BlobArenaTest, NewSegmentWhenFull)
+{
+    auto const first = arena.store(ripple::uint256{1}, 10, blobOf(1));
+    auto const second = arena.store(ripple::uint256{2}, 10, blobOf(2));
+    auto const third = arena.store(ripple::uint256{3}, 10, blobOf(3));
+
+    EXPECT_EQ(arena.allocatedBytes(), 2 * kSEGMENT_SIZE);
+    EXPECT_EQ(arena.liveBytes(), 3 * kRECORD_SIZE);
+    EXPECT_EQ(first.toBlob(), blobOf(1));
+    EXPECT_EQ(second.toBlob(), blobOf(2));
+    EXPECT_EQ(third.toBlob(), blobOf(3));
+}
+
+TEST_F(BlobArenaTest, LargeBlobGetsOwnSegment)
+{
+    auto const ref = arena.store(ripple::uint256{1}, 10, blobOf(1, kSEGMENT_SIZE * 2));
+
+    EXPECT_EQ(ref.toBlob(), blobOf(1, kSEGMENT_SIZE * 2));
+    EXPECT_EQ(arena.allocatedBytes(), BlobSegment::kRECORD_HEADER_SIZE + kSEGMENT_SIZE * 2);
+}
+
+TEST_F(BlobArenaTest, SparsestSegmentSkipsActiveSegment)
+{
+    auto const first = arena.store(ripple::uint256{1}, 10, blobOf(1));
+    arena.release(first);
+    EXPECT_EQ(arena.liveBytes(), 0);
+    EXPECT_EQ(arena.sparsestSegment(1.0), nullptr);
+}
+
+TEST_F(BlobArenaTest, CompactSparseSegment)
+{
+    auto const first = arena.store(ripple::uint256{1}, 10, blobOf(1));
+    auto const second = arena.store(ripple::uint256{2}, 11, blobOf(2));
+    arena.store(ripple::uint256{3}, 12, blobOf(3));  // seals the first segment
+    arena.release(first);
+
+    auto const segment = arena.sparsestSegment(0.5);
+    ASSERT_NE(segment, nullptr);
+
+    std::vector<BlobRef> live;
+    BlobArena::forEachRecord(segment, [&](BlobRef const& record) {
+        if (not record.isSameRecord(first))
+            live.push_back(record);
+    });
+    ASSERT_EQ(live.size(), 1);
+    EXPECT_TRUE(live.front().isSameRecord(second));
+
+    auto const moved = arena.store(live.front().key(), live.front().seq(), live.front().data());
+    arena.release(second);
+    arena.retire(segment);
+
+    EXPECT_EQ(moved.key(), ripple::uint256{2});
+    EXPECT_EQ(moved.seq(), 11);
+    EXPECT_EQ(moved.toBlob(), blobOf(2));
+    EXPECT_EQ(arena.allocatedBytes(), kSEGMENT_SIZE);
+    EXPECT_EQ(arena.liveBytes(), 2 * kRECORD_SIZE);
+
+    // views of retired segments stay valid and releasing them is a no-op
+    EXPECT_EQ(second.toBlob(), blobOf(2));
+    arena.release(second);
+    EXPECT_EQ(arena.liveBytes(), 2 * kRECORD_SIZE);
+}
+
+TEST_F(BlobArenaTest, ForEachRecordInSteps)
+{
+    auto const first = arena.store(ripple::uint256{1}, 10, blobOf(1));
+    auto const second = arena.store(ripple::uint256{2}, 11, blobOf(2));
+    arena.store(ripple::uint256{3}, 12, blobOf(3));  // seals the first segment
+
+    auto const segment = arena.sparsestSegment(1.0);
+    ASSERT_NE(segment, nullptr);
+
+    std::vector<BlobRef> visited;
+    auto const visit = [&](BlobRef const& record) { visited.push_back(record); };
+
+    auto offset = BlobArena::forEachRecord(segment, 0, 1, visit);
+    EXPECT_EQ(offset, kRECORD_SIZE);
+    ASSERT_EQ(visited.size(), 1);
+    EXPECT_TRUE(visited.back().isSameRecord(first));
+
+    offset = BlobArena::forEachRecord(segment, offset, 1, visit);
+    EXPECT_EQ(offset, segment->used());
+    ASSERT_EQ(visited.size(), 2);
+    EXPECT_TRUE(visited.back().isSameRecord(second));
+
+    EXPECT_EQ(BlobArena::forEachRecord(segment, offset, 1, visit), offset);
+    EXPECT_EQ(visited.size(), 2);
+}
@@ -0,0 +1,199 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "data/impl/BoundedObjectCache.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+
+using namespace data::impl;
+
+namespace {
+
+constexpr std::size_t kBLOB_SIZE = 100;
+constexpr std::size_t kENTRIES_PER_SHARD = 4;
+constexpr std::size_t kBUDGET =
+    BoundedObjectCache::kNUM_SHARDS * kENTRIES_PER_SHARD * (kBLOB_SIZE + BoundedObjectCache::kENTRY_OVERHEAD);
+
+data::Blob
+blobOf(unsigned char value)
+{
+    return data::Blob(kBLOB_SIZE, value);
+}
+
+// small integers only differ in the last bytes, so all of these keys land in the same shard
+ripple::uint256
+keyOf(uint64_t value)
+{
+    return ripple::uint256{value};
+}
+
+}  // namespace
+
+struct BoundedObjectCacheTest : ::testing::Test {
+    BoundedObjectCache cache{kBUDGET};
+
+    bool
+    put(uint64_t key, uint32_t seq = 1)
+    {
+        return cache.put(keyOf(key), seq, blobOf(static_cast<unsigned char>(key)), [] { return true; }).admitted;
+    }
+
+    void
+    touch(uint64_t key, std::size_t times)
+    {
+        for (std::size_t i = 0; i < times; ++i)
+            cache.get(keyOf(key), 1);
+    }
+};
+
+TEST_F(BoundedObjectCacheTest, PutAndGet)
+{
+    EXPECT_TRUE(put(1, 10));
+
+    EXPECT_EQ(cache.get(keyOf(1), 10), blobOf(1));
+    EXPECT_EQ(cache.get(keyOf(1), 11), blobOf(1));
+    EXPECT_FALSE(cache.get(keyOf(1), 9).has_value());
+    EXPECT_FALSE(cache.get(keyOf(2), 10).has_value());
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.bytes(), kBLOB_SIZE + BoundedObjectCache::kENTRY_OVERHEAD);
+}
+
+TEST_F(BoundedObjectCacheTest, PutIsSkippedIfNotCurrent)
+{
+    auto const result = cache.put(keyOf(1), 1, blobOf(1), [] { return false; });
+
+    EXPECT_FALSE(result.admitted);
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(BoundedObjectCacheTest, PutDoesNotReplaceCachedObject)
+{
+    EXPECT_TRUE(put(1, 10));
+    EXPECT_FALSE(cache.put(keyOf(1), 5, blobOf(2), [] { return true; }).admitted);
+
+    EXPECT_EQ(cache.get(keyOf(1), 10), blobOf(1));
+}
+
+TEST_F(BoundedObjectCacheTest, StaysWithinBudget)
+{
+    for (uint64_t key = 1; key <= kENTRIES_PER_SHARD; ++key)
+        EXPECT_TRUE(put(key));
+
+    // a new key was never read, so it is not more popular than anything in the cache
+    EXPECT_FALSE(put(100));
+    EXPECT_EQ(cache.size(), kENTRIES_PER_SHARD);
+    EXPECT_LE(cache.bytes(), kBUDGET);
+}
+
+TEST_F(BoundedObjectCacheTest, PopularObjectIsAdmitted)
+{
+    for (uint64_t key = 1; key <= kENTRIES_PER_SHARD; ++key)
+        EXPECT_TRUE(put(key));
+
+    touch(100, 3);
+    auto const result = cache.put(keyOf(100), 1, blobOf(100), [] { return true; });
+
+    EXPECT_TRUE(result.admitted);
+    EXPECT_EQ(result.evicted, 1);
+    EXPECT_EQ(cache.size(), kENTRIES_PER_SHARD);
+    EXPECT_EQ(cache.get(keyOf(100), 1), blobOf(100));
+    EXPECT_FALSE(cache.get(keyOf(1), 1).has_value());  // the least recently used object is evicted
+}
+
+TEST_F(BoundedObjectCacheTest, ReadObjectsAreProtected)
+{
+    for (uint64_t key = 1; key <= kENTRIES_PER_SHARD; ++key)
+        EXPECT_TRUE(put(key));
+
+    touch(1, 1);  // promoted to protected
+    touch(100, 3);
+    EXPECT_TRUE(put(100));
+
+    EXPECT_TRUE(cache.get(keyOf(1), 1).has_value());
+    EXPECT_FALSE(cache.get(keyOf(2), 1).has_value());
+}
+
+TEST_F(BoundedObjectCacheTest, UpdateChangesCachedObject)
+{
+    EXPECT_TRUE(put(1, 10));
+
+    EXPECT_EQ(cache.update(keyOf(1), 11, blobOf(42)), 0);
+
+    EXPECT_FALSE(cache.get(keyOf(1), 10).has_value());
+    EXPECT_EQ(cache.get(keyOf(1), 11), blobOf(42));
+}
+
+TEST_F(BoundedObjectCacheTest, UpdateIgnoresObjectsNotCached)
+{
+    EXPECT_EQ(cache.update(keyOf(1), 11, blobOf(42)), 0);
+
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(BoundedObjectCacheTest, UpdateWithEmptyBlobErases)
+{
+    EXPECT_TRUE(put(1, 10));
+
+    cache.update(keyOf(1), 11, {});
+
+    EXPECT_FALSE(cache.get(keyOf(1), 11).has_value());
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.bytes(), 0);
+}
+
+TEST_F(BoundedObjectCacheTest, UpdateEvictsWhenObjectGrows)
+{
+    for (uint64_t key = 1; key <= kENTRIES_PER_SHARD; ++key)
+        EXPECT_TRUE(put(key));
+
+    EXPECT_EQ(cache.update(keyOf(kENTRIES_PER_SHARD), 2, data::Blob(kBLOB_SIZE * 2, 1)), 1);
+
+    EXPECT_EQ(cache.size(), kENTRIES_PER_SHARD - 1);
+    EXPECT_LE(cache.bytes(), kBUDGET);
+}
+
+TEST(FrequencySketchTest, EstimatesAccessCount)
+{
+    FrequencySketch sketch{64};
+    for (int i = 0; i < 5; ++i)
+        sketch.increment(keyOf(1));
+    sketch.increment(keyOf(2));
+
+    EXPECT_EQ(sketch.estimate(keyOf(1)), 5);
+    EXPECT_EQ(sketch.estimate(keyOf(2)), 1);
+    EXPECT_EQ(sketch.estimate(keyOf(3)), 0);
+}
+
+TEST(FrequencySketchTest, CountersAreAgedOverTime)
+{
+    FrequencySketch sketch{64};
+    for (int i = 0; i < 10; ++i)
+        sketch.increment(keyOf(1));
+
+    // 64 counters per row, halved after 640 additions
+    for (uint64_t key = 100; key < 800; ++key)
+        sketch.increment(keyOf(key));
+
+    EXPECT_LT(sketch.estimate(keyOf(1)), 10);
+}
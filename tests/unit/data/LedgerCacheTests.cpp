@@ -0,0 +1,653 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCache.hpp"
+#include "data/Types.hpp"
+#include "data/impl/BlobArena.hpp"
+#include "data/impl/LedgerCacheFile.hpp"
+#include "data/impl/LedgerCacheTree.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/TmpFile.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr auto kKEY1 = "1000000000000000000000000000000000000000000000000000000000000001";
+constexpr auto kKEY2 = "1000000000000000000000000000000000000000000000000000000000000002";
+constexpr auto kKEY3 = "8000000000000000000000000000000000000000000000000000000000000000";
+constexpr auto kKEY4 = "F000000000000000000000000000000000000000000000000000000000000000";
+
+Blob
+blobOf(unsigned char value)
+{
+    return Blob{value, value, value};
+}
+
+}  // namespace
+
+struct LedgerCacheTest : util::prometheus::WithPrometheus {
+    LedgerCache cache;
+};
+
+TEST_F(LedgerCacheTest, WritesAreVisibleBeforeFull)
+{
+    cache.update({{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)}}, 10, true);
+    EXPECT_EQ(cache.get(ripple::uint256{kKEY1}, 10), blobOf(1));
+    EXPECT_EQ(cache.latestLedgerSequence(), 10);
+
+    cache.update({{.key = ripple::uint256{kKEY2}, .blob = blobOf(2)}}, 11);
+    EXPECT_EQ(cache.get(ripple::uint256{kKEY1}, 11), blobOf(1));
+    EXPECT_EQ(cache.get(ripple::uint256{kKEY2}, 11), blobOf(2));
+    EXPECT_FALSE(cache.getSuccessor(ripple::uint256{kKEY1}, 11).has_value());
+
+    cache.setFull();
+    EXPECT_EQ(cache.get(ripple::uint256{kKEY1}, 11), blobOf(1));
+}
+
+TEST_F(LedgerCacheTest, GetReturnsObjectForNewerSequence)
+{
+    cache.update({{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)}}, 10);
+    cache.setFull();
+
+    EXPECT_EQ(cache.get(ripple::uint256{kKEY1}, 10), blobOf(1));
+    EXPECT_FALSE(cache.get(ripple::uint256{kKEY1}, 9).has_value());
+    EXPECT_FALSE(cache.get(ripple::uint256{kKEY1}, 11).has_value());
+    EXPECT_FALSE(cache.get(ripple::uint256{kKEY2}, 10).has_value());
+    EXPECT_EQ(cache.latestLedgerSequence(), 10);
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(LedgerCacheTest, BackgroundUpdateDoesNotOverwriteNewerData)
+{
+    cache.update({{.key = ripple::uint256{kKEY1}, .blob = blobOf(2)}}, 10);
+    cache.update({{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)}}, 5, true);
+    cache.setFull();
+
+    EXPECT_EQ(cache.get(ripple::uint256{kKEY1}, 10), blobOf(2));
+}
+
+TEST_F(LedgerCacheTest, BackgroundUpdateSkipsDeletedKeys)
+{
+    cache.update({{.key = ripple::uint256{kKEY1}, .blob = {}}}, 10);
+    cache.update({{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)}}, 5, true);
+    cache.setFull();
+
+    EXPECT_FALSE(cache.get(ripple::uint256{kKEY1}, 10).has_value());
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(LedgerCacheTest, SuccessorAndPredecessorRequireFullCache)
+{
+    cache.update({{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)}}, 10);
+
+    EXPECT_FALSE(cache.getSuccessor(ripple::uint256{}, 10).has_value());
+    EXPECT_FALSE(cache.getPredecessor(ripple::uint256{kKEY4}, 10).has_value());
+}
+
+TEST_F(LedgerCacheTest, SuccessorAndPredecessor)
+{
+    cache.update(
+        {{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)},
+         {.key = ripple::uint256{kKEY2}, .blob = blobOf(2)},
+         {.key = ripple::uint256{kKEY3}, .blob = blobOf(3)}},
+        10
+    );
+    cache.setFull();
+
+    auto succ = cache.getSuccessor(ripple::uint256{}, 10);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, ripple::uint256{kKEY1});
+
+    succ = cache.getSuccessor(ripple::uint256{kKEY2}, 10);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, ripple::uint256{kKEY3});
+    EXPECT_EQ(succ->blob, blobOf(3));
+
+    EXPECT_FALSE(cache.getSuccessor(ripple::uint256{kKEY3}, 10).has_value());
+    EXPECT_FALSE(cache.getSuccessor(ripple::uint256{}, 9).has_value());
+
+    auto pred = cache.getPredecessor(ripple::uint256{kKEY4}, 10);
+    ASSERT_TRUE(pred.has_value());
+    EXPECT_EQ(pred->key, ripple::uint256{kKEY3});
+
+    pred = cache.getPredecessor(ripple::uint256{kKEY3}, 10);
+    ASSERT_TRUE(pred.has_value());
+    EXPECT_EQ(pred->key, ripple::uint256{kKEY2});
+
+    EXPECT_FALSE(cache.getPredecessor(ripple::uint256{kKEY1}, 10).has_value());
+}
+
+TEST_F(LedgerCacheTest, SuccessorSkipsDeletedObjects)
+{
+    cache.update(
+        {{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)},
+         {.key = ripple::uint256{kKEY2}, .blob = blobOf(2)},
+         {.key = ripple::uint256{kKEY3}, .blob = blobOf(3)}},
+        10
+    );
+    cache.setFull();
+    cache.update({{.key = ripple::uint256{kKEY2}, .blob = {}}}, 11);
+
+    auto const succ = cache.getSuccessor(ripple::uint256{kKEY1}, 11);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, ripple::uint256{kKEY3});
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST_F(LedgerCacheTest, RecentSnapshotsStayReadable)
+{
+    cache.update(
+        {{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)}, {.key = ripple::uint256{kKEY3}, .blob = blobOf(3)}}, 10
+    );
+    cache.setFull();
+    cache.update({{.key = ripple::uint256{kKEY2}, .blob = blobOf(2)}}, 11);
+    cache.update({{.key = ripple::uint256{kKEY1}, .blob = {}}}, 12);
+
+    auto succ = cache.getSuccessor(ripple::uint256{kKEY1}, 10);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, ripple::uint256{kKEY3});
+
+    succ = cache.getSuccessor(ripple::uint256{kKEY1}, 11);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, ripple::uint256{kKEY2});
+
+    EXPECT_EQ(cache.get(ripple::uint256{kKEY1}, 11), blobOf(1));
+    EXPECT_FALSE(cache.get(ripple::uint256{kKEY1}, 12).has_value());
+
+    for (uint32_t seq = 13; seq < 13 + LedgerCache::kSNAPSHOT_HISTORY_SIZE; ++seq)
+        cache.update({}, seq);
+
+    EXPECT_FALSE(cache.getSuccessor(ripple::uint256{kKEY1}, 10).has_value());
+}
+
+TEST_F(LedgerCacheTest, GetViewReturnsStoredData)
+{
+    cache.update({{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)}}, 10);
+    cache.setFull();
+
+    auto const view = cache.getView(ripple::uint256{kKEY1}, 10);
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->key(), ripple::uint256{kKEY1});
+    EXPECT_EQ(view->seq(), 10);
+    EXPECT_EQ(view->toBlob(), blobOf(1));
+    EXPECT_FALSE(cache.getView(ripple::uint256{kKEY1}, 9).has_value());
+}
+
+TEST_F(LedgerCacheTest, ViewOutlivesOverwrite)
+{
+    cache.update({{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)}}, 10);
+    cache.setFull();
+    auto const view = cache.getView(ripple::uint256{kKEY1}, 10);
+
+    for (uint32_t seq = 11; seq < 11 + LedgerCache::kSNAPSHOT_HISTORY_SIZE; ++seq)
+        cache.update({{.key = ripple::uint256{kKEY1}, .blob = blobOf(static_cast<unsigned char>(seq))}}, seq);
+
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->toBlob(), blobOf(1));
+}
+
+TEST_F(LedgerCacheTest, SuccessorKeys)
+{
+    cache.update(
+        {{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)},
+         {.key = ripple::uint256{kKEY2}, .blob = blobOf(2)},
+         {.key = ripple::uint256{kKEY3}, .blob = blobOf(3)},
+         {.key = ripple::uint256{kKEY4}, .blob = blobOf(4)}},
+        10
+    );
+    EXPECT_FALSE(cache.getSuccessorKeys(kFIRST_KEY, kLAST_KEY, 10, 4).has_value());
+
+    cache.setFull();
+    EXPECT_EQ(
+        cache.getSuccessorKeys(kFIRST_KEY, kLAST_KEY, 10, 4),
+        (std::vector{ripple::uint256{kKEY1}, ripple::uint256{kKEY2}, ripple::uint256{kKEY3}, ripple::uint256{kKEY4}})
+    );
+    EXPECT_EQ(
+        cache.getSuccessorKeys(ripple::uint256{kKEY1}, kLAST_KEY, 10, 2),
+        (std::vector{ripple::uint256{kKEY2}, ripple::uint256{kKEY3}})
+    );
+    EXPECT_EQ(
+        cache.getSuccessorKeys(ripple::uint256{kKEY1}, ripple::uint256{kKEY3}, 10, 10),
+        std::vector{ripple::uint256{kKEY2}}
+    );
+    EXPECT_EQ(cache.getSuccessorKeys(ripple::uint256{kKEY4}, kLAST_KEY, 10, 10), std::vector<ripple::uint256>{});
+    EXPECT_FALSE(cache.getSuccessorKeys(kFIRST_KEY, kLAST_KEY, 9, 4).has_value());
+}
+
+TEST_F(LedgerCacheTest, CursorsRequireFullCache)
+{
+    cache.update({{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)}}, 10);
+    EXPECT_TRUE(cache.getCursors(10, 2).empty());
+
+    cache.setFull();
+    EXPECT_EQ(cache.getCursors(10, 2).size(), 1);
+    EXPECT_TRUE(cache.getCursors(9, 2).empty());
+}
+
+TEST_F(LedgerCacheTest, CursorsCoverCacheOnce)
+{
+    cache.update(
+        {{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)},
+         {.key = ripple::uint256{kKEY2}, .blob = blobOf(2)},
+         {.key = ripple::uint256{kKEY3}, .blob = blobOf(3)},
+         {.key = ripple::uint256{kKEY4}, .blob = blobOf(4)}},
+        10
+    );
+    cache.setFull();
+
+    auto cursors = cache.getCursors(10, 3);
+    ASSERT_EQ(cursors.size(), 3);
+
+    // the cursors read their snapshot even after the cache moved on
+    cache.update({{.key = ripple::uint256{kKEY2}, .blob = {}}}, 11);
+
+    std::vector<LedgerObject> walked;
+    for (auto& cursor : cursors) {
+        while (auto const item = cursor.next())
+            walked.push_back({.key = *item->key, .blob = item->blob->toBlob()});
+    }
+
+    std::vector<LedgerObject> const expected = {
+        {.key = ripple::uint256{kKEY1}, .blob = blobOf(1)},
+        {.key = ripple::uint256{kKEY2}, .blob = blobOf(2)},
+        {.key = ripple::uint256{kKEY3}, .blob = blobOf(3)},
+        {.key = ripple::uint256{kKEY4}, .blob = blobOf(4)}
+    };
+    EXPECT_EQ(walked, expected);
+}
+
+struct LedgerCachePartialTest : LedgerCacheTest {
+    LedgerCachePartialTest()
+    {
+        cache.setPartial(1024 * 1024);
+        cache.update({}, 10);
+    }
+};
+
+TEST_F(LedgerCachePartialTest, FillAtLatestSequence)
+{
+    EXPECT_TRUE(cache.isPartial());
+    EXPECT_FALSE(cache.get(ripple::uint256{kKEY1}, 10).has_value());
+
+    cache.fill(ripple::uint256{kKEY1}, 10, blobOf(1));
+
+    EXPECT_EQ(cache.get(ripple::uint256{kKEY1}, 10), blobOf(1));
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(LedgerCachePartialTest, FillIgnoresStaleSequence)
+{
+    cache.fill(ripple::uint256{kKEY1}, 9, blobOf(1));
+
+    EXPECT_FALSE(cache.get(ripple::uint256{kKEY1}, 9).has_value());
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(LedgerCachePartialTest, UpdateKeepsCachedObjectsCurrent)
+{
+    cache.fill(ripple::uint256{kKEY1}, 10, blobOf(1));
+    cache.fill(ripple::uint256{kKEY2}, 10, blobOf(2));
+
+    cache.update({{.key = ripple::uint256{kKEY1}, .blob = blobOf(3)}, {.key = ripple::uint256{kKEY2}, .blob = {}}}, 11);
+
+    EXPECT_EQ(cache.get(ripple::uint256{kKEY1}, 11), blobOf(3));
+    EXPECT_FALSE(cache.get(ripple::uint256{kKEY2}, 11).has_value());
+    EXPECT_FALSE(cache.get(ripple::uint256{kKEY1}, 12).has_value());
+}
+
+TEST_F(LedgerCachePartialTest, SuccessorAlwaysMisses)
+{
+    cache.fill(ripple::uint256{kKEY1}, 10, blobOf(1));
+    cache.setFull();
+
+    EXPECT_FALSE(cache.isFull());
+    EXPECT_FALSE(cache.getSuccessor(ripple::uint256{kKEY1}, 10).has_value());
+    EXPECT_FALSE(cache.getPredecessor(ripple::uint256{kKEY2}, 10).has_value());
+}
+
+struct LedgerCacheFileTest : LedgerCacheTest {
+    TmpFile file{""};
+    LedgerCache::DiffFetcher const noDiffs = [](uint32_t) { return std::optional{std::vector<LedgerObject>{}}; };
+
+    void
+    populate()
+    {
+        cache.update(
+            {{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)},
+             {.key = ripple::uint256{kKEY2}, .blob = blobOf(2)},
+             {.key = ripple::uint256{kKEY3}, .blob = blobOf(3)}},
+            10
+        );
+        cache.setFull();
+    }
+};
+
+TEST_F(LedgerCacheFileTest, SaveRequiresFullCache)
+{
+    cache.update({{.key = ripple::uint256{kKEY1}, .blob = blobOf(1)}}, 10);
+    EXPECT_FALSE(cache.saveToFile(file.path).has_value());
+}
+
+TEST_F(LedgerCacheFileTest, SaveAndLoad)
+{
+    populate();
+    auto const saved = cache.saveToFile(file.path);
+    ASSERT_TRUE(saved.has_value());
+    EXPECT_EQ(*saved, 10);
+
+    std::map<uint32_t, std::vector<LedgerObject>> const diffs{
+        {11, {{.key = ripple::uint256{kKEY2}, .blob = {}}}},
+        {12, {{.key = ripple::uint256{kKEY1}, .blob = blobOf(4)}}},
+    };
+
+    LedgerCache loaded;
+    auto const seq = loaded.loadFromFile(file.path, 10, 12, [&](uint32_t diffSeq) {
+        // the file is not visible before it has caught up
+        EXPECT_EQ(loaded.size(), 0);
+        return std::optional{diffs.at(diffSeq)};
+    });
+    ASSERT_TRUE(seq.has_value());
+    EXPECT_EQ(*seq, 10);
+    EXPECT_EQ(loaded.latestLedgerSequence(), 12);
+    EXPECT_EQ(loaded.size(), 2);
+    EXPECT_FALSE(loaded.isFull());
+
+    loaded.setFull();
+
+    EXPECT_EQ(loaded.get(ripple::uint256{kKEY1}, 12), blobOf(4));
+    EXPECT_FALSE(loaded.get(ripple::uint256{kKEY2}, 12).has_value());
+    EXPECT_EQ(loaded.get(ripple::uint256{kKEY3}, 12), blobOf(3));
+
+    auto const succ = loaded.getSuccessor(ripple::uint256{kKEY1}, 12);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, ripple::uint256{kKEY3});
+}
+
+TEST_F(LedgerCacheFileTest, LoadKeepsUpdatesMadeWhileCatchingUp)
+{
+    populate();
+    ASSERT_TRUE(cache.saveToFile(file.path).has_value());
+
+    LedgerCache loaded;
+    auto const seq = loaded.loadFromFile(file.path, 10, 11, [&](uint32_t diffSeq) {
+        // the next ledger is written while the file catches up
+        loaded.update(
+            {{.key = ripple::uint256{kKEY1}, .blob = blobOf(5)},
+             {.key = ripple::uint256{kKEY3}, .blob = {}},
+             {.key = ripple::uint256{kKEY4}, .blob = blobOf(6)}},
+            12
+        );
+        EXPECT_EQ(loaded.get(ripple::uint256{kKEY4}, 12), blobOf(6));
+        EXPECT_FALSE(loaded.get(ripple::uint256{kKEY2}, 12).has_value());
+
+        return std::optional{std::vector<LedgerObject>{
+            {.key = ripple::uint256{kKEY1}, .blob = blobOf(4)}, {.key = ripple::uint256{kKEY3}, .blob = blobOf(7)}
+        }};
+    });
+    ASSERT_TRUE(seq.has_value());
+    EXPECT_EQ(loaded.latestLedgerSequence(), 12);
+
+    EXPECT_EQ(loaded.get(ripple::uint256{kKEY1}, 12), blobOf(5));
+    EXPECT_EQ(loaded.get(ripple::uint256{kKEY2}, 12), blobOf(2));
+    EXPECT_FALSE(loaded.get(ripple::uint256{kKEY3}, 12).has_value());
+    EXPECT_EQ(loaded.get(ripple::uint256{kKEY4}, 12), blobOf(6));
+}
+
+TEST_F(LedgerCacheFileTest, LoadStopsWhenADiffIsMissing)
+{
+    populate();
+    ASSERT_TRUE(cache.saveToFile(file.path).has_value());
+
+    LedgerCache::DiffFetcher const missing = [](uint32_t) { return std::optional<std::vector<LedgerObject>>{}; };
+
+    LedgerCache loaded;
+    EXPECT_FALSE(loaded.loadFromFile(file.path, 10, 12, missing).has_value());
+    EXPECT_EQ(loaded.size(), 0);
+    EXPECT_EQ(loaded.latestLedgerSequence(), 0);
+}
+
+TEST_F(LedgerCacheFileTest, ReadSplitsRecordsIntoSegments)
+{
+    populate();
+    ASSERT_TRUE(cache.saveToFile(file.path).has_value());
+
+    // a segment of two records stands in for the 4 GiB a segment can address
+    auto constexpr kRECORD_SIZE = impl::BlobSegment::kRECORD_HEADER_SIZE + 3;
+    auto const data = impl::LedgerCacheFile::read(file.path, 2 * kRECORD_SIZE + 1);
+    ASSERT_TRUE(data.has_value());
+    EXPECT_EQ(data->count, 3);
+    ASSERT_EQ(data->segments.size(), 2);
+    EXPECT_EQ(data->segments[0]->used(), 2 * kRECORD_SIZE);
+    EXPECT_EQ(data->segments[1]->used(), kRECORD_SIZE);
+
+    std::vector<ripple::uint256> keys;
+    for (auto const& segment : data->segments) {
+        impl::BlobArena::forEachRecord(segment, [&](impl::BlobRef const& record) { keys.push_back(record.key()); });
+    }
+    EXPECT_EQ(keys, (std::vector{ripple::uint256{kKEY1}, ripple::uint256{kKEY2}, ripple::uint256{kKEY3}}));
+}
+
+TEST_F(LedgerCacheFileTest, ReadRejectsRecordLargerThanASegment)
+{
+    populate();
+    ASSERT_TRUE(cache.saveToFile(file.path).has_value());
+
+    EXPECT_FALSE(impl::LedgerCacheFile::read(file.path, impl::BlobSegment::kRECORD_HEADER_SIZE).has_value());
+}
+
+TEST_F(LedgerCacheFileTest, LoadRejectsSequenceOutOfRange)
+{
+    populate();
+    ASSERT_TRUE(cache.saveToFile(file.path).has_value());
+
+    LedgerCache loaded;
+    EXPECT_FALSE(loaded.loadFromFile(file.path, 11, 20, noDiffs).has_value());
+    EXPECT_FALSE(loaded.loadFromFile(file.path, 1, 9, noDiffs).has_value());
+    EXPECT_EQ(loaded.size(), 0);
+}
+
+TEST_F(LedgerCacheFileTest, LoadRejectsCorruptFile)
+{
+    populate();
+    ASSERT_TRUE(cache.saveToFile(file.path).has_value());
+
+    {
+        std::fstream stream{file.path, std::ios::in | std::ios::out | std::ios::binary};
+        stream.seekp(-1, std::ios::end);
+        stream.put('\xFF');
+    }
+
+    LedgerCache loaded;
+    EXPECT_FALSE(loaded.loadFromFile(file.path, 10, 10, noDiffs).has_value());
+    EXPECT_EQ(loaded.size(), 0);
+}
+
+TEST_F(LedgerCacheFileTest, LoadRejectsMissingFile)
+{
+    LedgerCache loaded;
+    EXPECT_FALSE(loaded.loadFromFile(file.path + ".missing", 0, 10, noDiffs).has_value());
+}
+
+TEST_F(LedgerCacheFileTest, LoadRejectsFullCache)
+{
+    populate();
+    ASSERT_TRUE(cache.saveToFile(file.path).has_value());
+    EXPECT_FALSE(cache.loadFromFile(file.path, 10, 10, noDiffs).has_value());
+}
+
+struct LedgerCacheTreeTest : ::testing::Test {
+    impl::BlobArena arena;
+
+    impl::LedgerCacheTree::Write
+    makeWrite(ripple::uint256 const& key, uint32_t seq, std::optional<Blob> const& blob)
+    {
+        if (not blob.has_value())
+            return {.key = key, .blob = {}};
+        return {.key = key, .blob = arena.store(key, seq, *blob)};
+    }
+};
+
+TEST_F(LedgerCacheTreeTest, MatchesOrderedMap)
+{
+    impl::LedgerCacheTree tree;
+    std::map<ripple::uint256, Blob> expected;
+
+    constexpr auto kNODE_SIZE = impl::LedgerCacheTree::kMAX_NODE_SIZE;
+    constexpr std::size_t kKEY_SPACE = kNODE_SIZE * kNODE_SIZE * 4;
+    constexpr std::size_t kBATCHES = 16;
+    for (std::size_t batch = 0; batch < kBATCHES; ++batch) {
+        std::vector<impl::LedgerCacheTree::Write> writes;
+        for (std::size_t i = batch; i < kKEY_SPACE; i += batch + 1) {
+            auto const key = ripple::uint256{(i * 7919) % kKEY_SPACE};
+            auto const seq = static_cast<uint32_t>(batch + 1);
+            if ((i + batch) % 3 == 0) {
+                writes.push_back(makeWrite(key, seq, std::nullopt));
+                expected.erase(key);
+            } else {
+                writes.push_back(makeWrite(key, seq, blobOf(static_cast<unsigned char>(i))));
+                expected[key] = blobOf(static_cast<unsigned char>(i));
+            }
+        }
+        tree = tree.apply(writes);
+    }
+
+    ASSERT_EQ(tree.size(), expected.size());
+    for (std::size_t i = 0; i <= kKEY_SPACE; ++i) {
+        auto const key = ripple::uint256{i};
+
+        auto const* found = tree.find(key);
+        auto const it = expected.find(key);
+        ASSERT_EQ(found != nullptr, it != expected.end());
+        if (found != nullptr)
+            EXPECT_EQ(found->toBlob(), it->second);
+
+        auto const succ = tree.successor(key);
+        auto const upper = expected.upper_bound(key);
+        ASSERT_EQ(succ.has_value(), upper != expected.end());
+        if (succ.has_value())
+            EXPECT_EQ(*succ->key, upper->first);
+
+        auto const pred = tree.predecessor(key);
+        auto const lower = expected.lower_bound(key);
+        ASSERT_EQ(pred.has_value(), lower != expected.begin());
+        if (pred.has_value())
+            EXPECT_EQ(*pred->key, std::prev(lower)->first);
+    }
+}
+
+TEST_F(LedgerCacheTreeTest, CursorsWalkRangesInKeyOrder)
+{
+    constexpr std::size_t kSIZE = impl::LedgerCacheTree::kMAX_NODE_SIZE * impl::LedgerCacheTree::kMAX_NODE_SIZE * 3;
+    std::vector<impl::LedgerCacheTree::Write> writes;
+    for (std::size_t i = 0; i < kSIZE; ++i)
+        writes.push_back(makeWrite(ripple::uint256{i * 2}, 1, blobOf(1)));
+    auto const tree = impl::LedgerCacheTree{}.apply(writes);
+
+    for (auto const [begin, end] : std::vector<std::pair<std::size_t, std::size_t>>{
+             {0, kSIZE}, {0, 1}, {31, 33}, {1000, 2100}, {kSIZE - 1, kSIZE + 5}
+         }) {
+        auto cursor = tree.cursor(begin, end);
+        EXPECT_EQ(cursor.remaining(), std::min(end, kSIZE) - begin);
+        for (auto i = begin; i < std::min(end, kSIZE); ++i) {
+            auto const item = cursor.next();
+            ASSERT_TRUE(item.has_value());
+            EXPECT_EQ(*item->key, ripple::uint256{i * 2});
+        }
+        EXPECT_FALSE(cursor.next().has_value());
+    }
+
+    EXPECT_FALSE(tree.cursor(kSIZE, kSIZE + 1).next().has_value());
+
+    EXPECT_EQ(tree.rank(ripple::uint256{0uz}), 1);
+    EXPECT_EQ(tree.rank(ripple::uint256{1uz}), 1);
+    EXPECT_EQ(tree.rank(ripple::uint256{1001uz}), 501);
+    EXPECT_EQ(tree.rank(ripple::uint256{kSIZE * 2}), kSIZE);
+    EXPECT_FALSE(impl::LedgerCacheTree{}.cursor(0, 1).next().has_value());
+}
+
+TEST_F(LedgerCacheTreeTest, ApplyKeepsPreviousVersion)
+{
+    std::vector writes{makeWrite(ripple::uint256{1}, 10, blobOf(1))};
+    auto const first = impl::LedgerCacheTree{}.apply(writes);
+
+    writes = {makeWrite(ripple::uint256{1}, 11, std::nullopt), makeWrite(ripple::uint256{2}, 11, blobOf(2))};
+    auto const second = first.apply(writes);
+
+    ASSERT_NE(first.find(ripple::uint256{1}), nullptr);
+    EXPECT_EQ(first.find(ripple::uint256{2}), nullptr);
+    EXPECT_EQ(second.find(ripple::uint256{1}), nullptr);
+    ASSERT_NE(second.find(ripple::uint256{2}), nullptr);
+}
+
+TEST_F(LedgerCacheTreeTest, OlderSequenceDoesNotOverwrite)
+{
+    std::vector writes{makeWrite(ripple::uint256{1}, 10, blobOf(1)), makeWrite(ripple::uint256{1}, 9, blobOf(2))};
+    std::vector<Blob> dropped;
+    auto const tree = impl::LedgerCacheTree{}.apply(writes, [&](auto const& blob) {
+        dropped.push_back(blob.toBlob());
+    });
+
+    auto const* found = tree.find(ripple::uint256{1});
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->seq(), 10);
+    EXPECT_EQ(found->toBlob(), blobOf(1));
+    EXPECT_EQ(dropped, std::vector<Blob>{blobOf(2)});
+}
+
+TEST_F(LedgerCacheTreeTest, ReplacedAndErasedEntriesAreDropped)
+{
+    std::vector writes{makeWrite(ripple::uint256{1}, 10, blobOf(1)), makeWrite(ripple::uint256{2}, 10, blobOf(2))};
+    auto const first = impl::LedgerCacheTree{}.apply(writes);
+
+    std::vector<Blob> dropped;
+    writes = {makeWrite(ripple::uint256{1}, 11, blobOf(3)), makeWrite(ripple::uint256{2}, 11, std::nullopt)};
+    auto const second = first.apply(writes, [&](auto const& blob) { dropped.push_back(blob.toBlob()); });
+
+    EXPECT_EQ(second.size(), 1);
+    EXPECT_EQ(dropped, (std::vector<Blob>{blobOf(1), blobOf(2)}));
+}
+
+TEST_F(LedgerCacheTreeTest, RelocationReplacesSameSequence)
+{
+    std::vector writes{makeWrite(ripple::uint256{1}, 10, blobOf(1))};
+    auto const first = impl::LedgerCacheTree{}.apply(writes);
+
+    auto relocated = makeWrite(ripple::uint256{1}, 10, blobOf(1));
+    auto const moved = relocated.blob;
+    writes = {relocated};
+    EXPECT_TRUE(first.apply(writes).find(ripple::uint256{1})->isSameRecord(*first.find(ripple::uint256{1})));
+
+    relocated.relocation = true;
+    writes = {relocated};
+    EXPECT_TRUE(first.apply(writes).find(ripple::uint256{1})->isSameRecord(moved));
+}
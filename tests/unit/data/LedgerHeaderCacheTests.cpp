@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2022, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerHeaderCache.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <cstdint>
+
+using namespace data;
+
+namespace {
+
+ripple::LedgerHeader
+makeHeader(uint32_t seq)
+{
+    ripple::LedgerHeader header;
+    header.seq = seq;
+    header.hash = ripple::uint256{seq};
+    return header;
+}
+
+}  // namespace
+
+TEST(LedgerHeaderCacheTest, GetBySequenceAndHash)
+{
+    LedgerHeaderCache cache;
+    cache.put(makeHeader(10));
+
+    ASSERT_TRUE(cache.getBySequence(10).has_value());
+    EXPECT_EQ(cache.getBySequence(10)->hash, ripple::uint256{10});
+    ASSERT_TRUE(cache.getByHash(ripple::uint256{10}).has_value());
+    EXPECT_EQ(cache.getByHash(ripple::uint256{10})->seq, 10);
+
+    EXPECT_FALSE(cache.getBySequence(11).has_value());
+    EXPECT_FALSE(cache.getByHash(ripple::uint256{11}).has_value());
+}
+
+TEST(LedgerHeaderCacheTest, PutSameSequenceTwice)
+{
+    LedgerHeaderCache cache;
+    cache.put(makeHeader(10));
+    cache.put(makeHeader(10));
+
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(LedgerHeaderCacheTest, EvictsLeastRecentlyUsed)
+{
+    LedgerHeaderCache cache{2};
+    cache.put(makeHeader(1));
+    cache.put(makeHeader(2));
+    EXPECT_TRUE(cache.getBySequence(1).has_value());
+
+    cache.put(makeHeader(3));
+
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_TRUE(cache.getBySequence(1).has_value());
+    EXPECT_FALSE(cache.getBySequence(2).has_value());
+    EXPECT_FALSE(cache.getByHash(ripple::uint256{2}).has_value());
+    EXPECT_TRUE(cache.getByHash(ripple::uint256{3}).has_value());
+}
+
+TEST(LedgerHeaderCacheTest, ZeroCapacityCachesNothing)
+{
+    LedgerHeaderCache cache{0};
+    cache.put(makeHeader(1));
+
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.getBySequence(1).has_value());
+}
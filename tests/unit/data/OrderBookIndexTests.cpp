@@ -0,0 +1,309 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCache.hpp"
+#include "data/Types.hpp"
+#include "data/impl/BlobArena.hpp"
+#include "data/impl/LedgerCacheTree.hpp"
+#include "data/impl/OrderBookIndex.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/TestObject.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/UintTypes.h>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr auto kBOOK = "1000000000000000000000000000000000000000000000000000000000000000";
+constexpr auto kOTHER_BOOK = "2000000000000000000000000000000000000000000000000000000000000000";
+constexpr auto kQUALITY1 = "1000000000000000000000000000000000000000000000000000000000000001";
+constexpr auto kQUALITY2 = "1000000000000000000000000000000000000000000000000000000000000002";
+constexpr auto kOTHER_QUALITY = "2000000000000000000000000000000000000000000000000000000000000001";
+constexpr auto kOWNER_DIR = "3000000000000000000000000000000000000000000000000000000000000000";
+constexpr auto kNFT_OFFERS_DIR = "4000000000000000000000000000000000000000000000000000000000000000";
+constexpr auto kACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+
+constexpr auto kOFFER1 = "A000000000000000000000000000000000000000000000000000000000000001";
+constexpr auto kOFFER2 = "A000000000000000000000000000000000000000000000000000000000000002";
+constexpr auto kOFFER3 = "A000000000000000000000000000000000000000000000000000000000000003";
+constexpr auto kOFFER4 = "A000000000000000000000000000000000000000000000000000000000000004";
+constexpr auto kOFFER5 = "A000000000000000000000000000000000000000000000000000000000000005";
+
+Blob
+makeDirPage(std::vector<ripple::uint256> indexes, std::string_view rootIndex, uint64_t next = 0)
+{
+    auto dir = createOwnerDirLedgerObject(std::move(indexes), rootIndex);
+    dir.setFieldH160(ripple::sfTakerPaysCurrency, ripple::xrpCurrency());
+    dir.setFieldU64(ripple::sfExchangeRate, 1);
+    if (next != 0)
+        dir.setFieldU64(ripple::sfIndexNext, next);
+    return dir.getSerializer().peekData();
+}
+
+Blob
+makeNftOffersPage(std::vector<ripple::uint256> indexes, std::string_view rootIndex)
+{
+    auto dir = createOwnerDirLedgerObject(std::move(indexes), rootIndex);
+    dir.setFieldH256(ripple::sfNFTokenID, ripple::uint256{kOFFER5});
+    return dir.getSerializer().peekData();
+}
+
+std::vector<ripple::uint256>
+keysOf(impl::OrderBookIndex::Book const* book)
+{
+    std::vector<ripple::uint256> keys;
+    if (book == nullptr)
+        return keys;
+
+    for (auto const& directory : *book)
+        keys.insert(keys.end(), directory.offers->begin(), directory.offers->end());
+    return keys;
+}
+
+Blob
+makeOwnerDirPage(std::vector<ripple::uint256> indexes, std::string_view rootIndex)
+{
+    auto dir = createOwnerDirLedgerObject(std::move(indexes), rootIndex);
+    dir.setAccountID(ripple::sfOwner, getAccountIdWithString(kACCOUNT));
+    return dir.getSerializer().peekData();
+}
+
+Blob
+offerBlob(unsigned char value)
+{
+    return Blob{value, value, value};
+}
+
+}  // namespace
+
+struct OrderBookIndexTest : ::testing::Test {
+    impl::BlobArena arena;
+    impl::LedgerCacheTree tree;
+    uint32_t seq = 1;
+
+    ripple::uint256 const secondPage = ripple::keylet::page(ripple::uint256{kQUALITY1}, 1).key;
+
+    impl::LedgerCacheTree
+    apply(std::vector<impl::LedgerCacheTree::Write>& writes)
+    {
+        ++seq;
+        return tree = tree.apply(writes);
+    }
+
+    impl::LedgerCacheTree::Write
+    makeWrite(ripple::uint256 const& key, std::optional<Blob> const& blob)
+    {
+        if (not blob.has_value())
+            return {.key = key, .blob = {}};
+        return {.key = key, .blob = arena.store(key, seq, *blob)};
+    }
+
+    void
+    populate()
+    {
+        std::vector<impl::LedgerCacheTree::Write> writes{
+            makeWrite(
+                ripple::uint256{kQUALITY1},
+                makeDirPage({ripple::uint256{kOFFER1}, ripple::uint256{kOFFER2}}, kQUALITY1, 1)
+            ),
+            makeWrite(secondPage, makeDirPage({ripple::uint256{kOFFER3}}, kQUALITY1)),
+            makeWrite(ripple::uint256{kQUALITY2}, makeDirPage({ripple::uint256{kOFFER4}}, kQUALITY2)),
+            makeWrite(ripple::uint256{kOTHER_QUALITY}, makeDirPage({ripple::uint256{kOFFER5}}, kOTHER_QUALITY)),
+            makeWrite(ripple::uint256{kOWNER_DIR}, makeOwnerDirPage({ripple::uint256{kOFFER1}}, kOWNER_DIR)),
+            makeWrite(
+                ripple::uint256{kNFT_OFFERS_DIR}, makeNftOffersPage({ripple::uint256{kOFFER2}}, kNFT_OFFERS_DIR)
+            ),
+        };
+        apply(writes);
+    }
+};
+
+TEST_F(OrderBookIndexTest, BuildOrdersOffersByQualityAndPage)
+{
+    populate();
+    auto const index = impl::OrderBookIndex::build(tree);
+
+    EXPECT_EQ(index.size(), 2);
+    ASSERT_NE(index.offers(ripple::uint256{kBOOK}), nullptr);
+    EXPECT_EQ(index.offers(ripple::uint256{kBOOK})->size(), 2);
+    EXPECT_EQ(
+        keysOf(index.offers(ripple::uint256{kBOOK})),
+        (std::vector{
+            ripple::uint256{kOFFER1}, ripple::uint256{kOFFER2}, ripple::uint256{kOFFER3}, ripple::uint256{kOFFER4}
+        })
+    );
+    ASSERT_NE(index.offers(ripple::uint256{kOTHER_BOOK}), nullptr);
+    EXPECT_EQ(keysOf(index.offers(ripple::uint256{kOTHER_BOOK})), std::vector{ripple::uint256{kOFFER5}});
+    EXPECT_EQ(index.offers(ripple::uint256{kOFFER1}), nullptr);
+    EXPECT_EQ(index.offers(ripple::uint256{kNFT_OFFERS_DIR}), nullptr);
+}
+
+TEST_F(OrderBookIndexTest, UpdateRereadsTouchedDirectoriesOnly)
+{
+    populate();
+    auto const index = impl::OrderBookIndex::build(tree);
+    auto const* otherBook = index.offers(ripple::uint256{kOTHER_BOOK});
+    auto const secondQuality = index.offers(ripple::uint256{kBOOK})->back().offers;
+
+    auto const before = tree;
+    std::vector<impl::LedgerCacheTree::Write> writes{
+        makeWrite(ripple::uint256{kQUALITY1}, makeDirPage({ripple::uint256{kOFFER2}}, kQUALITY1)),
+        makeWrite(secondPage, std::nullopt),
+    };
+    auto const updated = index.update(before, apply(writes), writes);
+
+    EXPECT_EQ(
+        keysOf(updated.offers(ripple::uint256{kBOOK})),
+        (std::vector{ripple::uint256{kOFFER2}, ripple::uint256{kOFFER4}})
+    );
+    EXPECT_EQ(updated.offers(ripple::uint256{kBOOK})->back().offers, secondQuality);
+    EXPECT_EQ(updated.offers(ripple::uint256{kOTHER_BOOK}), otherBook);
+    EXPECT_EQ(keysOf(index.offers(ripple::uint256{kBOOK})).size(), 4);
+}
+
+TEST_F(OrderBookIndexTest, UpdateAddsNewDirectoriesInQualityOrder)
+{
+    std::vector<impl::LedgerCacheTree::Write> first{
+        makeWrite(ripple::uint256{kQUALITY2}, makeDirPage({ripple::uint256{kOFFER4}}, kQUALITY2))
+    };
+    apply(first);
+    auto const index = impl::OrderBookIndex::build(tree);
+
+    auto const before = tree;
+    std::vector<impl::LedgerCacheTree::Write> writes{
+        makeWrite(ripple::uint256{kQUALITY1}, makeDirPage({ripple::uint256{kOFFER1}}, kQUALITY1)),
+        makeWrite(ripple::uint256{kOTHER_QUALITY}, makeDirPage({ripple::uint256{kOFFER5}}, kOTHER_QUALITY)),
+    };
+    auto const updated = index.update(before, apply(writes), writes);
+
+    EXPECT_EQ(updated.size(), 2);
+    EXPECT_EQ(
+        keysOf(updated.offers(ripple::uint256{kBOOK})),
+        (std::vector{ripple::uint256{kOFFER1}, ripple::uint256{kOFFER4}})
+    );
+    EXPECT_EQ(keysOf(updated.offers(ripple::uint256{kOTHER_BOOK})), std::vector{ripple::uint256{kOFFER5}});
+    EXPECT_EQ(index.size(), 1);
+}
+
+TEST_F(OrderBookIndexTest, UpdateDropsEmptyBooks)
+{
+    populate();
+    auto const index = impl::OrderBookIndex::build(tree);
+
+    auto const before = tree;
+    std::vector<impl::LedgerCacheTree::Write> writes{makeWrite(ripple::uint256{kOTHER_QUALITY}, std::nullopt)};
+    auto const updated = index.update(before, apply(writes), writes);
+
+    EXPECT_EQ(updated.size(), 1);
+    EXPECT_EQ(updated.offers(ripple::uint256{kOTHER_BOOK}), nullptr);
+}
+
+TEST_F(OrderBookIndexTest, UpdateIgnoresOtherObjects)
+{
+    populate();
+    auto const index = impl::OrderBookIndex::build(tree);
+
+    auto const before = tree;
+    std::vector<impl::LedgerCacheTree::Write> writes{
+        makeWrite(ripple::uint256{kOFFER1}, offerBlob(1)),
+        makeWrite(ripple::uint256{kOWNER_DIR}, std::nullopt),
+        makeWrite(ripple::uint256{kNFT_OFFERS_DIR}, std::nullopt),
+    };
+    auto const updated = index.update(before, apply(writes), writes);
+
+    EXPECT_EQ(updated.offers(ripple::uint256{kBOOK}), index.offers(ripple::uint256{kBOOK}));
+    EXPECT_EQ(updated.offers(ripple::uint256{kOTHER_BOOK}), index.offers(ripple::uint256{kOTHER_BOOK}));
+}
+
+struct LedgerCacheBookOffersTest : util::prometheus::WithPrometheus {
+    LedgerCache cache;
+
+    void
+    populate(uint32_t seq)
+    {
+        cache.update(
+            {{.key = ripple::uint256{kQUALITY1},
+              .blob = makeDirPage({ripple::uint256{kOFFER1}, ripple::uint256{kOFFER2}}, kQUALITY1)},
+             {.key = ripple::uint256{kQUALITY2}, .blob = makeDirPage({ripple::uint256{kOFFER3}}, kQUALITY2)},
+             {.key = ripple::uint256{kOFFER1}, .blob = offerBlob(1)},
+             {.key = ripple::uint256{kOFFER2}, .blob = offerBlob(2)},
+             {.key = ripple::uint256{kOFFER3}, .blob = offerBlob(3)}},
+            seq
+        );
+    }
+};
+
+TEST_F(LedgerCacheBookOffersTest, RequiresFullCache)
+{
+    populate(10);
+    EXPECT_FALSE(cache.getBookOffers(ripple::uint256{kBOOK}, 10, 10).has_value());
+
+    cache.setFull();
+    EXPECT_TRUE(cache.getBookOffers(ripple::uint256{kBOOK}, 10, 10).has_value());
+    EXPECT_FALSE(cache.getBookOffers(ripple::uint256{kBOOK}, 9, 10).has_value());
+}
+
+TEST_F(LedgerCacheBookOffersTest, ReturnsOffersUpToLimit)
+{
+    populate(10);
+    cache.setFull();
+
+    auto const offers = cache.getBookOffers(ripple::uint256{kBOOK}, 10, 2);
+    ASSERT_TRUE(offers.has_value());
+    ASSERT_EQ(offers->size(), 2);
+    EXPECT_EQ((*offers)[0].key, ripple::uint256{kOFFER1});
+    EXPECT_EQ((*offers)[0].blob, offerBlob(1));
+    EXPECT_EQ((*offers)[1].key, ripple::uint256{kOFFER2});
+    EXPECT_EQ((*offers)[1].blob, offerBlob(2));
+
+    EXPECT_EQ(cache.getBookOffers(ripple::uint256{kOTHER_BOOK}, 10, 2), std::vector<LedgerObject>{});
+}
+
+TEST_F(LedgerCacheBookOffersTest, FollowsUpdates)
+{
+    populate(10);
+    cache.setFull();
+
+    cache.update(
+        {{.key = ripple::uint256{kQUALITY1}, .blob = {}},
+         {.key = ripple::uint256{kOFFER1}, .blob = {}},
+         {.key = ripple::uint256{kOFFER2}, .blob = {}},
+         {.key = ripple::uint256{kOFFER3}, .blob = offerBlob(4)}},
+        11
+    );
+
+    auto const offers = cache.getBookOffers(ripple::uint256{kBOOK}, 11, 10);
+    ASSERT_TRUE(offers.has_value());
+    ASSERT_EQ(offers->size(), 1);
+    EXPECT_EQ(offers->front().key, ripple::uint256{kOFFER3});
+    EXPECT_EQ(offers->front().blob, offerBlob(4));
+
+    EXPECT_EQ(cache.getBookOffers(ripple::uint256{kBOOK}, 10, 10)->size(), 3);
+}
@@ -42,7 +42,10 @@ generateDefaultCacheConfig()
          {"cache.num_cursors_from_diff", ConfigValue{ConfigType::Integer}.defaultValue(0)},
          {"cache.num_cursors_from_account", ConfigValue{ConfigType::Integer}.defaultValue(0)},
          {"cache.page_fetch_size", ConfigValue{ConfigType::Integer}.defaultValue(512)},
-         {"cache.load", ConfigValue{ConfigType::String}.defaultValue("async")}}
+         {"cache.load", ConfigValue{ConfigType::String}.defaultValue("async")},
+         {"cache.max_size_mb", ConfigValue{ConfigType::Integer}.optional()},
+         {"cache.file.path", ConfigValue{ConfigType::String}.optional()},
+         {"cache.file.max_sequence_age", ConfigValue{ConfigType::Integer}.defaultValue(5000)}}
     };
 }
 
@@ -134,3 +137,23 @@ TEST_F(CacheLoaderSettingsTest, NoLoadStyleCorrectlyPropagatedThroughConfig)
         EXPECT_TRUE(settings.isDisabled());
     }
 }
+
+TEST_F(CacheLoaderSettingsTest, CacheFileCorrectlyPropagatedThroughConfig)
+{
+    auto const cfg = getParseCacheConfig(
+        json::parse(R"({"cache": {"file": {"path": "/var/lib/clio/cache.bin", "max_sequence_age": 42}}})")
+    );
+    auto const settings = makeCacheLoaderSettings(cfg);
+
+    EXPECT_EQ(settings.cacheFilePath, "/var/lib/clio/cache.bin");
+    EXPECT_EQ(settings.cacheFileMaxSequenceAge, 42);
+}
+
+TEST_F(CacheLoaderSettingsTest, PartialCacheCorrectlyPropagatedThroughConfig)
+{
+    auto const cfg = getParseCacheConfig(json::parse(R"({"cache": {"max_size_mb": 42}})"));
+    auto const settings = makeCacheLoaderSettings(cfg);
+
+    EXPECT_EQ(settings.partialCacheMaxBytes, 42 * 1024 * 1024);
+    EXPECT_TRUE(settings.isPartial());
+}
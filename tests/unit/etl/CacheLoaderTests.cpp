@@ -36,6 +36,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <expected>
+#include <future>
+#include <string>
 #include <vector>
 
 namespace json = boost::json;
@@ -57,7 +61,10 @@ generateDefaultCacheConfig()
          {"cache.num_cursors_from_diff", ConfigValue{ConfigType::Integer}.defaultValue(0)},
          {"cache.num_cursors_from_account", ConfigValue{ConfigType::Integer}.defaultValue(0)},
          {"cache.page_fetch_size", ConfigValue{ConfigType::Integer}.defaultValue(512)},
-         {"cache.load", ConfigValue{ConfigType::String}.defaultValue("async")}}
+         {"cache.load", ConfigValue{ConfigType::String}.defaultValue("async")},
+         {"cache.max_size_mb", ConfigValue{ConfigType::Integer}.optional()},
+         {"cache.file.path", ConfigValue{ConfigType::String}.optional()},
+         {"cache.file.max_sequence_age", ConfigValue{ConfigType::Integer}.defaultValue(5000)}}
     };
 }
 
@@ -285,3 +292,156 @@ TEST_F(CacheLoaderTest, DisabledCacheLoaderCanCallStopAndWait)
     EXPECT_NO_THROW(loader.stop());
     EXPECT_NO_THROW(loader.wait());
 }
+
+TEST_F(CacheLoaderTest, LoadsFromFileAndCatchesUpWithDiffs)
+{
+    auto const cfg = getParseCacheConfig(
+        json::parse(R"({"cache": {"load": "sync", "file": {"path": "cache.bin", "max_sequence_age": 10}}})")
+    );
+    CacheLoader loader{cfg, backend_, cache};
+
+    EXPECT_CALL(cache, isFull).WillOnce(Return(false)).WillRepeatedly(Return(true));
+    EXPECT_CALL(cache, loadFromFile("cache.bin", kSEQ - 10, kSEQ, _))
+        .WillOnce([](auto&&, auto, auto, LedgerCache::DiffFetcher const& fetchDiff) {
+            EXPECT_TRUE(fetchDiff(kSEQ - 1).has_value());
+            EXPECT_TRUE(fetchDiff(kSEQ).has_value());
+            return std::expected<uint32_t, std::string>{kSEQ - 2};
+        });
+    EXPECT_CALL(*backend_, fetchLedgerDiff(kSEQ - 1, _)).WillOnce(Return(std::vector<LedgerObject>{}));
+    EXPECT_CALL(*backend_, fetchLedgerDiff(kSEQ, _)).WillOnce(Return(std::vector<LedgerObject>{}));
+    EXPECT_CALL(cache, setFull).Times(1);
+
+    loader.load(kSEQ);
+}
+
+TEST_F(CacheLoaderTest, LoadsFromFileInTheBackgroundWhenAsync)
+{
+    auto const cfg = getParseCacheConfig(
+        json::parse(R"({"cache": {"load": "async", "file": {"path": "cache.bin", "max_sequence_age": 10}}})")
+    );
+    CacheLoader loader{cfg, backend_, cache};
+
+    std::promise<void> entered;
+    std::promise<void> released;
+    auto const release = released.get_future().share();
+
+    EXPECT_CALL(cache, isFull).WillRepeatedly(Return(false));
+    EXPECT_CALL(cache, loadFromFile("cache.bin", kSEQ - 10, kSEQ, _))
+        .WillOnce([&entered, release](auto&&, auto, auto, LedgerCache::DiffFetcher const& fetchDiff) {
+            entered.set_value();
+            release.wait();
+            EXPECT_TRUE(fetchDiff(kSEQ).has_value());
+            return std::expected<uint32_t, std::string>{kSEQ - 1};
+        });
+    EXPECT_CALL(*backend_, fetchLedgerDiff(kSEQ, _)).WillOnce(Return(std::vector<LedgerObject>{}));
+    EXPECT_CALL(cache, setFull).Times(1);
+
+    // load returns while the file is still loading; the cache is only marked full once it finishes
+    loader.load(kSEQ);
+    entered.get_future().wait();
+
+    released.set_value();
+    loader.wait();
+}
+
+TEST_F(CacheLoaderTest, StoppingAsyncFileLoadDoesNotFallBackToDatabase)
+{
+    auto const cfg = getParseCacheConfig(json::parse(R"({"cache": {"load": "async", "file": {"path": "cache.bin"}}})"));
+    CacheLoader loader{cfg, backend_, cache};
+
+    std::promise<void> entered;
+    std::promise<void> released;
+    auto const release = released.get_future().share();
+
+    EXPECT_CALL(cache, isFull).WillRepeatedly(Return(false));
+    EXPECT_CALL(cache, loadFromFile).WillOnce([&entered, release](auto&&, auto, auto, auto const& fetchDiff) {
+        entered.set_value();
+        release.wait();
+        EXPECT_FALSE(fetchDiff(kSEQ).has_value());
+        return std::expected<uint32_t, std::string>{std::unexpected{std::string{"stopped"}}};
+    });
+    EXPECT_CALL(*backend_, fetchLedgerDiff).Times(0);
+    EXPECT_CALL(*backend_, doFetchSuccessorKey).Times(0);
+    EXPECT_CALL(cache, setFull).Times(0);
+
+    loader.load(kSEQ);
+    entered.get_future().wait();
+
+    loader.stop();
+    released.set_value();
+    loader.wait();
+}
+
+TEST_F(CacheLoaderTest, FallsBackToDatabaseWhenFileCantBeLoaded)
+{
+    auto const cfg = getParseCacheConfig(json::parse(R"({"cache": {"load": "sync", "file": {"path": "cache.bin"}}})"));
+    CacheLoader loader{cfg, backend_, cache};
+
+    auto const diffs = diffProvider.getLatestDiff();
+    auto const loops = diffs.size() + 1;
+    auto const keysSize = 14;
+
+    EXPECT_CALL(cache, loadFromFile).WillOnce(Return(std::unexpected{std::string{"bad checksum"}}));
+    EXPECT_CALL(*backend_, fetchLedgerDiff(_, _)).Times(32).WillRepeatedly(Return(diffs));
+    EXPECT_CALL(*backend_, doFetchSuccessorKey).Times(keysSize * loops).WillRepeatedly([this]() {
+        return diffProvider.nextKey(keysSize);
+    });
+
+    EXPECT_CALL(*backend_, doFetchLedgerObjects(_, kSEQ, _))
+        .Times(loops)
+        .WillRepeatedly(Return(std::vector<Blob>{keysSize - 1, Blob{'s'}}));
+
+    EXPECT_CALL(cache, isDisabled).WillRepeatedly(Return(false));
+    EXPECT_CALL(cache, updateImp).Times(loops);
+    EXPECT_CALL(cache, isFull).WillOnce(Return(false)).WillRepeatedly(Return(true));
+    EXPECT_CALL(cache, setFull).Times(1);
+
+    loader.load(kSEQ);
+}
+
+TEST_F(CacheLoaderTest, SaveWritesFullCacheToFile)
+{
+    auto const cfg = getParseCacheConfig(json::parse(R"({"cache": {"file": {"path": "cache.bin"}}})"));
+    CacheLoader loader{cfg, backend_, cache};
+
+    EXPECT_CALL(cache, isFull).WillOnce(Return(true));
+    EXPECT_CALL(cache, saveToFile("cache.bin")).WillOnce(Return(kSEQ));
+
+    loader.save();
+}
+
+TEST_F(CacheLoaderTest, SaveSkipsIncompleteCache)
+{
+    auto const cfg = getParseCacheConfig(json::parse(R"({"cache": {"file": {"path": "cache.bin"}}})"));
+    CacheLoader loader{cfg, backend_, cache};
+
+    EXPECT_CALL(cache, isFull).WillOnce(Return(false));
+    EXPECT_CALL(cache, saveToFile).Times(0);
+
+    loader.save();
+}
+
+TEST_F(CacheLoaderTest, SaveWithoutCacheFileDoesNothing)
+{
+    auto const cfg = getParseCacheConfig(json::parse(R"({"cache": {"load": "async"}})"));
+    CacheLoader loader{cfg, backend_, cache};
+
+    EXPECT_CALL(cache, saveToFile).Times(0);
+
+    loader.save();
+}
+
+TEST_F(CacheLoaderTest, PartialCacheIsNotLoaded)
+{
+    auto const cfg =
+        getParseCacheConfig(json::parse(R"({"cache": {"max_size_mb": 16, "file": {"path": "cache.bin"}}})"));
+    CacheLoader loader{cfg, backend_, cache};
+
+    EXPECT_CALL(cache, isFull).WillRepeatedly(Return(false));
+    EXPECT_CALL(cache, setPartial(16 * 1024 * 1024));
+    EXPECT_CALL(cache, loadFromFile).Times(0);
+    EXPECT_CALL(cache, updateImp).Times(0);
+    EXPECT_CALL(cache, setFull).Times(0);
+
+    loader.load(kSEQ);
+}
@@ -37,6 +37,8 @@
 #include <xrpl/protocol/LedgerHeader.h>
 
 #include <chrono>
+#include <cstdint>
+#include <optional>
 #include <vector>
 
 using namespace testing;
@@ -128,6 +130,21 @@ TEST_F(ETLLedgerPublisherTest, PublishLedgerHeaderIsWritingTrue)
     EXPECT_FALSE(backend_->fetchLedgerRange());
 }
 
+TEST_F(ETLLedgerPublisherTest, PublishLedgerHeaderCallsOnPublished)
+{
+    SystemState dummyState;
+    dummyState.isWriting = true;
+    auto const dummyLedgerHeader = createLedgerHeader(kLEDGER_HASH, kSEQ, kAGE);
+    impl::LedgerPublisher publisher(ctx_, backend_, mockCache, mockSubscriptionManagerPtr, dummyState);
+
+    std::optional<std::uint32_t> publishedSeq;
+    publisher.setOnPublished([&publishedSeq](std::uint32_t seq) { publishedSeq = seq; });
+    publisher.publish(dummyLedgerHeader);
+
+    ctx_.run();
+    EXPECT_EQ(publishedSeq, kSEQ);
+}
+
 TEST_F(ETLLedgerPublisherTest, PublishLedgerHeaderInRange)
 {
     SystemState dummyState;
@@ -294,3 +311,40 @@ TEST_F(ETLLedgerPublisherTest, PublishMultipleTxInOrder)
     // last publish time should be set
     EXPECT_TRUE(publisher.lastPublishAgeSeconds() <= 1);
 }
+
+TEST_F(ETLLedgerPublisherTest, PublishWrittenTransactionsWithoutFetching)
+{
+    SystemState dummyState;
+    dummyState.isWriting = true;
+
+    auto const dummyLedgerHeader = createLedgerHeader(kLEDGER_HASH, kSEQ, 0);  // age is 0
+    impl::LedgerPublisher publisher(ctx_, backend_, mockCache, mockSubscriptionManagerPtr, dummyState);
+    backend_->setRange(kSEQ - 1, kSEQ);
+
+    TransactionAndMetadata t1;
+    t1.transaction = createPaymentTransactionObject(kACCOUNT, kACCOUNT2, 100, 3, kSEQ).getSerializer().peekData();
+    t1.metadata = createPaymentTransactionMetaObject(kACCOUNT, kACCOUNT2, 110, 30, 1).getSerializer().peekData();
+    t1.ledgerSequence = kSEQ;
+    t1.date = 1;
+    TransactionAndMetadata t2;
+    t2.transaction = createPaymentTransactionObject(kACCOUNT, kACCOUNT2, 100, 3, kSEQ).getSerializer().peekData();
+    t2.metadata = createPaymentTransactionMetaObject(kACCOUNT, kACCOUNT2, 110, 30, 2).getSerializer().peekData();
+    t2.ledgerSequence = kSEQ;
+    t2.date = 2;
+
+    publisher.publish(dummyLedgerHeader, {t1, t2});
+
+    // mock fetch fee
+    EXPECT_CALL(*backend_, doFetchLedgerObject(ripple::keylet::fees().key, kSEQ, _))
+        .WillOnce(Return(createLegacyFeeSettingBlob(1, 2, 3, 4, 0)));
+    EXPECT_CALL(*backend_, fetchAllTransactionsInLedger).Times(0);
+
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubLedger(_, _, fmt::format("{}-{}", kSEQ - 1, kSEQ), 2));
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubBookChanges);
+    Sequence const s;
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubTransaction(t1, _)).InSequence(s);
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubTransaction(t2, _)).InSequence(s);
+
+    ctx_.run();
+    EXPECT_EQ(publisher.getLastPublishedSequence(), kSEQ);
+}
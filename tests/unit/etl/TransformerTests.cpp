@@ -30,6 +30,7 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <xrpl/protocol/LedgerHeader.h>
 
 #include <chrono>
 #include <memory>
@@ -90,7 +91,7 @@ TEST_F(ETLTransformerTest, StopsOnWriteConflict)
     state_.writeConflict = true;
 
     EXPECT_CALL(dataPipe_, popNext).Times(0);
-    EXPECT_CALL(ledgerPublisher_, publish(_)).Times(0);
+    EXPECT_CALL(ledgerPublisher_, publish(An<ripple::LedgerHeader const&>(), _)).Times(0);
 
     transformer_ = std::make_unique<TransformerType>(
         dataPipe_, backend_, ledgerLoader_, ledgerPublisher_, amendmentBlockHandler_, 0, state_
@@ -122,7 +123,7 @@ TEST_F(ETLTransformerTest, StopsOnEmptyFetchResponse)
     EXPECT_CALL(*backend_, writeNFTs).Times(AtLeast(1));
     EXPECT_CALL(*backend_, writeNFTTransactions).Times(AtLeast(1));
     EXPECT_CALL(*backend_, doFinishWrites).Times(AtLeast(1));
-    EXPECT_CALL(ledgerPublisher_, publish(_)).Times(AtLeast(1));
+    EXPECT_CALL(ledgerPublisher_, publish(An<ripple::LedgerHeader const&>(), _)).Times(AtLeast(1));
 
     transformer_ = std::make_unique<TransformerType>(
         dataPipe_, backend_, ledgerLoader_, ledgerPublisher_, amendmentBlockHandler_, 0, state_
@@ -155,7 +156,7 @@ TEST_F(ETLTransformerTest, DoesNotPublishIfCanNotBuildNextLedger)
     EXPECT_CALL(*backend_, doFinishWrites).Times(AtLeast(1));
 
     // should not call publish
-    EXPECT_CALL(ledgerPublisher_, publish(_)).Times(0);
+    EXPECT_CALL(ledgerPublisher_, publish(An<ripple::LedgerHeader const&>(), _)).Times(0);
 
     transformer_ = std::make_unique<TransformerType>(
         dataPipe_, backend_, ledgerLoader_, ledgerPublisher_, amendmentBlockHandler_, 0, state_
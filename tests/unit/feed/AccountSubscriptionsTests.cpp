@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "feed/Types.hpp"
+#include "feed/impl/AccountSubscriptions.hpp"
+#include "util/LoggerFixtures.hpp"
+#include "util/MockWsBase.hpp"
+#include "util/TestObject.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <xrpl/protocol/AccountID.h>
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+using namespace feed::impl;
+
+namespace {
+
+constexpr auto kACCOUNT1 = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr auto kACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
+constexpr auto kACCOUNT3 = "rK9DrarGKnVEo2nYp5MfVRXRYf5yRX3mwD";
+
+}  // namespace
+
+struct AccountSubscriptionsTest : NoLoggerFixture {
+    AccountSubscriptions subscriptions;
+    ripple::AccountID const account1 = getAccountIdWithString(kACCOUNT1);
+    ripple::AccountID const account2 = getAccountIdWithString(kACCOUNT2);
+    ripple::AccountID const account3 = getAccountIdWithString(kACCOUNT3);
+    feed::SubscriberSharedPtr session1 = std::make_shared<MockSession>();
+    feed::SubscriberSharedPtr session2 = std::make_shared<MockSession>();
+};
+
+TEST_F(AccountSubscriptionsTest, SubCountsNewAccountsOnly)
+{
+    auto const first = subscriptions.sub({account1, account2, account2}, session1);
+    EXPECT_EQ(first.added, 2);
+    EXPECT_TRUE(first.newSubscriber);
+
+    auto const second = subscriptions.sub({account2, account3}, session1);
+    EXPECT_EQ(second.added, 1);
+    EXPECT_FALSE(second.newSubscriber);
+
+    auto const empty = subscriptions.sub({}, session2);
+    EXPECT_EQ(empty.added, 0);
+    EXPECT_FALSE(empty.newSubscriber);
+
+    EXPECT_TRUE(subscriptions.containsAny({account3}));
+    EXPECT_EQ(subscriptions.match({account1, account2, account3}), std::vector{session1});
+    EXPECT_TRUE(subscriptions.match({}).empty());
+}
+
+TEST_F(AccountSubscriptionsTest, MatchReturnsEverySubscriberOnce)
+{
+    subscriptions.sub({account1, account2}, session1);
+    subscriptions.sub({account2}, session2);
+
+    auto const matched = subscriptions.match({account1, account2});
+    EXPECT_THAT(matched, testing::UnorderedElementsAre(session1, session2));
+    EXPECT_EQ(subscriptions.match({account1}), std::vector{session1});
+    EXPECT_TRUE(subscriptions.match({account3}).empty());
+    EXPECT_FALSE(subscriptions.containsAny({account3}));
+}
+
+TEST_F(AccountSubscriptionsTest, Unsub)
+{
+    subscriptions.sub({account1, account2}, session1);
+    subscriptions.sub({account2}, session2);
+
+    EXPECT_EQ(subscriptions.unsub({account2, account3}, session1.get()), 1);
+    EXPECT_EQ(subscriptions.match({account2}), std::vector{session2});
+    EXPECT_EQ(subscriptions.match({account1}), std::vector{session1});
+
+    EXPECT_EQ(subscriptions.unsub({account1}, session1.get()), 1);
+    EXPECT_EQ(subscriptions.unsub({account1}, session1.get()), 0);
+    EXPECT_FALSE(subscriptions.containsAny({account1}));
+}
+
+TEST_F(AccountSubscriptionsTest, UnsubAll)
+{
+    subscriptions.sub({account1, account2, account3}, session1);
+    subscriptions.sub({account3}, session2);
+
+    EXPECT_EQ(subscriptions.unsubAll(session1.get()), 3);
+    EXPECT_EQ(subscriptions.unsubAll(session1.get()), 0);
+    EXPECT_FALSE(subscriptions.containsAny({account1, account2}));
+    EXPECT_EQ(subscriptions.match({account1, account2, account3}), std::vector{session2});
+}
+
+TEST_F(AccountSubscriptionsTest, DestroyedSubscriberIsNotMatched)
+{
+    subscriptions.sub({account1}, session1);
+    subscriptions.sub({account1}, session2);
+
+    auto* const destroyed = session1.get();
+    session1.reset();
+    EXPECT_EQ(subscriptions.match({account1}), std::vector{session2});
+
+    EXPECT_EQ(subscriptions.unsubAll(destroyed), 1);
+    EXPECT_TRUE(subscriptions.containsAny({account1}));
+}
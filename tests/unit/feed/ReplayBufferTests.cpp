@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "feed/impl/ReplayBuffer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace feed::impl;
+
+namespace {
+
+std::vector<int>
+collectSince(ReplayBuffer<int> const& buffer, std::uint32_t fromLedgerSeq)
+{
+    std::vector<int> messages;
+    buffer.forEachSince(fromLedgerSeq, [&messages](int message) { messages.push_back(message); });
+    return messages;
+}
+
+}  // namespace
+
+TEST(ReplayBufferTest, DisabledBufferKeepsNothing)
+{
+    ReplayBuffer<int> buffer;
+    buffer.push(10, 1);
+
+    EXPECT_FALSE(buffer.enabled());
+    EXPECT_EQ(buffer.size(), 0);
+    EXPECT_TRUE(collectSince(buffer, 0).empty());
+    EXPECT_FALSE(buffer.containsSince(10));
+}
+
+TEST(ReplayBufferTest, KeepsMessagesOfRecentLedgersInOrder)
+{
+    ReplayBuffer<int> buffer{2};
+    buffer.push(10, 1);
+    buffer.push(10, 2);
+    buffer.push(11, 3);
+    EXPECT_EQ(collectSince(buffer, 0), (std::vector{1, 2, 3}));
+    EXPECT_EQ(collectSince(buffer, 11), std::vector{3});
+    EXPECT_TRUE(collectSince(buffer, 12).empty());
+
+    buffer.push(12, 4);
+    EXPECT_EQ(buffer.size(), 2);
+    EXPECT_EQ(collectSince(buffer, 10), (std::vector{3, 4}));
+}
+
+TEST(ReplayBufferTest, EvictsEverythingOlderThanTheWindowAfterAGap)
+{
+    ReplayBuffer<int> buffer{3};
+    buffer.push(10, 1);
+    buffer.push(11, 2);
+    buffer.push(20, 3);
+
+    EXPECT_EQ(collectSince(buffer, 0), std::vector{3});
+}
+
+TEST(ReplayBufferTest, ContainsSinceTheOldestLedgerOfTheWindow)
+{
+    ReplayBuffer<int> buffer{2};
+    EXPECT_TRUE(buffer.containsSince(1));
+
+    buffer.push(10, 1);
+    buffer.push(12, 2);
+    EXPECT_FALSE(buffer.containsSince(10));
+    EXPECT_TRUE(buffer.containsSince(11));
+    EXPECT_TRUE(buffer.containsSince(13));
+}
@@ -29,7 +29,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 namespace {
 constexpr auto kFEED = R"({"test":"test"})";
@@ -71,7 +73,12 @@ TEST_F(FeedBaseMockPrometheusTest, AutoUnsub)
 
 class NamedSingleFeedTest : public SingleFeedBase {
 public:
-    NamedSingleFeedTest(util::async::AnyExecutionContext& executionCtx) : SingleFeedBase(executionCtx, "forTest")
+    NamedSingleFeedTest(
+        util::async::AnyExecutionContext& executionCtx,
+        std::size_t numShards = 1,
+        std::size_t replayLedgers = 0
+    )
+        : SingleFeedBase(executionCtx, "forTest", numShards, replayLedgers)
     {
     }
 };
@@ -117,3 +124,77 @@ TEST_F(SingleFeedBaseTest, RepeatSub)
     testFeedPtr->unsub(sessionPtr);
     EXPECT_EQ(testFeedPtr->count(), 0);
 }
+
+TEST_F(SingleFeedBaseTest, ShardedFeedSendsToEverySubscriberInOrder)
+{
+    constexpr auto kNUM_SESSIONS = 16;
+    constexpr auto kOTHER_FEED = R"({"test":"other"})";
+    NamedSingleFeedTest shardedFeed{ctx_, 4};
+
+    std::vector<std::shared_ptr<MockSession>> sessions;
+    for (auto i = 0; i < kNUM_SESSIONS; ++i) {
+        auto const& session = sessions.emplace_back(std::make_shared<MockSession>());
+        EXPECT_CALL(*session, onDisconnect);
+        testing::Sequence const seq;
+        EXPECT_CALL(*session, send(sharedStringJsonEq(kFEED))).InSequence(seq);
+        EXPECT_CALL(*session, send(sharedStringJsonEq(kOTHER_FEED))).InSequence(seq);
+        shardedFeed.sub(session);
+    }
+    EXPECT_EQ(shardedFeed.count(), kNUM_SESSIONS);
+
+    shardedFeed.pub(kFEED);
+    shardedFeed.pub(kOTHER_FEED);
+
+    for (auto const& session : sessions)
+        shardedFeed.unsub(session);
+    EXPECT_EQ(shardedFeed.count(), 0);
+    shardedFeed.pub(kFEED);
+}
+
+TEST_F(SingleFeedBaseTest, ResumeReplaysBufferedMessagesBeforeLiveOnes)
+{
+    constexpr auto kOLD_FEED = R"({"test":"old"})";
+    constexpr auto kOTHER_FEED = R"({"test":"other"})";
+    NamedSingleFeedTest replayingFeed{ctx_, 2, 2};
+
+    replayingFeed.pub(kOLD_FEED, 10);
+    replayingFeed.pub(kFEED, 11);
+    replayingFeed.pub(kOTHER_FEED, 12);
+
+    testing::Sequence const seq;
+    EXPECT_CALL(*mockSessionPtr, onDisconnect);
+    EXPECT_CALL(*mockSessionPtr, send(sharedStringJsonEq(kFEED))).InSequence(seq);
+    EXPECT_CALL(*mockSessionPtr, send(sharedStringJsonEq(kOTHER_FEED))).InSequence(seq);
+    EXPECT_CALL(*mockSessionPtr, send(sharedStringJsonEq(kOLD_FEED))).InSequence(seq);
+
+    replayingFeed.sub(sessionPtr, 11);
+    EXPECT_EQ(replayingFeed.count(), 1);
+
+    // already subscribed, nothing is replayed again
+    replayingFeed.sub(sessionPtr, 12);
+    EXPECT_EQ(replayingFeed.count(), 1);
+
+    replayingFeed.pub(kOLD_FEED, 13);
+    replayingFeed.unsub(sessionPtr);
+}
+
+TEST_F(SingleFeedBaseTest, ResumeFromEvictedLedgerSendsMarkerAndSubscribesLive)
+{
+    constexpr auto kOLD_FEED = R"({"test":"old"})";
+    constexpr auto kMARKER = R"({"type":"ledgerNotBuffered","stream":"forTest","resume_from_ledger":10})";
+    NamedSingleFeedTest replayingFeed{ctx_, 1, 2};
+
+    replayingFeed.pub(kOLD_FEED, 10);
+    replayingFeed.pub(kOLD_FEED, 12);
+
+    testing::Sequence const seq;
+    EXPECT_CALL(*mockSessionPtr, onDisconnect);
+    EXPECT_CALL(*mockSessionPtr, send(sharedStringJsonEq(kMARKER))).InSequence(seq);
+    EXPECT_CALL(*mockSessionPtr, send(sharedStringJsonEq(kFEED))).InSequence(seq);
+
+    replayingFeed.sub(sessionPtr, 10);
+    EXPECT_EQ(replayingFeed.count(), 1);
+
+    replayingFeed.pub(kFEED, 13);
+    replayingFeed.unsub(sessionPtr);
+}
@@ -41,7 +41,9 @@
 #include <xrpl/protocol/STObject.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace {
@@ -150,7 +152,7 @@ TEST_F(SubscriptionManagerTest, ReportCurrentSubscriber)
     subscriptionManagerPtr_->subAccount(account, session1);
     subscriptionManagerPtr_->subAccount(account, session2);
     subscriptionManagerPtr_->subProposedAccount(account, session1);
-    subscriptionManagerPtr_->subProposedAccount(account, session2);
+    subscriptionManagerPtr_->subProposedAccounts(std::vector{account}, session2);
     auto const issue1 = getIssue(kCURRENCY, kISSUER);
     ripple::Book const book{ripple::xrpIssue(), issue1};
     subscriptionManagerPtr_->subBook(book, session1);
@@ -314,6 +316,72 @@ TEST_F(SubscriptionManagerTest, LedgerTest)
     EXPECT_EQ(subscriptionManagerPtr_->report()["ledger"], 0);
 }
 
+TEST_F(SubscriptionManagerTest, CanResumeFromBufferedLedgersOnly)
+{
+    auto const fees = ripple::Fees();
+    auto const pubLedger = [&fees](SubscriptionManager& manager, std::uint32_t seq) {
+        manager.pubLedger(createLedgerHeader(kLEDGER_HASH, seq), fees, "10-" + std::to_string(seq), 0);
+    };
+
+    pubLedger(*subscriptionManagerPtr_, 30);
+    EXPECT_FALSE(subscriptionManagerPtr_->canResumeFrom(30));
+
+    SubscriptionManager replaying{util::async::SyncExecutionContext(2), backend_, 1, 3};
+    EXPECT_FALSE(replaying.canResumeFrom(30));
+
+    pubLedger(replaying, 30);
+    EXPECT_FALSE(replaying.canResumeFrom(29));
+    EXPECT_TRUE(replaying.canResumeFrom(30));
+    EXPECT_TRUE(replaying.canResumeFrom(31));
+
+    for (auto seq = 31u; seq <= 33u; ++seq)
+        pubLedger(replaying, seq);
+    EXPECT_FALSE(replaying.canResumeFrom(30));
+    EXPECT_TRUE(replaying.canResumeFrom(31));
+
+    // the ledgers before a gap can't be replayed without the skipped ones
+    pubLedger(replaying, 35);
+    EXPECT_FALSE(replaying.canResumeFrom(34));
+    EXPECT_TRUE(replaying.canResumeFrom(35));
+}
+
+TEST_F(SubscriptionManagerTest, ResumeLedgerReplaysBufferedLedgers)
+{
+    auto const replaying = std::make_shared<SubscriptionManager>(util::async::SyncExecutionContext(2), backend_, 1, 3);
+    auto const fees = ripple::Fees();
+    replaying->pubLedger(createLedgerHeader(kLEDGER_HASH, 30), fees, "10-30", 1);
+    replaying->pubLedger(createLedgerHeader(kLEDGER_HASH, 31), fees, "10-31", 2);
+
+    backend_->setRange(10, 31);
+    EXPECT_CALL(*backend_, fetchLedgerBySequence).WillOnce(testing::Return(createLedgerHeader(kLEDGER_HASH, 31)));
+    EXPECT_CALL(*backend_, doFetchLedgerObject).WillOnce(testing::Return(createLegacyFeeSettingBlob(1, 2, 3, 4, 0)));
+
+    static constexpr auto kLEDGER_PUB =
+        R"({
+            "type":"ledgerClosed",
+            "ledger_index":31,
+            "ledger_hash":"4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652",
+            "ledger_time":0,
+            "fee_base":0,
+            "reserve_base":0,
+            "reserve_inc":0,
+            "validated_ledgers":"10-31",
+            "txn_count":2
+        })";
+    EXPECT_CALL(*sessionPtr_, onDisconnect);
+    EXPECT_CALL(*sessionPtr_, send(sharedStringJsonEq(kLEDGER_PUB)));
+
+    boost::asio::io_context ctx;
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        auto const res = replaying->resumeLedger(yield, 31, session_);
+        EXPECT_EQ(res.at("ledger_index"), 31);
+    });
+    ctx.run();
+    EXPECT_EQ(replaying->report()["ledger"], 1);
+
+    replaying->unsubLedger(session_);
+}
+
 TEST_F(SubscriptionManagerTest, TransactionTest)
 {
     auto const issue1 = getIssue(kCURRENCY, kISSUER);
@@ -868,6 +868,30 @@ TEST_F(FeedTransactionTest, PubTransactionWithOwnerFund)
     testFeedPtr->pub(trans1, ledgerHeader, backend_);
 }
 
+TEST_F(FeedTransactionTest, PubTransactionWithoutSubscribersSkipsOwnerFund)
+{
+    auto const otherAccount = getAccountIdWithString(kACCOUNT2);
+    EXPECT_CALL(*mockSessionPtr, onDisconnect);
+    testFeedPtr->sub(otherAccount, sessionPtr);
+
+    auto const ledgerHeader = createLedgerHeader(kLEDGER_HASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = createCreateOfferTransactionObject(kACCOUNT1, 1, 32, kCURRENCY, kISSUER, 1, 3);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    ripple::STArray const metaArray{0};
+    ripple::STObject metaObj(ripple::sfTransactionMetaData);
+    metaObj.setFieldArray(ripple::sfAffectedNodes, metaArray);
+    metaObj.setFieldU8(ripple::sfTransactionResult, ripple::tesSUCCESS);
+    metaObj.setFieldU32(ripple::sfTransactionIndex, 22);
+    trans1.metadata = metaObj.getSerializer().peekData();
+
+    // the transaction does not affect the subscribed account
+    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(0);
+    EXPECT_CALL(*mockSessionPtr, send).Times(0);
+    testFeedPtr->pub(trans1, ledgerHeader, backend_);
+}
+
 static constexpr auto kTRAN_FROZEN =
     R"({
         "transaction":
@@ -1083,6 +1107,139 @@ TEST_F(FeedTransactionTest, SubProposedAccountDisconnect)
     testFeedPtr->pub(trans1, ledgerHeader, backend_);
 }
 
+TEST_F(FeedTransactionTest, SubMoreAccountsRegistersDisconnectOnce)
+{
+    auto const account = getAccountIdWithString(kACCOUNT1);
+    auto const account2 = getAccountIdWithString(kACCOUNT2);
+
+    EXPECT_CALL(*mockSessionPtr, onDisconnect);
+    testFeedPtr->sub(std::vector{account}, sessionPtr);
+    testFeedPtr->sub(std::vector{account, account2}, sessionPtr);
+    EXPECT_EQ(testFeedPtr->accountSubCount(), 2);
+
+    EXPECT_CALL(*mockSessionPtr, onDisconnect);
+    testFeedPtr->subProposed(std::vector{account, account2}, sessionPtr);
+    testFeedPtr->subProposed(account2, sessionPtr);
+    EXPECT_EQ(testFeedPtr->accountSubCount(), 2);
+
+    testFeedPtr->unsub(std::vector{account, account2}, sessionPtr);
+    EXPECT_EQ(testFeedPtr->accountSubCount(), 0);
+
+    // every account was unsubscribed, so subscribing again needs a new slot
+    EXPECT_CALL(*mockSessionPtr, onDisconnect);
+    testFeedPtr->sub(account2, sessionPtr);
+    EXPECT_EQ(testFeedPtr->accountSubCount(), 1);
+}
+
+TEST_F(FeedTransactionTest, ShardedFeedNotifiesEverySubscriberOnce)
+{
+    constexpr auto kNUM_SESSIONS = 16;
+    auto const shardedFeed = std::make_shared<TransactionFeed>(ctx_, 4);
+    auto const account1 = getAccountIdWithString(kACCOUNT1);
+    auto const account2 = getAccountIdWithString(kACCOUNT2);
+
+    std::vector<std::shared_ptr<MockSession>> sessions;
+    for (auto i = 0; i < kNUM_SESSIONS; ++i) {
+        auto const& session = sessions.emplace_back(std::make_shared<MockSession>());
+        EXPECT_CALL(*session, onDisconnect).Times(testing::AnyNumber());
+        if (i % 2 == 0) {
+            shardedFeed->sub(session);
+        } else {
+            // the transaction affects both accounts, it must still be sent once
+            shardedFeed->sub(account1, session);
+            shardedFeed->sub(account2, session);
+        }
+    }
+    EXPECT_EQ(shardedFeed->transactionSubCount(), kNUM_SESSIONS / 2);
+    EXPECT_EQ(shardedFeed->accountSubCount(), kNUM_SESSIONS);
+
+    auto const ledgerHeader = createLedgerHeader(kLEDGER_HASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = createPaymentTransactionObject(kACCOUNT1, kACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = createPaymentTransactionMetaObject(kACCOUNT1, kACCOUNT2, 110, 30, 22).getSerializer().peekData();
+
+    for (auto const& session : sessions) {
+        EXPECT_CALL(*session, apiSubversion).WillOnce(testing::Return(1));
+        EXPECT_CALL(*session, send(sharedStringJsonEq(kTRAN_V1)));
+    }
+    shardedFeed->pub(trans1, ledgerHeader, backend_);
+
+    for (auto i = 0; i < kNUM_SESSIONS; ++i) {
+        if (i % 2 == 0) {
+            shardedFeed->unsub(sessions[i]);
+        } else {
+            shardedFeed->unsub(account1, sessions[i]);
+            shardedFeed->unsub(account2, sessions[i]);
+        }
+    }
+    EXPECT_EQ(shardedFeed->transactionSubCount(), 0);
+    EXPECT_EQ(shardedFeed->accountSubCount(), 0);
+    shardedFeed->pub(trans1, ledgerHeader, backend_);
+}
+
+TEST_F(FeedTransactionTest, ResumeReplaysBufferedTransactionsBeforeLiveOnes)
+{
+    auto const replayingFeed = std::make_shared<TransactionFeed>(ctx_, 2, 2);
+    auto const otherSessionPtr = std::make_shared<MockSession>();
+
+    auto const ledgerHeader = createLedgerHeader(kLEDGER_HASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = createPaymentTransactionObject(kACCOUNT1, kACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = createPaymentTransactionMetaObject(kACCOUNT1, kACCOUNT2, 110, 30, 22).getSerializer().peekData();
+
+    // buffered even though nobody is subscribed
+    replayingFeed->pub(trans1, ledgerHeader, backend_);
+
+    EXPECT_CALL(*mockSessionPtr, onDisconnect);
+    EXPECT_CALL(*mockSessionPtr, apiSubversion).WillRepeatedly(testing::Return(1));
+    EXPECT_CALL(*mockSessionPtr, send(sharedStringJsonEq(kTRAN_V1))).Times(2);
+    replayingFeed->sub(sessionPtr, 33);
+
+    // resuming from a later ledger replays nothing
+    EXPECT_CALL(*otherSessionPtr, onDisconnect);
+    EXPECT_CALL(*otherSessionPtr, apiSubversion).WillRepeatedly(testing::Return(1));
+    EXPECT_CALL(*otherSessionPtr, send(sharedStringJsonEq(kTRAN_V1)));
+    replayingFeed->sub(otherSessionPtr, 34);
+    EXPECT_EQ(replayingFeed->transactionSubCount(), 2);
+
+    replayingFeed->pub(trans1, ledgerHeader, backend_);
+
+    replayingFeed->unsub(sessionPtr);
+    replayingFeed->unsub(otherSessionPtr);
+}
+
+TEST_F(FeedTransactionTest, ResumeFromEvictedLedgerSendsMarkerAndSubscribesLive)
+{
+    constexpr auto kMARKER = R"({"type":"ledgerNotBuffered","stream":"transactions","resume_from_ledger":31})";
+    auto const replayingFeed = std::make_shared<TransactionFeed>(ctx_, 1, 2);
+
+    auto const ledgerHeader = createLedgerHeader(kLEDGER_HASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = createPaymentTransactionObject(kACCOUNT1, kACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = createPaymentTransactionMetaObject(kACCOUNT1, kACCOUNT2, 110, 30, 22).getSerializer().peekData();
+
+    replayingFeed->pub(trans1, ledgerHeader, backend_);
+
+    testing::Sequence const seq;
+    EXPECT_CALL(*mockSessionPtr, onDisconnect);
+    EXPECT_CALL(*mockSessionPtr, apiSubversion).WillRepeatedly(testing::Return(1));
+    EXPECT_CALL(*mockSessionPtr, send(sharedStringJsonEq(kMARKER))).InSequence(seq);
+    EXPECT_CALL(*mockSessionPtr, send(sharedStringJsonEq(kTRAN_V1))).InSequence(seq);
+
+    // ledger 31 is older than the two buffered ledgers
+    replayingFeed->sub(sessionPtr, 31);
+    EXPECT_EQ(replayingFeed->transactionSubCount(), 1);
+
+    replayingFeed->pub(trans1, ledgerHeader, backend_);
+    replayingFeed->unsub(sessionPtr);
+}
+
 struct TransactionFeedMockPrometheusTest : WithMockPrometheus, SyncExecutionCtxFixture {
 protected:
     web::SubscriptionContextPtr sessionPtr_ = std::make_shared<MockSession>();
@@ -0,0 +1,197 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/ConcurrencyLimiter.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Gauge.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace rpc;
+
+namespace {
+
+constexpr auto kFAST = std::chrono::microseconds{1'000};
+constexpr auto kSLOW = std::chrono::microseconds{10'000};
+constexpr auto kNO_WAIT = std::chrono::microseconds{0};
+
+}  // namespace
+
+struct ConcurrencyLimiterTest : util::prometheus::WithPrometheus {
+    ConcurrencyLimiter limiter{4, 10};
+
+    std::vector<ConcurrencyLimiter::Ticket>
+    acquire(std::uint32_t count)
+    {
+        std::vector<ConcurrencyLimiter::Ticket> tickets;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            auto ticket = limiter.tryAcquire("account_info");
+            EXPECT_TRUE(ticket.has_value());
+            if (ticket.has_value())
+                tickets.push_back(*ticket);
+        }
+        return tickets;
+    }
+};
+
+TEST_F(ConcurrencyLimiterTest, AdmitsUpToTheLimit)
+{
+    EXPECT_EQ(limiter.limit(), 10);
+    auto const tickets = acquire(10);
+    EXPECT_EQ(limiter.inFlight(), 10);
+
+    auto const shed = limiter.tryAcquire("account_info");
+    ASSERT_FALSE(shed.has_value());
+    EXPECT_EQ(shed.error(), ConcurrencyLimiter::ShedReason::Limit);
+
+    limiter.release(tickets.front(), kFAST, kNO_WAIT);
+    EXPECT_TRUE(limiter.tryAcquire("account_info").has_value());
+}
+
+TEST_F(ConcurrencyLimiterTest, ShedsExpensiveRequestsFirst)
+{
+    EXPECT_EQ(ConcurrencyLimiter::costOf("account_info"), 1);
+    EXPECT_EQ(ConcurrencyLimiter::costOf("ledger_data"), 8);
+
+    auto const tickets = acquire(5);
+    auto const shed = limiter.tryAcquire("ledger_data");
+    ASSERT_FALSE(shed.has_value());
+    EXPECT_EQ(shed.error(), ConcurrencyLimiter::ShedReason::Cost);
+    EXPECT_TRUE(limiter.tryAcquire("account_tx").has_value());
+    EXPECT_EQ(limiter.inFlight(), 9);
+}
+
+TEST_F(ConcurrencyLimiterTest, DecreasesOncePerRoundWhenRequestsGetSlower)
+{
+    auto const first = acquire(4);
+    for (auto const& ticket : first)
+        limiter.release(ticket, kFAST, kNO_WAIT);
+
+    auto const second = acquire(4);
+    for (auto const& ticket : second)
+        limiter.release(ticket, kSLOW, kNO_WAIT);
+    EXPECT_EQ(limiter.limit(), 9);
+
+    auto const third = acquire(4);
+    limiter.release(third.front(), kSLOW, kNO_WAIT);
+    EXPECT_EQ(limiter.limit(), 8);
+}
+
+TEST_F(ConcurrencyLimiterTest, DecreasesWhenRequestsWaitTooLong)
+{
+    auto const tickets = acquire(1);
+    limiter.release(tickets.front(), kFAST, ConcurrencyLimiter::kMAX_QUEUE_WAIT * 2);
+    EXPECT_EQ(limiter.limit(), 9);
+}
+
+TEST_F(ConcurrencyLimiterTest, NeverGoesBelowTheMinimum)
+{
+    for (auto i = 0; i < 20; ++i)
+        limiter.releaseOverloaded(acquire(1).front());
+
+    EXPECT_EQ(limiter.limit(), 4);
+    EXPECT_EQ(limiter.inFlight(), 0);
+}
+
+TEST_F(ConcurrencyLimiterTest, GrowsBackWhileFastAndInUse)
+{
+    limiter.releaseOverloaded(acquire(1).front());
+    ASSERT_EQ(limiter.limit(), 9);
+
+    // not enough requests to use half of the limit
+    auto const few = acquire(2);
+    for (auto const& ticket : few)
+        limiter.release(ticket, kFAST, kNO_WAIT);
+    EXPECT_EQ(limiter.limit(), 9);
+
+    for (auto round = 0; round < 4; ++round) {
+        auto const many = acquire(9);
+        for (auto const& ticket : many)
+            limiter.release(ticket, kFAST, kNO_WAIT);
+    }
+    EXPECT_EQ(limiter.limit(), 10);
+}
+
+TEST_F(ConcurrencyLimiterTest, MixedCheapAndExpensiveRequestsDoNotLowerTheLimit)
+{
+    // a ledger_data request is much slower per unit of cost than account_info, and stays as slow
+    constexpr auto kSCAN = kSLOW * ConcurrencyLimiter::costOf("ledger_data");
+
+    for (auto round = 0; round < 10; ++round) {
+        auto const cheap = acquire(1);
+        auto const expensive = limiter.tryAcquire("ledger_data");
+        ASSERT_TRUE(expensive.has_value());
+
+        limiter.release(cheap.front(), kFAST, kNO_WAIT);
+        limiter.release(*expensive, kSCAN, kNO_WAIT);
+    }
+    EXPECT_EQ(limiter.limit(), 10);
+}
+
+TEST_F(ConcurrencyLimiterTest, AdmitsARequestAboveTheLimitWhenIdle)
+{
+    ConcurrencyLimiter small{1, 4};
+
+    auto const expensive = small.tryAcquire("ledger_data");
+    ASSERT_TRUE(expensive.has_value());
+    EXPECT_EQ(small.inFlight(), 8);
+
+    auto const shed = small.tryAcquire("account_info");
+    ASSERT_FALSE(shed.has_value());
+    EXPECT_EQ(shed.error(), ConcurrencyLimiter::ShedReason::Limit);
+
+    small.release(*expensive, kFAST, kNO_WAIT);
+    EXPECT_EQ(small.inFlight(), 0);
+}
+
+struct ConcurrencyLimiterMetricsTest : util::prometheus::WithMockPrometheus {};
+
+TEST_F(ConcurrencyLimiterMetricsTest, ReportsLimitAndShedRequests)
+{
+    auto& limit = makeMock<util::prometheus::GaugeInt>("rpc_concurrency_limit", "");
+    auto& shedLimit = makeMock<util::prometheus::CounterInt>("rpc_shed_requests_total_number", "{reason=\"limit\"}");
+    auto& shedCost = makeMock<util::prometheus::CounterInt>("rpc_shed_requests_total_number", "{reason=\"cost\"}");
+    auto& shedBackend =
+        makeMock<util::prometheus::CounterInt>("rpc_shed_requests_total_number", "{reason=\"backend_too_busy\"}");
+
+    EXPECT_CALL(limit, set(2));
+    ConcurrencyLimiter limiter{1, 2};
+
+    auto const ticket = limiter.tryAcquire("account_info");
+    ASSERT_TRUE(ticket.has_value());
+
+    EXPECT_CALL(shedCost, add(1));
+    EXPECT_FALSE(limiter.tryAcquire("book_offers").has_value());
+
+    ASSERT_TRUE(limiter.tryAcquire("account_info").has_value());
+    EXPECT_CALL(shedLimit, add(1));
+    EXPECT_FALSE(limiter.tryAcquire("account_info").has_value());
+
+    EXPECT_CALL(shedBackend, add(1));
+    limiter.registerShed(ConcurrencyLimiter::ShedReason::BackendTooBusy);
+
+    EXPECT_CALL(limit, set(1));
+    limiter.releaseOverloaded(*ticket);
+}
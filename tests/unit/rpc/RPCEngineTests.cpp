@@ -46,6 +46,7 @@
 
 #include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
+#include <fmt/core.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -80,13 +81,19 @@ generateDefaultRPCEngineConfig()
         {"workers", ConfigValue{ConfigType::Integer}.defaultValue(4).withConstraint(gValidateUint16)},
         {"rpc.cache_timeout", ConfigValue{ConfigType::Double}.defaultValue(0.0).withConstraint(gValidatePositiveDouble)
         },
+        {"rpc.response_cache.max_size_mb", ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateUint32)},
+        {"rpc.coalesce_requests", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"rpc.concurrency_limit.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"rpc.concurrency_limit.min", ConfigValue{ConfigType::Integer}.defaultValue(16)},
+        {"rpc.concurrency_limit.max", ConfigValue{ConfigType::Integer}.defaultValue(1024)},
         {"log_tag_style", ConfigValue{ConfigType::String}.defaultValue("uint")},
         {"dos_guard.whitelist.[]", Array{ConfigValue{ConfigType::String}.optional()}},
         {"dos_guard.max_fetches",
          ConfigValue{ConfigType::Integer}.defaultValue(1000'000u).withConstraint(gValidateUint32)},
         {"dos_guard.max_connections", ConfigValue{ConfigType::Integer}.defaultValue(20u).withConstraint(gValidateUint32)
         },
-        {"dos_guard.max_requests", ConfigValue{ConfigType::Integer}.defaultValue(20u).withConstraint(gValidateUint32)}
+        {"dos_guard.max_requests", ConfigValue{ConfigType::Integer}.defaultValue(20u).withConstraint(gValidateUint32)},
+        {"dos_guard.sweep_interval", ConfigValue{ConfigType::Double}.defaultValue(1.0)}
     };
 }
 
@@ -468,7 +475,12 @@ TEST_F(RPCEngineTest, NotCacheIfErrorHappen)
         {"server.max_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(2)},
         {"workers", ConfigValue{ConfigType::Integer}.defaultValue(4).withConstraint(gValidateUint16)},
         {"rpc.cache_timeout", ConfigValue{ConfigType::Double}.defaultValue(10.0).withConstraint(gValidatePositiveDouble)
-        }
+        },
+        {"rpc.response_cache.max_size_mb", ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateUint32)},
+        {"rpc.coalesce_requests", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"rpc.concurrency_limit.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"rpc.concurrency_limit.min", ConfigValue{ConfigType::Integer}.defaultValue(16)},
+        {"rpc.concurrency_limit.max", ConfigValue{ConfigType::Integer}.defaultValue(1024)}
     };
 
     auto const notAdmin = false;
@@ -507,3 +519,43 @@ TEST_F(RPCEngineTest, NotCacheIfErrorHappen)
         });
     }
 }
+
+TEST_F(RPCEngineTest, LedgerResponseCacheServesRepeatedRequests)
+{
+    auto cfgCache{generateDefaultRPCEngineConfig()};
+    auto const cacheJson = json::parse(R"JSON({"rpc": {"response_cache": {"max_size_mb": 1}}})JSON");
+    auto const errors = cfgCache.parse(ConfigFileJson{cacheJson.as_object()});
+    EXPECT_TRUE(!errors.has_value());
+
+    std::shared_ptr<RPCEngine<MockLoadBalancer, MockCounters>> engine =
+        RPCEngine<MockLoadBalancer, MockCounters>::makeRPCEngine(
+            cfgCache, backend_, mockLoadBalancerPtr_, dosGuard, queue, *mockCountersPtr_, handlerProvider
+        );
+
+    int callTime = 2;
+    EXPECT_CALL(*handlerProvider, isClioOnly).Times(callTime).WillRepeatedly(Return(false));
+    EXPECT_CALL(*backend_, isTooBusy).WillOnce(Return(false));
+    EXPECT_CALL(*handlerProvider, getHandler).WillOnce(Return(AnyHandler{tests::common::HandlerFake{}}));
+
+    while (callTime-- != 0) {
+        runSpawn([&](auto yield) {
+            auto const ctx = web::Context(
+                yield,
+                "account_info",
+                1,
+                json::parse(fmt::format(R"JSON({{"id": {}, "hello": "world", "limit": 50}})JSON", callTime))
+                    .as_object(),
+                nullptr,
+                tagFactory,
+                LedgerRange{.minSequence = 0, .maxSequence = 30},
+                "127.0.0.2",
+                false
+            );
+
+            auto const res = engine->buildResponse(ctx);
+            auto const response = std::get_if<boost::json::object>(&res.response);
+            ASSERT_NE(response, nullptr);
+            EXPECT_EQ(*response, json::parse(R"JSON({"computed": "world_50"})JSON").as_object());
+        });
+    }
+}
@@ -0,0 +1,178 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "rpc/Errors.hpp"
+#include "rpc/RequestCoalescer.hpp"
+#include "rpc/common/Types.hpp"
+#include "util/AsioContextTestFixture.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/prometheus/Counter.hpp"
+
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/json/object.hpp>
+#include <boost/system/error_code.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace rpc;
+
+namespace {
+
+constexpr auto kMETHOD = "account_info";
+constexpr std::uint32_t kAPI_VERSION = 2;
+constexpr data::LedgerRange kRANGE{.minSequence = 10, .maxSequence = 30};
+
+boost::json::object
+request(int id, std::string const& account = "acc")
+{
+    return boost::json::object{{"id", id}, {"account", account}};
+}
+
+enum class Outcome { Success, Error, Throw };
+
+}  // namespace
+
+struct RequestCoalescerTestBase : SyncAsioContextTest {
+    RequestCoalescer coalescer{std::unordered_set<std::string>{kMETHOD}};
+    int executions = 0;
+    std::vector<Result> results;
+
+    /**
+     * @brief Spawn a request whose execution takes a while, so requests spawned after it overlap with it
+     */
+    void
+    spawnRequest(std::string const& method, boost::json::object const& params, Outcome outcome = Outcome::Success)
+    {
+        boost::asio::spawn(ctx_, [this, method, params, outcome](boost::asio::yield_context yield) {
+            try {
+                results.push_back(coalescer.execute(method, params, kAPI_VERSION, kRANGE, yield, [&] {
+                    ++executions;
+                    boost::asio::steady_timer timer{yield.get_executor(), std::chrono::milliseconds{10}};
+                    boost::system::error_code error;
+                    timer.async_wait(yield[error]);
+                    if (outcome == Outcome::Throw)
+                        throw std::runtime_error{"failed"};
+                    if (outcome == Outcome::Error)
+                        return Result{Status{RippledError::rpcINTERNAL}};
+                    return Result{boost::json::object{{"execution", executions}}};
+                }));
+            } catch (std::runtime_error const&) {
+                EXPECT_EQ(outcome, Outcome::Throw);
+            }
+        });
+    }
+};
+
+struct RequestCoalescerTest : util::prometheus::WithPrometheus, RequestCoalescerTestBase {};
+
+TEST_F(RequestCoalescerTest, IdenticalRequestsShareOneExecution)
+{
+    spawnRequest(kMETHOD, request(1));
+    spawnRequest(kMETHOD, request(2));
+    spawnRequest(kMETHOD, request(3));
+    runContext();
+
+    EXPECT_EQ(executions, 1);
+    ASSERT_EQ(results.size(), 3);
+    for (auto const& result : results)
+        EXPECT_EQ(result.response, results.front().response);
+    EXPECT_EQ(coalescer.inFlight(), 0);
+}
+
+TEST_F(RequestCoalescerTest, DifferentRequestsExecuteSeparately)
+{
+    spawnRequest(kMETHOD, request(1));
+    spawnRequest(kMETHOD, request(2, "other"));
+    runContext();
+
+    EXPECT_EQ(executions, 2);
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_NE(results[0].response, results[1].response);
+}
+
+TEST_F(RequestCoalescerTest, OtherMethodsAreNotCoalesced)
+{
+    spawnRequest("server_info", request(1));
+    spawnRequest("server_info", request(2));
+    runContext();
+
+    EXPECT_EQ(executions, 2);
+}
+
+TEST_F(RequestCoalescerTest, FinishedRequestsAreNotShared)
+{
+    spawnRequest(kMETHOD, request(1));
+    runContext();
+    spawnRequest(kMETHOD, request(1));
+    runContext();
+
+    EXPECT_EQ(executions, 2);
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_NE(results[0].response, results[1].response);
+}
+
+TEST_F(RequestCoalescerTest, WaitingRequestsExecuteThemselvesIfTheExecutionThrows)
+{
+    spawnRequest(kMETHOD, request(1), Outcome::Throw);
+    spawnRequest(kMETHOD, request(2));
+    runContext();
+
+    EXPECT_EQ(executions, 2);
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(coalescer.inFlight(), 0);
+}
+
+TEST_F(RequestCoalescerTest, WaitingRequestsExecuteThemselvesIfTheExecutionFails)
+{
+    spawnRequest(kMETHOD, request(1), Outcome::Error);
+    spawnRequest(kMETHOD, request(2));
+    runContext();
+
+    EXPECT_EQ(executions, 2);
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_FALSE(results[0].response.has_value());
+    ASSERT_TRUE(results[1].response.has_value());
+    EXPECT_EQ(results[1].response.value(), (boost::json::object{{"execution", 2}}));
+    EXPECT_EQ(coalescer.inFlight(), 0);
+}
+
+struct RequestCoalescerMetricsTest : util::prometheus::WithMockPrometheus, RequestCoalescerTestBase {};
+
+TEST_F(RequestCoalescerMetricsTest, CountsCoalescedRequests)
+{
+    auto& coalesced = makeMock<util::prometheus::CounterInt>(
+        "rpc_coalesced_requests_total_number", "{method=\"account_info\"}"
+    );
+    EXPECT_CALL(coalesced, add(1)).Times(2);
+
+    spawnRequest(kMETHOD, request(1));
+    spawnRequest(kMETHOD, request(2));
+    spawnRequest(kMETHOD, request(3));
+    runContext();
+}
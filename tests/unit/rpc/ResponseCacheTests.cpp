@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "rpc/ResponseCache.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Gauge.hpp"
+
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+using namespace rpc;
+
+namespace {
+
+constexpr auto kMETHOD = "account_info";
+constexpr std::uint32_t kAPI_VERSION = 2;
+constexpr data::LedgerRange kRANGE{.minSequence = 10, .maxSequence = 30};
+
+boost::json::object
+parse(std::string const& json)
+{
+    return boost::json::parse(json).as_object();
+}
+
+boost::json::object
+response(std::uint32_t seq)
+{
+    return boost::json::object{{"account_data", "data"}, {"ledger_index", seq}};
+}
+
+}  // namespace
+
+struct ResponseCacheTest : util::prometheus::WithPrometheus {
+    ResponseCache cache{1024 * 1024};
+};
+
+TEST_F(ResponseCacheTest, CachesOnlyConfiguredMethods)
+{
+    auto const params = parse(R"JSON({"account": "acc"})JSON");
+    cache.put("server_info", params, kAPI_VERSION, kRANGE, response(30));
+    EXPECT_FALSE(cache.get("server_info", params, kAPI_VERSION, kRANGE).has_value());
+
+    cache.put(kMETHOD, params, kAPI_VERSION, kRANGE, response(30));
+    EXPECT_EQ(cache.get(kMETHOD, params, kAPI_VERSION, kRANGE), response(30));
+}
+
+TEST_F(ResponseCacheTest, KeyIgnoresFieldOrderAndRequestId)
+{
+    cache.put(
+        kMETHOD,
+        parse(R"JSON({"id": 1, "command": "account_info", "account": "acc", "signer_lists": true})JSON"),
+        kAPI_VERSION,
+        kRANGE,
+        response(30)
+    );
+
+    auto const sameRequest = parse(R"JSON({"signer_lists": true, "account": "acc", "id": 2})JSON");
+    EXPECT_EQ(cache.get(kMETHOD, sameRequest, kAPI_VERSION, kRANGE), response(30));
+    EXPECT_FALSE(cache.get(kMETHOD, sameRequest, kAPI_VERSION + 1, kRANGE).has_value());
+    EXPECT_FALSE(cache.get(kMETHOD, parse(R"JSON({"account": "acc"})JSON"), kAPI_VERSION, kRANGE).has_value());
+}
+
+TEST_F(ResponseCacheTest, LatestLedgerEntriesAreDroppedOnNewLedger)
+{
+    auto const params = parse(R"JSON({"account": "acc"})JSON");
+    auto const validated = parse(R"JSON({"account": "acc", "ledger_index": "validated"})JSON");
+    cache.put(kMETHOD, params, kAPI_VERSION, kRANGE, response(30));
+    EXPECT_EQ(cache.get(kMETHOD, validated, kAPI_VERSION, kRANGE), response(30));
+
+    auto const nextRange = data::LedgerRange{.minSequence = 10, .maxSequence = 31};
+    EXPECT_FALSE(cache.get(kMETHOD, params, kAPI_VERSION, nextRange).has_value());
+    EXPECT_EQ(cache.sizeBytes(), 0);
+
+    // a request that started before the new ledger must not put its response back
+    cache.put(kMETHOD, params, kAPI_VERSION, kRANGE, response(30));
+    EXPECT_EQ(cache.sizeBytes(), 0);
+}
+
+TEST_F(ResponseCacheTest, OnLedgerPublishedDropsLatestLedgerEntries)
+{
+    auto const params = parse(R"JSON({"account": "acc"})JSON");
+    cache.put(kMETHOD, params, kAPI_VERSION, kRANGE, response(30));
+    ASSERT_GT(cache.sizeBytes(), 0);
+
+    cache.onLedgerPublished(31);
+    EXPECT_EQ(cache.sizeBytes(), 0);
+}
+
+TEST_F(ResponseCacheTest, OnLedgerPublishedKeepsPinnedLedgerEntries)
+{
+    auto const latest = parse(R"JSON({"account": "acc"})JSON");
+    auto const bySeq = parse(R"JSON({"account": "acc", "ledger_index": 20})JSON");
+    cache.put(kMETHOD, bySeq, kAPI_VERSION, kRANGE, response(20));
+    auto const pinnedBytes = cache.sizeBytes();
+
+    // replacing a latest ledger entry leaves a single one to drop
+    cache.put(kMETHOD, latest, kAPI_VERSION, kRANGE, response(30));
+    cache.put(kMETHOD, latest, kAPI_VERSION, kRANGE, response(30));
+
+    cache.onLedgerPublished(31);
+    EXPECT_EQ(cache.sizeBytes(), pinnedBytes);
+
+    auto const nextRange = data::LedgerRange{.minSequence = 10, .maxSequence = 31};
+    EXPECT_FALSE(cache.get(kMETHOD, latest, kAPI_VERSION, nextRange).has_value());
+    EXPECT_EQ(cache.get(kMETHOD, bySeq, kAPI_VERSION, nextRange), response(20));
+}
+
+TEST_F(ResponseCacheTest, PinnedLedgerEntriesSurviveNewLedgers)
+{
+    auto const bySeq = parse(R"JSON({"account": "acc", "ledger_index": 20})JSON");
+    auto const bySeqString = parse(R"JSON({"account": "acc", "ledger_index": "20"})JSON");
+    auto const byHash = parse(R"JSON({"account": "acc", "ledger_hash": "ABCD"})JSON");
+    cache.put(kMETHOD, bySeq, kAPI_VERSION, kRANGE, response(20));
+    cache.put(kMETHOD, byHash, kAPI_VERSION, kRANGE, response(25));
+
+    auto const nextRange = data::LedgerRange{.minSequence = 10, .maxSequence = 31};
+    EXPECT_EQ(cache.get(kMETHOD, bySeqString, kAPI_VERSION, nextRange), response(20));
+    EXPECT_EQ(cache.get(kMETHOD, byHash, kAPI_VERSION, nextRange), response(25));
+
+    // online deletion removed the ledgers
+    auto const prunedRange = data::LedgerRange{.minSequence = 26, .maxSequence = 31};
+    EXPECT_FALSE(cache.get(kMETHOD, bySeq, kAPI_VERSION, prunedRange).has_value());
+    EXPECT_FALSE(cache.get(kMETHOD, byHash, kAPI_VERSION, prunedRange).has_value());
+}
+
+TEST_F(ResponseCacheTest, DoesNotCacheUnavailableOrMismatchingLedgers)
+{
+    auto const future = parse(R"JSON({"account": "acc", "ledger_index": 31})JSON");
+    cache.put(kMETHOD, future, kAPI_VERSION, kRANGE, response(31));
+    EXPECT_FALSE(cache.get(kMETHOD, future, kAPI_VERSION, kRANGE).has_value());
+
+    auto const invalid = parse(R"JSON({"account": "acc", "ledger_index": "current"})JSON");
+    cache.put(kMETHOD, invalid, kAPI_VERSION, kRANGE, response(30));
+    EXPECT_FALSE(cache.get(kMETHOD, invalid, kAPI_VERSION, kRANGE).has_value());
+
+    // the handler saw a ledger published after the request was made
+    auto const latest = parse(R"JSON({"account": "acc"})JSON");
+    cache.put(kMETHOD, latest, kAPI_VERSION, kRANGE, response(31));
+    EXPECT_FALSE(cache.get(kMETHOD, latest, kAPI_VERSION, kRANGE).has_value());
+}
+
+TEST_F(ResponseCacheTest, EvictsLeastRecentlyUsed)
+{
+    auto const request = [](std::uint32_t seq) {
+        return boost::json::object{{"account", "acc"}, {"ledger_index", seq}};
+    };
+
+    cache.put(kMETHOD, request(20), kAPI_VERSION, kRANGE, response(20));
+    auto const entryBytes = cache.sizeBytes();
+
+    ResponseCache small{entryBytes * 2};
+    small.put(kMETHOD, request(20), kAPI_VERSION, kRANGE, response(20));
+    small.put(kMETHOD, request(21), kAPI_VERSION, kRANGE, response(21));
+    EXPECT_TRUE(small.get(kMETHOD, request(20), kAPI_VERSION, kRANGE).has_value());
+
+    small.put(kMETHOD, request(22), kAPI_VERSION, kRANGE, response(22));
+    EXPECT_LE(small.sizeBytes(), entryBytes * 2);
+    EXPECT_TRUE(small.get(kMETHOD, request(20), kAPI_VERSION, kRANGE).has_value());
+    EXPECT_FALSE(small.get(kMETHOD, request(21), kAPI_VERSION, kRANGE).has_value());
+    EXPECT_TRUE(small.get(kMETHOD, request(22), kAPI_VERSION, kRANGE).has_value());
+}
+
+struct ResponseCacheMetricsTest : util::prometheus::WithMockPrometheus {};
+
+TEST_F(ResponseCacheMetricsTest, CountsPerMethod)
+{
+    auto& hit = makeMock<util::prometheus::CounterInt>(
+        "rpc_response_cache_total_number", "{method=\"account_info\",type=\"hit\"}"
+    );
+    auto& miss = makeMock<util::prometheus::CounterInt>(
+        "rpc_response_cache_total_number", "{method=\"account_info\",type=\"miss\"}"
+    );
+    auto& eviction = makeMock<util::prometheus::CounterInt>(
+        "rpc_response_cache_total_number", "{method=\"account_info\",type=\"eviction\"}"
+    );
+    auto& size = makeMock<util::prometheus::GaugeInt>("rpc_response_cache_size_bytes", "");
+    EXPECT_CALL(size, set).Times(testing::AnyNumber());
+
+    auto const request = [](std::uint32_t seq) {
+        return boost::json::object{{"account", "acc"}, {"ledger_index", seq}};
+    };
+
+    ResponseCache probe{1024 * 1024, {kMETHOD}};
+    probe.put(kMETHOD, request(20), kAPI_VERSION, kRANGE, response(20));
+
+    ResponseCache cache{probe.sizeBytes(), {kMETHOD}};
+    EXPECT_CALL(miss, add(1));
+    EXPECT_FALSE(cache.get(kMETHOD, request(20), kAPI_VERSION, kRANGE).has_value());
+
+    cache.put(kMETHOD, request(20), kAPI_VERSION, kRANGE, response(20));
+    EXPECT_CALL(eviction, add(1));
+    cache.put(kMETHOD, request(21), kAPI_VERSION, kRANGE, response(21));
+
+    EXPECT_CALL(hit, add(1));
+    EXPECT_TRUE(cache.get(kMETHOD, request(21), kAPI_VERSION, kRANGE).has_value());
+}
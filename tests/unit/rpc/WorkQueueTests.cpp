@@ -25,6 +25,7 @@
 #include "util/newconfig/Types.hpp"
 #include "util/prometheus/Counter.hpp"
 #include "util/prometheus/Gauge.hpp"
+#include "util/prometheus/Histogram.hpp"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -33,6 +34,8 @@
 #include <condition_variable>
 #include <mutex>
 #include <semaphore>
+#include <string>
+#include <vector>
 
 using namespace util;
 using namespace util::config;
@@ -104,6 +107,88 @@ TEST_F(WorkQueueTest, NonWhitelistedPreventSchedulingAtQueueLimitExceeded)
     EXPECT_TRUE(unblocked);
 }
 
+struct WorkQueueSchedulingTest : WithPrometheus, NoLoggerFixture {
+    WorkQueue queue{1};
+    std::binary_semaphore started{0};
+    std::binary_semaphore unblock{0};
+    std::vector<std::string> order;
+
+    // keeps the only worker busy until unblock is released, so the jobs posted meanwhile queue up
+    void
+    block()
+    {
+        queue.postCoro(
+            [this](auto /* yield */) {
+                started.release();
+                unblock.acquire();
+            },
+            WorkQueue::Priority::Public,
+            "blocker"
+        );
+        started.acquire();
+    }
+
+    void
+    post(std::string const& name, WorkQueue::Priority priority, std::string const& client)
+    {
+        queue.postCoro([this, name](auto /* yield */) { order.push_back(name); }, priority, client);
+    }
+};
+
+TEST_F(WorkQueueSchedulingTest, ClientsTakeTurns)
+{
+    block();
+    post("heavy1", WorkQueue::Priority::Public, "heavy");
+    post("heavy2", WorkQueue::Priority::Public, "heavy");
+    post("heavy3", WorkQueue::Priority::Public, "heavy");
+    post("light", WorkQueue::Priority::Public, "light");
+    unblock.release();
+    queue.join();
+
+    EXPECT_EQ(order, (std::vector<std::string>{"heavy1", "light", "heavy2", "heavy3"}));
+}
+
+TEST_F(WorkQueueSchedulingTest, HigherPriorityRunsFirst)
+{
+    block();
+    post("public", WorkQueue::Priority::Public, "client");
+    post("subscription", WorkQueue::Priority::Subscription, "client");
+    post("admin", WorkQueue::Priority::Admin, "client");
+    unblock.release();
+    queue.join();
+
+    EXPECT_EQ(order, (std::vector<std::string>{"admin", "subscription", "public"}));
+}
+
+TEST_F(WorkQueueSchedulingTest, LowerPriorityIsNotStarved)
+{
+    block();
+    for (auto i = 0; i < 16; ++i)
+        post("admin", WorkQueue::Priority::Admin, "admin");
+    post("public", WorkQueue::Priority::Public, "client");
+    unblock.release();
+    queue.join();
+
+    ASSERT_EQ(order.size(), 17);
+    EXPECT_NE(order.back(), "public");
+}
+
+TEST_F(WorkQueueSchedulingTest, ReportsPerPriority)
+{
+    block();
+    post("admin", WorkQueue::Priority::Admin, "admin");
+    unblock.release();
+    queue.join();
+
+    auto const report = queue.report();
+    auto const& priorities = report.at("priorities").as_object();
+    EXPECT_EQ(priorities.at("admin").at("queued"), 1);
+    EXPECT_EQ(priorities.at("public").at("queued"), 1);
+    EXPECT_EQ(priorities.at("whitelisted").at("queued"), 0);
+    EXPECT_EQ(priorities.at("public").at("current_queue_size"), 0);
+    EXPECT_EQ(priorities.at("admin").at("wait_us_histogram").at("+Inf"), 1);
+}
+
 struct WorkQueueStopTest : WorkQueueTest {
     testing::StrictMock<testing::MockFunction<void()>> onTasksComplete;
     testing::StrictMock<testing::MockFunction<void()>> taskMock;
@@ -156,12 +241,14 @@ TEST_F(WorkQueueMockPrometheusTest, postCoroCouhters)
     auto& queuedMock = makeMock<CounterInt>("work_queue_queued_total_number", "");
     auto& durationMock = makeMock<CounterInt>("work_queue_cumulitive_tasks_duration_us", "");
     auto& curSizeMock = makeMock<GaugeInt>("work_queue_current_size", "");
+    auto& waitMock = makeMock<HistogramInt>("work_queue_wait_duration_us_histogram", "{priority=\"public\"}");
 
     std::binary_semaphore semaphore{0};
 
     EXPECT_CALL(curSizeMock, value()).Times(2).WillRepeatedly(::testing::Return(0));
     EXPECT_CALL(curSizeMock, add(1));
     EXPECT_CALL(queuedMock, add(1));
+    EXPECT_CALL(waitMock, observe(::testing::Gt(0)));
     EXPECT_CALL(durationMock, add(::testing::Gt(0))).WillOnce([&](auto) {
         EXPECT_CALL(curSizeMock, add(-1));
         semaphore.release();
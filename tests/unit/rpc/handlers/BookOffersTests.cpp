@@ -509,6 +509,7 @@ struct BookOffersNormalTestBundle {
     std::map<ripple::uint256, std::optional<ripple::uint256>> mockedSuccessors;
     std::map<ripple::uint256, Blob> mockedLedgerObjects;
     uint32_t ledgerObjectCalls;
+    uint32_t ledgerObjectsCalls;
     std::vector<ripple::STObject> mockedOffers;
     std::string expectedJson;
 };
@@ -545,8 +546,17 @@ TEST_P(RPCBookOffersNormalPathTest, CheckOutput)
         std::back_inserter(bbs),
         [](auto const& obj) { return obj.getSerializer().peekData(); }
     );
-    ON_CALL(*backend_, doFetchLedgerObjects).WillByDefault(Return(bbs));
-    EXPECT_CALL(*backend_, doFetchLedgerObjects).Times(1);
+    // the funds of all offer owners are fetched at once, after the offers
+    ON_CALL(*backend_, doFetchLedgerObjects)
+        .WillByDefault([&](std::vector<ripple::uint256> const& keys, auto, auto) {
+            std::vector<Blob> blobs;
+            std::ranges::transform(keys, std::back_inserter(blobs), [&](auto const& key) {
+                return bundle.mockedLedgerObjects.contains(key) ? bundle.mockedLedgerObjects.at(key) : Blob{};
+            });
+            return blobs;
+        });
+    ON_CALL(*backend_, doFetchLedgerObjects(Each(ripple::uint256{kINDEX2}), seq, _)).WillByDefault(Return(bbs));
+    EXPECT_CALL(*backend_, doFetchLedgerObjects).Times(bundle.ledgerObjectsCalls);
 
     auto const handler = AnyHandler{BookOffersHandler{backend_}};
     runSpawn([&](boost::asio::yield_context yield) {
@@ -670,7 +680,8 @@ generateNormalPathBookOffersTestBundles()
                     // owner_funds should be 193
                     {ripple::keylet::fees().key, feeLedgerObject}
                 },
-            .ledgerObjectCalls = 5,
+            .ledgerObjectCalls = 4,
+            .ledgerObjectsCalls = 2,
             .mockedOffers = std::vector<ripple::STObject>{gets10XRPPays20USDOffer},
             .expectedJson = fmt::format(
                 R"({{
@@ -730,7 +741,8 @@ generateNormalPathBookOffersTestBundles()
                     // reserve ->7
                     {ripple::keylet::fees().key, feeLedgerObject}
                 },
-            .ledgerObjectCalls = 5,
+            .ledgerObjectCalls = 4,
+            .ledgerObjectsCalls = 2,
             .mockedOffers = std::vector<ripple::STObject>{gets10XRPPays20USDOffer},
             .expectedJson = fmt::format(
                 R"({{
@@ -793,6 +805,7 @@ generateNormalPathBookOffersTestBundles()
                          .peekData()}
                 },
             .ledgerObjectCalls = 3,
+            .ledgerObjectsCalls = 1,
             .mockedOffers = std::vector<ripple::STObject>{gets10XRPPays20USDOffer},
             .expectedJson = fmt::format(
                 R"({{
@@ -857,6 +870,7 @@ generateNormalPathBookOffersTestBundles()
                          .peekData()}
                 },
             .ledgerObjectCalls = 3,
+            .ledgerObjectsCalls = 1,
             .mockedOffers = std::vector<ripple::STObject>{gets10USDPays20XRPOffer},
             .expectedJson = fmt::format(
                 R"({{
@@ -922,7 +936,8 @@ generateNormalPathBookOffersTestBundles()
                     {ripple::keylet::line(account2, account, ripple::to_currency("USD")).key,
                      trustline8Balance.getSerializer().peekData()},
                 },
-            .ledgerObjectCalls = 6,
+            .ledgerObjectCalls = 3,
+            .ledgerObjectsCalls = 2,
             .mockedOffers = std::vector<ripple::STObject>{gets10USDPays20XRPOffer},
             .expectedJson = fmt::format(
                 R"({{
@@ -990,7 +1005,8 @@ generateNormalPathBookOffersTestBundles()
                     {ripple::keylet::line(account2, account, ripple::to_currency("USD")).key,
                      trustline30Balance.getSerializer().peekData()},
                 },
-            .ledgerObjectCalls = 6,
+            .ledgerObjectCalls = 3,
+            .ledgerObjectsCalls = 2,
             .mockedOffers =
                 std::vector<ripple::STObject>{// After offer1, balance is 30 - 2*10 = 10
                                               gets10USDPays20XRPOffer,
@@ -1082,6 +1098,7 @@ generateNormalPathBookOffersTestBundles()
                          .peekData()},
                 },
             .ledgerObjectCalls = 3,
+            .ledgerObjectsCalls = 1,
             .mockedOffers = std::vector<ripple::STObject>{gets10USDPays20XRPOwnerOffer},
             .expectedJson = fmt::format(
                 R"({{
@@ -1141,7 +1158,8 @@ generateNormalPathBookOffersTestBundles()
                     {ripple::keylet::line(account2, account, ripple::to_currency("USD")).key,
                      frozenTrustLine.getSerializer().peekData()},
                 },
-            .ledgerObjectCalls = 6,
+            .ledgerObjectCalls = 3,
+            .ledgerObjectsCalls = 2,
             .mockedOffers = std::vector<ripple::STObject>{gets10USDPays20XRPOffer},
             .expectedJson = fmt::format(
                 R"({{
@@ -1309,7 +1327,7 @@ TEST_F(RPCBookOffersHandlerTest, Limit)
     ON_CALL(*backend_, doFetchSuccessorKey(getsXRPPaysUSDBook, seq, _))
         .WillByDefault(Return(ripple::uint256{kPAYS20_USD_GETS10_XRP_BOOK_DIR}));
 
-    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(5);
+    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(4);
     auto const indexes = std::vector<ripple::uint256>(10, ripple::uint256{kINDEX2});
 
     ON_CALL(*backend_, doFetchLedgerObject(ripple::uint256{kPAYS20_USD_GETS10_XRP_BOOK_DIR}, seq, _))
@@ -1338,7 +1356,13 @@ TEST_F(RPCBookOffersHandlerTest, Limit)
 
     std::vector<Blob> const bbs(10, gets10XRPPays20USDOffer.getSerializer().peekData());
     ON_CALL(*backend_, doFetchLedgerObjects).WillByDefault(Return(bbs));
-    EXPECT_CALL(*backend_, doFetchLedgerObjects).Times(1);
+    // the owner is looked up once for all offers
+    auto const ownerKey = ripple::keylet::account(getAccountIdWithString(kACCOUNT2)).key;
+    ON_CALL(*backend_, doFetchLedgerObjects(ElementsAre(ownerKey), seq, _))
+        .WillByDefault(Return(std::vector<Blob>{
+            createAccountRootObject(kACCOUNT2, 0, 2, 200, 2, kINDEX1, 2).getSerializer().peekData()
+        }));
+    EXPECT_CALL(*backend_, doFetchLedgerObjects).Times(2);
 
     auto static const kINPUT = json::parse(fmt::format(
         R"({{
@@ -1382,7 +1406,7 @@ TEST_F(RPCBookOffersHandlerTest, LimitMoreThanMax)
     ON_CALL(*backend_, doFetchSuccessorKey(getsXRPPaysUSDBook, seq, _))
         .WillByDefault(Return(ripple::uint256{kPAYS20_USD_GETS10_XRP_BOOK_DIR}));
 
-    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(5);
+    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(4);
     auto const indexes = std::vector<ripple::uint256>(BookOffersHandler::kLIMIT_MAX + 1, ripple::uint256{kINDEX2});
 
     ON_CALL(*backend_, doFetchLedgerObject(ripple::uint256{kPAYS20_USD_GETS10_XRP_BOOK_DIR}, seq, _))
@@ -1411,7 +1435,13 @@ TEST_F(RPCBookOffersHandlerTest, LimitMoreThanMax)
 
     std::vector<Blob> const bbs(BookOffersHandler::kLIMIT_MAX + 1, gets10XRPPays20USDOffer.getSerializer().peekData());
     ON_CALL(*backend_, doFetchLedgerObjects).WillByDefault(Return(bbs));
-    EXPECT_CALL(*backend_, doFetchLedgerObjects).Times(1);
+    // the owner is looked up once for all offers
+    auto const ownerKey = ripple::keylet::account(getAccountIdWithString(kACCOUNT2)).key;
+    ON_CALL(*backend_, doFetchLedgerObjects(ElementsAre(ownerKey), seq, _))
+        .WillByDefault(Return(std::vector<Blob>{
+            createAccountRootObject(kACCOUNT2, 0, 2, 200, 2, kINDEX1, 2).getSerializer().peekData()
+        }));
+    EXPECT_CALL(*backend_, doFetchLedgerObjects).Times(2);
 
     auto static const kINPUT = json::parse(fmt::format(
         R"({{
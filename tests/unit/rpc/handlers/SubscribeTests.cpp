@@ -587,6 +587,12 @@ generateTestValuesForParametersTest()
             .expectedError = "badIssuer",
             .expectedErrorMessage = "Issuer account malformed."
         },
+        SubscribeParamTestCaseBundle{
+            .testName = "ResumeFromLedgerNotInt",
+            .testJson = R"({"streams": ["ledger"], "resume_from_ledger": "30"})",
+            .expectedError = "invalidParams",
+            .expectedErrorMessage = "Invalid parameters."
+        },
     };
 }
 
@@ -676,6 +682,60 @@ TEST_F(RPCSubscribeHandlerTest, StreamsLedger)
     });
 }
 
+TEST_F(RPCSubscribeHandlerTest, StreamsResumeFromLedger)
+{
+    static constexpr auto kLEDGER_OUTPUT = R"({"ledger_index":30})";
+
+    auto const input = json::parse(
+        R"({
+            "streams": ["ledger", "transactions", "book_changes", "manifests"],
+            "resume_from_ledger": 28
+        })"
+    );
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{SubscribeHandler{backend_, mockSubscriptionManagerPtr_}};
+
+        EXPECT_CALL(*mockSubscriptionManagerPtr_, canResumeFrom(28)).WillOnce(testing::Return(true));
+        EXPECT_CALL(*mockSubscriptionManagerPtr_, resumeLedger(testing::_, 28, testing::_))
+            .WillOnce(testing::Return(boost::json::parse(kLEDGER_OUTPUT).as_object()));
+        EXPECT_CALL(*mockSubscriptionManagerPtr_, resumeTransactions(28, testing::_));
+        EXPECT_CALL(*mockSubscriptionManagerPtr_, resumeBookChanges(28, testing::_));
+        // streams that are not buffered are subscribed as usual
+        EXPECT_CALL(*mockSubscriptionManagerPtr_, subManifest);
+
+        EXPECT_CALL(*mockSession_, setApiSubversion(0));
+        auto const output = handler.process(input, Context{yield, session_});
+        ASSERT_TRUE(output);
+        EXPECT_EQ(output.result->as_object(), json::parse(kLEDGER_OUTPUT));
+    });
+}
+
+TEST_F(RPCSubscribeHandlerTest, ResumeFromLedgerNotBuffered)
+{
+    auto const input = json::parse(
+        R"({
+            "streams": ["ledger", "transactions"],
+            "accounts": ["rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun"],
+            "resume_from_ledger": 28
+        })"
+    );
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{SubscribeHandler{backend_, mockSubscriptionManagerPtr_}};
+
+        EXPECT_CALL(*mockSubscriptionManagerPtr_, canResumeFrom(28)).WillOnce(testing::Return(false));
+        EXPECT_CALL(*mockSubscriptionManagerPtr_, resumeLedger).Times(0);
+        EXPECT_CALL(*mockSubscriptionManagerPtr_, resumeTransactions).Times(0);
+        EXPECT_CALL(*mockSubscriptionManagerPtr_, subAccounts).Times(0);
+
+        EXPECT_CALL(*mockSession_, setApiSubversion(0));
+        auto const output = handler.process(input, Context{yield, session_});
+        ASSERT_FALSE(output);
+        auto const err = rpc::makeError(output.result.error());
+        EXPECT_EQ(err.at("error").as_string(), "lgrNotFound");
+        EXPECT_EQ(err.at("error_message").as_string(), "ledgerNotBuffered");
+    });
+}
+
 TEST_F(RPCSubscribeHandlerTest, Accounts)
 {
     auto const input = json::parse(fmt::format(
@@ -689,8 +749,10 @@ TEST_F(RPCSubscribeHandlerTest, Accounts)
     runSpawn([&, this](auto yield) {
         auto const handler = AnyHandler{SubscribeHandler{backend_, mockSubscriptionManagerPtr_}};
 
-        EXPECT_CALL(*mockSubscriptionManagerPtr_, subAccount(getAccountIdWithString(kACCOUNT), session_));
-        EXPECT_CALL(*mockSubscriptionManagerPtr_, subAccount(getAccountIdWithString(kACCOUNT2), session_)).Times(2);
+        auto const accounts = std::vector{
+            getAccountIdWithString(kACCOUNT), getAccountIdWithString(kACCOUNT2), getAccountIdWithString(kACCOUNT2)
+        };
+        EXPECT_CALL(*mockSubscriptionManagerPtr_, subAccounts(accounts, session_));
         EXPECT_CALL(*mockSession_, setApiSubversion(0));
         auto const output = handler.process(input, Context{yield, session_});
         ASSERT_TRUE(output);
@@ -711,9 +773,10 @@ TEST_F(RPCSubscribeHandlerTest, AccountsProposed)
     runSpawn([&, this](auto yield) {
         auto const handler = AnyHandler{SubscribeHandler{backend_, mockSubscriptionManagerPtr_}};
 
-        EXPECT_CALL(*mockSubscriptionManagerPtr_, subProposedAccount(getAccountIdWithString(kACCOUNT), session_));
-        EXPECT_CALL(*mockSubscriptionManagerPtr_, subProposedAccount(getAccountIdWithString(kACCOUNT2), session_))
-            .Times(2);
+        auto const accounts = std::vector{
+            getAccountIdWithString(kACCOUNT), getAccountIdWithString(kACCOUNT2), getAccountIdWithString(kACCOUNT2)
+        };
+        EXPECT_CALL(*mockSubscriptionManagerPtr_, subProposedAccounts(accounts, session_));
         EXPECT_CALL(*mockSession_, setApiSubversion(0));
         auto const output = handler.process(input, Context{yield, session_});
         ASSERT_TRUE(output);
@@ -830,8 +893,8 @@ TEST_F(RPCSubscribeHandlerTest, BooksBothSnapshotSet)
 
     EXPECT_CALL(*backend_, doFetchSuccessorKey).Times(4);
 
-    // 2 book dirs + 2 issuer global freeze + 2 transferRate + 1 owner root + 1 fee
-    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(8);
+    // 2 book dirs + 2 issuer global freeze + 2 transferRate + 1 fee
+    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(7);
 
     auto const indexes = std::vector<ripple::uint256>(10, ripple::uint256{kINDEX2});
     ON_CALL(*backend_, doFetchLedgerObject(ripple::uint256{kPAYS20_USD_GETS10_XRP_BOOK_DIR}, kMAX_SEQ, _))
@@ -842,9 +905,12 @@ TEST_F(RPCSubscribeHandlerTest, BooksBothSnapshotSet)
     ON_CALL(*backend_, doFetchLedgerObject(ripple::uint256{kPAYS20_XRP_GETS10_USD_BOOK_DIR}, kMAX_SEQ, _))
         .WillByDefault(Return(createOwnerDirLedgerObject(indexes2, kINDEX2).getSerializer().peekData()));
 
-    // offer owner account root
-    ON_CALL(*backend_, doFetchLedgerObject(ripple::keylet::account(getAccountIdWithString(kACCOUNT2)).key, kMAX_SEQ, _))
-        .WillByDefault(Return(createAccountRootObject(kACCOUNT2, 0, 2, 200, 2, kINDEX1, 2).getSerializer().peekData()));
+    // offer owner account roots are fetched in one batch per book
+    auto const ownerKey = ripple::keylet::account(getAccountIdWithString(kACCOUNT2)).key;
+    ON_CALL(*backend_, doFetchLedgerObjects(ElementsAre(ownerKey), kMAX_SEQ, _))
+        .WillByDefault(Return(
+            std::vector<Blob>{createAccountRootObject(kACCOUNT2, 0, 2, 200, 2, kINDEX1, 2).getSerializer().peekData()}
+        ));
 
     // issuer account root
     ON_CALL(*backend_, doFetchLedgerObject(ripple::keylet::account(getAccountIdWithString(kACCOUNT)).key, kMAX_SEQ, _))
@@ -885,7 +951,8 @@ TEST_F(RPCSubscribeHandlerTest, BooksBothSnapshotSet)
     std::vector<Blob> const bbs2(10, gets10USDPays20XRPOffer.getSerializer().peekData());
     ON_CALL(*backend_, doFetchLedgerObjects(indexes2, kMAX_SEQ, _)).WillByDefault(Return(bbs2));
 
-    EXPECT_CALL(*backend_, doFetchLedgerObjects).Times(2);
+    // offers of both books + owners of the first book; the reversed book's only owner is the issuer
+    EXPECT_CALL(*backend_, doFetchLedgerObjects).Times(3);
 
     static auto const kEXPECTED_OFFER = fmt::format(
         R"({{
@@ -999,7 +1066,7 @@ TEST_F(RPCSubscribeHandlerTest, BooksBothUnsetSnapshotSet)
 
     EXPECT_CALL(*backend_, doFetchSuccessorKey).Times(2);
 
-    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(5);
+    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(4);
 
     auto const indexes = std::vector<ripple::uint256>(10, ripple::uint256{kINDEX2});
     ON_CALL(*backend_, doFetchLedgerObject(ripple::uint256{kPAYS20_USD_GETS10_XRP_BOOK_DIR}, kMAX_SEQ, _))
@@ -1010,9 +1077,12 @@ TEST_F(RPCSubscribeHandlerTest, BooksBothUnsetSnapshotSet)
     ON_CALL(*backend_, doFetchLedgerObject(ripple::uint256{kPAYS20_XRP_GETS10_USD_BOOK_DIR}, kMAX_SEQ, _))
         .WillByDefault(Return(createOwnerDirLedgerObject(indexes2, kINDEX2).getSerializer().peekData()));
 
-    // offer owner account root
-    ON_CALL(*backend_, doFetchLedgerObject(ripple::keylet::account(getAccountIdWithString(kACCOUNT2)).key, kMAX_SEQ, _))
-        .WillByDefault(Return(createAccountRootObject(kACCOUNT2, 0, 2, 200, 2, kINDEX1, 2).getSerializer().peekData()));
+    // offer owner account roots are fetched in one batch per book
+    auto const ownerKey = ripple::keylet::account(getAccountIdWithString(kACCOUNT2)).key;
+    ON_CALL(*backend_, doFetchLedgerObjects(ElementsAre(ownerKey), kMAX_SEQ, _))
+        .WillByDefault(Return(
+            std::vector<Blob>{createAccountRootObject(kACCOUNT2, 0, 2, 200, 2, kINDEX1, 2).getSerializer().peekData()}
+        ));
 
     // issuer account root
     ON_CALL(*backend_, doFetchLedgerObject(ripple::keylet::account(getAccountIdWithString(kACCOUNT)).key, kMAX_SEQ, _))
@@ -1053,7 +1123,8 @@ TEST_F(RPCSubscribeHandlerTest, BooksBothUnsetSnapshotSet)
     std::vector<Blob> const bbs2(10, gets10USDPays20XRPOffer.getSerializer().peekData());
     ON_CALL(*backend_, doFetchLedgerObjects(indexes2, kMAX_SEQ, _)).WillByDefault(Return(bbs2));
 
-    EXPECT_CALL(*backend_, doFetchLedgerObjects);
+    // offers + owners
+    EXPECT_CALL(*backend_, doFetchLedgerObjects).Times(2);
 
     static auto const kEXPECTED_OFFER = fmt::format(
         R"({{
@@ -596,9 +596,9 @@ TEST_F(RPCUnsubscribeTest, Accounts)
         kACCOUNT2
     ));
 
-    EXPECT_CALL(*mockSubscriptionManagerPtr_, unsubAccount(rpc::accountFromStringStrict(kACCOUNT).value(), _)).Times(1);
-    EXPECT_CALL(*mockSubscriptionManagerPtr_, unsubAccount(rpc::accountFromStringStrict(kACCOUNT2).value(), _))
-        .Times(1);
+    auto const accounts =
+        std::vector{rpc::accountFromStringStrict(kACCOUNT).value(), rpc::accountFromStringStrict(kACCOUNT2).value()};
+    EXPECT_CALL(*mockSubscriptionManagerPtr_, unsubAccounts(accounts, _)).Times(1);
 
     runSpawn([&, this](auto yield) {
         auto const handler = AnyHandler{UnsubscribeHandler{mockSubscriptionManagerPtr_}};
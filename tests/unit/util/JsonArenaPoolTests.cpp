@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/CountingMemoryResource.hpp"
+#include "util/JsonArenaPool.hpp"
+
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/json/storage_ptr.hpp>
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+
+using namespace util;
+
+namespace {
+
+constexpr auto kREQUEST = R"JSON({
+    "method": "account_tx",
+    "params": [{"account": "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn", "ledger_index_min": -1, "limit": 200}]
+})JSON";
+
+}  // namespace
+
+struct JsonArenaPoolTest : ::testing::Test {
+    CountingMemoryResource upstream;
+    JsonArenaPool pool{4096, 2, boost::json::storage_ptr{&upstream}};
+};
+
+TEST_F(JsonArenaPoolTest, ParsesWithoutHeapAllocations)
+{
+    auto const arena = pool.acquire();
+    auto const json = boost::json::parse(kREQUEST, arena.storage());
+
+    EXPECT_EQ(boost::json::serialize(json), boost::json::serialize(boost::json::parse(kREQUEST)));
+    EXPECT_EQ(upstream.allocations(), 0);
+}
+
+TEST_F(JsonArenaPoolTest, GrowsPastTheBlock)
+{
+    auto const arena = pool.acquire();
+    std::string large(8192, 'a');
+    auto const json = boost::json::parse("\"" + large + "\"", arena.storage());
+
+    EXPECT_EQ(json.as_string(), large);
+    EXPECT_GT(upstream.allocations(), 0);
+}
+
+TEST_F(JsonArenaPoolTest, ReusesReleasedArenas)
+{
+    EXPECT_EQ(pool.idle(), 0);
+    {
+        auto const arena = pool.acquire();
+    }
+    EXPECT_EQ(pool.idle(), 1);
+
+    {
+        auto const arena = pool.acquire();
+        EXPECT_EQ(pool.idle(), 0);
+    }
+    EXPECT_EQ(pool.idle(), 1);
+}
+
+TEST_F(JsonArenaPoolTest, KeepsAtMostMaxIdleArenas)
+{
+    {
+        auto const first = pool.acquire();
+        auto const second = pool.acquire();
+        auto const third = pool.acquire();
+    }
+    EXPECT_EQ(pool.idle(), 2);
+}
+
+TEST_F(JsonArenaPoolTest, MovedLeaseReleasesOnce)
+{
+    {
+        std::optional<JsonArenaPool::Lease> moved;
+        {
+            auto arena = pool.acquire();
+            moved.emplace(std::move(arena));
+        }
+        EXPECT_EQ(pool.idle(), 0);
+    }
+    EXPECT_EQ(pool.idle(), 1);
+}
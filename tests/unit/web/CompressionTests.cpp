@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/MockPrometheus.hpp"
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/newconfig/ConfigValue.hpp"
+#include "util/newconfig/Types.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "web/Compression.hpp"
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+using namespace util::config;
+using namespace web;
+
+namespace {
+
+ClioConfigDefinition
+makeConfig(bool enabled, std::int64_t minSize = 16)
+{
+    return ClioConfigDefinition{
+        {"server.compression.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(enabled)},
+        {"server.compression.level", ConfigValue{ConfigType::Integer}.defaultValue(6)},
+        {"server.compression.min_size", ConfigValue{ConfigType::Integer}.defaultValue(minSize)},
+    };
+}
+
+std::string
+decompress(std::string const& data, Compression::Encoding encoding)
+{
+    boost::iostreams::filtering_istream stream;
+    if (encoding == Compression::Encoding::Gzip) {
+        stream.push(boost::iostreams::gzip_decompressor{});
+    } else {
+        stream.push(boost::iostreams::zlib_decompressor{});
+    }
+    stream.push(boost::iostreams::array_source{data.data(), data.size()});
+
+    std::string out;
+    boost::iostreams::copy(stream, boost::iostreams::back_inserter(out));
+    return out;
+}
+
+std::string
+makeResponse()
+{
+    std::string response = R"({"result":{"state":[)";
+    for (auto idx = 0; idx < 1000; ++idx)
+        response += R"({"LedgerEntryType":"AccountRoot","Balance":"1000000"},)";
+    response.back() = ']';
+    return response + "}}";
+}
+
+}  // namespace
+
+struct CompressionTest : util::prometheus::WithPrometheus {
+    Compression compression{makeConfig(true)};
+};
+
+TEST_F(CompressionTest, NegotiatePrefersGzip)
+{
+    EXPECT_EQ(compression.negotiate("gzip", 100), Compression::Encoding::Gzip);
+    EXPECT_EQ(compression.negotiate("deflate, gzip;q=0.5", 100), Compression::Encoding::Gzip);
+    EXPECT_EQ(compression.negotiate("br, DEFLATE", 100), Compression::Encoding::Deflate);
+    EXPECT_EQ(compression.negotiate("*", 100), Compression::Encoding::Gzip);
+}
+
+TEST_F(CompressionTest, NegotiateHonoursRejectedCodings)
+{
+    EXPECT_EQ(compression.negotiate("gzip;q=0, deflate", 100), Compression::Encoding::Deflate);
+    EXPECT_EQ(compression.negotiate("gzip; q=0.0", 100), std::nullopt);
+    EXPECT_EQ(compression.negotiate("identity, br", 100), std::nullopt);
+    EXPECT_EQ(compression.negotiate("", 100), std::nullopt);
+}
+
+TEST_F(CompressionTest, NegotiateSkipsSmallResponses)
+{
+    EXPECT_EQ(compression.negotiate("gzip", 15), std::nullopt);
+    EXPECT_EQ(compression.negotiate("gzip", 16), Compression::Encoding::Gzip);
+}
+
+TEST_F(CompressionTest, DisabledNeverCompresses)
+{
+    Compression const disabled{makeConfig(false)};
+    EXPECT_EQ(disabled.negotiate("gzip, deflate", 1'000'000), std::nullopt);
+    EXPECT_FALSE(disabled.permessageDeflate().server_enable);
+}
+
+TEST_F(CompressionTest, CompressRoundTrips)
+{
+    auto const response = makeResponse();
+    for (auto const encoding : {Compression::Encoding::Gzip, Compression::Encoding::Deflate}) {
+        auto const compressed = compression.compress(response, encoding);
+        EXPECT_LT(compressed.size(), response.size() / 10);
+        EXPECT_EQ(decompress(compressed, encoding), response);
+    }
+}
+
+TEST_F(CompressionTest, StreamMatchesWholeResponse)
+{
+    auto const response = makeResponse();
+    auto stream = compression.makeStream(Compression::Encoding::Gzip);
+
+    std::string compressed;
+    for (std::size_t offset = 0; offset < response.size(); offset += 1000)
+        stream->write(std::string_view{response}.substr(offset, 1000), compressed);
+    stream->finish(compressed);
+
+    EXPECT_EQ(decompress(compressed, Compression::Encoding::Gzip), response);
+}
+
+TEST_F(CompressionTest, PermessageDeflate)
+{
+    auto const options = compression.permessageDeflate();
+    EXPECT_TRUE(options.server_enable);
+    EXPECT_EQ(options.compLevel, 6);
+    EXPECT_EQ(options.msg_size_threshold, 16);
+}
+
+struct CompressionMetricsTest : util::prometheus::WithMockPrometheus {};
+
+TEST_F(CompressionMetricsTest, CountsBytesBeforeAndAfterCompression)
+{
+    auto& uncompressed =
+        makeMock<util::prometheus::CounterInt>("web_compression_bytes_total_number", "{type=\"uncompressed\"}");
+    auto& compressed =
+        makeMock<util::prometheus::CounterInt>("web_compression_bytes_total_number", "{type=\"compressed\"}");
+    Compression const compression{makeConfig(true)};
+
+    auto const response = makeResponse();
+    std::size_t compressedSize = 0;
+    EXPECT_CALL(uncompressed, add(static_cast<std::int64_t>(response.size())));
+    EXPECT_CALL(compressed, add).WillRepeatedly([&compressedSize](std::int64_t const value) {
+        compressedSize += static_cast<std::size_t>(value);
+    });
+
+    auto const result = compression.compress(response, Compression::Encoding::Gzip);
+    EXPECT_EQ(compressedSize, result.size());
+}
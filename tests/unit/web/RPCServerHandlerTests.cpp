@@ -31,9 +31,12 @@
 #include "util/newconfig/Types.hpp"
 #include "web/RPCServerHandler.hpp"
 #include "web/SubscriptionContextInterface.hpp"
+#include "web/dosguard/DOSGuardMock.hpp"
 #include "web/interface/ConnectionBase.hpp"
 
 #include <boost/beast/http/status.hpp>
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
 #include <fmt/core.h>
 #include <gmock/gmock.h>
@@ -90,13 +93,17 @@ struct WebRPCServerHandlerTest : util::prometheus::WithPrometheus, MockBackendTe
         {"log_tag_style", ConfigValue{ConfigType::String}.defaultValue("none")},
         {"api_version.default", ConfigValue{ConfigType::Integer}.defaultValue(rpc::kAPI_VERSION_DEFAULT)},
         {"api_version.min", ConfigValue{ConfigType::Integer}.defaultValue(rpc::kAPI_VERSION_MIN)},
-        {"api_version.max", ConfigValue{ConfigType::Integer}.defaultValue(rpc::kAPI_VERSION_MAX)}
+        {"api_version.max", ConfigValue{ConfigType::Integer}.defaultValue(rpc::kAPI_VERSION_MAX)},
+        {"rpc.max_batch_size", ConfigValue{ConfigType::Integer}.defaultValue(3)}
     };
+    DOSGuardStrictMock dosGuard;
     std::shared_ptr<MockAsyncRPCEngine> rpcEngine = std::make_shared<MockAsyncRPCEngine>();
     std::shared_ptr<MockETLService> etl = std::make_shared<MockETLService>();
     std::shared_ptr<util::TagDecoratorFactory> tagFactory = std::make_shared<util::TagDecoratorFactory>(cfg);
     std::shared_ptr<RPCServerHandler<MockAsyncRPCEngine, MockETLService>> handler =
-        std::make_shared<RPCServerHandler<MockAsyncRPCEngine, MockETLService>>(cfg, backend_, rpcEngine, etl);
+        std::make_shared<RPCServerHandler<MockAsyncRPCEngine, MockETLService>>(
+            cfg, backend_, rpcEngine, etl, dosGuard
+        );
     std::shared_ptr<MockWsBase> session = std::make_shared<MockWsBase>(*tagFactory);
 };
 
@@ -756,8 +763,9 @@ TEST_F(WebRPCServerHandlerTest, WsTooBusy)
     session->upgraded = true;
 
     auto localRpcEngine = std::make_shared<MockRPCEngine>();
-    auto localHandler =
-        std::make_shared<RPCServerHandler<MockRPCEngine, MockETLService>>(cfg, backend_, localRpcEngine, etl);
+    auto localHandler = std::make_shared<RPCServerHandler<MockRPCEngine, MockETLService>>(
+        cfg, backend_, localRpcEngine, etl, dosGuard
+    );
     static constexpr auto kREQUEST = R"({
                                         "command": "server_info",
                                         "id": 99
@@ -784,8 +792,9 @@ TEST_F(WebRPCServerHandlerTest, WsTooBusy)
 TEST_F(WebRPCServerHandlerTest, HTTPTooBusy)
 {
     auto localRpcEngine = std::make_shared<MockRPCEngine>();
-    auto localHandler =
-        std::make_shared<RPCServerHandler<MockRPCEngine, MockETLService>>(cfg, backend_, localRpcEngine, etl);
+    auto localHandler = std::make_shared<RPCServerHandler<MockRPCEngine, MockETLService>>(
+        cfg, backend_, localRpcEngine, etl, dosGuard
+    );
     static constexpr auto kREQUEST = R"({
                                         "method": "server_info",
                                         "params": [{}]
@@ -840,6 +849,119 @@ TEST_F(WebRPCServerHandlerTest, WsRequestNotJson)
     EXPECT_EQ(boost::json::parse(session->message), boost::json::parse(kRESPONSE));
 }
 
+TEST_F(WebRPCServerHandlerTest, HTTPBatchRespondsInOrderOfRequests)
+{
+    static constexpr auto kREQUEST = R"([
+                                        {"method": "server_info", "params": [{}]},
+                                        {"method": "ledger", "params": [{"ledger_index": 10}]},
+                                        {"id": 3}
+                                    ])";
+
+    backend_->setRange(kMIN_SEQ, kMAX_SEQ);
+
+    EXPECT_CALL(dosGuard, request(session->clientIp)).Times(2).WillRepeatedly(testing::Return(true));
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_))
+        .WillOnce(testing::Return(rpc::Result{boost::json::object{{"info", 1}}}))
+        .WillOnce(testing::Return(rpc::Result{boost::json::object{{"ledger", 2}}}));
+    EXPECT_CALL(*rpcEngine, notifyComplete("server_info", testing::_));
+    EXPECT_CALL(*rpcEngine, notifyComplete("ledger", testing::_));
+    EXPECT_CALL(*rpcEngine, notifyBadSyntax);
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillRepeatedly(testing::Return(45));
+
+    (*handler)(kREQUEST, session);
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::ok);
+
+    auto const response = boost::json::parse(session->message);
+    ASSERT_TRUE(response.is_array());
+    auto const& responses = response.as_array();
+    ASSERT_EQ(responses.size(), 3);
+    EXPECT_EQ(responses.at(0).as_object().at("result"), (boost::json::object{{"info", 1}, {"status", "success"}}));
+    EXPECT_EQ(responses.at(1).as_object().at("result"), (boost::json::object{{"ledger", 2}, {"status", "success"}}));
+    EXPECT_TRUE(responses.at(1).as_object().contains("warnings"));
+    EXPECT_EQ(responses.at(2).as_object().at("result").as_object().at("error").as_string(), "invalidParams");
+    EXPECT_EQ(responses.at(2).as_object().at("result").as_object().at("error_message").as_string(), "Null method");
+}
+
+TEST_F(WebRPCServerHandlerTest, HTTPBatchRequestsOverRateLimitAreNotHandled)
+{
+    static constexpr auto kREQUEST = R"([
+                                        {"method": "server_info", "params": [{}]},
+                                        {"method": "server_info", "params": [{}]}
+                                    ])";
+
+    backend_->setRange(kMIN_SEQ, kMAX_SEQ);
+
+    EXPECT_CALL(dosGuard, request(session->clientIp)).WillOnce(testing::Return(false));
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_)).WillOnce(testing::Return(rpc::Result{boost::json::object{}}));
+    EXPECT_CALL(*rpcEngine, notifyComplete("server_info", testing::_));
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*handler)(kREQUEST, session);
+
+    auto const response = boost::json::parse(session->message);
+    ASSERT_TRUE(response.is_array());
+    auto const& responses = response.as_array();
+    ASSERT_EQ(responses.size(), 2);
+    EXPECT_EQ(responses.at(0).as_object().at("result").as_object().at("status").as_string(), "success");
+    EXPECT_EQ(responses.at(1).as_object().at("result").as_object().at("error").as_string(), "slowDown");
+}
+
+TEST_F(WebRPCServerHandlerTest, HTTPBatchRequestsOverWorkQueueLimitAreTooBusy)
+{
+    static constexpr auto kREQUEST = R"([
+                                        {"method": "server_info", "params": [{}]},
+                                        {"method": "server_info", "params": [{}]}
+                                    ])";
+
+    backend_->setRange(kMIN_SEQ, kMAX_SEQ);
+    rpcEngine->postsLeft = 2;  // the batch and its first request
+
+    EXPECT_CALL(dosGuard, request(session->clientIp)).WillOnce(testing::Return(true));
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_)).WillOnce(testing::Return(rpc::Result{boost::json::object{}}));
+    EXPECT_CALL(*rpcEngine, notifyComplete("server_info", testing::_));
+    EXPECT_CALL(*rpcEngine, notifyTooBusy);
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*handler)(kREQUEST, session);
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::ok);
+
+    auto const response = boost::json::parse(session->message);
+    ASSERT_TRUE(response.is_array());
+    auto const& responses = response.as_array();
+    ASSERT_EQ(responses.size(), 2);
+    EXPECT_EQ(responses.at(0).as_object().at("result").as_object().at("status").as_string(), "success");
+    EXPECT_EQ(responses.at(1).as_object().at("result").as_object().at("error").as_string(), "tooBusy");
+}
+
+TEST_F(WebRPCServerHandlerTest, HTTPBatchTooLarge)
+{
+    static constexpr auto kREQUEST =
+        R"([{"method": "ping"}, {"method": "ping"}, {"method": "ping"}, {"method": "ping"}])";
+
+    EXPECT_CALL(*rpcEngine, notifyBadSyntax);
+
+    (*handler)(kREQUEST, session);
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::bad_request);
+
+    auto const response = boost::json::parse(session->message);
+    EXPECT_EQ(response.as_object().at("result").as_object().at("error").as_string(), "invalidParams");
+    EXPECT_EQ(
+        response.as_object().at("result").as_object().at("error_message").as_string(),
+        "A batch must contain between 1 and 3 requests"
+    );
+}
+
+TEST_F(WebRPCServerHandlerTest, WsBatchIsBadSyntax)
+{
+    session->upgraded = true;
+    static constexpr auto kREQUEST = R"([{"command": "ping"}])";
+
+    EXPECT_CALL(*rpcEngine, notifyBadSyntax);
+
+    (*handler)(kREQUEST, session);
+    EXPECT_EQ(boost::json::parse(session->message).as_object().at("error").as_string(), "badSyntax");
+}
+
 struct InvalidAPIVersionTestBundle {
     std::string testName;
     std::string version;
@@ -36,14 +36,29 @@
 #include "web/dosguard/DOSGuardInterface.hpp"
 #include "web/dosguard/IntervalSweepHandler.hpp"
 #include "web/dosguard/WhitelistHandler.hpp"
+#include "web/impl/ResponseSerializer.hpp"
 #include "web/interface/ConnectionBase.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
 #include <boost/beast/core/error.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
 #include <boost/beast/http/field.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/read.hpp>
 #include <boost/beast/http/status.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <boost/beast/http/write.hpp>
 #include <boost/beast/websocket/error.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/value.hpp>
 #include <boost/system/system_error.hpp>
@@ -120,6 +135,9 @@ getParseServerConfig(boost::json::value val)
         {"server.admin_password", ConfigValue{ConfigType::String}.optional()},
         {"server.local_admin", ConfigValue{ConfigType::Boolean}.optional()},
         {"server.ws_max_sending_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(1500)},
+        {"server.compression.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.compression.level", ConfigValue{ConfigType::Integer}.defaultValue(6)},
+        {"server.compression.min_size", ConfigValue{ConfigType::Integer}.defaultValue(1024)},
         {"log_tag_style", ConfigValue{ConfigType::String}.defaultValue("uint")},
         {"dos_guard.max_fetches", ConfigValue{ConfigType::Integer}},
         {"dos_guard.sweep_interval", ConfigValue{ConfigType::Integer}},
@@ -194,6 +212,26 @@ public:
     }
 };
 
+class LargeJsonExecutor {
+public:
+    static std::string
+    payload()
+    {
+        return std::string(kSTREAMED_CHUNK_SIZE * 2 + 10, 'a');
+    }
+
+    void
+    operator()(std::string const& /* req */, std::shared_ptr<web::ConnectionBase> const& ws)
+    {
+        ws->send(boost::json::object{{"payload", payload()}}, http::status::ok);
+    }
+
+    void
+    operator()(boost::beast::error_code /* ec */, std::shared_ptr<web::ConnectionBase> const& /* ws */)
+    {
+    }
+};
+
 class ExceptionExecutor {
 public:
     void
@@ -238,6 +276,27 @@ makeServerSync(
     return server;
 }
 
+http::response<http::string_body>
+postWithVersion(std::string const& port, unsigned version)
+{
+    boost::asio::io_context ioc;
+    boost::asio::ip::tcp::resolver resolver{ioc};
+    boost::beast::tcp_stream stream{ioc};
+    stream.connect(resolver.resolve("localhost", port));
+
+    http::request<http::string_body> req{http::verb::post, "/", version};
+    req.set(http::field::host, "localhost");
+    req.keep_alive(true);
+    req.body() = "{}";
+    req.prepare_payload();
+    http::write(stream, req);
+
+    boost::beast::flat_buffer buffer;
+    http::response<http::string_body> res;
+    http::read(stream, buffer, res);
+    return res;
+}
+
 }  // namespace
 
 TEST_F(WebServerTest, Http)
@@ -260,6 +319,39 @@ TEST_F(WebServerTest, Ws)
     wsClient.disconnect();
 }
 
+TEST_F(WebServerTest, HttpLargeJsonResponseIsChunked)
+{
+    auto const e = std::make_shared<LargeJsonExecutor>();
+    auto const server = makeServerSync(cfg, ctx, dosGuard, e);
+    auto const res = postWithVersion(port, 11);
+    EXPECT_EQ(res.result(), boost::beast::http::status::ok);
+    EXPECT_TRUE(res.chunked());
+    EXPECT_TRUE(res.keep_alive());
+    EXPECT_EQ(res.body(), fmt::format(R"({{"payload":"{}"}})", LargeJsonExecutor::payload()));
+}
+
+TEST_F(WebServerTest, HttpLargeJsonResponseToHttp10IsNotChunked)
+{
+    auto const e = std::make_shared<LargeJsonExecutor>();
+    auto const server = makeServerSync(cfg, ctx, dosGuard, e);
+    auto const res = postWithVersion(port, 10);
+    EXPECT_EQ(res.result(), boost::beast::http::status::ok);
+    EXPECT_FALSE(res.chunked());
+    EXPECT_FALSE(res.keep_alive());
+    EXPECT_EQ(res.body(), fmt::format(R"({{"payload":"{}"}})", LargeJsonExecutor::payload()));
+}
+
+TEST_F(WebServerTest, WsLargeJsonResponseIsFragmented)
+{
+    auto e = std::make_shared<LargeJsonExecutor>();
+    auto const server = makeServerSync(cfg, ctx, dosGuard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", port);
+    EXPECT_EQ(wsClient.syncPost(R"({})"), fmt::format(R"({{"payload":"{}"}})", LargeJsonExecutor::payload()));
+    EXPECT_EQ(wsClient.syncPost(R"({})"), fmt::format(R"({{"payload":"{}"}})", LargeJsonExecutor::payload()));
+    wsClient.disconnect();
+}
+
 TEST_F(WebServerTest, HttpInternalError)
 {
     auto const e = std::make_shared<ExceptionExecutor>();
@@ -549,6 +641,9 @@ getParseAdminServerConfig(boost::json::value val)
         {"server.processing_policy", ConfigValue{ConfigType::String}.defaultValue("parallel")},
         {"server.parallel_requests_limit", ConfigValue{ConfigType::Integer}.optional()},
         {"server.ws_max_sending_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(1500)},
+        {"server.compression.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.compression.level", ConfigValue{ConfigType::Integer}.defaultValue(6)},
+        {"server.compression.min_size", ConfigValue{ConfigType::Integer}.defaultValue(1024)},
         {"ssl_cert_file", ConfigValue{ConfigType::String}.optional()},
         {"ssl_key_file", ConfigValue{ConfigType::String}.optional()},
         {"prometheus.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(true)},
@@ -702,6 +797,28 @@ TEST_F(WebServerTest, AdminErrorCfgTestBothAdminPasswordAndLocalAdminFalse)
 
 struct WebServerPrometheusTest : util::prometheus::WithPrometheus, WebServerTest {};
 
+TEST_F(WebServerPrometheusTest, HttpLargeJsonResponseIsCompressed)
+{
+    auto json = generateJSONWithDynamicPort(port);
+    json.as_object()["server"].as_object()["compression"] = boost::json::object{{"enabled", true}};
+    auto const compressionCfg = getParseServerConfig(json);
+
+    auto const e = std::make_shared<LargeJsonExecutor>();
+    auto const server = makeServerSync(compressionCfg, ctx, dosGuard, e);
+    auto const [status, res] = HttpSyncClient::post(
+        "localhost", port, R"({})", {WebHeader{http::field::accept_encoding, "gzip"}}
+    );
+    EXPECT_EQ(status, boost::beast::http::status::ok);
+    EXPECT_LT(res.size(), LargeJsonExecutor::payload().size() / 10);
+
+    boost::iostreams::filtering_istream stream;
+    stream.push(boost::iostreams::gzip_decompressor{});
+    stream.push(boost::iostreams::array_source{res.data(), res.size()});
+    std::string decompressed;
+    boost::iostreams::copy(stream, boost::iostreams::back_inserter(decompressed));
+    EXPECT_EQ(decompressed, fmt::format(R"({{"payload":"{}"}})", LargeJsonExecutor::payload()));
+}
+
 TEST_F(WebServerPrometheusTest, rejectedWithoutAdminPassword)
 {
     auto const e = std::make_shared<EchoExecutor>();
@@ -28,6 +28,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <string_view>
 
 using namespace testing;
@@ -42,6 +43,7 @@ struct DOSGuardTest : NoLoggerFixture {
             "max_fetches": 100,
             "max_connections": 2,
             "max_requests": 3,
+            "sweep_interval": 1,
             "whitelist": [
                 "127.0.0.1"
             ]
@@ -58,10 +60,12 @@ struct DOSGuardTest : NoLoggerFixture {
         {{"dos_guard.max_fetches", ConfigValue{ConfigType::Integer}.defaultValue(100)},
          {"dos_guard.max_connections", ConfigValue{ConfigType::Integer}.defaultValue(2)},
          {"dos_guard.max_requests", ConfigValue{ConfigType::Integer}.defaultValue(3)},
+         {"dos_guard.sweep_interval", ConfigValue{ConfigType::Double}.defaultValue(1.0)},
          {"dos_guard.whitelist", Array{ConfigValue{ConfigType::String}}}}
     };
     NiceMock<MockWhitelistHandler> whitelistHandler;
-    DOSGuard guard{cfg, whitelistHandler};
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    DOSGuard guard{cfg, whitelistHandler, [this] { return now; }};
 };
 
 TEST_F(DOSGuardTest, Whitelisting)
@@ -93,19 +97,17 @@ TEST_F(DOSGuardTest, FetchCount)
     EXPECT_FALSE(guard.add(kIP, 1));  // can't add even 1 anymore
     EXPECT_FALSE(guard.isOk(kIP));
 
-    guard.clear();                 // force clear the above fetch count
-    EXPECT_TRUE(guard.isOk(kIP));  // can fetch again
+    now += std::chrono::seconds{1};  // the whole allowence drains in one sweep interval
+    EXPECT_TRUE(guard.isOk(kIP));    // can fetch again
 }
 
-TEST_F(DOSGuardTest, ClearFetchCountOnTimer)
+TEST_F(DOSGuardTest, FetchCountDrainsGradually)
 {
-    EXPECT_TRUE(guard.add(kIP, 50));  // half of allowence
-    EXPECT_TRUE(guard.add(kIP, 50));  // now fully charged
-    EXPECT_FALSE(guard.add(kIP, 1));  // can't add even 1 anymore
-    EXPECT_FALSE(guard.isOk(kIP));
+    EXPECT_TRUE(guard.add(kIP, 100));
 
-    guard.clear();                 // pretend sweep called from timer
-    EXPECT_TRUE(guard.isOk(kIP));  // can fetch again
+    now += std::chrono::milliseconds{500};
+    EXPECT_TRUE(guard.add(kIP, 50));  // half of the allowence drained
+    EXPECT_FALSE(guard.add(kIP, 1));  // but not more
 }
 
 TEST_F(DOSGuardTest, RequestLimit)
@@ -116,18 +118,30 @@ TEST_F(DOSGuardTest, RequestLimit)
     EXPECT_TRUE(guard.isOk(kIP));
     EXPECT_FALSE(guard.request(kIP));
     EXPECT_FALSE(guard.isOk(kIP));
-    guard.clear();
+
+    now += std::chrono::seconds{1};
     EXPECT_TRUE(guard.isOk(kIP));  // can request again
 }
 
-TEST_F(DOSGuardTest, RequestLimitOnTimer)
+TEST_F(DOSGuardTest, ClearOnlyForgetsIdleClients)
 {
-    EXPECT_TRUE(guard.request(kIP));
-    EXPECT_TRUE(guard.request(kIP));
-    EXPECT_TRUE(guard.request(kIP));
-    EXPECT_TRUE(guard.isOk(kIP));
-    EXPECT_FALSE(guard.request(kIP));
+    EXPECT_TRUE(guard.add(kIP, 100));
+    EXPECT_FALSE(guard.add(kIP, 1));
+
+    guard.clear();  // pretend sweep called from timer
     EXPECT_FALSE(guard.isOk(kIP));
+
+    now += std::chrono::seconds{1};
     guard.clear();
-    EXPECT_TRUE(guard.isOk(kIP));  // can request again
+    EXPECT_TRUE(guard.isOk(kIP));
+}
+
+TEST_F(DOSGuardTest, KeyedByAddress)
+{
+    guard.increment(kIP);
+    guard.increment("::ffff:127.0.0.2");  // the same client over IPv6
+    EXPECT_TRUE(guard.isOk(kIP));
+    guard.increment(kIP);
+    EXPECT_FALSE(guard.isOk("::ffff:127.0.0.2"));
+    EXPECT_TRUE(guard.isOk("127.0.0.3"));
 }
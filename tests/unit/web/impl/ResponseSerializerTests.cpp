@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/dosguard/DOSGuardMock.hpp"
+#include "web/impl/ResponseSerializer.hpp"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+
+using namespace web::impl;
+
+namespace {
+
+constexpr auto kIP = "127.0.0.2";
+constexpr auto kRATE_LIMIT_WARNINGS = R"JSON([{"id":2003,"message":"You are about to be rate limited"}])JSON";
+
+boost::json::object
+parse(std::string const& json)
+{
+    return boost::json::parse(json).as_object();
+}
+
+}  // namespace
+
+struct ResponseSerializerTest : ::testing::Test {
+    DOSGuardStrictMock dosGuard;
+    std::string buffer;
+};
+
+TEST_F(ResponseSerializerTest, SerializeIntoReplacesContent)
+{
+    buffer = "leftover";
+    auto const json = parse(R"JSON({"result": {"status": "success"}})JSON");
+
+    serializeInto(json, buffer);
+    EXPECT_EQ(buffer, boost::json::serialize(json));
+}
+
+TEST_F(ResponseSerializerTest, ChargesTheSerializedSize)
+{
+    auto response = parse(R"JSON({"result": {"status": "success"}, "warnings": [{"id": 2001}]})JSON");
+    auto const expected = boost::json::serialize(response);
+    EXPECT_CALL(dosGuard, add(kIP, expected.size())).WillOnce(testing::Return(true));
+
+    serializeResponse(response, kIP, dosGuard, buffer);
+    EXPECT_EQ(parse(buffer), parse(expected));
+}
+
+TEST_F(ResponseSerializerTest, AppendsRateLimitWarning)
+{
+    auto response = parse(R"JSON({"result": {"status": "success"}, "warnings": [{"id": 2001}]})JSON");
+    EXPECT_CALL(dosGuard, add(kIP, testing::_)).WillOnce(testing::Return(false));
+
+    serializeResponse(response, kIP, dosGuard, buffer);
+    EXPECT_EQ(
+        parse(buffer),
+        parse(R"JSON({
+            "result": {"status": "success"},
+            "warning": "load",
+            "warnings": [{"id": 2001}, {"id": 2003, "message": "You are about to be rate limited"}]
+        })JSON")
+    );
+}
+
+TEST_F(ResponseSerializerTest, AddsRateLimitWarningsWhenThereAreNone)
+{
+    auto response = parse(R"JSON({"error": "tooBusy"})JSON");
+    EXPECT_CALL(dosGuard, add(kIP, testing::_)).WillOnce(testing::Return(false));
+
+    serializeResponse(response, kIP, dosGuard, buffer);
+    EXPECT_EQ(buffer, std::string{R"({"error":"tooBusy","warning":"load","warnings":)"} + kRATE_LIMIT_WARNINGS + "}");
+}
+
+TEST_F(ResponseSerializerTest, EmptyResponse)
+{
+    boost::json::object response;
+    EXPECT_CALL(dosGuard, add(kIP, 2)).WillOnce(testing::Return(true));
+    serializeResponse(response, kIP, dosGuard, buffer);
+    EXPECT_EQ(buffer, "{}");
+
+    EXPECT_CALL(dosGuard, add(kIP, 2)).WillOnce(testing::Return(false));
+    serializeResponse(response, kIP, dosGuard, buffer);
+    EXPECT_EQ(buffer, std::string{R"({"warning":"load","warnings":)"} + kRATE_LIMIT_WARNINGS + "}");
+}
+
+TEST_F(ResponseSerializerTest, StreamSerializesInPieces)
+{
+    boost::json::array state;
+    for (auto idx = 0; idx < 100; ++idx)
+        state.push_back(boost::json::object{{"index", idx}});
+    auto response = boost::json::object{
+        {"result", boost::json::object{{"state", state}}},
+        {"warnings", boost::json::array{boost::json::object{{"id", 2001}}}}
+    };
+    auto const expected = boost::json::serialize(response);
+
+    ResponseStream stream{std::move(response), kIP, dosGuard};
+    EXPECT_CALL(dosGuard, add(kIP, expected.size())).WillOnce([&stream](auto&&...) {
+        EXPECT_TRUE(stream.done());
+        return true;
+    });
+
+    std::string serialized;
+    while (not stream.done()) {
+        std::string piece;
+        stream.next(piece, 64);
+        if (not stream.done())
+            EXPECT_EQ(piece.size(), 64);
+        serialized += piece;
+    }
+    EXPECT_EQ(parse(serialized), parse(expected));
+}
+
+TEST_F(ResponseSerializerTest, StreamAppendsRateLimitWarningToLastPiece)
+{
+    ResponseStream stream{parse(R"JSON({"result": {"status": "success"}})JSON"), kIP, dosGuard};
+    EXPECT_CALL(dosGuard, add(kIP, testing::_)).WillOnce(testing::Return(false));
+
+    std::string serialized;
+    while (not stream.done())
+        stream.next(serialized, 8);
+    EXPECT_EQ(
+        serialized,
+        std::string{R"({"result":{"status":"success"},"warning":"load","warnings":)"} + kRATE_LIMIT_WARNINGS + "}"
+    );
+}
+
+TEST_F(ResponseSerializerTest, StreamSerializesBatchInPieces)
+{
+    auto batch = boost::json::array{
+        parse(R"JSON({"result": {"status": "success"}, "warnings": [{"id": 2001}]})JSON"),
+        parse(R"JSON({"result": {"status": "error"}})JSON"),
+    };
+    auto const expected = boost::json::serialize(batch);
+    EXPECT_CALL(dosGuard, add(kIP, boost::json::serialize(batch.at(0)).size())).WillOnce(testing::Return(true));
+    EXPECT_CALL(dosGuard, add(kIP, boost::json::serialize(batch.at(1)).size())).WillOnce(testing::Return(true));
+
+    ResponseStream stream{std::move(batch), kIP, dosGuard};
+
+    std::string serialized;
+    while (not stream.done())
+        stream.next(serialized, 8);
+    EXPECT_EQ(boost::json::parse(serialized), boost::json::parse(expected));
+}
+
+TEST_F(ResponseSerializerTest, StreamAddsRateLimitWarningToBatchResponsesFromTheLimitOn)
+{
+    ResponseStream stream{
+        boost::json::array{
+            parse(R"JSON({"result": {"status": "success"}})JSON"),
+            parse(R"JSON({"result": {"status": "success"}, "warnings": [{"id": 2001}]})JSON"),
+        },
+        kIP,
+        dosGuard
+    };
+    EXPECT_CALL(dosGuard, add(kIP, testing::_)).WillOnce(testing::Return(true)).WillOnce(testing::Return(false));
+
+    std::string serialized;
+    stream.next(serialized, 1024);
+    EXPECT_TRUE(stream.done());
+    EXPECT_EQ(
+        boost::json::parse(serialized),
+        boost::json::parse(R"JSON([
+            {"result": {"status": "success"}},
+            {
+                "result": {"status": "success"},
+                "warning": "load",
+                "warnings": [{"id": 2001}, {"id": 2003, "message": "You are about to be rate limited"}]
+            }
+        ])JSON")
+    );
+}
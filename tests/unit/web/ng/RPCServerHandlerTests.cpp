@@ -107,7 +107,7 @@ TEST_F(NgRpcServerHandlerTest, CoroutineSleepsUntilRpcEngineFinishes)
     runSpawn([&](boost::asio::yield_context yield) {
         auto const request = makeHttpRequest("some message");
 
-        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&) {
+        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&, auto&&) {
             boost::asio::spawn(
                 ctx_,
                 [this, &rpcEngineDone, fn = std::forward<decltype(fn)>(fn)](boost::asio::yield_context yield) {
@@ -131,7 +131,7 @@ TEST_F(NgRpcServerHandlerTest, JsonParseFailed)
     runSpawn([&](boost::asio::yield_context yield) {
         auto const request = makeHttpRequest("not a json");
 
-        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&) {
+        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&, auto&&) {
             EXPECT_CALL(*rpcEngine_, notifyBadSyntax);
             fn(yield);
             return true;
@@ -145,7 +145,7 @@ TEST_F(NgRpcServerHandlerTest, GotNotJsonObject)
 {
     runSpawn([&](boost::asio::yield_context yield) {
         auto const request = makeHttpRequest("[]");
-        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&) {
+        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&, auto&&) {
             EXPECT_CALL(*rpcEngine_, notifyBadSyntax);
             fn(yield);
             return true;
@@ -160,7 +160,7 @@ TEST_F(NgRpcServerHandlerTest, HandleRequest_NoRangeFromBackend)
     runSpawn([&](boost::asio::yield_context yield) {
         auto const request = makeHttpRequest("{}");
 
-        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&) {
+        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&, auto&&) {
             EXPECT_CALL(connectionMetadata_, wasUpgraded).WillOnce(Return(not request.isHttp()));
             EXPECT_CALL(*rpcEngine_, notifyNotReady);
             fn(yield);
@@ -182,7 +182,7 @@ TEST_F(NgRpcServerHandlerTest, HandleRequest_ContextCreationFailed)
     runSpawn([&](boost::asio::yield_context yield) {
         auto const request = makeHttpRequest("{}");
 
-        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&) {
+        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&, auto&&) {
             EXPECT_CALL(connectionMetadata_, wasUpgraded).WillRepeatedly(Return(not request.isHttp()));
             EXPECT_CALL(*rpcEngine_, notifyBadSyntax);
             fn(yield);
@@ -202,7 +202,7 @@ TEST_F(NgRpcServerHandlerTest, HandleRequest_BuildResponseFailed)
     runSpawn([&](boost::asio::yield_context yield) {
         auto const request = makeHttpRequest(R"json({"method":"some_method"})json");
 
-        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&) {
+        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&, auto&&) {
             EXPECT_CALL(connectionMetadata_, wasUpgraded).WillRepeatedly(Return(not request.isHttp()));
             EXPECT_CALL(*rpcEngine_, buildResponse)
                 .WillOnce(Return(rpc::Result{rpc::Status{rpc::ClioError::RpcUnknownOption}}));
@@ -229,7 +229,7 @@ TEST_F(NgRpcServerHandlerTest, HandleRequest_BuildResponseThrewAnException)
     runSpawn([&](boost::asio::yield_context yield) {
         auto const request = makeHttpRequest(R"json({"method":"some_method"})json");
 
-        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&) {
+        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&, auto&&) {
             EXPECT_CALL(connectionMetadata_, wasUpgraded).WillRepeatedly(Return(not request.isHttp()));
             EXPECT_CALL(*rpcEngine_, buildResponse).WillOnce([](auto&&) -> rpc::Result {
                 throw std::runtime_error("some error");
@@ -251,7 +251,7 @@ TEST_F(NgRpcServerHandlerTest, HandleRequest_Successful_HttpRequest)
     runSpawn([&](boost::asio::yield_context yield) {
         auto const request = makeHttpRequest(R"json({"method":"some_method"})json");
 
-        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&) {
+        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&, auto&&) {
             EXPECT_CALL(connectionMetadata_, wasUpgraded).WillRepeatedly(Return(not request.isHttp()));
             EXPECT_CALL(*rpcEngine_, buildResponse)
                 .WillOnce(Return(rpc::Result{rpc::ReturnType{boost::json::object{{"some key", "some value"}}}}));
@@ -280,7 +280,7 @@ TEST_F(NgRpcServerHandlerTest, HandleRequest_OutdatedWarning)
     runSpawn([&](boost::asio::yield_context yield) {
         auto const request = makeHttpRequest(R"json({"method":"some_method"})json");
 
-        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&) {
+        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&, auto&&) {
             EXPECT_CALL(connectionMetadata_, wasUpgraded).WillRepeatedly(Return(not request.isHttp()));
             EXPECT_CALL(*rpcEngine_, buildResponse)
                 .WillOnce(Return(rpc::Result{rpc::ReturnType{boost::json::object{{"some key", "some value"}}}}));
@@ -315,7 +315,7 @@ TEST_F(NgRpcServerHandlerTest, HandleRequest_Successful_HttpRequest_Forwarded)
     runSpawn([&](boost::asio::yield_context yield) {
         auto const request = makeHttpRequest(R"json({"method":"some_method"})json");
 
-        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&) {
+        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&, auto&&) {
             EXPECT_CALL(connectionMetadata_, wasUpgraded).WillRepeatedly(Return(not request.isHttp()));
             EXPECT_CALL(*rpcEngine_, buildResponse)
                 .WillOnce(Return(rpc::Result{rpc::ReturnType{boost::json::object{
@@ -347,7 +347,7 @@ TEST_F(NgRpcServerHandlerTest, HandleRequest_Successful_HttpRequest_HasError)
     runSpawn([&](boost::asio::yield_context yield) {
         auto const request = makeHttpRequest(R"json({"method":"some_method"})json");
 
-        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&) {
+        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&, auto&&) {
             EXPECT_CALL(connectionMetadata_, wasUpgraded).WillRepeatedly(Return(not request.isHttp()));
             EXPECT_CALL(*rpcEngine_, buildResponse)
                 .WillOnce(Return(rpc::Result{
@@ -395,7 +395,7 @@ TEST_F(NgRpcServerHandlerWsTest, HandleRequest_Successful_WsRequest)
         Request::HttpHeaders const headers;
         auto const request = Request(R"json({"method":"some_method", "id": 1234, "api_version": 1})json", headers);
 
-        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&) {
+        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&, auto&&) {
             EXPECT_CALL(connectionMetadata_, wasUpgraded).WillRepeatedly(Return(not request.isHttp()));
             EXPECT_CALL(*rpcEngine_, buildResponse)
                 .WillOnce(Return(rpc::Result{rpc::ReturnType{boost::json::object{{"some key", "some value"}}}}));
@@ -426,7 +426,7 @@ TEST_F(NgRpcServerHandlerWsTest, HandleRequest_Successful_WsRequest_HasError)
         Request::HttpHeaders const headers;
         auto const request = Request(R"json({"method":"some_method", "id": 1234, "api_version": 1})json", headers);
 
-        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&) {
+        EXPECT_CALL(*rpcEngine_, post).WillOnce([&](auto&& fn, auto&&, auto&&) {
             EXPECT_CALL(connectionMetadata_, wasUpgraded).WillRepeatedly(Return(not request.isHttp()));
             EXPECT_CALL(*rpcEngine_, buildResponse)
                 .WillOnce(Return(rpc::Result{
@@ -84,6 +84,9 @@ TEST_P(MakeServerTest, Make)
         {"server.processing_policy", ConfigValue{ConfigType::String}.defaultValue("parallel")},
         {"server.parallel_requests_limit", ConfigValue{ConfigType::Integer}.optional()},
         {"server.ws_max_sending_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(1500)},
+        {"server.compression.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.compression.level", ConfigValue{ConfigType::Integer}.defaultValue(6)},
+        {"server.compression.min_size", ConfigValue{ConfigType::Integer}.defaultValue(1024)},
         {"log_tag_style", ConfigValue{ConfigType::String}.defaultValue("uint")},
         {"ssl_cert_file", ConfigValue{ConfigType::String}.optional()},
         {"ssl_key_file", ConfigValue{ConfigType::String}.optional()}
@@ -171,6 +174,9 @@ protected:
         {"server.local_admin", ConfigValue{ConfigType::Boolean}.optional()},
         {"server.parallel_requests_limit", ConfigValue{ConfigType::Integer}.optional()},
         {"server.ws_max_sending_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(1500)},
+        {"server.compression.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.compression.level", ConfigValue{ConfigType::Integer}.defaultValue(6)},
+        {"server.compression.min_size", ConfigValue{ConfigType::Integer}.defaultValue(1024)},
         {"log_tag_style", ConfigValue{ConfigType::String}.defaultValue("uint")},
         {"ssl_key_file", ConfigValue{ConfigType::String}.optional()},
         {"ssl_cert_file", ConfigValue{ConfigType::String}.optional()}